@@ -0,0 +1,116 @@
+#include <ydb/public/api/grpc/ydb_operation_v1.grpc.pb.h>
+#include <ydb/public/api/grpc/ydb_scripting_v1.grpc.pb.h>
+#include <client/draft/ydb_scripting.h>
+
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+#include <library/cpp/testing/unittest/tests_data.h>
+
+#include <atomic>
+
+using namespace NYdb;
+using namespace NYdb::NScripting;
+
+namespace {
+
+// Enough rows for the response to take several segments of the request arena
+constexpr size_t ROWS_COUNT = 1000;
+const std::string OPERATION_ID = "ydb://operation/1";
+
+Ydb::Scripting::ExecuteYqlResult MakeResult() {
+    Ydb::Scripting::ExecuteYqlResult result;
+    auto& resultSet = *result.add_result_sets();
+    auto& column = *resultSet.add_columns();
+    column.set_name("value");
+    column.mutable_type()->set_type_id(Ydb::Type::UTF8);
+    for (size_t i = 0; i < ROWS_COUNT; ++i) {
+        resultSet.add_rows()->add_items()->set_text_value("row " + std::to_string(i));
+    }
+    return result;
+}
+
+// Operation is not ready in the response, its result is polled with GetOperation
+class TMockScriptingService : public Ydb::Scripting::V1::ScriptingService::Service {
+public:
+    grpc::Status ExecuteYql(
+        grpc::ServerContext* context,
+        const Ydb::Scripting::ExecuteYqlRequest* request,
+        Ydb::Scripting::ExecuteYqlResponse* response) override
+    {
+        Y_UNUSED(context);
+        Y_UNUSED(request);
+
+        auto* op = response->mutable_operation();
+        op->set_id(OPERATION_ID);
+        op->set_ready(false);
+        return grpc::Status::OK;
+    }
+};
+
+class TMockOperationService : public Ydb::Operation::V1::OperationService::Service {
+public:
+    grpc::Status GetOperation(
+        grpc::ServerContext* context,
+        const Ydb::Operations::GetOperationRequest* request,
+        Ydb::Operations::GetOperationResponse* response) override
+    {
+        Y_UNUSED(context);
+        UNIT_ASSERT_VALUES_EQUAL(request->id(), OPERATION_ID);
+
+        auto* op = response->mutable_operation();
+        op->set_id(OPERATION_ID);
+        // Result is ready on the second poll
+        if (Polls.fetch_add(1) == 0) {
+            op->set_ready(false);
+            return grpc::Status::OK;
+        }
+
+        op->set_ready(true);
+        op->set_status(Ydb::StatusIds::SUCCESS);
+        op->add_issues()->set_message("deferred");
+        op->mutable_result()->PackFrom(MakeResult());
+        return grpc::Status::OK;
+    }
+
+    std::atomic<size_t> Polls = 0;
+};
+
+}
+
+Y_UNIT_TEST_SUITE(DeferredOperation) {
+    Y_UNIT_TEST(ResultOutlivesArena) {
+        TMockScriptingService scriptingService;
+        TMockOperationService operationService;
+
+        TPortManager pm;
+        const std::string addr = "localhost:" + std::to_string(pm.GetPort());
+
+        grpc::ServerBuilder builder;
+        builder.AddListeningPort(addr, grpc::InsecureServerCredentials());
+        builder.RegisterService(&scriptingService);
+        builder.RegisterService(&operationService);
+        auto server = builder.BuildAndStart();
+
+        TDriver driver(TDriverConfig().SetEndpoint(addr));
+        TScriptingClient client(driver);
+
+        // Responses of ExecuteYql and of both GetOperation calls are parsed into request arenas,
+        // which are freed right after the callbacks, the result is read after that
+        auto result = client.ExecuteYqlScript("SMTH").GetValueSync();
+        UNIT_ASSERT_C(result.IsSuccess(), result.GetIssues().ToString());
+        UNIT_ASSERT_VALUES_EQUAL(operationService.Polls.load(), 2);
+        UNIT_ASSERT_STRING_CONTAINS(result.GetIssues().ToString(), "deferred");
+
+        UNIT_ASSERT_VALUES_EQUAL(result.GetResultSets().size(), 1);
+        auto parser = result.GetResultSetParser(0);
+        UNIT_ASSERT_VALUES_EQUAL(parser.RowsCount(), ROWS_COUNT);
+        for (size_t i = 0; parser.TryNextRow(); ++i) {
+            UNIT_ASSERT_VALUES_EQUAL(parser.ColumnParser("value").GetUtf8(), "row " + std::to_string(i));
+        }
+
+        driver.Stop(true);
+    }
+}
@@ -0,0 +1,331 @@
+#include "otlp_file_tracer.h"
+
+#include <library/cpp/json/writer/json.h>
+#include <library/cpp/threading/chunk_queue/queue.h>
+
+#include <util/random/random.h>
+#include <util/stream/file.h>
+#include <util/string/builder.h>
+#include <util/system/file.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace NOtelTracing {
+
+using namespace NYdb;
+using namespace NYdb::NTracing;
+
+namespace {
+
+ui64 NowUnixNano() {
+    return TInstant::Now().NanoSeconds();
+}
+
+template <size_t Size>
+void GenerateId(std::array<ui8, Size>& id) {
+    for (size_t i = 0; i < Size; i += sizeof(ui64)) {
+        const ui64 value = RandomNumber<ui64>();
+        std::memcpy(id.data() + i, &value, std::min(sizeof(ui64), Size - i));
+    }
+    // All zero id is invalid
+    if (std::all_of(id.begin(), id.end(), [](ui8 b) { return b == 0; })) {
+        id[Size - 1] = 1;
+    }
+}
+
+struct TSpanData {
+    struct TEvent {
+        ui64 TimeUnixNano;
+        std::string Name;
+    };
+
+    TSpanContext Context;
+    std::optional<TSpanContext> Parent;
+    std::string Name;
+    ESpanKind Kind = ESpanKind::Internal;
+    ui64 StartUnixNano = 0;
+    ui64 EndUnixNano = 0;
+    std::vector<std::pair<std::string, std::variant<std::string, i64>>> Attributes;
+    std::vector<TEvent> Events;
+    EStatus Status = EStatus::SUCCESS;
+};
+
+using TSpanDataPtr = std::unique_ptr<TSpanData>;
+
+class TOtlpFileExporter {
+public:
+    explicit TOtlpFileExporter(const TOtlpFileTracerSettings& settings)
+        : Settings_(settings)
+        , Output_(TFile(settings.FilePath_, OpenAlways | WrOnly | ForAppend))
+    {}
+
+    ~TOtlpFileExporter() {
+        Stop();
+    }
+
+    void Start() {
+        Thread_ = std::thread([this] {
+            Run();
+        });
+    }
+
+    void Stop() {
+        {
+            std::lock_guard guard(Lock_);
+            if (Stopped_) {
+                return;
+            }
+            Stopped_ = true;
+        }
+        StopCondVar_.notify_all();
+        if (Thread_.joinable()) {
+            Thread_.join();
+        }
+    }
+
+    void Push(TSpanDataPtr span) {
+        if (Queued_.fetch_add(1, std::memory_order_relaxed) >= Settings_.MaxQueuedSpans_) {
+            Queued_.fetch_sub(1, std::memory_order_relaxed);
+            Dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Queue_.Enqueue(std::move(span));
+    }
+
+private:
+    void Run() {
+        std::unique_lock guard(Lock_);
+        while (!Stopped_) {
+            StopCondVar_.wait_for(guard, std::chrono::microseconds(Settings_.FlushPeriod_.MicroSeconds()), [this] {
+                return Stopped_;
+            });
+            guard.unlock();
+            Flush();
+            guard.lock();
+        }
+    }
+
+    // Called from the exporter thread only, it is the single consumer of the queue
+    void Flush() {
+        std::vector<TSpanDataPtr> spans;
+        TSpanDataPtr span;
+        while (Queue_.Dequeue(span)) {
+            spans.emplace_back(std::move(span));
+        }
+        Queued_.fetch_sub(spans.size(), std::memory_order_relaxed);
+
+        if (spans.empty()) {
+            return;
+        }
+
+        NJsonWriter::TBuf json;
+        json.BeginObject();
+        json.WriteKey("resourceSpans").BeginList();
+        json.BeginObject();
+        json.WriteKey("resource").BeginObject();
+        json.WriteKey("attributes").BeginList();
+        WriteAttribute(json, "service.name", Settings_.ServiceName_);
+        if (const ui64 dropped = Dropped_.exchange(0, std::memory_order_relaxed)) {
+            WriteAttribute(json, "ydb.tracing.dropped_spans", static_cast<i64>(dropped));
+        }
+        json.EndList();
+        json.EndObject();
+        json.WriteKey("scopeSpans").BeginList();
+        json.BeginObject();
+        json.WriteKey("scope").BeginObject().WriteKey("name").WriteString("ydb-cpp-sdk").EndObject();
+        json.WriteKey("spans").BeginList();
+        for (const auto& data : spans) {
+            WriteSpan(json, *data);
+        }
+        json.EndList();
+        json.EndObject();
+        json.EndList();
+        json.EndObject();
+        json.EndList();
+        json.EndObject();
+
+        Output_ << json.Str() << '\n';
+        Output_.Flush();
+    }
+
+    static void WriteAttribute(NJsonWriter::TBuf& json, const std::string& key, const std::variant<std::string, i64>& value) {
+        json.BeginObject();
+        json.WriteKey("key").WriteString(key);
+        json.WriteKey("value").BeginObject();
+        if (std::holds_alternative<std::string>(value)) {
+            json.WriteKey("stringValue").WriteString(std::get<std::string>(value));
+        } else {
+            // int64 values are strings in OTLP/JSON
+            json.WriteKey("intValue").WriteString(ToString(std::get<i64>(value)));
+        }
+        json.EndObject();
+        json.EndObject();
+    }
+
+    static void WriteSpan(NJsonWriter::TBuf& json, const TSpanData& data) {
+        json.BeginObject();
+        json.WriteKey("traceId").WriteString(data.Context.GetTraceIdHex());
+        json.WriteKey("spanId").WriteString(data.Context.GetSpanIdHex());
+        if (data.Parent) {
+            json.WriteKey("parentSpanId").WriteString(data.Parent->GetSpanIdHex());
+        }
+        json.WriteKey("name").WriteString(data.Name);
+        // SPAN_KIND_INTERNAL = 1, SPAN_KIND_CLIENT = 3
+        json.WriteKey("kind").WriteInt(data.Kind == ESpanKind::Client ? 3 : 1);
+        json.WriteKey("startTimeUnixNano").WriteString(ToString(data.StartUnixNano));
+        json.WriteKey("endTimeUnixNano").WriteString(ToString(data.EndUnixNano));
+
+        json.WriteKey("attributes").BeginList();
+        for (const auto& [key, value] : data.Attributes) {
+            WriteAttribute(json, key, value);
+        }
+        json.EndList();
+
+        json.WriteKey("events").BeginList();
+        for (const auto& event : data.Events) {
+            json.BeginObject();
+            json.WriteKey("timeUnixNano").WriteString(ToString(event.TimeUnixNano));
+            json.WriteKey("name").WriteString(event.Name);
+            json.EndObject();
+        }
+        json.EndList();
+
+        // STATUS_CODE_OK = 1, STATUS_CODE_ERROR = 2
+        json.WriteKey("status").BeginObject();
+        json.WriteKey("code").WriteInt(data.Status == EStatus::SUCCESS ? 1 : 2);
+        if (data.Status != EStatus::SUCCESS) {
+            json.WriteKey("message").WriteString(TStringBuilder() << data.Status);
+        }
+        json.EndObject();
+
+        json.EndObject();
+    }
+
+private:
+    const TOtlpFileTracerSettings Settings_;
+    TUnbufferedFileOutput Output_;
+
+    NThreading::TManyOneQueue<TSpanDataPtr> Queue_;
+    std::atomic<size_t> Queued_ = 0;
+    std::atomic<ui64> Dropped_ = 0;
+
+    std::mutex Lock_;
+    std::condition_variable StopCondVar_;
+    bool Stopped_ = false;
+    std::thread Thread_;
+};
+
+class TOtlpSpan : public ISpan {
+public:
+    TOtlpSpan(std::shared_ptr<TOtlpFileExporter> exporter, TSpanDataPtr data)
+        : Exporter_(std::move(exporter))
+        , Data_(std::move(data))
+        , Context_(Data_->Context)
+    {}
+
+    ~TOtlpSpan() override {
+        // Span which is not ended explicitly is still exported, e.g. if client is destroyed
+        // while request is in flight
+        End(EStatus::CLIENT_CANCELLED);
+    }
+
+    const TSpanContext& GetContext() const override {
+        return Context_;
+    }
+
+    void SetAttribute(const std::string& key, const std::string& value) override {
+        std::lock_guard guard(Lock_);
+        if (Data_) {
+            Data_->Attributes.emplace_back(key, value);
+        }
+    }
+
+    void SetAttribute(const std::string& key, i64 value) override {
+        std::lock_guard guard(Lock_);
+        if (Data_) {
+            Data_->Attributes.emplace_back(key, value);
+        }
+    }
+
+    void AddEvent(const std::string& name) override {
+        std::lock_guard guard(Lock_);
+        if (Data_) {
+            Data_->Events.push_back({NowUnixNano(), name});
+        }
+    }
+
+    void End(EStatus status) override {
+        TSpanDataPtr data;
+        {
+            std::lock_guard guard(Lock_);
+            data = std::move(Data_);
+        }
+        if (data) {
+            data->EndUnixNano = NowUnixNano();
+            data->Status = status;
+            Exporter_->Push(std::move(data));
+        }
+    }
+
+private:
+    const std::shared_ptr<TOtlpFileExporter> Exporter_;
+    std::mutex Lock_;
+    TSpanDataPtr Data_;
+    const TSpanContext Context_;
+};
+
+class TOtlpFileTracer : public ITracer {
+public:
+    explicit TOtlpFileTracer(const TOtlpFileTracerSettings& settings)
+        : SampleRatio_(settings.SampleRatio_)
+        , Exporter_(std::make_shared<TOtlpFileExporter>(settings))
+    {
+        Exporter_->Start();
+    }
+
+    ~TOtlpFileTracer() override {
+        Exporter_->Stop();
+    }
+
+    TSpanPtr StartSpan(const std::string& name, ESpanKind kind, const TSpanContext* parent) override {
+        const bool hasParent = parent && parent->IsValid();
+        const bool sampled = hasParent ? parent->Sampled : RandomNumber<double>() < SampleRatio_;
+        if (!sampled) {
+            return nullptr;
+        }
+
+        auto data = std::make_unique<TSpanData>();
+        if (hasParent) {
+            data->Context.TraceId = parent->TraceId;
+            data->Parent = *parent;
+        } else {
+            GenerateId(data->Context.TraceId);
+        }
+        GenerateId(data->Context.SpanId);
+        data->Context.Sampled = true;
+        data->Name = name;
+        data->Kind = kind;
+        data->StartUnixNano = NowUnixNano();
+
+        return std::make_shared<TOtlpSpan>(Exporter_, std::move(data));
+    }
+
+private:
+    const double SampleRatio_;
+    const std::shared_ptr<TOtlpFileExporter> Exporter_;
+};
+
+} // namespace
+
+std::shared_ptr<ITracer> CreateOtlpFileTracer(const TOtlpFileTracerSettings& settings) {
+    return std::make_shared<TOtlpFileTracer>(settings);
+}
+
+} // namespace NOtelTracing
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <client/ydb_types/fluent_settings_helpers.h>
+#include <client/ydb_types/tracing/tracing.h>
+
+#include <util/datetime/base.h>
+
+namespace NOtelTracing {
+
+struct TOtlpFileTracerSettings {
+    using TSelf = TOtlpFileTracerSettings;
+
+    // Spans are appended to this file, one OTLP/JSON ExportTraceServiceRequest per line,
+    // so the file can be imported by the OpenTelemetry collector otlpjsonfile receiver
+    FLUENT_SETTING(std::string, FilePath);
+    FLUENT_SETTING_DEFAULT(std::string, ServiceName, "ydb-cpp-sdk");
+    // Share of root spans to sample, child spans follow the decision of the parent
+    FLUENT_SETTING_DEFAULT(double, SampleRatio, 1.0);
+    FLUENT_SETTING_DEFAULT(TDuration, FlushPeriod, TDuration::Seconds(1));
+    // Finished spans above this limit are dropped until the next flush
+    FLUENT_SETTING_DEFAULT(size_t, MaxQueuedSpans, 64 * 1024);
+};
+
+// Creates tracer for TDriverConfig::SetTracer.
+// Finished spans are put to a lock free queue and written to the file by a background thread,
+// so tracing adds no file IO to request path.
+std::shared_ptr<NYdb::NTracing::ITracer> CreateOtlpFileTracer(const TOtlpFileTracerSettings& settings);
+
+} // namespace NOtelTracing
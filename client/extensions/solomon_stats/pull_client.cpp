@@ -25,12 +25,34 @@ NMonitoring::TLabels TSolomonStatPullExtension::TParams::GetLabels() const {
 
 TSolomonStatPullExtension::TSolomonStatPage::TSolomonStatPage(const std::string& title, const std::string& path, IApi* api)
     : NMonitoring::IMonPage(title, path), Api_(api)
+    , SpackEncoder_(NMonitoring::CachingEncoderSpackV1(NMonitoring::ETimePrecision::SECONDS, NMonitoring::ECompression::IDENTITY))
+    , PrometheusEncoder_(NMonitoring::CachingEncoderPrometheus())
     { }
 
 void TSolomonStatPullExtension::TSolomonStatPage::Output(NMonitoring::IMonHttpRequest& request) {
-    request.Output() << NMonitoring::HTTPOKJSON;
-    auto json = NMonitoring::EncoderJson(&request.Output());
-    Api_->Accept(json.Get());
+    switch (NMonitoring::FormatFromAcceptHeader(request.GetHeader("Accept"))) {
+        case NMonitoring::EFormat::SPACK:
+            Output(request, NMonitoring::HTTPOKSPACK, SpackEncoder_.Get());
+            break;
+        case NMonitoring::EFormat::PROMETHEUS:
+            Output(request, NMonitoring::HTTPOKPROMETHEUS, PrometheusEncoder_.Get());
+            break;
+        default: {
+            request.Output() << NMonitoring::HTTPOKJSON;
+            auto json = NMonitoring::EncoderJson(&request.Output());
+            Api_->Accept(json.Get());
+        }
+    }
+}
+
+void TSolomonStatPullExtension::TSolomonStatPage::Output(NMonitoring::IMonHttpRequest& request,
+    const char* httpHeader, NMonitoring::IReusableMetricEncoder* encoder)
+{
+    std::lock_guard guard(EncodersLock_);
+    request.Output() << httpHeader;
+    encoder->Reset(&request.Output());
+    Api_->Accept(encoder);
+    encoder->Close();
 }
 
 TSolomonStatPullExtension::TSolomonStatPullExtension(const TSolomonStatPullExtension::TParams& params, IApi* api)
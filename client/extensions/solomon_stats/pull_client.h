@@ -5,10 +5,14 @@
 #include <library/cpp/http/server/response.h>
 #include <library/cpp/monlib/metrics/metric_consumer.h>
 #include <library/cpp/monlib/encode/json/json.h>
+#include <library/cpp/monlib/encode/prometheus/prometheus.h>
+#include <library/cpp/monlib/encode/spack/spack_v1.h>
 #include <library/cpp/monlib/metrics/metric_registry.h>
 #include <library/cpp/monlib/service/pages/mon_page.h>
 #include <library/cpp/monlib/service/monservice.h>
 
+#include <mutex>
+
 namespace NSolomonStatExtension {
 
 class TSolomonStatPullExtension: public NYdb::IExtension {
@@ -45,8 +49,15 @@ private:
 
         void Output(NMonitoring::IMonHttpRequest& request) override ;
 
+    private:
+        void Output(NMonitoring::IMonHttpRequest& request, const char* httpHeader, NMonitoring::IReusableMetricEncoder* encoder);
+
     private:
         IApi* Api_;
+        // Spack and Prometheus encoders are kept between scrapes to reuse encoded labels
+        std::mutex EncodersLock_;
+        NMonitoring::IReusableMetricEncoderPtr SpackEncoder_;
+        NMonitoring::IReusableMetricEncoderPtr PrometheusEncoder_;
     };
 
 private:
@@ -12,6 +12,46 @@ namespace NYdb {
 
 using std::string;
 
+namespace {
+
+class TInternedEndpoints {
+public:
+    const std::string* Intern(std::string_view endpoint) {
+        {
+            std::shared_lock lock(Mutex_);
+            auto it = Strings_.find(endpoint);
+            if (it != Strings_.end()) {
+                return it->second;
+            }
+        }
+        std::unique_lock lock(Mutex_);
+        auto it = Strings_.find(endpoint);
+        if (it == Strings_.end()) {
+            auto value = new std::string(endpoint);
+            it = Strings_.emplace(*value, value).first;
+        }
+        return it->second;
+    }
+
+private:
+    std::shared_mutex Mutex_;
+    // Keys refer to the values, which are never freed
+    std::unordered_map<std::string_view, const std::string*> Strings_;
+};
+
+} // namespace
+
+const std::string TInternedEndpoint::Empty_;
+
+const std::string* TInternedEndpoint::Intern(std::string_view endpoint) {
+    if (endpoint.empty()) {
+        return &Empty_;
+    }
+    // Never destroyed, endpoints may be interned by the threads which outlive static objects
+    static TInternedEndpoints* const endpoints = new TInternedEndpoints();
+    return endpoints->Intern(endpoint);
+}
+
 class TEndpointElectorSafe::TObjRegistry : public IObjRegistryHandle {
 public:
     TObjRegistry(const ui64& nodeId)
@@ -160,6 +200,15 @@ TEndpointRecord TEndpointElectorSafe::GetEndpoint(const TEndpointKey& preferredE
     }
 }
 
+std::vector<TEndpointRecord> TEndpointElectorSafe::GetBestEndpoints() const {
+    std::shared_lock guard(Mutex_);
+
+    if (BestK_ == -1) {
+        return {};
+    }
+    return std::vector<TEndpointRecord>(Records_.begin(), Records_.begin() + BestK_ + 1);
+}
+
 // TODO: Suboptimal, but should not be used often
 void TEndpointElectorSafe::PessimizeEndpoint(const string& endpoint) {
     std::unique_lock guard(Mutex_);
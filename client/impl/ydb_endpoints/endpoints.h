@@ -5,12 +5,71 @@
 #include <unordered_map>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <client/impl/ydb_stats/stats.h>
 
 namespace NYdb {
 
+// Endpoint name interned in a process wide pool.
+// Copies share one immutable string, so an endpoint is passed from the records to the keys,
+// results and statuses of requests without allocations. Interned strings are never freed,
+// the pool is bounded by the number of endpoints ever discovered
+class TInternedEndpoint {
+public:
+    TInternedEndpoint()
+        : Value_(&Empty_)
+    {}
+
+    TInternedEndpoint(const std::string& endpoint)
+        : Value_(Intern(endpoint))
+    {}
+
+    TInternedEndpoint(const char* endpoint)
+        : Value_(Intern(endpoint))
+    {}
+
+    explicit TInternedEndpoint(std::string_view endpoint)
+        : Value_(Intern(endpoint))
+    {}
+
+    const std::string& Get() const {
+        return *Value_;
+    }
+
+    operator const std::string&() const {
+        return *Value_;
+    }
+
+    bool empty() const {
+        return Value_->empty();
+    }
+
+    // Interned strings are equal only if they are the same string
+    friend bool operator==(const TInternedEndpoint& lhs, const TInternedEndpoint& rhs) {
+        return lhs.Value_ == rhs.Value_;
+    }
+
+    friend bool operator==(const TInternedEndpoint& lhs, const std::string& rhs) {
+        return *lhs.Value_ == rhs;
+    }
+
+    friend bool operator==(const TInternedEndpoint& lhs, const char* rhs) {
+        return *lhs.Value_ == rhs;
+    }
+
+    friend IOutputStream& operator<<(IOutputStream& out, const TInternedEndpoint& value) {
+        return out << *value.Value_;
+    }
+
+private:
+    static const std::string* Intern(std::string_view endpoint);
+
+    static const std::string Empty_;
+    const std::string* Value_;
+};
+
 struct TEndpointRecord {
-    std::string Endpoint;
+    TInternedEndpoint Endpoint;
     i32 Priority;
     std::string SslTargetNameOverride;
     ui64 NodeId = 0;
@@ -23,8 +82,8 @@ struct TEndpointRecord {
     {
     }
 
-    TEndpointRecord(std::string endpoint, i32 priority, std::string sslTargetNameOverride = std::string(), ui64 nodeId = 0)
-        : Endpoint(std::move(endpoint))
+    TEndpointRecord(TInternedEndpoint endpoint, i32 priority, std::string sslTargetNameOverride = std::string(), ui64 nodeId = 0)
+        : Endpoint(endpoint)
         , Priority(priority)
         , SslTargetNameOverride(std::move(sslTargetNameOverride))
         , NodeId(nodeId)
@@ -41,7 +100,7 @@ struct TEndpointRecord {
 };
 
 struct TEndpointKey {
-    std::string Endpoint;
+    TInternedEndpoint Endpoint;
     ui64 NodeId = 0;
 
     TEndpointKey()
@@ -49,8 +108,8 @@ struct TEndpointKey {
         , NodeId(0)
     {}
 
-    TEndpointKey(std::string endpoint, ui64 nodeId)
-        : Endpoint(std::move(endpoint))
+    TEndpointKey(TInternedEndpoint endpoint, ui64 nodeId)
+        : Endpoint(endpoint)
         , NodeId(nodeId)
     {}
 
@@ -94,6 +153,9 @@ public:
     // Returns preferred (if presents) or best endpoint
     TEndpointRecord GetEndpoint(const TEndpointKey& preferredEndpoint, bool onlyPreferred = false) const;
 
+    // Returns all endpoints with the best priority
+    std::vector<TEndpointRecord> GetBestEndpoints() const;
+
     // Move endpoint to the end
     void PessimizeEndpoint(const std::string& endpoint);
 
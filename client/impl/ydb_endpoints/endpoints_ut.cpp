@@ -109,6 +109,18 @@ Y_UNIT_TEST_SUITE(CheckUtils) {
 
 Y_UNIT_TEST_SUITE(EndpointElector) {
 
+    Y_UNIT_TEST(InternedEndpoint) {
+        std::string name = "localhost:2135";
+        TInternedEndpoint one(name);
+        TInternedEndpoint two("localhost:2135");
+        UNIT_ASSERT_EQUAL(one, two);
+        UNIT_ASSERT_EQUAL(&one.Get(), &two.Get());
+        UNIT_ASSERT_VALUES_EQUAL(one.Get(), name);
+        UNIT_ASSERT(!(one == TInternedEndpoint("localhost:2136")));
+        UNIT_ASSERT(TInternedEndpoint().empty());
+        UNIT_ASSERT_EQUAL(&TInternedEndpoint().Get(), &TInternedEndpoint(std::string()).Get());
+    }
+
     Y_UNIT_TEST(Empty) {
         TEndpointElectorSafe elector;
         UNIT_ASSERT_VALUES_EQUAL(elector.GetEndpoint(TEndpointKey()).Endpoint, "");
@@ -164,6 +176,20 @@ Y_UNIT_TEST_SUITE(EndpointElector) {
         UNIT_ASSERT_VALUES_EQUAL(elector.GetEndpoint(TEndpointKey()).Endpoint, "One");
     }
 
+    Y_UNIT_TEST(BestEndpoints) {
+        TEndpointElectorSafe elector;
+        UNIT_ASSERT(elector.GetBestEndpoints().empty());
+
+        elector.SetNewState(std::vector<TEndpointRecord>{{"Two", 2}, {"One_A", 1}, {"Three", 3}, {"One_B", 1}});
+        std::unordered_set<std::string> endpoints;
+        for (const auto& record : elector.GetBestEndpoints()) {
+            endpoints.insert(record.Endpoint);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(endpoints.size(), 2);
+        UNIT_ASSERT(endpoints.contains("One_A"));
+        UNIT_ASSERT(endpoints.contains("One_B"));
+    }
+
     Y_UNIT_TEST(EndpointAssociationTwoThreadsNoRace) {
         TEndpointElectorSafe elector;
 
@@ -0,0 +1,216 @@
+#define INCLUDE_YDB_INTERNAL_H
+#include "admission.h"
+
+#include <util/generic/ylimits.h>
+
+#include <cmath>
+
+namespace NYdb {
+
+// Min latency is forgotten periodically, so the limiter adapts to a permanent latency change
+constexpr TDuration MIN_LATENCY_WINDOW = TDuration::Seconds(30);
+// Retry budget accounts operations of the last 10 seconds
+constexpr TDuration RETRY_BUDGET_HALF_WINDOW = TDuration::Seconds(5);
+
+static bool IsOverloadStatus(EStatus status) {
+    switch (status) {
+        case EStatus::OVERLOADED:
+        case EStatus::UNAVAILABLE:
+        case EStatus::TIMEOUT:
+        case EStatus::TRANSPORT_UNAVAILABLE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TConcurrencyLimiter::TConcurrencyLimiter(const TAdmissionControlSettings& settings)
+    : Settings_(settings)
+    , Limit_(settings.InitialLimit_)
+    , ExactLimit_(settings.InitialLimit_)
+{}
+
+bool TConcurrencyLimiter::TryAcquire() {
+    ui32 inFlight = InFlight_.load(std::memory_order_relaxed);
+    do {
+        if (inFlight >= Limit_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+    } while (!InFlight_.compare_exchange_weak(inFlight, inFlight + 1, std::memory_order_relaxed));
+    return true;
+}
+
+void TConcurrencyLimiter::Release(std::type_index method, TDuration latency, bool overloaded, TInstant now) {
+    const ui32 inFlight = InFlight_.fetch_sub(1, std::memory_order_relaxed);
+
+    std::lock_guard guard(Lock_);
+    auto& minLatency = MinLatencies_[method];
+    if (now >= minLatency.ResetAt) {
+        minLatency.Value = TDuration::Max();
+        minLatency.ResetAt = now + MIN_LATENCY_WINDOW;
+    }
+    if (!overloaded) {
+        minLatency.Value = Min(minLatency.Value, latency);
+    }
+
+    const bool congested = overloaded
+        || (minLatency.Value != TDuration::Max() && latency > minLatency.Value * Settings_.LatencyTolerance_);
+    if (congested) {
+        // Requests in flight observe the same congestion, decrease once per round trip
+        if (now >= NextDecreaseAt_) {
+            ExactLimit_ = Max<double>(Settings_.MinLimit_, ExactLimit_ * Settings_.BackoffRatio_);
+            NextDecreaseAt_ = now + latency;
+        }
+    } else if (inFlight * 2 >= ExactLimit_) {
+        // Grow only if the limit is actually used, +1 per round trip of the whole limit
+        ExactLimit_ = Min<double>(Settings_.MaxLimit_, ExactLimit_ + 1.0 / ExactLimit_);
+    }
+    Limit_.store(static_cast<ui32>(std::floor(ExactLimit_)), std::memory_order_relaxed);
+}
+
+void TConcurrencyLimiter::Release() {
+    InFlight_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+ui32 TConcurrencyLimiter::GetLimit() const {
+    return Limit_.load(std::memory_order_relaxed);
+}
+
+ui32 TConcurrencyLimiter::GetInFlight() const {
+    return InFlight_.load(std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TRetryBudget::TRetryBudget(double ratio, ui32 minRetriesPerSecond)
+    : Ratio_(ratio)
+    , MinRetriesPerSecond_(minRetriesPerSecond)
+{}
+
+bool TRetryBudget::IsEnabled() const {
+    return Ratio_ > 0;
+}
+
+TRetryBudget::TBucket& TRetryBudget::Rotate(TInstant now) {
+    if (now >= Buckets_[0].Start + RETRY_BUDGET_HALF_WINDOW) {
+        Buckets_[1] = now >= Buckets_[0].Start + 2 * RETRY_BUDGET_HALF_WINDOW ? TBucket() : Buckets_[0];
+        Buckets_[0] = TBucket{now, 0, 0};
+    }
+    return Buckets_[0];
+}
+
+void TRetryBudget::OnOperation(TInstant now) {
+    if (!IsEnabled()) {
+        return;
+    }
+    std::lock_guard guard(Lock_);
+    Rotate(now).Operations++;
+}
+
+bool TRetryBudget::TryAcquireRetry(TInstant now) {
+    if (!IsEnabled()) {
+        return true;
+    }
+    std::lock_guard guard(Lock_);
+    auto& current = Rotate(now);
+    const ui64 operations = Buckets_[0].Operations + Buckets_[1].Operations;
+    const ui64 retries = Buckets_[0].Retries + Buckets_[1].Retries;
+    const double allowed = Ratio_ * operations + MinRetriesPerSecond_ * 2 * RETRY_BUDGET_HALF_WINDOW.SecondsFloat();
+    if (retries >= allowed) {
+        return false;
+    }
+    current.Retries++;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TAdmissionPermit::TAdmissionPermit(std::shared_ptr<TAdmissionController> controller, std::type_index method)
+    : Controller_(std::move(controller))
+    , Method_(method)
+{}
+
+TAdmissionPermit::~TAdmissionPermit() {
+    // Request was dropped without response, e.g. client was stopped
+    if (!Released_.exchange(true)) {
+        Controller_->DatabaseLimiter_.Release();
+        if (EndpointLimiter_) {
+            EndpointLimiter_->Release();
+        }
+    }
+}
+
+bool TAdmissionPermit::TryAcquireEndpoint(const std::string& endpoint) {
+    auto& limiter = Controller_->GetEndpointLimiter(endpoint);
+    if (!limiter.TryAcquire()) {
+        return false;
+    }
+    EndpointLimiter_ = &limiter;
+    return true;
+}
+
+void TAdmissionPermit::OnSent(TInstant now) {
+    SentTime_ = now;
+}
+
+void TAdmissionPermit::Release(EStatus status, TInstant now) {
+    if (Released_.exchange(true)) {
+        return;
+    }
+    // Request which was not sent (or was cancelled) says nothing about the server
+    if (!EndpointLimiter_ || !SentTime_ || status == EStatus::CLIENT_CANCELLED) {
+        Controller_->DatabaseLimiter_.Release();
+        if (EndpointLimiter_) {
+            EndpointLimiter_->Release();
+        }
+        return;
+    }
+    const TDuration latency = now - SentTime_;
+    const bool overloaded = IsOverloadStatus(status);
+    Controller_->DatabaseLimiter_.Release(Method_, latency, overloaded, now);
+    EndpointLimiter_->Release(Method_, latency, overloaded, now);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TAdmissionController::TAdmissionController(const TAdmissionControlSettings& settings)
+    : Settings_(settings)
+    , DatabaseLimiter_(settings)
+    , RetryBudget_(settings.RetryBudgetRatio_, settings.MinRetriesPerSecond_)
+{}
+
+bool TAdmissionController::IsConcurrencyLimitEnabled() const {
+    return Settings_.ConcurrencyLimitEnabled_;
+}
+
+TAdmissionPermitPtr TAdmissionController::TryAdmit(std::type_index method) {
+    if (!DatabaseLimiter_.TryAcquire()) {
+        return nullptr;
+    }
+    return std::make_shared<TAdmissionPermit>(shared_from_this(), method);
+}
+
+TRetryBudget& TAdmissionController::GetRetryBudget() {
+    return RetryBudget_;
+}
+
+TConcurrencyLimiter& TAdmissionController::GetEndpointLimiter(const std::string& endpoint) {
+    {
+        std::shared_lock guard(EndpointLimitersLock_);
+        auto it = EndpointLimiters_.find(endpoint);
+        if (it != EndpointLimiters_.end()) {
+            return *it->second;
+        }
+    }
+
+    std::unique_lock guard(EndpointLimitersLock_);
+    auto& limiter = EndpointLimiters_[endpoint];
+    if (!limiter) {
+        limiter = std::make_unique<TConcurrencyLimiter>(Settings_);
+    }
+    return *limiter;
+}
+
+} // namespace NYdb
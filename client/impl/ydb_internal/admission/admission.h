@@ -0,0 +1,126 @@
+#pragma once
+
+#include <client/impl/ydb_internal/internal_header.h>
+
+#include <client/ydb_types/admission_settings.h>
+#include <client/ydb_types/status_codes.h>
+
+#include <util/datetime/base.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <typeindex>
+#include <unordered_map>
+
+namespace NYdb {
+
+// AIMD limit of requests in flight driven by latency and overload signals
+class TConcurrencyLimiter {
+public:
+    explicit TConcurrencyLimiter(const TAdmissionControlSettings& settings);
+
+    bool TryAcquire();
+    // Releases slot taken by TryAcquire and adjusts the limit,
+    // latency is compared with the minimal one of the same RPC method
+    void Release(std::type_index method, TDuration latency, bool overloaded, TInstant now = TInstant::Now());
+    // Releases slot without adjusting the limit, e.g. if request was not sent
+    void Release();
+
+    ui32 GetLimit() const;
+    ui32 GetInFlight() const;
+
+private:
+    const TAdmissionControlSettings Settings_;
+    std::atomic<ui32> InFlight_ = 0;
+    std::atomic<ui32> Limit_;
+
+    struct TMinLatency {
+        TDuration Value = TDuration::Max();
+        TInstant ResetAt;
+    };
+
+    std::mutex Lock_;
+    double ExactLimit_;
+    // Methods differ in latency a lot, e.g. KeepAlive and ExecuteDataQuery
+    std::unordered_map<std::type_index, TMinLatency> MinLatencies_;
+    TInstant NextDecreaseAt_;
+};
+
+// Share of retries over a sliding window of operations
+class TRetryBudget {
+public:
+    TRetryBudget(double ratio, ui32 minRetriesPerSecond);
+
+    bool IsEnabled() const;
+    void OnOperation(TInstant now = TInstant::Now());
+    // Returns false if the retry would exceed the budget
+    bool TryAcquireRetry(TInstant now = TInstant::Now());
+
+private:
+    struct TBucket {
+        TInstant Start;
+        ui64 Operations = 0;
+        ui64 Retries = 0;
+    };
+
+    TBucket& Rotate(TInstant now);
+
+    const double Ratio_;
+    const ui32 MinRetriesPerSecond_;
+
+    std::mutex Lock_;
+    // Current and previous halves of the window
+    std::array<TBucket, 2> Buckets_;
+};
+
+class TAdmissionController;
+
+// Slot of a unary request in database and endpoint limiters, released exactly once
+class TAdmissionPermit {
+public:
+    TAdmissionPermit(std::shared_ptr<TAdmissionController> controller, std::type_index method);
+    ~TAdmissionPermit();
+
+    bool TryAcquireEndpoint(const std::string& endpoint);
+    // Latency is measured from the send, so waiting for endpoint and credentials is not counted
+    void OnSent(TInstant now = TInstant::Now());
+    void Release(EStatus status, TInstant now = TInstant::Now());
+
+private:
+    const std::shared_ptr<TAdmissionController> Controller_;
+    const std::type_index Method_;
+    TInstant SentTime_;
+    TConcurrencyLimiter* EndpointLimiter_ = nullptr;
+    std::atomic<bool> Released_ = false;
+};
+
+using TAdmissionPermitPtr = std::shared_ptr<TAdmissionPermit>;
+
+class TAdmissionController : public std::enable_shared_from_this<TAdmissionController> {
+    friend class TAdmissionPermit;
+
+public:
+    explicit TAdmissionController(const TAdmissionControlSettings& settings);
+
+    bool IsConcurrencyLimitEnabled() const;
+    // Returns nullptr if the limit of the database is reached,
+    // method identifies the RPC (e.g. by request type) for latency tracking
+    TAdmissionPermitPtr TryAdmit(std::type_index method);
+
+    TRetryBudget& GetRetryBudget();
+
+private:
+    TConcurrencyLimiter& GetEndpointLimiter(const std::string& endpoint);
+
+    const TAdmissionControlSettings Settings_;
+    TConcurrencyLimiter DatabaseLimiter_;
+    // Limiters are not removed, number of endpoints of a database is small
+    std::shared_mutex EndpointLimitersLock_;
+    std::unordered_map<std::string, std::unique_ptr<TConcurrencyLimiter>> EndpointLimiters_;
+    TRetryBudget RetryBudget_;
+};
+
+} // namespace NYdb
@@ -0,0 +1,268 @@
+#define INCLUDE_YDB_INTERNAL_H
+#include <client/impl/ydb_internal/admission/admission.h>
+#undef INCLUDE_YDB_INTERNAL_H
+
+#include <library/cpp/testing/unittest/registar.h>
+
+using namespace NYdb;
+
+namespace {
+
+struct TMethodA {};
+struct TMethodB {};
+
+const TInstant START = TInstant::Seconds(1000);
+
+TAdmissionControlSettings LimiterSettings() {
+    return TAdmissionControlSettings()
+        .ConcurrencyLimitEnabled(true)
+        .InitialLimit(10)
+        .MinLimit(2)
+        .MaxLimit(100)
+        .BackoffRatio(0.5)
+        .LatencyTolerance(2.0);
+}
+
+// Takes all slots of the limiter and releases them with the given latency
+void RunRound(TConcurrencyLimiter& limiter, TDuration latency, TInstant now) {
+    ui32 acquired = 0;
+    while (limiter.TryAcquire()) {
+        ++acquired;
+    }
+    for (ui32 i = 0; i < acquired; ++i) {
+        limiter.Release(typeid(TMethodA), latency, false, now);
+    }
+}
+
+} // namespace
+
+Y_UNIT_TEST_SUITE(ConcurrencyLimiterTest) {
+    Y_UNIT_TEST(AcquireUpToLimit) {
+        TConcurrencyLimiter limiter(LimiterSettings());
+        for (ui32 i = 0; i < 10; ++i) {
+            UNIT_ASSERT(limiter.TryAcquire());
+        }
+        UNIT_ASSERT(!limiter.TryAcquire());
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetInFlight(), 10);
+
+        // Release without a response doesn't change the limit
+        limiter.Release();
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetInFlight(), 9);
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 10);
+        UNIT_ASSERT(limiter.TryAcquire());
+    }
+
+    Y_UNIT_TEST(AdditiveIncrease) {
+        TConcurrencyLimiter limiter(LimiterSettings());
+
+        // Releases with at least half of the limit in flight add 1/limit each, about 1/2 per round
+        RunRound(limiter, TDuration::MilliSeconds(10), START);
+        RunRound(limiter, TDuration::MilliSeconds(10), START);
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 10);
+        RunRound(limiter, TDuration::MilliSeconds(10), START);
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 11);
+
+        for (ui32 i = 0; i < 1000; ++i) {
+            RunRound(limiter, TDuration::MilliSeconds(10), START);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 100);
+    }
+
+    Y_UNIT_TEST(NoIncreaseIfLimitIsNotUsed) {
+        TConcurrencyLimiter limiter(LimiterSettings());
+        for (ui32 i = 0; i < 1000; ++i) {
+            UNIT_ASSERT(limiter.TryAcquire());
+            limiter.Release(typeid(TMethodA), TDuration::MilliSeconds(10), false, START);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 10);
+    }
+
+    Y_UNIT_TEST(MultiplicativeDecreaseOncePerRoundTrip) {
+        TConcurrencyLimiter limiter(LimiterSettings());
+        const TDuration latency = TDuration::MilliSeconds(100);
+
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), latency, true, START);
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 5);
+
+        // Other requests of the same round trip observe the same overload
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), latency, true, START + latency / 2);
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 5);
+
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), latency, true, START + latency);
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 2);
+
+        // Not lower than MinLimit
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), latency, true, START + 2 * latency);
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 2);
+    }
+
+    Y_UNIT_TEST(DecreaseOnLatency) {
+        TConcurrencyLimiter limiter(LimiterSettings());
+
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), TDuration::MilliSeconds(10), false, START);
+
+        // Within the tolerance of the min latency
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), TDuration::MilliSeconds(20), false, START);
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 10);
+
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), TDuration::MilliSeconds(21), false, START);
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 5);
+    }
+
+    Y_UNIT_TEST(MinLatencyPerMethod) {
+        TConcurrencyLimiter limiter(LimiterSettings());
+
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), TDuration::MilliSeconds(1), false, START);
+
+        // Slower method is not compared with the faster one
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodB), TDuration::MilliSeconds(100), false, START);
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodB), TDuration::MilliSeconds(150), false, START);
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 10);
+
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), TDuration::MilliSeconds(3), false, START);
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 5);
+    }
+
+    Y_UNIT_TEST(MinLatencyWindow) {
+        TConcurrencyLimiter limiter(LimiterSettings());
+
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), TDuration::MilliSeconds(10), false, START);
+
+        // Latency grew permanently, it is compared with the old min latency until the window is over
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), TDuration::MilliSeconds(50), false, START + TDuration::Seconds(29));
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 5);
+
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), TDuration::MilliSeconds(50), false, START + TDuration::Seconds(30));
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), TDuration::MilliSeconds(100), false, START + TDuration::Seconds(31));
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 5);
+
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), TDuration::MilliSeconds(101), false, START + TDuration::Seconds(32));
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 2);
+    }
+
+    Y_UNIT_TEST(OverloadedLatencyIsNotMin) {
+        TConcurrencyLimiter limiter(LimiterSettings());
+
+        // Fast failures of an overloaded server are not a min latency
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), TDuration::MilliSeconds(1), true, START);
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 5);
+
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), TDuration::MilliSeconds(10), false, START + TDuration::Seconds(1));
+        UNIT_ASSERT(limiter.TryAcquire());
+        limiter.Release(typeid(TMethodA), TDuration::MilliSeconds(20), false, START + TDuration::Seconds(1));
+        UNIT_ASSERT_VALUES_EQUAL(limiter.GetLimit(), 5);
+    }
+}
+
+Y_UNIT_TEST_SUITE(RetryBudgetTest) {
+    Y_UNIT_TEST(Disabled) {
+        TRetryBudget budget(0, 0);
+        UNIT_ASSERT(!budget.IsEnabled());
+        for (ui32 i = 0; i < 100; ++i) {
+            UNIT_ASSERT(budget.TryAcquireRetry(START));
+        }
+    }
+
+    Y_UNIT_TEST(ShareOfOperations) {
+        // 10% of operations plus 1 per second of the 10 seconds window
+        TRetryBudget budget(0.1, 1);
+        for (ui32 i = 0; i < 100; ++i) {
+            budget.OnOperation(START);
+        }
+        for (ui32 i = 0; i < 20; ++i) {
+            UNIT_ASSERT_C(budget.TryAcquireRetry(START), i);
+        }
+        UNIT_ASSERT(!budget.TryAcquireRetry(START));
+
+        for (ui32 i = 0; i < 10; ++i) {
+            budget.OnOperation(START + TDuration::Seconds(1));
+        }
+        UNIT_ASSERT(budget.TryAcquireRetry(START + TDuration::Seconds(1)));
+        UNIT_ASSERT(!budget.TryAcquireRetry(START + TDuration::Seconds(1)));
+    }
+
+    Y_UNIT_TEST(SlidingWindow) {
+        TRetryBudget budget(0.1, 1);
+        for (ui32 i = 0; i < 10; ++i) {
+            UNIT_ASSERT(budget.TryAcquireRetry(START));
+        }
+        UNIT_ASSERT(!budget.TryAcquireRetry(START));
+
+        // Previous half of the window is still accounted
+        UNIT_ASSERT(!budget.TryAcquireRetry(START + TDuration::Seconds(5)));
+        UNIT_ASSERT(!budget.TryAcquireRetry(START + TDuration::Seconds(9)));
+
+        // Both halves are over
+        for (ui32 i = 0; i < 10; ++i) {
+            UNIT_ASSERT(budget.TryAcquireRetry(START + TDuration::Seconds(20)));
+        }
+        UNIT_ASSERT(!budget.TryAcquireRetry(START + TDuration::Seconds(20)));
+    }
+}
+
+Y_UNIT_TEST_SUITE(AdmissionPermitTest) {
+    Y_UNIT_TEST(LatencyFromSend) {
+        auto controller = std::make_shared<TAdmissionController>(LimiterSettings());
+
+        auto permit = controller->TryAdmit(typeid(TMethodA));
+        UNIT_ASSERT(permit);
+        UNIT_ASSERT(permit->TryAcquireEndpoint("host:2135"));
+        permit->OnSent(START);
+        permit->Release(EStatus::SUCCESS, START + TDuration::MilliSeconds(10));
+
+        // Time of waiting for endpoint and credentials is not a server latency
+        permit = controller->TryAdmit(typeid(TMethodA));
+        UNIT_ASSERT(permit->TryAcquireEndpoint("host:2135"));
+        permit->OnSent(START + TDuration::Seconds(1));
+        permit->Release(EStatus::SUCCESS, START + TDuration::Seconds(1) + TDuration::MilliSeconds(15));
+
+        permit = controller->TryAdmit(typeid(TMethodA));
+        UNIT_ASSERT(permit->TryAcquireEndpoint("host:2135"));
+        permit->OnSent(START + TDuration::Seconds(2));
+        permit->Release(EStatus::SUCCESS, START + TDuration::Seconds(2) + TDuration::MilliSeconds(30));
+        permit.reset();
+
+        // Only the last latency is above the tolerance
+        std::vector<TAdmissionPermitPtr> permits;
+        while (auto next = controller->TryAdmit(typeid(TMethodA))) {
+            permits.push_back(std::move(next));
+        }
+        UNIT_ASSERT_VALUES_EQUAL(permits.size(), 5);
+    }
+
+    Y_UNIT_TEST(NotSent) {
+        auto controller = std::make_shared<TAdmissionController>(LimiterSettings());
+
+        // E.g. credentials failed after the endpoint was taken
+        auto permit = controller->TryAdmit(typeid(TMethodA));
+        UNIT_ASSERT(permit->TryAcquireEndpoint("host:2135"));
+        permit->Release(EStatus::UNAVAILABLE, START);
+        // Released exactly once
+        permit->Release(EStatus::UNAVAILABLE, START);
+        permit.reset();
+
+        std::vector<TAdmissionPermitPtr> permits;
+        while (auto next = controller->TryAdmit(typeid(TMethodA))) {
+            permits.push_back(std::move(next));
+        }
+        UNIT_ASSERT_VALUES_EQUAL(permits.size(), 10);
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <util/datetime/base.h>
+#include <util/generic/noncopyable.h>
+
+#include <memory>
+#include <string>
+
+namespace NYdb {
+
+// Zero timeout means no timeout, expired deadline gives minimal nonzero timeout
+// to make the request fail with deadline exceeded
+inline TDuration ClampTimeout(TDuration timeout, TInstant deadline) {
+    if (deadline == TInstant::Max()) {
+        return timeout;
+    }
+    const TDuration left = Max(deadline - TInstant::Now(), TDuration::MicroSeconds(1));
+    return timeout ? Min(timeout, left) : left;
+}
+
+// Attempt of a retry operation the requests belong to
+struct TRetryAttempt {
+    TInstant Deadline = TInstant::Max();
+    // Traceparent of the retry span, which is the parent of the spans of the requests
+    std::string TraceParent;
+
+    // Settings of a request made by the attempt: timeouts are cut to the time left
+    // (client timeout also gives the operation timeout unless it is set explicitly)
+    template <typename TRequestSettings>
+    TRequestSettings Apply(const TRequestSettings& settings) const {
+        TRequestSettings result = settings;
+        if (result.TraceParent_.empty()) {
+            result.TraceParent_ = TraceParent;
+        }
+        result.ClientTimeout_ = ClampTimeout(result.ClientTimeout_, Deadline);
+        if constexpr (requires { result.OperationTimeout_; }) {
+            if (result.OperationTimeout_) {
+                result.OperationTimeout_ = ClampTimeout(result.OperationTimeout_, Deadline);
+            }
+        }
+        return result;
+    }
+};
+
+using TRetryAttemptPtr = std::shared_ptr<const TRetryAttempt>;
+
+// Retry attempt which is being started in the current thread.
+// Only requests started while the guard is alive belong to the attempt, requests started later
+// from continuations of the operation are bound to the attempt through the session of the operation
+// (see TKqpSessionCommon::SetRetryAttempt). Operations without session lose the attempt there:
+// their requests get neither the deadline nor the trace parent, such operations take the remaining
+// timeout as an argument to pass it explicitly.
+class TRetryAttemptGuard : TNonCopyable {
+public:
+    explicit TRetryAttemptGuard(const TRetryAttemptPtr& attempt)
+        : PrevDeadline_(CurrentDeadline_)
+        , PrevTraceParent_(CurrentTraceParent_)
+    {
+        if (attempt) {
+            CurrentDeadline_ = Min(attempt->Deadline, PrevDeadline_);
+            CurrentTraceParent_ = &attempt->TraceParent;
+        }
+    }
+
+    ~TRetryAttemptGuard() {
+        CurrentDeadline_ = PrevDeadline_;
+        CurrentTraceParent_ = PrevTraceParent_;
+    }
+
+    static TDuration Clamp(TDuration timeout) {
+        return ClampTimeout(timeout, CurrentDeadline_);
+    }
+
+    // Parent of the spans of the requests, empty out of the attempt
+    static const std::string& GetTraceParent() {
+        static const std::string empty;
+        return CurrentTraceParent_ ? *CurrentTraceParent_ : empty;
+    }
+
+private:
+    const TInstant PrevDeadline_;
+    const std::string* const PrevTraceParent_;
+    static inline thread_local TInstant CurrentDeadline_ = TInstant::Max();
+    static inline thread_local const std::string* CurrentTraceParent_ = nullptr;
+};
+
+} // namespace NYdb
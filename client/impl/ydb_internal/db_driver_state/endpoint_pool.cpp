@@ -130,6 +130,10 @@ TEndpointRecord TEndpointPool::GetEndpoint(const TEndpointKey& preferredEndpoint
     return Elector_.GetEndpoint(preferredEndpoint, onlyPreferred);
 }
 
+std::vector<TEndpointRecord> TEndpointPool::GetBestEndpoints() const {
+    return Elector_.GetBestEndpoints();
+}
+
 TDuration TEndpointPool::TimeSinceLastUpdate() const {
     auto now = TInstant::Now().MicroSeconds();
     return TDuration::MicroSeconds(now - LastUpdateTime_.load());
@@ -35,7 +35,9 @@ TDbDriverState::TDbDriverState(
         return client->GetEndpoints(self);
     }, client)
     , StatCollector(database, client->GetMetricRegistry())
+    , Admission(std::make_shared<TAdmissionController>(client->GetAdmissionControlSettings()))
     , Log(Client->GetLog())
+    , StructuredLog(Client->GetLog(), Client->GetAsyncLog(), GetDatabaseLogPrefix(Database))
     , DiscoveryCompletedPromise(NThreading::NewPromise<void>())
 {
     EndpointPool.SetStatCollector(StatCollector);
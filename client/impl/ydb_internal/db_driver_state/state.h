@@ -4,7 +4,9 @@
 
 #include <client/impl/ydb_internal/internal_header.h>
 
+#include <client/impl/ydb_internal/admission/admission.h>
 #include <client/impl/ydb_internal/internal_client/client.h>
+#include <client/impl/ydb_internal/logger/async_log.h>
 #include <client/impl/ydb_internal/common/ssl_credentials.h>
 #include <client/ydb_types/core_facility/core_facility.h>
 
@@ -66,7 +68,10 @@ public:
     std::shared_mutex LastDiscoveryStatusRWLock;
     TPlainStatus LastDiscoveryStatus;
     NSdkStats::TStatCollector StatCollector;
+    const std::shared_ptr<TAdmissionController> Admission;
     TLog Log;
+    // Hot paths write typed records here, see LOG_STRUCTURED
+    TStructuredLog StructuredLog;
     NThreading::TPromise<void> DiscoveryCompletedPromise;
 };
 
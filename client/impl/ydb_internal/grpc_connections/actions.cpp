@@ -26,7 +26,7 @@ TDeferredAction::TDeferredAction(const std::string& operationId,
         std::shared_ptr<IQueueClientContext> context,
         TDuration delay,
         TDbDriverStatePtr dbState,
-        const std::string& endpoint)
+        const TInternedEndpoint& endpoint)
     : TAlarmActionBase(std::move(userCb), connection, std::move(context))
     , NextDelay_(Min(delay * 2, MAX_DEFERRED_CALL_DELAY))
     , DbDriverState_(dbState)
@@ -72,42 +72,4 @@ void TDeferredAction::OnError() {
     Connection_->EnqueueResponse(resp);
 }
 
-TPeriodicAction::TPeriodicAction(
-    TPeriodicCb&& userCb,
-    TGRpcConnectionsImpl* connection,
-    std::shared_ptr<NYdbGrpc::IQueueClientContext> context,
-    TDuration period)
-    : TAlarmActionBase(std::move(userCb), connection, std::move(context))
-    , Period_(period)
-{
-    Deadline_ = gpr_time_add(
-        gpr_now(GPR_CLOCK_MONOTONIC),
-        gpr_time_from_micros(Period_.MicroSeconds(), GPR_TIMESPAN));
-}
-
-void TPeriodicAction::OnAlarm() {
-    NYql::TIssues issues;
-    if (!UserResponseCb_(std::move(issues), EStatus::SUCCESS)) {
-        return;
-    }
-
-    auto ctx = Connection_->CreateContext();
-    if (!ctx)
-        return;
-    Context_ = ctx;
-
-    auto action = MakeIntrusive<TPeriodicAction>(
-        std::move(UserResponseCb_),
-        Connection_,
-        Context_,
-        Period_);
-    action->Start();
-}
-
-void TPeriodicAction::OnError() {
-    NYql::TIssues issues;
-    issues.AddIssue(NYql::TIssue("Deferred timer interrupted"));
-    UserResponseCb_(std::move(issues), EStatus::CLIENT_INTERNAL_ERROR);
-}
-
 } // namespace NYdb
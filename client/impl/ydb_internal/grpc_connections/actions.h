@@ -118,7 +118,7 @@ public:
             TResponseCb<TResponse>&& userCb,
             TGRpcConnectionsImpl* connections,
             std::shared_ptr<IQueueClientContext> context,
-            const std::string& endpoint)
+            const TInternedEndpoint& endpoint)
         : TGenericCbHolder<TResponseCb<TResponse>>(std::move(userCb), connections, std::move(context))
         , GRpcStatus_(std::move(status))
         , Endpoint_(endpoint)
@@ -139,22 +139,34 @@ public:
 
 private:
     NYdbGrpc::TGrpcStatus GRpcStatus_;
-    std::string Endpoint_;
+    TInternedEndpoint Endpoint_;
 };
 
 template<typename TResponse>
+TResponse* GetResponseMessage(TResponse& response) {
+    return &response;
+}
+
+template<typename TResponse>
+TResponse* GetResponseMessage(NYdbGrpc::TArenaMessage<TResponse>& response) {
+    return response.Get();
+}
+
+// TStorage is either the response itself or the response in the arena of the request,
+// in the latter case the whole response is freed at once with the result
+template<typename TResponse, typename TStorage = TResponse>
 class TResult
     : public TGenericCbHolder<TResponseCb<TResponse>>
     , public IObjectInQueue
 {
 public:
     TResult(
-            TResponse&& response,
+            TStorage&& response,
             NYdbGrpc::TGrpcStatus&& status,
             TResponseCb<TResponse>&& userCb,
             TGRpcConnectionsImpl* connections,
             std::shared_ptr<IQueueClientContext> context,
-            const std::string& endpoint,
+            const TInternedEndpoint& endpoint,
             std::multimap<std::string, std::string>&& metadata)
         : TGenericCbHolder<TResponseCb<TResponse>>(std::move(userCb), connections, std::move(context))
         , Response_(std::move(response))
@@ -163,14 +175,14 @@ public:
         , Metadata_(std::move(metadata)) {}
 
     void Process(void*) override {
-        this->UserResponseCb_(&Response_, TPlainStatus{GRpcStatus_, Endpoint_, std::move(Metadata_)});
+        this->UserResponseCb_(GetResponseMessage(Response_), TPlainStatus{GRpcStatus_, Endpoint_, std::move(Metadata_)});
         delete this;
     }
 
 private:
-    TResponse Response_;
+    TStorage Response_;
     NYdbGrpc::TGrpcStatus GRpcStatus_;
-    const std::string Endpoint_;
+    const TInternedEndpoint Endpoint_;
     std::multimap<std::string, std::string> Metadata_;
 };
 
@@ -201,7 +213,7 @@ public:
         std::shared_ptr<IQueueClientContext> context,
         TDuration timeout,
         TDbDriverStatePtr dbState,
-        const std::string& endpoint);
+        const TInternedEndpoint& endpoint);
 
     void OnAlarm() override;
     void OnError() override;
@@ -210,23 +222,7 @@ private:
     TDuration NextDelay_;
     TDbDriverStatePtr DbDriverState_;
     const std::string OperationId_;
-    const std::string Endpoint_;
-};
-
-class TPeriodicAction
-    : public TAlarmActionBase<TPeriodicCb>
-{
-public:
-    TPeriodicAction(
-        TPeriodicCb&& userCb,
-        TGRpcConnectionsImpl* connection,
-        std::shared_ptr<IQueueClientContext> context,
-        TDuration period);
-
-    void OnAlarm() override;
-    void OnError() override;
-private:
-    TDuration Period_;
+    const TInternedEndpoint Endpoint_;
 };
 
 } // namespace NYdb
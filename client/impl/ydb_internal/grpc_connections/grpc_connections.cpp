@@ -30,113 +30,17 @@ std::string CreateSDKBuildInfo() {
     return std::string("ydb-cpp-sdk/") + GetSdkSemver();
 }
 
-template<class TDerived>
-class TScheduledObject : public TThrRefBase {
-    using TSelf = TScheduledObject<TDerived>;
-    using TPtr = TIntrusivePtr<TSelf>;
-
-    Y_FORCE_INLINE TDerived* Derived() {
-        return static_cast<TDerived*>(this);
-    }
-
-protected:
-    TScheduledObject() { }
-
-    void Start(TDuration timeout, IQueueClientContextProvider* provider) {
-        auto context = provider->CreateContext();
-        if (!context) {
-            Derived()->OnComplete(false);
-            return;
-        }
-
-        auto deadline = gpr_time_add(
-            gpr_now(GPR_CLOCK_MONOTONIC),
-            gpr_time_from_micros(timeout.MicroSeconds(), GPR_TIMESPAN));
-
-        {
-            std::lock_guard guard(Mutex);
-            Context = context;
-            Alarm.Set(context->CompletionQueue(), deadline, OnAlarmTag.Prepare());
-        }
-
-        context->SubscribeCancel([self = TPtr(this)] {
-            self->Alarm.Cancel();
-        });
-    }
-
-private:
-    void OnAlarm(bool ok) {
-        {
-            std::lock_guard guard(Mutex);
-            // Break circular dependencies
-            Context.reset();
-        }
-
-        Derived()->OnComplete(ok);
-    }
-
-private:
-    std::mutex Mutex;
-    IQueueClientContextPtr Context;
-    grpc::Alarm Alarm;
-
-private:
-    using TFixedEvent = NYdbGrpc::TQueueClientFixedEvent<TSelf>;
-
-    TFixedEvent OnAlarmTag = { this, &TSelf::OnAlarm };
-};
-
-class TScheduledCallback : public TScheduledObject<TScheduledCallback> {
-    using TBase = TScheduledObject<TScheduledCallback>;
-
-public:
-    using TCallback = std::function<void(bool)>;
-
-    TScheduledCallback(TCallback&& callback)
-        : Callback(std::move(callback))
-    { }
-
-    void Start(TDuration timeout, IQueueClientContextProvider* provider) {
-        TBase::Start(timeout, provider);
-    }
-
-    void OnComplete(bool ok) {
-        Callback(ok);
-        Callback = { };
-    }
-
-private:
-    TCallback Callback;
-};
-
-class TScheduledFuture : public TScheduledObject<TScheduledFuture> {
-    using TBase = TScheduledObject<TScheduledFuture>;
-
-public:
-    TScheduledFuture()
-        : Promise(NThreading::NewPromise<bool>())
-    { }
-
-    NThreading::TFuture<bool> Start(TDuration timeout, IQueueClientContextProvider* provider) {
-        auto future = Promise.GetFuture();
-
-        TBase::Start(timeout, provider);
-
-        return future;
+static std::shared_ptr<TAsyncLog> CreateAsyncLog(const TAsyncLogSettings& settings, const TLog& log) {
+    // Text records go to the log backend, there is nothing to write without it
+    if (!settings.Enabled_ || (settings.BinaryLogPath_.empty() && log.IsNullLog())) {
+        return nullptr;
     }
-
-    void OnComplete(bool ok) {
-        Promise.SetValue(ok);
-        Promise = { };
-    }
-
-private:
-    NThreading::TPromise<bool> Promise;
-};
+    return std::make_shared<TAsyncLog>(settings, log);
+}
 
 TGRpcConnectionsImpl::TGRpcConnectionsImpl(std::shared_ptr<IConnectionsParams> params)
     : MetricRegistryPtr_(nullptr)
-    , ResponseQueue_(CreateThreadPool(params->GetClientThreadsNum()))
+    , ResponseQueue_(CreateThreadPool(params->GetClientThreadsNum(), params->GetClientThreadPoolSettings()))
     , DefaultDiscoveryEndpoint_(params->GetEndpoint())
     , SslCredentials_(params->GetSslCredentials())
     , DefaultDatabase_(params->GetDatabase())
@@ -146,6 +50,7 @@ TGRpcConnectionsImpl::TGRpcConnectionsImpl(std::shared_ptr<IConnectionsParams> p
     , MaxQueuedRequests_(params->GetMaxQueuedRequests())
     , DrainOnDtors_(params->GetDrinOnDtors())
     , BalancingSettings_(params->GetBalancingSettings())
+    , AdmissionControlSettings_(params->GetAdmissionControlSettings())
     , GRpcKeepAliveTimeout_(params->GetGRpcKeepAliveTimeout())
     , GRpcKeepAlivePermitWithoutCalls_(params->GetGRpcKeepAlivePermitWithoutCalls())
     , MemoryQuota_(params->GetMemoryQuota())
@@ -154,11 +59,14 @@ TGRpcConnectionsImpl::TGRpcConnectionsImpl(std::shared_ptr<IConnectionsParams> p
     , MaxMessageSize_(params->GetMaxMessageSize())
     , QueuedRequests_(0)
 #ifndef YDB_GRPC_BYPASS_CHANNEL_POOL
-    , ChannelPool_(params->GetTcpKeepAliveSettings(), params->GetSocketIdleTimeout())
+    , ChannelPool_(params->GetTcpKeepAliveSettings(), params->GetSocketIdleTimeout(), params->GetChannelPoolSettings())
 #endif
+    , Tracer_(params->GetTracer())
     , GRpcClientLow_(params->GetNetworkThreadsNum())
     , Log(params->GetLog())
+    , AsyncLog_(CreateAsyncLog(params->GetAsyncLogSettings(), Log))
 {
+    TimerWheel_.Start();
 #ifndef YDB_GRPC_BYPASS_CHANNEL_POOL
     if (params->GetSocketIdleTimeout() != TDuration::Max()) {
         auto channelPoolUpdateWrapper = [this]
@@ -189,22 +97,28 @@ TGRpcConnectionsImpl::TGRpcConnectionsImpl(std::shared_ptr<IConnectionsParams> p
 
 TGRpcConnectionsImpl::~TGRpcConnectionsImpl() {
     GRpcClientLow_.Stop(true);
+    TimerWheel_.Stop();
     ResponseQueue_->Stop();
 }
 
 void TGRpcConnectionsImpl::AddPeriodicTask(TPeriodicCb&& cb, TDuration period) {
-    std::shared_ptr<IQueueClientContext> context;
-    if (!TryCreateContext(context)) {
+    SchedulePeriodicTask(std::make_shared<TPeriodicCb>(std::move(cb)), period);
+}
+
+void TGRpcConnectionsImpl::SchedulePeriodicTask(std::shared_ptr<TPeriodicCb> cb, TDuration period) {
+    ScheduleCallback(period, [this, cb, period](bool ok) {
+        if (!ok) {
+            NYql::TIssues issues;
+            issues.AddIssue(NYql::TIssue("Deferred timer interrupted"));
+            (*cb)(std::move(issues), EStatus::CLIENT_INTERNAL_ERROR);
+            return;
+        }
+
         NYql::TIssues issues;
-        cb(std::move(issues), EStatus::CLIENT_INTERNAL_ERROR);
-    } else {
-        auto action = MakeIntrusive<TPeriodicAction>(
-            std::move(cb),
-            this,
-            std::move(context),
-            period);
-        action->Start();
-    }
+        if ((*cb)(std::move(issues), EStatus::SUCCESS)) {
+            SchedulePeriodicTask(std::move(cb), period);
+        }
+    });
 }
 
 void TGRpcConnectionsImpl::ScheduleOneTimeTask(TSimpleCb&& fn, TDuration timeout) {
@@ -241,13 +155,14 @@ NThreading::TFuture<bool> TGRpcConnectionsImpl::ScheduleFuture(
         TDuration timeout,
         IQueueClientContextPtr context)
 {
-    IQueueClientContextProvider* provider = context.get();
-    if (!provider) {
-        provider = &GRpcClientLow_;
-    }
+    auto promise = NThreading::NewPromise<bool>();
+    auto future = promise.GetFuture();
 
-    return MakeIntrusive<TScheduledFuture>()
-        ->Start(timeout, provider);
+    ScheduleCallback(timeout, [promise](bool ok) mutable {
+        promise.SetValue(ok);
+    }, std::move(context));
+
+    return future;
 }
 
 void TGRpcConnectionsImpl::ScheduleCallback(
@@ -260,8 +175,30 @@ void TGRpcConnectionsImpl::ScheduleCallback(
         provider = &GRpcClientLow_;
     }
 
-    return MakeIntrusive<TScheduledCallback>(std::move(callback))
-        ->Start(timeout, provider);
+    // Timer context keeps client running until the timer is fired or cancelled
+    auto timerContext = provider->CreateContext();
+    if (!timerContext) {
+        callback(false);
+        return;
+    }
+
+    // Wheel thread only hands fired callbacks over to the response queue,
+    // so a slow callback does not delay other timers
+    auto timer = TimerWheel_.Schedule(timeout, [this, timerContext, callback = std::move(callback)](bool ok) mutable {
+        auto resp = new TSimpleCbResult(
+            [callback = std::move(callback), ok] {
+                callback(ok);
+            },
+            this,
+            timerContext);
+        EnqueueResponse(resp);
+    });
+
+    if (timer) {
+        timerContext->SubscribeCancel([this, timer] {
+            TimerWheel_.Cancel(timer);
+        });
+    }
 }
 
 TDbDriverStatePtr TGRpcConnectionsImpl::GetDriverState(
@@ -303,6 +240,25 @@ void TGRpcConnectionsImpl::Stop(bool wait) {
     GRpcClientLow_.Stop(wait);
 }
 
+void TGRpcConnectionsImpl::AddStartupTask(NThreading::TFuture<void> task) {
+    std::lock_guard lock(StartupTasksLock_);
+    // Drop tasks which are already done to keep the list short
+    std::erase_if(StartupTasks_, [](const NThreading::TFuture<void>& f) { return f.HasValue(); });
+    StartupTasks_.emplace_back(std::move(task));
+}
+
+NThreading::TFuture<void> TGRpcConnectionsImpl::WaitReady() {
+    std::vector<NThreading::TFuture<void>> tasks;
+    {
+        std::lock_guard lock(StartupTasksLock_);
+        tasks = StartupTasks_;
+    }
+    if (DefaultState_) {
+        tasks.emplace_back(DefaultState_->DiscoveryCompleted());
+    }
+    return NThreading::WaitAll(tasks);
+}
+
 void TGRpcConnectionsImpl::SetGrpcKeepAlive(NYdbGrpc::TGRpcClientConfig& config, const TDuration& timeout, bool permitWithoutCalls) {
     ui64 timeoutMs = timeout.MilliSeconds();
     config.IntChannelParams[GRPC_ARG_KEEPALIVE_TIME_MS] = timeoutMs >> 3;
@@ -380,6 +336,10 @@ TBalancingSettings TGRpcConnectionsImpl::GetBalancingSettings() const {
     return BalancingSettings_;
 }
 
+TAdmissionControlSettings TGRpcConnectionsImpl::GetAdmissionControlSettings() const {
+    return AdmissionControlSettings_;
+}
+
 bool TGRpcConnectionsImpl::StartStatCollecting(NMonitoring::IMetricRegistry* sensorsRegistry) {
     {
         std::lock_guard lock(ExtensionsLock_);
@@ -420,6 +380,30 @@ const TLog& TGRpcConnectionsImpl::GetLog() const {
     return Log;
 }
 
+std::shared_ptr<TAsyncLog> TGRpcConnectionsImpl::GetAsyncLog() const {
+    return AsyncLog_;
+}
+
+NTracing::TSpanPtr TGRpcConnectionsImpl::StartSpan(const std::string& name, NTracing::ESpanKind kind, const std::string& traceparent) const {
+    if (!Tracer_) {
+        return nullptr;
+    }
+
+    std::optional<NTracing::TSpanContext> parent;
+    if (!traceparent.empty()) {
+        parent = NTracing::TSpanContext::FromTraceparent(traceparent);
+    }
+    return Tracer_->StartSpan(name, kind, parent ? &*parent : nullptr);
+}
+
+void TGRpcConnectionsImpl::AddTraceparentHeader(TCallMeta& meta, const NTracing::TSpanPtr& span, const std::string& traceparent) {
+    if (span) {
+        meta.Aux.push_back({OTEL_TRACE_HEADER, span->GetContext().ToTraceparent()});
+    } else if (!traceparent.empty()) {
+        meta.Aux.push_back({OTEL_TRACE_HEADER, traceparent});
+    }
+}
+
 void TGRpcConnectionsImpl::EnqueueResponse(IObjectInQueue* action) {
     Y_ENSURE(ResponseQueue_->Add(action));
 }
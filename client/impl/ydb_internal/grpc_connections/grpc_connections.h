@@ -1,6 +1,7 @@
 #pragma once
 
 #include <client/impl/ydb_internal/internal_header.h>
+#include <client/impl/ydb_internal/common/retry_attempt.h>
 #include <client/impl/ydb_internal/common/ssl_credentials.h>
 
 #include "actions.h"
@@ -10,6 +11,7 @@
 #include <client/impl/ydb_internal/db_driver_state/state.h>
 #include <client/impl/ydb_internal/rpc_request_settings/settings.h>
 #include <client/impl/ydb_internal/thread_pool/pool.h>
+#include <client/impl/ydb_internal/timer_wheel/timer_wheel.h>
 #include <client/resources/ydb_resources.h>
 #include <client/ydb_extension/extension.h>
 
@@ -34,6 +36,33 @@ std::string GetAuthInfo(TDbDriverStatePtr p);
 void SetDatabaseHeader(TCallMeta& meta, const std::string& database);
 std::string CreateSDKBuildInfo();
 
+// Name of rpc method by it's request message, e.g. "ExecuteDataQuery" for ExecuteDataQueryRequest
+template<typename TRequest>
+const std::string& GetRpcMethodName() {
+    static const std::string name = [] {
+        std::string name(TRequest::descriptor()->name());
+        const std::string_view suffix = "Request";
+        if (name.size() > suffix.size() && name.ends_with(suffix)) {
+            name.resize(name.size() - suffix.size());
+        }
+        return name;
+    }();
+    return name;
+}
+
+// Status of ydb operation in response if the call itself succeeded
+template<typename TResponse>
+EStatus GetResponseStatus(const TResponse* response, const TPlainStatus& status) {
+    if (response && status.Ok()) {
+        if constexpr (requires { response->operation().status(); }) {
+            return static_cast<EStatus>(response->operation().status());
+        } else if constexpr (requires { { response->status() } -> std::same_as<Ydb::StatusIds::StatusCode>; }) {
+            return static_cast<EStatus>(response->status());
+        }
+    }
+    return status.Status;
+}
+
 class TGRpcConnectionsImpl
     : public IQueueClientContextProvider
     , public IInternalClient
@@ -68,6 +97,12 @@ public:
     bool TryCreateContext(IQueueClientContextPtr& context);
     void WaitIdle();
     void Stop(bool wait = false);
+    // Registers background work (e.g. session pool pre-warming) which has to be done
+    // before driver is considered ready
+    void AddStartupTask(NThreading::TFuture<void> task);
+    // Returns future which is set when discovery for default database is completed
+    // and all startup tasks registered so far are done
+    NThreading::TFuture<void> WaitReady();
 
     template<typename TService>
     using TServiceConnection = NYdbGrpc::TServiceConnection<TService>;
@@ -77,7 +112,8 @@ public:
     template<typename TService>
     std::pair<std::unique_ptr<TServiceConnection<TService>>, TEndpointKey> GetServiceConnection(
         TDbDriverStatePtr dbState, const TEndpointKey& preferredEndpoint,
-        TRpcRequestSettings::TEndpointPolicy endpointPolicy)
+        TRpcRequestSettings::TEndpointPolicy endpointPolicy,
+        NYdbGrpc::EChannelType channelType = NYdbGrpc::EChannelType::Unary)
     {
         auto clientConfig = NYdbGrpc::TGRpcClientConfig(dbState->DiscoveryEndpoint);
         const auto& sslCredentials = dbState->SslCredentials;
@@ -118,7 +154,7 @@ public:
         ChannelPool_.GetStubsHolderLocked(
             clientConfig.Locator, clientConfig, [&conn, this](NYdbGrpc::TStubsHolder& holder) mutable {
             conn.reset(GRpcClientLow_.CreateGRpcServiceConnection<TService>(holder).release());
-        });
+        }, channelType);
 #else
         conn = std::move(GRpcClientLow_.CreateGRpcServiceConnection<TService>(clientConfig));
 #endif
@@ -151,23 +187,61 @@ public:
             return;
         }
 
+        std::shared_ptr<NSdkStats::TRequestPhaseTimer> phaseTimer;
         if (dbState->StatCollector.IsCollecting()) {
             std::weak_ptr<TDbDriverState> weakState = dbState;
             const auto startTime = TInstant::Now();
-            userResponseCb = std::move([cb = std::move(userResponseCb), weakState, startTime](TResponse* response, TPlainStatus status) {
+            phaseTimer = std::make_shared<NSdkStats::TRequestPhaseTimer>();
+            userResponseCb = std::move([cb = std::move(userResponseCb), weakState, startTime, phaseTimer](TResponse* response, TPlainStatus status) {
+                phaseTimer->Mark(NSdkStats::ERequestPhase::ResponseQueue);
+                status.RequestTimings = phaseTimer->GetTimings();
+
                 const auto resultSize = response ? response->ByteSizeLong() : 0;
-                cb(response, status);
+                cb(response, std::move(status));
+                phaseTimer->Mark(NSdkStats::ERequestPhase::Callback);
 
                 if (auto state = weakState.lock()) {
                     state->StatCollector.IncRequestLatency(TInstant::Now() - startTime);
                     state->StatCollector.IncResultSize(resultSize);
+                    state->StatCollector.RecordRequestPhases(GetRpcMethodName<TRequest>(), *phaseTimer);
                 }
             });
         }
 
+        NTracing::TSpanPtr span = StartRpcSpan<TRequest>(dbState, requestSettings);
+        if (span) {
+            userResponseCb = [cb = std::move(userResponseCb), span](TResponse* response, TPlainStatus status) {
+                span->End(status.Status);
+                cb(response, std::move(status));
+            };
+        }
+
+        // Discovery is not limited, it is needed to find endpoints which are not overloaded
+        TAdmissionPermitPtr permit;
+        if (dbState->Admission->IsConcurrencyLimitEnabled() && !std::is_same<TService, Ydb::Discovery::V1::DiscoveryService>()) {
+            permit = dbState->Admission->TryAdmit(typeid(TRequest));
+            if (!permit) {
+                userResponseCb(nullptr, TPlainStatus(EStatus::CLIENT_RESOURCE_EXHAUSTED,
+                    "Too many requests in flight to the database, rejected by client side admission control"));
+                return;
+            }
+            userResponseCb = [cb = std::move(userResponseCb), permit](TResponse* response, TPlainStatus status) {
+                permit->Release(GetResponseStatus(response, status));
+                cb(response, std::move(status));
+            };
+        }
+
+        // Requests of a session bound to a retry attempt get its deadline with the settings,
+        // the others only when they are started in the thread of the attempt
+        const TDuration clientTimeout = TRetryAttemptGuard::Clamp(requestSettings.ClientTimeout);
+
         WithServiceConnection<TService>(
-            [this, request = std::move(request), userResponseCb = std::move(userResponseCb), rpc, requestSettings, context = std::move(context), dbState]
+            [this, request = std::move(request), userResponseCb = std::move(userResponseCb), rpc, requestSettings, clientTimeout, context = std::move(context), dbState, phaseTimer, span, permit]
             (TPlainStatus status, TConnection serviceConnection, TEndpointKey endpoint) mutable -> void {
+                if (phaseTimer) {
+                    phaseTimer->Mark(NSdkStats::ERequestPhase::EndpointWait);
+                }
+
                 if (!status.Ok()) {
                     userResponseCb(
                         nullptr,
@@ -175,8 +249,15 @@ public:
                     return;
                 }
 
+                if (permit && !permit->TryAcquireEndpoint(endpoint.GetEndpoint())) {
+                    userResponseCb(nullptr, TPlainStatus(EStatus::CLIENT_RESOURCE_EXHAUSTED,
+                        TStringBuilder() << "Too many requests in flight to " << endpoint.GetEndpoint()
+                            << ", rejected by client side admission control"));
+                    return;
+                }
+
                 TCallMeta meta;
-                meta.Timeout = requestSettings.ClientTimeout;
+                meta.Timeout = clientTimeout;
         #ifndef YDB_GRPC_UNSECURE_AUTH
                 meta.CallCredentials = dbState->CallCredentials;
         #else
@@ -199,6 +280,11 @@ public:
                     meta.Aux.push_back({YDB_TRACE_ID_HEADER, requestSettings.TraceId});
                 }
 
+                if (span) {
+                    span->SetAttribute("server.address", endpoint.GetEndpoint());
+                }
+                AddTraceparentHeader(meta, span, requestSettings.TraceParent);
+
                 if (!requestSettings.RequestType.empty()) {
                     meta.Aux.push_back({YDB_REQUEST_TYPE_HEADER, requestSettings.RequestType});
                 }
@@ -216,9 +302,15 @@ public:
                 dbState->StatCollector.IncGRpcInFlight();
                 dbState->StatCollector.IncGRpcInFlightByHost(endpoint.GetEndpoint());
 
-                NYdbGrpc::TAdvancedResponseCallback<TResponse> responseCbLow =
-                    [this, context, userResponseCb = std::move(userResponseCb), endpoint, dbState]
-                    (const grpc::ClientContext& ctx, TGrpcStatus&& grpcStatus, TResponse&& response) mutable -> void {
+                // Response is either TResponse or NYdbGrpc::TArenaMessage<TResponse>
+                auto responseCbLow =
+                    [this, context, userResponseCb = std::move(userResponseCb), endpoint, dbState, phaseTimer]
+                    (const grpc::ClientContext& ctx, TGrpcStatus&& grpcStatus, auto&& response) mutable -> void {
+                        using TStorage = std::decay_t<decltype(response)>;
+                        if (phaseTimer) {
+                            phaseTimer->Mark(NSdkStats::ERequestPhase::Grpc);
+                        }
+
                         dbState->StatCollector.DecGRpcInFlight();
                         dbState->StatCollector.DecGRpcInFlightByHost(endpoint.GetEndpoint());
 
@@ -236,13 +328,13 @@ public:
                                     std::string(value.begin(), value.end()));
                             }
 
-                            auto resp = new TResult<TResponse>(
+                            auto resp = new TResult<TResponse, TStorage>(
                                 std::move(response),
                                 std::move(grpcStatus),
                                 std::move(userResponseCb),
                                 this,
                                 std::move(context),
-                                endpoint.GetEndpoint(),
+                                endpoint.Endpoint,
                                 std::move(metadata));
 
                             EnqueueResponse(resp);
@@ -255,7 +347,7 @@ public:
                                 std::move(userResponseCb),
                                 this,
                                 std::move(context),
-                                endpoint.GetEndpoint());
+                                endpoint.Endpoint);
 
                             dbState->EndpointPool.BanEndpoint(endpoint.GetEndpoint());
 
@@ -263,8 +355,21 @@ public:
                         }
                     };
 
-                serviceConnection->DoAdvancedRequest(std::move(request), std::move(responseCbLow), rpc, meta,
-                    context.get());
+                if (phaseTimer) {
+                    phaseTimer->Mark(NSdkStats::ERequestPhase::Credentials);
+                }
+
+                if (permit) {
+                    permit->OnSent();
+                }
+
+                if (requestSettings.UseArena) {
+                    serviceConnection->template DoArenaRequest<TRequest, TResponse>(request, std::move(responseCbLow), rpc, meta,
+                        context.get());
+                } else {
+                    serviceConnection->template DoAdvancedRequest<TRequest, TResponse>(request, std::move(responseCbLow), rpc, meta,
+                        context.get());
+                }
             }, dbState, requestSettings.PreferredEndpoint, requestSettings.EndpointPolicy);
     }
 
@@ -312,12 +417,16 @@ public:
             }
         };
 
+        // Operation payload is unpacked from Any by the callbacks, so nothing refers to the response after them
+        TRpcRequestSettings rpcSettings = requestSettings;
+        rpcSettings.UseArena = true;
+
         Run<TService, TRequest, TResponse>(
             std::move(request),
             responseCb,
             rpc,
             dbState,
-            requestSettings,
+            rpcSettings,
             std::move(context));
     }
 
@@ -402,9 +511,15 @@ public:
             return;
         }
 
+        // Span of the stream lasts until the stream is finished
+        NTracing::TSpanPtr span = StartRpcSpan<TRequest>(dbState, requestSettings);
+
         WithServiceConnection<TService>(
-            [request, responseCb = std::move(responseCb), rpc, requestSettings, context = std::move(context), dbState](TPlainStatus status, TConnection serviceConnection, TEndpointKey endpoint) mutable {
+            [request, responseCb = std::move(responseCb), rpc, requestSettings, context = std::move(context), dbState, span](TPlainStatus status, TConnection serviceConnection, TEndpointKey endpoint) mutable {
                 if (!status.Ok()) {
+                    if (span) {
+                        span->End(status.Status);
+                    }
                     responseCb(std::move(status), nullptr);
                     return;
                 }
@@ -418,6 +533,9 @@ public:
                     try {
                         meta.Aux.push_back({ YDB_AUTH_TICKET_HEADER, GetAuthInfo(dbState) });
                     } catch (const std::exception& e) {
+                        if (span) {
+                            span->End(EStatus::CLIENT_UNAUTHENTICATED);
+                        }
                         responseCb(
                             TPlainStatus(
                                 EStatus::CLIENT_UNAUTHENTICATED,
@@ -433,6 +551,11 @@ public:
                     meta.Aux.push_back({YDB_TRACE_ID_HEADER, requestSettings.TraceId});
                 }
 
+                if (span) {
+                    span->SetAttribute("server.address", endpoint.GetEndpoint());
+                }
+                AddTraceparentHeader(meta, span, requestSettings.TraceParent);
+
                 if (!requestSettings.RequestType.empty()) {
                     meta.Aux.push_back({YDB_REQUEST_TYPE_HEADER, requestSettings.RequestType});
                 }
@@ -444,14 +567,17 @@ public:
                 dbState->StatCollector.IncGRpcInFlight();
                 dbState->StatCollector.IncGRpcInFlightByHost(endpoint.GetEndpoint());
 
-                auto lowCallback = [responseCb = std::move(responseCb), dbState, endpoint]
+                auto lowCallback = [responseCb = std::move(responseCb), dbState, endpoint, span]
                     (TGrpcStatus grpcStatus, TProcessor processor) mutable {
                         dbState->StatCollector.DecGRpcInFlight();
                         dbState->StatCollector.DecGRpcInFlightByHost(endpoint.GetEndpoint());
 
                         if (grpcStatus.Ok()) {
                             Y_ABORT_UNLESS(processor);
-                            auto finishedCallback = [dbState, endpoint] (TGrpcStatus grpcStatus) {
+                            auto finishedCallback = [dbState, endpoint, span] (TGrpcStatus grpcStatus) {
+                                if (span) {
+                                    span->End(TPlainStatus(grpcStatus, endpoint.GetEndpoint()).Status);
+                                }
                                 if (!grpcStatus.Ok() && grpcStatus.GRpcStatusCode != grpc::StatusCode::CANCELLED) {
                                     dbState->EndpointPool.BanEndpoint(endpoint.GetEndpoint());
                                 }
@@ -468,6 +594,9 @@ public:
                             }
                             // TODO: Add headers for streaming calls.
                             TPlainStatus status(std::move(grpcStatus), endpoint.GetEndpoint(), {});
+                            if (span) {
+                                span->End(status.Status);
+                            }
                             responseCb(std::move(status), nullptr);
                         }
                     };
@@ -478,7 +607,7 @@ public:
                     std::move(rpc),
                     std::move(meta),
                     context.get());
-            }, dbState, requestSettings.PreferredEndpoint, requestSettings.EndpointPolicy);
+            }, dbState, requestSettings.PreferredEndpoint, requestSettings.EndpointPolicy, NYdbGrpc::EChannelType::Streaming);
     }
 
     template<class TService, class TRequest, class TResponse, class TCallback>
@@ -498,10 +627,16 @@ public:
             return;
         }
 
+        // Span of the stream lasts until the stream is finished
+        NTracing::TSpanPtr span = StartRpcSpan<TRequest>(dbState, requestSettings);
+
         WithServiceConnection<TService>(
-            [connectedCallback = std::move(connectedCallback), rpc, requestSettings, context = std::move(context), dbState]
+            [connectedCallback = std::move(connectedCallback), rpc, requestSettings, context = std::move(context), dbState, span]
             (TPlainStatus status, TConnection serviceConnection, TEndpointKey endpoint) mutable {
                 if (!status.Ok()) {
+                    if (span) {
+                        span->End(status.Status);
+                    }
                     connectedCallback(std::move(status), nullptr);
                     return;
                 }
@@ -514,6 +649,9 @@ public:
                     try {
                         meta.Aux.push_back({ YDB_AUTH_TICKET_HEADER, GetAuthInfo(dbState) });
                     } catch (const std::exception& e) {
+                        if (span) {
+                            span->End(EStatus::CLIENT_UNAUTHENTICATED);
+                        }
                         connectedCallback(
                             TPlainStatus(
                                 EStatus::CLIENT_UNAUTHENTICATED,
@@ -529,6 +667,11 @@ public:
                     meta.Aux.push_back({YDB_TRACE_ID_HEADER, requestSettings.TraceId});
                 }
 
+                if (span) {
+                    span->SetAttribute("server.address", endpoint.GetEndpoint());
+                }
+                AddTraceparentHeader(meta, span, requestSettings.TraceParent);
+
                 if (!requestSettings.RequestType.empty()) {
                     meta.Aux.push_back({YDB_REQUEST_TYPE_HEADER, requestSettings.RequestType});
                 }
@@ -540,14 +683,17 @@ public:
                 dbState->StatCollector.IncGRpcInFlight();
                 dbState->StatCollector.IncGRpcInFlightByHost(endpoint.GetEndpoint());
 
-                auto lowCallback = [connectedCallback = std::move(connectedCallback), dbState, endpoint]
+                auto lowCallback = [connectedCallback = std::move(connectedCallback), dbState, endpoint, span]
                     (TGrpcStatus grpcStatus, TProcessor processor) {
                         dbState->StatCollector.DecGRpcInFlight();
                         dbState->StatCollector.DecGRpcInFlightByHost(endpoint.GetEndpoint());
 
                         if (grpcStatus.Ok()) {
                             Y_ABORT_UNLESS(processor);
-                            auto finishedCallback = [dbState, endpoint] (TGrpcStatus grpcStatus) {
+                            auto finishedCallback = [dbState, endpoint, span] (TGrpcStatus grpcStatus) {
+                                if (span) {
+                                    span->End(TPlainStatus(grpcStatus, endpoint.GetEndpoint()).Status);
+                                }
                                 if (!grpcStatus.Ok() && grpcStatus.GRpcStatusCode != grpc::StatusCode::CANCELLED) {
                                     dbState->EndpointPool.BanEndpoint(endpoint.GetEndpoint());
                                 }
@@ -564,6 +710,9 @@ public:
                             }
                             // TODO: Add headers for streaming calls.
                             TPlainStatus status(std::move(grpcStatus), endpoint.GetEndpoint(), {});
+                            if (span) {
+                                span->End(status.Status);
+                            }
                             connectedCallback(std::move(status), nullptr);
                         }
                     };
@@ -573,7 +722,7 @@ public:
                     std::move(rpc),
                     std::move(meta),
                     context.get());
-            }, dbState, requestSettings.PreferredEndpoint, requestSettings.EndpointPolicy);
+            }, dbState, requestSettings.PreferredEndpoint, requestSettings.EndpointPolicy, NYdbGrpc::EChannelType::Streaming);
     }
 
     TAsyncListEndpointsResult GetEndpoints(TDbDriverStatePtr dbState) override;
@@ -589,22 +738,48 @@ public:
 
     bool GetDrainOnDtors() const;
     TBalancingSettings GetBalancingSettings() const override;
+    TAdmissionControlSettings GetAdmissionControlSettings() const override;
     bool StartStatCollecting(::NMonitoring::IMetricRegistry* sensorsRegistry) override;
     ::NMonitoring::TMetricRegistry* GetMetricRegistry() override;
     void RegisterExtension(IExtension* extension);
     void RegisterExtensionApi(IExtensionApi* api);
     void SetDiscoveryMutator(IDiscoveryMutatorApi::TMutatorCb&& cb);
     const TLog& GetLog() const override;
+    std::shared_ptr<TAsyncLog> GetAsyncLog() const override;
+
+    // Starts span if driver has tracer, otherwise returns nullptr.
+    // Parent is given as traceparent header value, empty if span is a root one.
+    NTracing::TSpanPtr StartSpan(const std::string& name, NTracing::ESpanKind kind, const std::string& traceparent) const;
+    // Adds traceparent header of the span, or passes parent through if span is not sampled
+    static void AddTraceparentHeader(TCallMeta& meta, const NTracing::TSpanPtr& span, const std::string& traceparent);
+
+    template<typename TRequest>
+    NTracing::TSpanPtr StartRpcSpan(const TDbDriverStatePtr& dbState, const TRpcRequestSettings& requestSettings) const {
+        if (!Tracer_) {
+            return nullptr;
+        }
+
+        const std::string& method = GetRpcMethodName<TRequest>();
+        auto span = StartSpan("ydb." + method, NTracing::ESpanKind::Client, requestSettings.TraceParent);
+        if (span) {
+            span->SetAttribute("db.system", "ydb");
+            span->SetAttribute("db.name", dbState->Database);
+            span->SetAttribute("rpc.system", "grpc");
+            span->SetAttribute("rpc.method", method);
+        }
+        return span;
+    }
 
 private:
     template <typename TService, typename TCallback>
     void WithServiceConnection(TCallback callback, TDbDriverStatePtr dbState,
-        const TEndpointKey& preferredEndpoint, TRpcRequestSettings::TEndpointPolicy endpointPolicy)
+        const TEndpointKey& preferredEndpoint, TRpcRequestSettings::TEndpointPolicy endpointPolicy,
+        NYdbGrpc::EChannelType channelType = NYdbGrpc::EChannelType::Unary)
     {
         using TConnection = std::unique_ptr<TServiceConnection<TService>>;
         TConnection serviceConnection;
         TEndpointKey endpoint;
-        std::tie(serviceConnection, endpoint) = GetServiceConnection<TService>(dbState, preferredEndpoint, endpointPolicy);
+        std::tie(serviceConnection, endpoint) = GetServiceConnection<TService>(dbState, preferredEndpoint, endpointPolicy, channelType);
         if (!serviceConnection) {
             if (dbState->DiscoveryMode == EDiscoveryMode::Sync) {
                 TStringStream errString;
@@ -648,7 +823,7 @@ private:
                 // UpdateAsync guarantee one update in progress for state
                 auto asyncResult = dbState->EndpointPool.UpdateAsync();
                 const bool needUpdateChannels = asyncResult.second;
-                asyncResult.first.Subscribe([this, callback = std::move(callback), needUpdateChannels, dbState, preferredEndpoint, endpointPolicy]
+                asyncResult.first.Subscribe([this, callback = std::move(callback), needUpdateChannels, dbState, preferredEndpoint, endpointPolicy, channelType]
                     (const NThreading::TFuture<TEndpointUpdateResult>& future) mutable {
                     --QueuedRequests_;
                     const auto& updateResult = future.GetValue();
@@ -659,7 +834,7 @@ private:
                     }
                     auto discoveryStatus = updateResult.DiscoveryStatus;
                     if (discoveryStatus.Status == EStatus::SUCCESS) {
-                        WithServiceConnection<TService>(std::move(callback), dbState, preferredEndpoint, endpointPolicy);
+                        WithServiceConnection<TService>(std::move(callback), dbState, preferredEndpoint, endpointPolicy, channelType);
                     } else {
                         callback(
                             TPlainStatus(discoveryStatus.Status, std::move(discoveryStatus.Issues)),
@@ -678,6 +853,7 @@ private:
     }
 
     void EnqueueResponse(IObjectInQueue* action);
+    void SchedulePeriodicTask(std::shared_ptr<TPeriodicCb> cb, TDuration period);
 
 private:
     std::mutex ExtensionsLock_;
@@ -694,6 +870,7 @@ private:
     const i64 MaxQueuedRequests_;
     const bool DrainOnDtors_;
     const TBalancingSettings BalancingSettings_;
+    const TAdmissionControlSettings AdmissionControlSettings_;
     const TDuration GRpcKeepAliveTimeout_;
     const bool GRpcKeepAlivePermitWithoutCalls_;
     const ui64 MemoryQuota_;
@@ -705,17 +882,25 @@ private:
 #ifndef YDB_GRPC_BYPASS_CHANNEL_POOL
     NYdbGrpc::TChannelPool ChannelPool_;
 #endif
+    // Single timer wheel for all delayed and periodic tasks of the driver
+    TTimerWheel TimerWheel_;
     // State for default database, token pair
     TDbDriverStatePtr DefaultState_;
 
+    std::mutex StartupTasksLock_;
+    std::vector<NThreading::TFuture<void>> StartupTasks_;
+
     std::vector<std::unique_ptr<IExtension>> Extensions_;
     std::vector<std::unique_ptr<IExtensionApi>> ExtensionApis_;
 
     IDiscoveryMutatorApi::TMutatorCb DiscoveryMutatorCb;
 
+    const std::shared_ptr<NTracing::ITracer> Tracer_;
+
     // Must be the last member (first called destructor)
     NYdbGrpc::TGRpcClientLow GRpcClientLow_;
     TLog Log;
+    const std::shared_ptr<TAsyncLog> AsyncLog_;
 };
 
 } // namespace NYdb
@@ -5,7 +5,11 @@
 #include <client/impl/ydb_internal/internal_header.h>
 #include <client/impl/ydb_internal/common/types.h>
 #include <client/impl/ydb_internal/common/ssl_credentials.h>
+#include <client/ydb_types/admission_settings.h>
+#include <client/ydb_types/async_log_settings.h>
 #include <client/ydb_types/credentials/credentials.h>
+#include <client/ydb_types/thread_pool_settings.h>
+#include <client/ydb_types/tracing/tracing.h>
 
 namespace NYdb {
 
@@ -15,6 +19,7 @@ public:
     virtual std::string GetEndpoint() const = 0;
     virtual size_t GetNetworkThreadsNum() const = 0;
     virtual size_t GetClientThreadsNum() const = 0;
+    virtual TThreadPoolSettings GetClientThreadPoolSettings() const = 0;
     virtual size_t GetMaxQueuedResponses() const = 0;
     virtual TSslCredentials GetSslCredentials() const = 0;
     virtual std::string GetDatabase() const = 0;
@@ -24,14 +29,18 @@ public:
     virtual NYdbGrpc::TTcpKeepAliveSettings GetTcpKeepAliveSettings() const = 0;
     virtual bool GetDrinOnDtors() const = 0;
     virtual TBalancingSettings GetBalancingSettings() const = 0;
+    virtual TAdmissionControlSettings GetAdmissionControlSettings() const = 0;
     virtual TDuration GetGRpcKeepAliveTimeout() const = 0;
     virtual bool GetGRpcKeepAlivePermitWithoutCalls() const = 0;
     virtual TDuration GetSocketIdleTimeout() const = 0;
     virtual const TLog& GetLog() const = 0;
+    virtual TAsyncLogSettings GetAsyncLogSettings() const = 0;
+    virtual std::shared_ptr<NTracing::ITracer> GetTracer() const = 0;
     virtual ui64 GetMemoryQuota() const = 0;
     virtual ui64 GetMaxInboundMessageSize() const = 0;
     virtual ui64 GetMaxOutboundMessageSize() const = 0;
     virtual ui64 GetMaxMessageSize() const = 0;
+    virtual NYdbGrpc::TChannelPoolSettings GetChannelPoolSettings() const = 0;
 };
 
 } // namespace NYdb
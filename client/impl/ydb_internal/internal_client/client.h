@@ -3,6 +3,7 @@
 #include <client/impl/ydb_internal/internal_header.h>
 
 #include <client/impl/ydb_internal/common/types.h>
+#include <client/ydb_types/admission_settings.h>
 #include <client/ydb_types/ydb.h>
 #include <client/ydb_types/core_facility/core_facility.h>
 
@@ -16,6 +17,7 @@ namespace NMonitoring {
 
 namespace NYdb {
 
+class TAsyncLog;
 class TDbDriverState;
 struct TListEndpointsResult;
 
@@ -27,9 +29,12 @@ public:
     virtual void DeleteChannels(const std::vector<std::string>& endpoints) = 0;
 #endif
     virtual TBalancingSettings GetBalancingSettings() const = 0;
+    virtual TAdmissionControlSettings GetAdmissionControlSettings() const = 0;
     virtual bool StartStatCollecting(::NMonitoring::IMetricRegistry* sensorsRegistry) = 0;
     virtual ::NMonitoring::TMetricRegistry* GetMetricRegistry() = 0;
     virtual const TLog& GetLog() const = 0;
+    // Returns nullptr if asynchronous logging is disabled
+    virtual std::shared_ptr<TAsyncLog> GetAsyncLog() const = 0;
 };
 
 } // namespace NYdb
@@ -55,6 +55,11 @@ const TEndpointKey& TKqpSessionCommon::GetEndpointKey() const {
     return EndpointKey_;
 }
 
+void TKqpSessionCommon::SetRetryAttempt(TRetryAttemptPtr attempt) {
+    std::lock_guard guard(Lock_);
+    RetryAttempt_ = std::move(attempt);
+}
+
 // Can be called from interceptor, need lock
 void TKqpSessionCommon::MarkBroken() {
     std::lock_guard guard(Lock_);
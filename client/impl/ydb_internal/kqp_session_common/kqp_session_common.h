@@ -1,12 +1,14 @@
 #pragma once
 
 #include <client/impl/ydb_endpoints/endpoints.h>
+#include <client/impl/ydb_internal/common/retry_attempt.h>
 #include <client/impl/ydb_internal/session_client/session_client.h>
 
 #include <util/datetime/base.h>
 #include <util/system/spinlock.h>
 
 #include <functional>
+#include <mutex>
 
 namespace NYdb {
 
@@ -51,6 +53,20 @@ public:
     void SetTimeInterval(TDuration interval);
     TDuration GetTimeInterval() const;
 
+    // Set by retry operation for the time of its attempt, requests of the session made by the operation
+    // belong to the attempt even if they are started from continuations in other threads
+    void SetRetryAttempt(TRetryAttemptPtr attempt);
+
+    template <typename TRequestSettings>
+    TRequestSettings ApplyRetryAttempt(const TRequestSettings& settings) {
+        TRetryAttemptPtr attempt;
+        {
+            std::lock_guard guard(Lock_);
+            attempt = RetryAttempt_;
+        }
+        return attempt ? attempt->Apply(settings) : settings;
+    }
+
     static std::function<void(TKqpSessionCommon*)>
         GetSmartDeleter(std::shared_ptr<ISessionClient> client);
 
@@ -72,6 +88,7 @@ private:
     // TODO: suboptimal because need lock for atomic change from interceptor
     // Rewrite with bit field
     bool NeedUpdateActiveCounter_;
+    TRetryAttemptPtr RetryAttempt_;
 };
 
 } // namespace NYdb
@@ -0,0 +1,415 @@
+#define INCLUDE_YDB_INTERNAL_H
+#include "async_log.h"
+#include "log.h"
+
+#include <library/cpp/yson/varint.h>
+
+#include <util/generic/bitops.h>
+#include <util/stream/file.h>
+#include <util/stream/str.h>
+#include <util/string/builder.h>
+#include <util/system/file.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace NYdb {
+
+namespace {
+
+constexpr std::string_view BINARY_LOG_MAGIC = "YDBBLOG1";
+
+enum class EBinaryRecord : ui8 {
+    // Written on every open of the file, string ids are reset
+    Start = 0,
+    String = 1,
+    Event = 2,
+};
+
+void FormatFields(IOutputStream& output, const TLogField* fields, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output << ' ' << fields[i].Name << '=';
+        std::visit([&output](const auto& value) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(value)>, bool>) {
+                output << (value ? "true" : "false");
+            } else {
+                output << value;
+            }
+        }, fields[i].Value);
+    }
+}
+
+// Same layout as GetPrefixLogFormatter gives, but with time of the event
+std::string FormatLine(TInstant time, ELogPriority priority, std::string_view prefix,
+    std::string_view message, const TLogField* fields, size_t count)
+{
+    TStringBuilder result;
+    result << time << LogPriorityToString(priority) << prefix << message;
+    FormatFields(result.Out, fields, count);
+    result << Endl;
+    return std::move(result);
+}
+
+void WriteString(IOutputStream& output, std::string_view value) {
+    NYson::WriteVarUInt64(&output, value.size());
+    output.Write(value.data(), value.size());
+}
+
+std::string ReadString(IInputStream& input) {
+    ui64 size = 0;
+    NYson::ReadVarUInt64(&input, &size);
+    std::string result(size, '\0');
+    input.LoadOrFail(result.data(), size);
+    return result;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Strings (messages, field names and prefixes) are written once per file open and referred by id
+class TAsyncLog::TBinaryWriter {
+public:
+    explicit TBinaryWriter(const std::string& path)
+        : File_(path.c_str(), OpenAlways | WrOnly | ForAppend)
+        , Output_(File_)
+        , BufferOutput_(Buffer_)
+    {
+        if (File_.GetLength() == 0) {
+            BufferOutput_.Write(BINARY_LOG_MAGIC.data(), BINARY_LOG_MAGIC.size());
+        }
+        BufferOutput_.Write(static_cast<char>(EBinaryRecord::Start));
+    }
+
+    void Write(const TLogEvent& event) {
+        const ui64 messageId = Intern(event.Message.data(), event.Message);
+        ui64 prefixId = 0;
+        if (event.Prefix) {
+            if (!Ids_.contains(event.Prefix.get())) {
+                // Keep the prefix alive, so it's address is not reused by another string
+                Prefixes_.push_back(event.Prefix);
+            }
+            prefixId = Intern(event.Prefix.get(), *event.Prefix);
+        }
+
+        std::array<ui64, MAX_LOG_FIELDS> nameIds;
+        for (size_t i = 0; i < event.FieldCount; ++i) {
+            nameIds[i] = Intern(event.Fields[i].Name.data(), event.Fields[i].Name);
+        }
+
+        BufferOutput_.Write(static_cast<char>(EBinaryRecord::Event));
+        NYson::WriteVarUInt64(&BufferOutput_, event.Time.MicroSeconds());
+        BufferOutput_.Write(static_cast<char>(event.Priority));
+        NYson::WriteVarUInt64(&BufferOutput_, messageId);
+        NYson::WriteVarUInt64(&BufferOutput_, prefixId);
+        BufferOutput_.Write(static_cast<char>(event.FieldCount));
+        for (size_t i = 0; i < event.FieldCount; ++i) {
+            const auto& value = event.Fields[i].Value;
+            NYson::WriteVarUInt64(&BufferOutput_, nameIds[i]);
+            BufferOutput_.Write(static_cast<char>(value.index()));
+            std::visit([this](const auto& value) {
+                using TValueType = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<TValueType, i64>) {
+                    NYson::WriteVarInt64(&BufferOutput_, value);
+                } else if constexpr (std::is_same_v<TValueType, ui64>) {
+                    NYson::WriteVarUInt64(&BufferOutput_, value);
+                } else if constexpr (std::is_same_v<TValueType, double>) {
+                    BufferOutput_.Write(&value, sizeof(value));
+                } else if constexpr (std::is_same_v<TValueType, bool>) {
+                    BufferOutput_.Write(static_cast<char>(value));
+                } else if constexpr (std::is_same_v<TValueType, TDuration>) {
+                    NYson::WriteVarUInt64(&BufferOutput_, value.MicroSeconds());
+                } else {
+                    WriteString(BufferOutput_, value);
+                }
+            }, value);
+        }
+    }
+
+    void Flush() {
+        if (!Buffer_.empty()) {
+            Output_.Write(Buffer_.data(), Buffer_.size());
+            Buffer_.clear();
+        }
+    }
+
+private:
+    ui64 Intern(const void* key, std::string_view value) {
+        auto [it, inserted] = Ids_.emplace(key, Ids_.size() + 1);
+        if (inserted) {
+            BufferOutput_.Write(static_cast<char>(EBinaryRecord::String));
+            NYson::WriteVarUInt64(&BufferOutput_, it->second);
+            WriteString(BufferOutput_, value);
+        }
+        return it->second;
+    }
+
+    TFile File_;
+    TUnbufferedFileOutput Output_;
+    std::string Buffer_;
+    TStringOutput BufferOutput_;
+    std::unordered_map<const void*, ui64> Ids_;
+    std::vector<std::shared_ptr<const std::string>> Prefixes_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TAsyncLog::TAsyncLog(const TAsyncLogSettings& settings, const TLog& log)
+    : Settings_(settings)
+    , Log_(log)
+    , Slots_(new TSlot[FastClp2(Max<size_t>(settings.QueueSize_, 2))])
+    , Mask_(FastClp2(Max<size_t>(settings.QueueSize_, 2)) - 1)
+{
+    Log_.SetFormatter({});
+    if (!Settings_.BinaryLogPath_.empty()) {
+        BinaryWriter_ = std::make_unique<TBinaryWriter>(Settings_.BinaryLogPath_);
+    }
+    for (ui64 i = 0; i <= Mask_; ++i) {
+        Slots_[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+    Thread_ = std::thread([this] {
+        Run();
+    });
+}
+
+TAsyncLog::~TAsyncLog() {
+    {
+        std::lock_guard guard(Lock_);
+        Stopped_ = true;
+    }
+    CondVar_.notify_all();
+    Thread_.join();
+}
+
+ELogPriority TAsyncLog::FiltrationLevel() const {
+    return BinaryWriter_ ? Settings_.BinaryLogPriority_ : Log_.FiltrationLevel();
+}
+
+void TAsyncLog::Push(TLogEvent&& event) {
+    if (!TryPush(event)) {
+        Dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Bounded queue of D. Vyukov: slot sequence tells whether the slot is free for the position
+// (sequence == pos) or holds the record of the position (sequence == pos + 1)
+bool TAsyncLog::TryPush(TLogEvent& event) {
+    ui64 pos = EnqueuePos_.load(std::memory_order_relaxed);
+    for (;;) {
+        TSlot& slot = Slots_[pos & Mask_];
+        const ui64 sequence = slot.Sequence.load(std::memory_order_acquire);
+        const i64 diff = static_cast<i64>(sequence - pos);
+        if (diff == 0) {
+            if (EnqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.Event = std::move(event);
+                slot.Sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = EnqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool TAsyncLog::TryPop(TLogEvent& event) {
+    TSlot& slot = Slots_[DequeuePos_ & Mask_];
+    if (slot.Sequence.load(std::memory_order_acquire) != DequeuePos_ + 1) {
+        return false;
+    }
+    event = std::move(slot.Event);
+    slot.Sequence.store(DequeuePos_ + Mask_ + 1, std::memory_order_release);
+    ++DequeuePos_;
+    return true;
+}
+
+void TAsyncLog::Run() {
+    std::unique_lock guard(Lock_);
+    // Records pushed before stop are drained even if the driver is stopped at once
+    for (bool stopped = false; !stopped;) {
+        CondVar_.wait_for(guard, std::chrono::microseconds(Settings_.FlushPeriod_.MicroSeconds()), [this] {
+            return Stopped_;
+        });
+        stopped = Stopped_;
+        guard.unlock();
+        Drain();
+        guard.lock();
+    }
+}
+
+void TAsyncLog::Drain() {
+    TLogEvent event;
+    while (TryPop(event)) {
+        if (BinaryWriter_) {
+            BinaryWriter_->Write(event);
+        } else {
+            Log_.Write(event.Priority, FormatLine(event.Time, event.Priority, event.Prefix ? *event.Prefix : std::string_view(),
+                event.Message, event.Fields.data(), event.FieldCount));
+        }
+    }
+
+    if (const ui64 dropped = Dropped_.exchange(0, std::memory_order_relaxed)) {
+        TLogEvent warning;
+        warning.Time = TInstant::Now();
+        warning.Priority = TLOG_WARNING;
+        warning.Message = "Async log queue is full, records are dropped";
+        warning.Fields[0] = TLogField("Dropped", dropped);
+        warning.FieldCount = 1;
+        if (BinaryWriter_) {
+            BinaryWriter_->Write(warning);
+        } else {
+            Log_.Write(warning.Priority, FormatLine(warning.Time, warning.Priority, {}, warning.Message, warning.Fields.data(), 1));
+        }
+    }
+
+    if (BinaryWriter_) {
+        BinaryWriter_->Flush();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TStructuredLog::TStructuredLog(const TLog& log, std::shared_ptr<TAsyncLog> asyncLog, const std::string& prefix)
+    : Log_(log)
+    , AsyncLog_(std::move(asyncLog))
+    , Prefix_(std::make_shared<const std::string>(prefix))
+{
+    Log_.SetFormatter(GetPrefixLogFormatter(prefix));
+}
+
+bool TStructuredLog::IsEnabled(ELogPriority priority) const {
+    if (AsyncLog_) {
+        return AsyncLog_->FiltrationLevel() >= priority;
+    }
+    return Log_.IsOpen() && Log_.FiltrationLevel() >= priority;
+}
+
+void TStructuredLog::Write(ELogPriority priority, std::string_view message, std::initializer_list<TLogField> fields) const {
+    Y_ASSERT(fields.size() <= MAX_LOG_FIELDS);
+    const size_t count = Min(fields.size(), MAX_LOG_FIELDS);
+
+    if (!AsyncLog_) {
+        TStringBuilder result;
+        result << message;
+        FormatFields(result.Out, fields.begin(), count);
+        Log_.Write(priority, result);
+        return;
+    }
+
+    TLogEvent event;
+    event.Time = TInstant::Now();
+    event.Priority = priority;
+    event.Message = message;
+    event.Prefix = Prefix_;
+    std::copy_n(fields.begin(), count, event.Fields.begin());
+    event.FieldCount = count;
+    AsyncLog_->Push(std::move(event));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DecodeBinaryLog(IInputStream& input, IOutputStream& output) {
+    std::array<char, BINARY_LOG_MAGIC.size()> magic;
+    if (input.Load(magic.data(), magic.size()) != magic.size() || std::string_view(magic.data(), magic.size()) != BINARY_LOG_MAGIC) {
+        ythrow yexception() << "Not a binary log of YDB SDK";
+    }
+
+    std::vector<std::string> strings(1);
+    const auto getString = [&strings](ui64 id) -> const std::string& {
+        if (id >= strings.size()) {
+            ythrow yexception() << "Unknown string id " << id << " in binary log";
+        }
+        return strings[id];
+    };
+
+    char tag;
+    while (input.ReadChar(tag)) {
+        switch (static_cast<EBinaryRecord>(tag)) {
+            case EBinaryRecord::Start:
+                strings.resize(1);
+                break;
+
+            case EBinaryRecord::String: {
+                ui64 id = 0;
+                NYson::ReadVarUInt64(&input, &id);
+                if (id >= strings.size()) {
+                    strings.resize(id + 1);
+                }
+                strings[id] = ReadString(input);
+                break;
+            }
+
+            case EBinaryRecord::Event: {
+                ui64 time = 0;
+                char priority = 0;
+                ui64 messageId = 0;
+                ui64 prefixId = 0;
+                char count = 0;
+                NYson::ReadVarUInt64(&input, &time);
+                input.LoadOrFail(&priority, 1);
+                NYson::ReadVarUInt64(&input, &messageId);
+                NYson::ReadVarUInt64(&input, &prefixId);
+                input.LoadOrFail(&count, 1);
+                if (static_cast<size_t>(count) > MAX_LOG_FIELDS) {
+                    ythrow yexception() << "Too many fields in binary log record";
+                }
+
+                std::array<TLogField, MAX_LOG_FIELDS> fields;
+                for (size_t i = 0; i < static_cast<size_t>(count); ++i) {
+                    ui64 nameId = 0;
+                    char type = 0;
+                    NYson::ReadVarUInt64(&input, &nameId);
+                    input.LoadOrFail(&type, 1);
+                    fields[i].Name = getString(nameId);
+                    switch (type) {
+                        case 0: {
+                            i64 value = 0;
+                            NYson::ReadVarInt64(&input, &value);
+                            fields[i].Value = value;
+                            break;
+                        }
+                        case 1: {
+                            ui64 value = 0;
+                            NYson::ReadVarUInt64(&input, &value);
+                            fields[i].Value = value;
+                            break;
+                        }
+                        case 2: {
+                            double value = 0;
+                            input.LoadOrFail(&value, sizeof(value));
+                            fields[i].Value = value;
+                            break;
+                        }
+                        case 3: {
+                            char value = 0;
+                            input.LoadOrFail(&value, 1);
+                            fields[i].Value = value != 0;
+                            break;
+                        }
+                        case 4: {
+                            ui64 value = 0;
+                            NYson::ReadVarUInt64(&input, &value);
+                            fields[i].Value = TDuration::MicroSeconds(value);
+                            break;
+                        }
+                        case 5:
+                            fields[i].Value = ReadString(input);
+                            break;
+                        default:
+                            ythrow yexception() << "Unknown field type " << static_cast<int>(type) << " in binary log";
+                    }
+                }
+
+                output << FormatLine(TInstant::MicroSeconds(time), static_cast<ELogPriority>(priority),
+                    getString(prefixId), getString(messageId), fields.data(), count);
+                break;
+            }
+
+            default:
+                ythrow yexception() << "Unknown record " << static_cast<int>(tag) << " in binary log";
+        }
+    }
+}
+
+} // namespace NYdb
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <client/impl/ydb_internal/internal_header.h>
+
+#include <client/ydb_types/async_log_settings.h>
+
+#include <library/cpp/logger/log.h>
+
+#include <util/stream/input.h>
+#include <util/stream/output.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <variant>
+
+namespace NYdb {
+
+// Typed field of a structured log record, name must be a string literal
+struct TLogField {
+    using TValue = std::variant<i64, ui64, double, bool, TDuration, std::string>;
+
+    std::string_view Name;
+    TValue Value;
+
+    TLogField() = default;
+
+    template <typename T>
+    TLogField(std::string_view name, T&& value)
+        : Name(name)
+        , Value(MakeValue(std::forward<T>(value)))
+    {}
+
+private:
+    template <typename T>
+    static TValue MakeValue(T&& value) {
+        using TValueType = std::decay_t<T>;
+        if constexpr (std::is_same_v<TValueType, bool> || std::is_same_v<TValueType, TDuration>) {
+            return value;
+        } else if constexpr (std::is_integral_v<TValueType> && std::is_signed_v<TValueType>) {
+            return static_cast<i64>(value);
+        } else if constexpr (std::is_integral_v<TValueType>) {
+            return static_cast<ui64>(value);
+        } else if constexpr (std::is_floating_point_v<TValueType>) {
+            return static_cast<double>(value);
+        } else {
+            return std::string(std::forward<T>(value));
+        }
+    }
+};
+
+constexpr size_t MAX_LOG_FIELDS = 8;
+
+struct TLogEvent {
+    TInstant Time;
+    ELogPriority Priority = TLOG_DEBUG;
+    // String literal
+    std::string_view Message;
+    std::shared_ptr<const std::string> Prefix;
+    std::array<TLogField, MAX_LOG_FIELDS> Fields;
+    size_t FieldCount = 0;
+};
+
+// Driver wide writer of structured log records.
+// Callers put records to a bounded lock free ring buffer, a background thread formats them
+// to the log backend or encodes them to the binary log. Records which don't fit are dropped.
+class TAsyncLog {
+public:
+    TAsyncLog(const TAsyncLogSettings& settings, const TLog& log);
+    ~TAsyncLog();
+
+    ELogPriority FiltrationLevel() const;
+    void Push(TLogEvent&& event);
+
+private:
+    struct TSlot {
+        std::atomic<ui64> Sequence;
+        TLogEvent Event;
+    };
+
+    bool TryPush(TLogEvent& event);
+    bool TryPop(TLogEvent& event);
+    void Run();
+    void Drain();
+
+    class TBinaryWriter;
+
+    const TAsyncLogSettings Settings_;
+    // Log of the driver without formatter, lines are formatted here
+    TLog Log_;
+    std::unique_ptr<TBinaryWriter> BinaryWriter_;
+
+    std::unique_ptr<TSlot[]> Slots_;
+    const ui64 Mask_;
+    std::atomic<ui64> EnqueuePos_ = 0;
+    // Used by the background thread only
+    ui64 DequeuePos_ = 0;
+    std::atomic<ui64> Dropped_ = 0;
+
+    std::mutex Lock_;
+    std::condition_variable CondVar_;
+    bool Stopped_ = false;
+    std::thread Thread_;
+};
+
+// Structured log of a database, writes through the async log of the driver if it is enabled
+// and formats records in place otherwise
+class TStructuredLog {
+public:
+    TStructuredLog(const TLog& log, std::shared_ptr<TAsyncLog> asyncLog, const std::string& prefix);
+
+    bool IsEnabled(ELogPriority priority) const;
+    void Write(ELogPriority priority, std::string_view message, std::initializer_list<TLogField> fields) const;
+
+private:
+    TLog Log_;
+    const std::shared_ptr<TAsyncLog> AsyncLog_;
+    const std::shared_ptr<const std::string> Prefix_;
+};
+
+// Converts binary log written by TAsyncLog to text
+void DecodeBinaryLog(IInputStream& input, IOutputStream& output);
+
+} // namespace NYdb
+
+// Message and field names must be string literals, e.g.
+// LOG_STRUCTURED(DbDriverState->StructuredLog, TLOG_DEBUG, "Acknowledged message", {"SessionId", SessionId}, {"Id", id});
+#define LOG_STRUCTURED(log, priority, message, ...)    \
+    if ((log).IsEnabled(priority)) {                   \
+        (log).Write(priority, message, {__VA_ARGS__}); \
+    }
@@ -0,0 +1,190 @@
+#define INCLUDE_YDB_INTERNAL_H
+#include <client/impl/ydb_internal/logger/async_log.h>
+#include <client/impl/ydb_internal/logger/log.h>
+#undef INCLUDE_YDB_INTERNAL_H
+
+#include <library/cpp/logger/stream.h>
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <util/folder/path.h>
+#include <util/stream/file.h>
+#include <util/stream/str.h>
+#include <util/string/split.h>
+
+using namespace NYdb;
+
+namespace {
+
+constexpr size_t TIME_LENGTH = 27; // 2020-10-08T20:31:11.202588Z
+const std::string PREFIX = "[/Root/db] ";
+
+// Lines without the time of the record
+std::vector<std::string> SplitLines(const std::string& text) {
+    std::vector<std::string> lines;
+    for (const auto& it : StringSplitter(text).Split('\n').SkipEmpty()) {
+        const std::string line(it.Token());
+        UNIT_ASSERT_GT_C(line.size(), TIME_LENGTH, line);
+        lines.push_back(line.substr(TIME_LENGTH));
+    }
+    return lines;
+}
+
+std::string Line(ELogPriority priority, const std::string& prefix, const std::string& text) {
+    return std::string(LogPriorityToString(priority)) + prefix + text;
+}
+
+void WriteRecords(const TStructuredLog& log) {
+    LOG_STRUCTURED(log, TLOG_DEBUG, "Acknowledged message", {"SessionId", "abc"}, {"SeqNo", 42u}, {"Offset", -7},
+        {"Ratio", 0.5}, {"Ok", true}, {"Took", TDuration::MilliSeconds(1500)});
+    LOG_STRUCTURED(log, TLOG_DEBUG, "Acknowledged message", {"SessionId", "def"}, {"SeqNo", 43u}, {"Offset", 0},
+        {"Ratio", 1.25}, {"Ok", false}, {"Took", TDuration::Zero()});
+    LOG_STRUCTURED(log, TLOG_INFO, "Session closed");
+}
+
+std::vector<std::string> ExpectedRecords() {
+    return {
+        Line(TLOG_DEBUG, PREFIX, "Acknowledged message SessionId=abc SeqNo=42 Offset=-7 Ratio=0.5 Ok=true Took=1.500000s"),
+        Line(TLOG_DEBUG, PREFIX, "Acknowledged message SessionId=def SeqNo=43 Offset=0 Ratio=1.25 Ok=false Took=0.000000s"),
+        Line(TLOG_INFO, PREFIX, "Session closed"),
+    };
+}
+
+std::string ReadFile(const TFsPath& path) {
+    return TFileInput(path).ReadAll();
+}
+
+size_t CountOccurrences(const std::string& text, const std::string& value) {
+    size_t count = 0;
+    for (size_t pos = text.find(value); pos != std::string::npos; pos = text.find(value, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+std::string Decode(const std::string& binary) {
+    TStringInput input(binary);
+    TStringStream output;
+    DecodeBinaryLog(input, output);
+    return output.Str();
+}
+
+} // namespace
+
+Y_UNIT_TEST_SUITE(AsyncLogTest) {
+    Y_UNIT_TEST(InPlace) {
+        TStringStream text;
+        TLog log(MakeHolder<TStreamLogBackend>(&text));
+        WriteRecords(TStructuredLog(log, nullptr, PREFIX));
+        UNIT_ASSERT_VALUES_EQUAL(SplitLines(text.Str()), ExpectedRecords());
+    }
+
+    Y_UNIT_TEST(Text) {
+        TStringStream text;
+        TLog log(MakeHolder<TStreamLogBackend>(&text));
+        {
+            auto asyncLog = std::make_shared<TAsyncLog>(TAsyncLogSettings().Enabled(true), log);
+            WriteRecords(TStructuredLog(log, asyncLog, PREFIX));
+        }
+        UNIT_ASSERT_VALUES_EQUAL(SplitLines(text.Str()), ExpectedRecords());
+    }
+
+    Y_UNIT_TEST(BinaryRoundTrip) {
+        const TFsPath path = "round_trip.blog";
+        path.DeleteIfExists();
+
+        const auto settings = TAsyncLogSettings().Enabled(true).BinaryLogPath(path.GetPath());
+        TLog log;
+        for (size_t i = 0; i < 2; ++i) {
+            auto asyncLog = std::make_shared<TAsyncLog>(settings, log);
+            WriteRecords(TStructuredLog(log, asyncLog, PREFIX));
+        }
+
+        const std::string binary = ReadFile(path);
+        // Strings are written once per open of the file, values don't repeat them
+        UNIT_ASSERT_VALUES_EQUAL(CountOccurrences(binary, "Acknowledged message"), 2);
+        UNIT_ASSERT_VALUES_EQUAL(CountOccurrences(binary, "SessionId"), 2);
+        UNIT_ASSERT_VALUES_EQUAL(CountOccurrences(binary, PREFIX), 2);
+        UNIT_ASSERT_VALUES_EQUAL(CountOccurrences(binary, "abc"), 2);
+
+        // The second open appends to the file and resets string ids
+        std::vector<std::string> expected = ExpectedRecords();
+        const auto reopened = ExpectedRecords();
+        expected.insert(expected.end(), reopened.begin(), reopened.end());
+        UNIT_ASSERT_VALUES_EQUAL(SplitLines(Decode(binary)), expected);
+
+        path.DeleteIfExists();
+    }
+
+    Y_UNIT_TEST(BinaryPriority) {
+        const TFsPath path = "priority.blog";
+        path.DeleteIfExists();
+        {
+            TLog log;
+            auto asyncLog = std::make_shared<TAsyncLog>(TAsyncLogSettings()
+                .Enabled(true)
+                .BinaryLogPath(path.GetPath())
+                .BinaryLogPriority(TLOG_INFO), log);
+            WriteRecords(TStructuredLog(log, asyncLog, PREFIX));
+        }
+        UNIT_ASSERT_VALUES_EQUAL(SplitLines(Decode(ReadFile(path))), std::vector<std::string>{ExpectedRecords().back()});
+        path.DeleteIfExists();
+    }
+
+    Y_UNIT_TEST(DroppedOnFullQueue) {
+        const TFsPath path = "dropped.blog";
+        path.DeleteIfExists();
+        {
+            TLog log;
+            // Nothing is drained until the log is destroyed
+            auto asyncLog = std::make_shared<TAsyncLog>(TAsyncLogSettings()
+                .Enabled(true)
+                .QueueSize(4)
+                .FlushPeriod(TDuration::Hours(1))
+                .BinaryLogPath(path.GetPath()), log);
+            TStructuredLog structuredLog(log, asyncLog, PREFIX);
+            for (ui64 i = 0; i < 10; ++i) {
+                LOG_STRUCTURED(structuredLog, TLOG_DEBUG, "Written", {"Id", i});
+            }
+        }
+
+        std::vector<std::string> expected;
+        for (ui64 i = 0; i < 4; ++i) {
+            expected.push_back(Line(TLOG_DEBUG, PREFIX, "Written Id=" + std::to_string(i)));
+        }
+        expected.push_back(Line(TLOG_WARNING, "", "Async log queue is full, records are dropped Dropped=6"));
+        UNIT_ASSERT_VALUES_EQUAL(SplitLines(Decode(ReadFile(path))), expected);
+        path.DeleteIfExists();
+    }
+
+    Y_UNIT_TEST(RingWrapsAround) {
+        const TFsPath path = "wraps.blog";
+        path.DeleteIfExists();
+        std::vector<std::string> expected;
+        {
+            TLog log;
+            auto asyncLog = std::make_shared<TAsyncLog>(TAsyncLogSettings()
+                .Enabled(true)
+                .QueueSize(4)
+                .FlushPeriod(TDuration::MilliSeconds(1))
+                .BinaryLogPath(path.GetPath()), log);
+            TStructuredLog structuredLog(log, asyncLog, PREFIX);
+            // Positions go around the ring several times, half of it is used at once
+            for (ui64 i = 0; i < 20; ++i) {
+                LOG_STRUCTURED(structuredLog, TLOG_DEBUG, "Written", {"Id", i});
+                expected.push_back(Line(TLOG_DEBUG, PREFIX, "Written Id=" + std::to_string(i)));
+                if (i % 2) {
+                    Sleep(TDuration::MilliSeconds(50));
+                }
+            }
+        }
+        UNIT_ASSERT_VALUES_EQUAL(SplitLines(Decode(ReadFile(path))), expected);
+        path.DeleteIfExists();
+    }
+
+    Y_UNIT_TEST(DecodeErrors) {
+        UNIT_ASSERT_EXCEPTION_CONTAINS(Decode("NOTABLOG"), yexception, "Not a binary log");
+        // Event refers to a string which was not written
+        UNIT_ASSERT_EXCEPTION_CONTAINS(Decode(std::string("YDBBLOG1\0\2\1\6\5\0\0", 15)), yexception, "Unknown string id");
+        UNIT_ASSERT_EXCEPTION_CONTAINS(Decode(std::string("YDBBLOG1\7", 9)), yexception, "Unknown record");
+    }
+}
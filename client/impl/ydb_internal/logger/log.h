@@ -6,6 +6,7 @@
 
 namespace NYdb {
 
+std::string_view LogPriorityToString(ELogPriority priority);
 TLogFormatter GetPrefixLogFormatter(const std::string& prefix);
 std::string GetDatabaseLogPrefix(const std::string& database);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <client/impl/ydb_internal/internal_header.h>
+#include <client/impl/ydb_internal/common/retry_attempt.h>
 #include <ydb/public/api/protos/ydb_common.pb.h>
 
 #include <util/datetime/base.h>
@@ -23,10 +24,16 @@ void FillOperationParams(const TRequestSettings& settings, TProtoRequest& params
         SetDuration(settings.ForgetAfter_, *operationParams.mutable_forget_after());
     }
 
+    TDuration operationTimeout;
     if (settings.OperationTimeout_) {
-        SetDuration(settings.OperationTimeout_, *operationParams.mutable_operation_timeout());
+        operationTimeout = settings.OperationTimeout_;
     } else if (settings.ClientTimeout_ && settings.UseClientTimeoutForOperation_) {
-        SetDuration(settings.ClientTimeout_, *operationParams.mutable_operation_timeout());
+        operationTimeout = settings.ClientTimeout_;
+    }
+    // Server stops the operation when the retry attempt deadline is reached
+    operationTimeout = TRetryAttemptGuard::Clamp(operationTimeout);
+    if (operationTimeout) {
+        SetDuration(operationTimeout, *operationParams.mutable_operation_timeout());
     }
 
     if (settings.ReportCostInfo_) {
@@ -9,7 +9,7 @@ using std::string;
 
 TPlainStatus::TPlainStatus(
     const NYdbGrpc::TGrpcStatus& grpcStatus,
-    const string& endpoint,
+    const TInternedEndpoint& endpoint,
     std::multimap<std::string, std::string>&& metadata)
     : Endpoint(endpoint)
     , Metadata(std::move(metadata))
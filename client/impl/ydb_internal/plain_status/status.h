@@ -2,7 +2,9 @@
 
 #include <client/impl/ydb_internal/internal_header.h>
 
+#include <client/impl/ydb_endpoints/endpoints.h>
 #include <client/ydb_types/status_codes.h>
+#include <client/ydb_types/status/status.h>
 
 #include <ydb/public/api/protos/ydb_operation.pb.h>
 
@@ -15,9 +17,10 @@ namespace NYdb {
 struct TPlainStatus {
     EStatus Status;
     NYql::TIssues Issues;
-    std::string Endpoint;
+    TInternedEndpoint Endpoint;
     std::multimap<std::string, std::string> Metadata;
     Ydb::CostInfo ConstInfo;
+    std::optional<TRequestTimings> RequestTimings;
 
     TPlainStatus()
         : Status(EStatus::SUCCESS)
@@ -28,7 +31,7 @@ struct TPlainStatus {
         , Issues(std::move(issues))
     { }
 
-    TPlainStatus(EStatus status, NYql::TIssues&& issues, const std::string& endpoint,
+    TPlainStatus(EStatus status, NYql::TIssues&& issues, const TInternedEndpoint& endpoint,
         std::multimap<std::string, std::string>&& metadata)
         : Status(status)
         , Issues(std::move(issues))
@@ -45,7 +48,7 @@ struct TPlainStatus {
     }
 
     TPlainStatus(
-        const NYdbGrpc::TGrpcStatus& grpcStatus, const std::string& endpoint = std::string(),
+        const NYdbGrpc::TGrpcStatus& grpcStatus, const TInternedEndpoint& endpoint = {},
         std::multimap<std::string, std::string>&& metadata = {});
 
     template<class T>
@@ -57,6 +60,11 @@ struct TPlainStatus {
         return Status == EStatus::SUCCESS;
     }
 
+    // Anything besides the status code, the endpoint and the timings, which TStatus keeps inline
+    bool HasDetails() const {
+        return !Issues.Empty() || !Metadata.empty() || ConstInfo.ByteSizeLong();
+    }
+
     static TPlainStatus Internal(const std::string& message);
 
     bool IsTransportError() const {
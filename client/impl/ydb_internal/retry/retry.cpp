@@ -1,7 +1,6 @@
 #include "retry.h"
 #include <util/random/random.h>
 #include <client/ydb_retry/retry.h>
-#include <client/ydb_common_client/impl/iface.h>
 
 #include <cmath>
 
@@ -21,16 +20,12 @@ ui32 CalcBackoffTime(const TBackoffSettings& settings, ui32 retryNumber) {
     return std::max(std::min(durationMs, (double)MAX_BACKOFF_DURATION_MS), 0.0);
 }
 
-void Backoff(const NRetry::TBackoffSettings& settings, ui32 retryNumber) {
-    auto durationMs = CalcBackoffTime(settings, retryNumber);
-    Sleep(TDuration::MilliSeconds(durationMs));
-}
-
-void AsyncBackoff(std::shared_ptr<IClientImplCommon> client, const TBackoffSettings& settings,
-    ui32 retryNumber, const std::function<void()>& fn)
-{
-    auto durationMs = CalcBackoffTime(settings, retryNumber);
-    client->ScheduleTask(fn, TDuration::MilliSeconds(durationMs));
+TDuration CalcDecorrelatedBackoffTime(const TBackoffSettings& settings, TDuration prevBackoff) {
+    const TDuration base = settings.SlotDuration_;
+    const TDuration cap = Min(base * (1u << std::min(settings.Ceiling_, 31u)), TDuration::MilliSeconds(MAX_BACKOFF_DURATION_MS));
+    const TDuration upper = Max(base, prevBackoff * 3);
+    const TDuration backoff = base + TDuration::FromValue(RandomNumber<ui64>(upper.GetValue() - base.GetValue() + 1));
+    return Min(backoff, cap);
 }
 
 }
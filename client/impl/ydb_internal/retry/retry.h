@@ -1,5 +1,7 @@
 #pragma once
 
+#include <client/impl/ydb_internal/common/retry_attempt.h>
+#include <client/ydb_common_client/impl/iface.h>
 #include <client/ydb_retry/retry.h>
 #include <client/ydb_types/fluent_settings_helpers.h>
 #include <client/ydb_types/status/status.h>
@@ -8,21 +10,16 @@
 #include <util/datetime/base.h>
 #include <util/datetime/cputimer.h>
 #include <util/generic/ptr.h>
+#include <util/string/builder.h>
 #include <util/system/types.h>
 
 #include <functional>
 #include <memory>
 
-namespace NYdb {
-class IClientImplCommon;
-}
-
 namespace NYdb::NRetry {
 
 ui32 CalcBackoffTime(const TBackoffSettings& settings, ui32 retryNumber);
-void Backoff(const NRetry::TBackoffSettings& settings, ui32 retryNumber);
-void AsyncBackoff(std::shared_ptr<IClientImplCommon> client, const TBackoffSettings& settings,
-    ui32 retryNumber, const std::function<void()>& fn);
+TDuration CalcDecorrelatedBackoffTime(const TBackoffSettings& settings, TDuration prevBackoff);
 
 enum class NextStep {
     RetryImmediately,
@@ -36,6 +33,15 @@ protected:
     TRetryOperationSettings Settings_;
     ui32 RetryNumber_;
     TSimpleTimer RetryTimer_;
+    NTracing::TSpanPtr Span_;
+    TInstant Deadline_ = TInstant::Max();
+    // Set on start, shared by all attempts
+    TRetryAttemptPtr Attempt_;
+    // Delay before the next attempt, chosen by GetNextStep
+    TDuration Backoff_;
+    TDuration LastBackoff_;
+    // Set on start, client outlives retry context
+    IClientImplCommon* ClientImpl_ = nullptr;
 
 protected:
     TRetryContextBase(const TRetryOperationSettings& settings)
@@ -51,9 +57,63 @@ protected:
                 << status.GetStatus() << ": " << status.GetIssues().ToString(true) << Endl;
             Cerr << "Sending retry attempt " << RetryNumber_ << " of " << Settings_.MaxRetries_ << Endl;
         }
+        if (Span_) {
+            Span_->AddEvent(TStringBuilder() << "retry " << RetryNumber_ << " after " << status.GetStatus());
+        }
+    }
+
+    void OnStart(IClientImplCommon& client) {
+        ClientImpl_ = &client;
+        Deadline_ = Settings_.MaxTimeout_.ToDeadLine();
+        client.OnRetryOperationStarted();
+        StartSpan(client);
+
+        auto attempt = std::make_shared<TRetryAttempt>();
+        attempt->Deadline = Deadline_;
+        attempt->TraceParent = Span_ ? Span_->GetContext().ToTraceparent() : Settings_.TraceParent_;
+        Attempt_ = std::move(attempt);
+    }
+
+    void StartSpan(IClientImplCommon& client) {
+        Span_ = client.StartSpan("ydb.RetryOperation", NTracing::ESpanKind::Internal, Settings_.TraceParent_);
+        if (Span_) {
+            Span_->SetAttribute("ydb.retry.max_retries", static_cast<i64>(Settings_.MaxRetries_));
+            Span_->SetAttribute("ydb.retry.idempotent", static_cast<i64>(Settings_.Idempotent_));
+        }
+    }
+
+    void EndSpan(EStatus status) {
+        if (Span_) {
+            Span_->SetAttribute("ydb.retry.attempts", static_cast<i64>(RetryNumber_) + 1);
+            Span_->End(status);
+            Span_.reset();
+        }
     }
 
     NextStep GetNextStep(const TStatus& status) {
+        const NextStep step = GetNextStepByStatus(status);
+        if (step == NextStep::RetryFastBackoff || step == NextStep::RetrySlowBackoff) {
+            Backoff_ = CalcBackoff(step == NextStep::RetryFastBackoff
+                ? Settings_.FastBackoffSettings_
+                : Settings_.SlowBackoffSettings_);
+            // Attempt after the deadline would fail anyway, return the current error instead
+            if (Backoff_.ToDeadLine() >= Deadline_) {
+                if (Span_) {
+                    Span_->AddEvent("retry deadline exceeded");
+                }
+                return NextStep::Finish;
+            }
+        }
+        if (step != NextStep::Finish && ClientImpl_ && !ClientImpl_->TryAcquireRetry()) {
+            if (Span_) {
+                Span_->AddEvent("retry budget exhausted");
+            }
+            return NextStep::Finish;
+        }
+        return step;
+    }
+
+    NextStep GetNextStepByStatus(const TStatus& status) {
         if (status.IsSuccess()) {
             return NextStep::Finish;
         }
@@ -106,6 +166,25 @@ protected:
         }
     }
 
+    TDuration CalcBackoff(const TBackoffSettings& settings) {
+        if (settings.DecorrelatedJitter_) {
+            LastBackoff_ = CalcDecorrelatedBackoffTime(settings, LastBackoff_);
+            return LastBackoff_;
+        }
+        return TDuration::MilliSeconds(CalcBackoffTime(settings, RetryNumber_));
+    }
+
+    // Requests started in scope of the guard belong to the attempt
+    TRetryAttemptGuard MakeAttemptGuard() const {
+        return TRetryAttemptGuard(Attempt_);
+    }
+
+    // Settings of the session request made by the retry itself
+    template <typename TCreateSessionSettings>
+    TCreateSessionSettings MakeCreateSessionSettings() const {
+        return Attempt_->Apply(TCreateSessionSettings().ClientTimeout(Settings_.GetSessionClientTimeout_));
+    }
+
     TDuration GetRemainingTimeout() {
         return Settings_.MaxTimeout_ - RetryTimer_.Get();
     }
@@ -19,6 +19,7 @@ protected:
 public:
     TAsyncStatusType Execute() {
         this->RetryTimer_.Reset();
+        this->OnStart(*this->Client_.Impl_);
         this->Retry();
         return this->Promise_.GetFuture();
     }
@@ -38,14 +39,12 @@ protected:
         self->Retry();
     }
 
-    static void DoBackoff(TPtr self, bool fast) {
-        auto backoffSettings = fast ? self->Settings_.FastBackoffSettings_
-                                    : self->Settings_.SlowBackoffSettings_;
-        AsyncBackoff(self->Client_.Impl_, backoffSettings, self->RetryNumber_,
-            [self]() {DoRetry(self);});
+    static void DoBackoff(TPtr self) {
+        self->Client_.Impl_->ScheduleTask([self]() {DoRetry(self);}, self->Backoff_);
     }
 
     static void HandleExceptionAsync(TPtr self, std::exception_ptr e) {
+        self->EndSpan(EStatus::CLIENT_INTERNAL_ERROR);
         self->Promise_.SetException(e);
     }
 
@@ -60,16 +59,29 @@ protected:
             case NextStep::RetryImmediately:
                 return DoRetry(self);
             case NextStep::RetryFastBackoff:
-                return DoBackoff(self, true);
             case NextStep::RetrySlowBackoff:
-                return DoBackoff(self, false);
+                return DoBackoff(self);
             case NextStep::Finish:
+                self->EndSpan(status.GetStatus());
                 return self->Promise_.SetValue(status);
         }
     }
 
+    // Requests of the session made by the operation belong to the attempt until its result is set
+    template <typename TSession>
+    static void SetRetryAttempt(TSession& session, TRetryAttemptPtr attempt) {
+        session.SessionImpl_->SetRetryAttempt(std::move(attempt));
+    }
+
     static void DoRunOperation(TPtr self) {
-        self->RunOperation().Subscribe(
+        TAsyncStatusType operation;
+        {
+            // Only requests started by the operation belong to the attempt, not the requests
+            // started by callbacks which may run inline if the result is already set
+            auto attemptGuard = self->MakeAttemptGuard();
+            operation = self->RunOperation();
+        }
+        operation.Subscribe(
             [self](const TAsyncStatusType& result) {
                 try {
                     HandleStatusAsync(self, result.GetValue());
@@ -134,8 +146,13 @@ public:
     void Retry() override {
         TPtr self(this);
         if (!Session_) {
-            auto settings = TCreateSessionSettings().ClientTimeout(this->Settings_.GetSessionClientTimeout_);
-            this->Client_.GetSession(settings).Subscribe(
+            auto settings = this->template MakeCreateSessionSettings<TCreateSessionSettings>();
+            TAsyncCreateSessionResult sessionResult;
+            {
+                auto attemptGuard = this->MakeAttemptGuard();
+                sessionResult = this->Client_.GetSession(settings);
+            }
+            sessionResult.Subscribe(
                 [self](const TAsyncCreateSessionResult& resultFuture) {
                     try {
                         auto& result = resultFuture.GetValue();
@@ -162,11 +179,24 @@ private:
     }
 
     TAsyncStatusType RunOperation() override {
-        if constexpr (TFunctionArgs<TOperation>::Length == 1) {
-            return Operation_(this->Session_.value());
-        } else {
-            return Operation_(this->Session_.value(), this->GetRemainingTimeout());
+        auto& session = Session_.value();
+        TRetryContextAsync::SetRetryAttempt(session, this->Attempt_);
+        TAsyncStatusType operation;
+        try {
+            if constexpr (TFunctionArgs<TOperation>::Length == 1) {
+                operation = Operation_(session);
+            } else {
+                operation = Operation_(session, this->GetRemainingTimeout());
+            }
+        } catch (...) {
+            TRetryContextAsync::SetRetryAttempt(session, nullptr);
+            throw;
         }
+        // Subscribed before the retry context, so the session is unbound before it is reused or released
+        operation.Subscribe([session](const TAsyncStatusType&) mutable {
+            TRetryContextAsync::SetRetryAttempt(session, nullptr);
+        });
+        return operation;
     }
 };
 
@@ -4,6 +4,8 @@
 #include <client/ydb_retry/retry.h>
 #include <client/ydb_types/status/status.h>
 
+#include <util/generic/scope.h>
+
 namespace NYdb::NRetry::Sync {
 
 template <typename TClient, typename TStatusType>
@@ -13,18 +15,29 @@ protected:
 
 public:
     TStatusType Execute() {
+        this->OnStart(*this->Client_.Impl_);
+        try {
+            TStatusType status = DoExecute();
+            this->EndSpan(status.GetStatus());
+            return status;
+        } catch (...) {
+            this->EndSpan(EStatus::CLIENT_INTERNAL_ERROR);
+            throw;
+        }
+    }
+
+protected:
+    TStatusType DoExecute() {
         this->RetryTimer_.Reset();
-        TStatusType status = Retry(); // first attempt
+        TStatusType status = RetryWithDeadline(); // first attempt
         for (this->RetryNumber_ = 0; this->RetryNumber_ <= this->Settings_.MaxRetries_;) {
             auto nextStep = this->GetNextStep(status);
             switch (nextStep) {
                 case NextStep::RetryImmediately:
                     break;
                 case NextStep::RetryFastBackoff:
-                    DoBackoff(true);
-                    break;
                 case NextStep::RetrySlowBackoff:
-                    DoBackoff(false);
+                    Sleep(this->Backoff_);
                     break;
                 case NextStep::Finish:
                     return status;
@@ -33,12 +46,22 @@ public:
             this->RetryNumber_++;
             this->LogRetry(status);
             this->Client_.Impl_->CollectRetryStatSync(status.GetStatus());
-            status = Retry();
+            status = RetryWithDeadline();
         }
         return status;
     }
 
-protected:
+    TStatusType RetryWithDeadline() {
+        auto attemptGuard = this->MakeAttemptGuard();
+        return Retry();
+    }
+
+    // Requests of the session made by the operation belong to the attempt until the operation returns
+    template <typename TSession>
+    static void SetRetryAttempt(TSession& session, TRetryAttemptPtr attempt) {
+        session.SessionImpl_->SetRetryAttempt(std::move(attempt));
+    }
+
     TRetryContext(TClient& client, const TRetryOperationSettings& settings)
         : TRetryContextBase(settings)
         , Client_(client)
@@ -48,11 +71,6 @@ protected:
 
     virtual TStatusType RunOperation() = 0;
 
-    void DoBackoff(bool fast) {
-        const auto &settings = fast ? this->Settings_.FastBackoffSettings_
-                                    : this->Settings_.SlowBackoffSettings_;
-        Backoff(settings, this->RetryNumber_);
-    }
 };
 
 template<typename TClient, typename TOperation, typename TStatusType = TFunctionResult<TOperation>>
@@ -100,7 +118,7 @@ protected:
         std::optional<TStatusType> status;
 
         if (!Session_) {
-            auto settings = TCreateSessionSettings().ClientTimeout(this->Settings_.GetSessionClientTimeout_);
+            auto settings = this->template MakeCreateSessionSettings<TCreateSessionSettings>();
             auto sessionResult = this->Client_.GetSession(settings).GetValueSync();
             if (sessionResult.IsSuccess()) {
                 Session_ = sessionResult.GetSession();
@@ -116,10 +134,15 @@ protected:
     }
 
     TStatusType RunOperation() override {
+        auto& session = Session_.value();
+        TRetryContext<TClient, TStatusType>::SetRetryAttempt(session, this->Attempt_);
+        Y_DEFER {
+            TRetryContext<TClient, TStatusType>::SetRetryAttempt(session, nullptr);
+        };
         if constexpr (TFunctionArgs<TOperation>::Length == 1) {
-            return Operation_(this->Session_.value());
+            return Operation_(session);
         } else {
-            return Operation_(this->Session_.value(), this->GetRemainingTimeout());
+            return Operation_(session, this->GetRemainingTimeout());
         }
     }
 
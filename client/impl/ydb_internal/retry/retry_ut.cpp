@@ -0,0 +1,269 @@
+#define INCLUDE_YDB_INTERNAL_H
+#include <client/impl/ydb_internal/kqp_session_common/kqp_session_common.h>
+#include <client/impl/ydb_internal/retry/retry_sync.h>
+#include <client/impl/ydb_internal/rpc_request_settings/settings.h>
+#undef INCLUDE_YDB_INTERNAL_H
+
+#include <client/ydb_types/request_settings.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+#include <library/cpp/threading/future/future.h>
+
+#include <future>
+
+using namespace NYdb;
+using namespace NYdb::NRetry;
+
+namespace {
+
+const std::string RetrySpanTraceparent = "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01";
+
+struct TTestRequestSettings : public TOperationRequestSettings<TTestRequestSettings> {};
+
+struct TTestCreateSessionSettings : public TSimpleRequestSettings<TTestCreateSessionSettings> {};
+
+class TTestSpan : public NTracing::ISpan {
+public:
+    TTestSpan()
+        : Context_(*NTracing::TSpanContext::FromTraceparent(RetrySpanTraceparent))
+    {}
+
+    const NTracing::TSpanContext& GetContext() const override {
+        return Context_;
+    }
+
+    void SetAttribute(const std::string&, const std::string&) override {}
+    void SetAttribute(const std::string&, i64) override {}
+    void AddEvent(const std::string&) override {}
+    void End(EStatus) override {}
+
+private:
+    const NTracing::TSpanContext Context_;
+};
+
+class TTestClientImpl : public IClientImplCommon {
+public:
+    void ScheduleTask(const std::function<void()>& fn, TDuration) override {
+        fn();
+    }
+
+    NTracing::TSpanPtr StartSpan(const std::string&, NTracing::ESpanKind, const std::string&) override {
+        return WithTracer ? std::make_shared<TTestSpan>() : nullptr;
+    }
+
+    void OnRetryOperationStarted() override {}
+
+    bool TryAcquireRetry() override {
+        return true;
+    }
+
+    void CollectRetryStatSync(EStatus) {}
+
+    bool WithTracer = true;
+};
+
+struct TTestSession {
+    std::shared_ptr<TKqpSessionCommon> SessionImpl_;
+};
+
+class TTestCreateSessionResult : public TStatus {
+public:
+    TTestCreateSessionResult(TTestSession session)
+        : TStatus(EStatus::SUCCESS, NYql::TIssues())
+        , Session_(std::move(session))
+    {}
+
+    const TTestSession& GetSession() const {
+        return Session_;
+    }
+
+private:
+    TTestSession Session_;
+};
+
+struct TTestClient {
+    using TSession = TTestSession;
+    using TCreateSessionSettings = TTestCreateSessionSettings;
+    using TAsyncCreateSessionResult = NThreading::TFuture<TTestCreateSessionResult>;
+
+    TAsyncCreateSessionResult GetSession(const TCreateSessionSettings& settings) {
+        GetSessionSettings.push_back(settings);
+        return NThreading::MakeFuture(TTestCreateSessionResult(Session));
+    }
+
+    std::shared_ptr<TTestClientImpl> Impl_ = std::make_shared<TTestClientImpl>();
+    TTestSession Session{std::make_shared<TKqpSessionCommon>("", "endpoint", false)};
+    std::vector<TTestCreateSessionSettings> GetSessionSettings;
+};
+
+template <typename TOperation>
+TStatus RetryWithoutSession(TTestClient& client, const TOperation& operation, const TRetryOperationSettings& settings = {}) {
+    Sync::TRetryWithoutSession<TTestClient, TOperation, TStatus> retry(client, operation, settings);
+    return retry.Execute();
+}
+
+template <typename TOperation>
+TStatus RetryWithSession(TTestClient& client, const TOperation& operation, const TRetryOperationSettings& settings = {}) {
+    Sync::TRetryWithSession<TTestClient, TOperation, TStatus> retry(client, operation, settings);
+    return retry.Execute();
+}
+
+} // namespace
+
+Y_UNIT_TEST_SUITE(RetryAttemptTest) {
+    Y_UNIT_TEST(RequestsAreChildrenOfRetrySpan) {
+        TTestClient client;
+        size_t attempts = 0;
+        auto status = RetryWithSession(client, [&](TTestSession session) {
+            // Started by the operation itself
+            UNIT_ASSERT_VALUES_EQUAL(TRpcRequestSettings::Make(TTestRequestSettings()).TraceParent, RetrySpanTraceparent);
+            // Started from a continuation in another thread
+            auto traceParent = std::async(std::launch::async, [session] {
+                return session.SessionImpl_->ApplyRetryAttempt(TTestRequestSettings()).TraceParent_;
+            }).get();
+            UNIT_ASSERT_VALUES_EQUAL(traceParent, RetrySpanTraceparent);
+            // Explicit parent is kept
+            auto settings = session.SessionImpl_->ApplyRetryAttempt(TTestRequestSettings().TraceParent("parent"));
+            UNIT_ASSERT_VALUES_EQUAL(TRpcRequestSettings::Make(settings).TraceParent, "parent");
+
+            return TStatus(++attempts < 3 ? EStatus::ABORTED : EStatus::SUCCESS, NYql::TIssues());
+        });
+        UNIT_ASSERT(status.IsSuccess());
+        UNIT_ASSERT_VALUES_EQUAL(attempts, 3);
+
+        UNIT_ASSERT_VALUES_EQUAL(client.GetSessionSettings.size(), 1);
+        UNIT_ASSERT_VALUES_EQUAL(client.GetSessionSettings[0].TraceParent_, RetrySpanTraceparent);
+
+        // Session is unbound when the operation is over
+        UNIT_ASSERT(client.Session.SessionImpl_->ApplyRetryAttempt(TTestRequestSettings()).TraceParent_.empty());
+        UNIT_ASSERT(TRpcRequestSettings::Make(TTestRequestSettings()).TraceParent.empty());
+    }
+
+    Y_UNIT_TEST(CallerParentWithoutTracer) {
+        TTestClient client;
+        client.Impl_->WithTracer = false;
+        auto status = RetryWithSession(client, [&](TTestSession session) {
+            UNIT_ASSERT_VALUES_EQUAL(session.SessionImpl_->ApplyRetryAttempt(TTestRequestSettings()).TraceParent_, "caller");
+            UNIT_ASSERT_VALUES_EQUAL(TRpcRequestSettings::Make(TTestRequestSettings()).TraceParent, "caller");
+            return TStatus(EStatus::SUCCESS, NYql::TIssues());
+        }, TRetryOperationSettings().TraceParent("caller"));
+        UNIT_ASSERT(status.IsSuccess());
+        UNIT_ASSERT_VALUES_EQUAL(client.GetSessionSettings[0].TraceParent_, "caller");
+    }
+
+    Y_UNIT_TEST(SessionUnboundOnException) {
+        TTestClient client;
+        UNIT_ASSERT_EXCEPTION(RetryWithSession(client, [&](TTestSession) -> TStatus {
+            ythrow yexception() << "operation failed";
+        }), yexception);
+        UNIT_ASSERT(client.Session.SessionImpl_->ApplyRetryAttempt(TTestRequestSettings()).TraceParent_.empty());
+    }
+
+    Y_UNIT_TEST(DeadlineOfSessionInOtherThread) {
+        TTestClient client;
+        auto status = RetryWithSession(client, [&](TTestSession session) {
+            auto settings = std::async(std::launch::async, [session] {
+                return session.SessionImpl_->ApplyRetryAttempt(TTestRequestSettings());
+            }).get();
+            // Client timeout also gives the operation timeout
+            UNIT_ASSERT(settings.ClientTimeout_);
+            UNIT_ASSERT_LE(settings.ClientTimeout_, TDuration::Seconds(10));
+            UNIT_ASSERT(!settings.OperationTimeout_);
+            UNIT_ASSERT(settings.UseClientTimeoutForOperation_);
+
+            settings = session.SessionImpl_->ApplyRetryAttempt(TTestRequestSettings()
+                .ClientTimeout(TDuration::Seconds(1))
+                .OperationTimeout(TDuration::Minutes(1)));
+            UNIT_ASSERT_VALUES_EQUAL(settings.ClientTimeout_, TDuration::Seconds(1));
+            UNIT_ASSERT(settings.OperationTimeout_);
+            UNIT_ASSERT_LE(settings.OperationTimeout_, TDuration::Seconds(10));
+
+            return TStatus(EStatus::SUCCESS, NYql::TIssues());
+        }, TRetryOperationSettings().MaxTimeout(TDuration::Seconds(10)));
+        UNIT_ASSERT(status.IsSuccess());
+
+        UNIT_ASSERT(client.GetSessionSettings[0].ClientTimeout_);
+        UNIT_ASSERT_LE(client.GetSessionSettings[0].ClientTimeout_, TDuration::Seconds(5));
+
+        // No deadline without MaxTimeout
+        RetryWithSession(client, [&](TTestSession session) {
+            UNIT_ASSERT(!session.SessionImpl_->ApplyRetryAttempt(TTestRequestSettings()).ClientTimeout_);
+            UNIT_ASSERT(!TRetryAttemptGuard::Clamp(TDuration::Zero()));
+            return TStatus(EStatus::SUCCESS, NYql::TIssues());
+        });
+    }
+
+    Y_UNIT_TEST(AttemptIsLostInOtherThreadWithoutSession) {
+        TTestClient client;
+        auto status = RetryWithoutSession(client, [&](TTestClient&, TDuration remaining) {
+            UNIT_ASSERT(TRetryAttemptGuard::Clamp(TDuration::Zero()));
+            UNIT_ASSERT_LE(TRetryAttemptGuard::Clamp(TDuration::Zero()), TDuration::Seconds(10));
+
+            // Known limitation: continuations don't know the attempt, remaining timeout is passed explicitly
+            auto [timeout, traceParent] = std::async(std::launch::async, [] {
+                return std::make_pair(TRetryAttemptGuard::Clamp(TDuration::Zero()),
+                    TRpcRequestSettings::Make(TTestRequestSettings()).TraceParent);
+            }).get();
+            UNIT_ASSERT(!timeout);
+            UNIT_ASSERT(traceParent.empty());
+            UNIT_ASSERT(remaining);
+            UNIT_ASSERT_LE(remaining, TDuration::Seconds(10));
+
+            return TStatus(EStatus::SUCCESS, NYql::TIssues());
+        }, TRetryOperationSettings().MaxTimeout(TDuration::Seconds(10)));
+        UNIT_ASSERT(status.IsSuccess());
+    }
+
+    Y_UNIT_TEST(NoRetryAfterDeadline) {
+        TTestClient client;
+        size_t attempts = 0;
+        const TInstant start = TInstant::Now();
+        auto status = RetryWithSession(client, [&](TTestSession) {
+            ++attempts;
+            return TStatus(EStatus::UNAVAILABLE, NYql::TIssues());
+        }, TRetryOperationSettings()
+            .MaxTimeout(TDuration::MilliSeconds(100))
+            .FastBackoffSettings(TBackoffSettings().SlotDuration(TDuration::Seconds(10))));
+        // Backoff would pass the deadline, the error is returned without waiting
+        UNIT_ASSERT_VALUES_EQUAL(status.GetStatus(), EStatus::UNAVAILABLE);
+        UNIT_ASSERT_VALUES_EQUAL(attempts, 1);
+        UNIT_ASSERT_LT(TInstant::Now() - start, TDuration::Seconds(5));
+
+        attempts = 0;
+        status = RetryWithSession(client, [&](TTestSession) {
+            return TStatus(++attempts < 3 ? EStatus::UNAVAILABLE : EStatus::SUCCESS, NYql::TIssues());
+        }, TRetryOperationSettings()
+            .MaxTimeout(TDuration::Seconds(10))
+            .FastBackoffSettings(TBackoffSettings().SlotDuration(TDuration::MilliSeconds(1)).Ceiling(1)));
+        UNIT_ASSERT(status.IsSuccess());
+        UNIT_ASSERT_VALUES_EQUAL(attempts, 3);
+    }
+}
+
+Y_UNIT_TEST_SUITE(BackoffTest) {
+    Y_UNIT_TEST(DecorrelatedBounds) {
+        const auto settings = TBackoffSettings()
+            .SlotDuration(TDuration::MilliSeconds(10))
+            .Ceiling(3)
+            .DecorrelatedJitter();
+        const TDuration cap = TDuration::MilliSeconds(80);
+
+        // The first delay is the slot
+        UNIT_ASSERT_VALUES_EQUAL(CalcDecorrelatedBackoffTime(settings, TDuration::Zero()), settings.SlotDuration_);
+
+        TDuration prev;
+        TDuration longest;
+        for (size_t i = 0; i < 1000; ++i) {
+            const TDuration backoff = CalcDecorrelatedBackoffTime(settings, prev);
+            UNIT_ASSERT_GE(backoff, settings.SlotDuration_);
+            UNIT_ASSERT_LE(backoff, Min(Max(settings.SlotDuration_, prev * 3), cap));
+            longest = Max(longest, backoff);
+            prev = backoff;
+        }
+        UNIT_ASSERT_GT(longest, settings.SlotDuration_ * 2);
+
+        // Cap is kept for big ceilings
+        const auto wide = TBackoffSettings().SlotDuration(TDuration::Seconds(1)).Ceiling(100);
+        UNIT_ASSERT_LE(CalcDecorrelatedBackoffTime(wide, TDuration::Hours(10)), TDuration::Hours(1));
+    }
+}
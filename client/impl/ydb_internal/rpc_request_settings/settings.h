@@ -2,11 +2,13 @@
 
 #include <client/impl/ydb_endpoints/endpoints.h>
 #include <client/impl/ydb_internal/internal_header.h>
+#include <client/impl/ydb_internal/common/retry_attempt.h>
 
 namespace NYdb {
 
 struct TRpcRequestSettings {
     std::string TraceId;
+    std::string TraceParent;
     std::string RequestType;
     std::vector<std::pair<std::string, std::string>> Header;
     TEndpointKey PreferredEndpoint = {};
@@ -17,11 +19,18 @@ struct TRpcRequestSettings {
     } EndpointPolicy = TEndpointPolicy::UsePreferredEndpointOptionally;
     bool UseAuth = true;
     TDuration ClientTimeout;
+    // Parse the response into a per-request arena, which is freed at once after the callback.
+    // Moving parts of such a response out to heap objects copies them
+    bool UseArena = false;
 
     template <typename TRequestSettings>
     static TRpcRequestSettings Make(const TRequestSettings& settings, const TEndpointKey& preferredEndpoint = {}, TEndpointPolicy endpointPolicy = TEndpointPolicy::UsePreferredEndpointOptionally) {
         TRpcRequestSettings rpcSettings;
         rpcSettings.TraceId = settings.TraceId_;
+        // Request started by a retry attempt is a child of the retry span
+        rpcSettings.TraceParent = settings.TraceParent_.empty()
+            ? TRetryAttemptGuard::GetTraceParent()
+            : settings.TraceParent_;
         rpcSettings.RequestType = settings.RequestType_;
         rpcSettings.Header = settings.Header_;
         rpcSettings.PreferredEndpoint = preferredEndpoint;
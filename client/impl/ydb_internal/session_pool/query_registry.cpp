@@ -0,0 +1,168 @@
+#include "query_registry.h"
+
+#include <util/generic/hash.h>
+
+#include <algorithm>
+
+namespace NYdb {
+namespace NSessionPool {
+
+TQueryRegistry::TQueryRegistry(size_t maxQueries)
+{
+    const size_t maxShardSize = std::max<size_t>(1, (maxQueries + ShardCount - 1) / ShardCount);
+    QueryShards_.reserve(ShardCount);
+    for (size_t i = 0; i < ShardCount; ++i) {
+        QueryShards_.emplace_back(std::make_unique<TQueryShard>(maxShardSize));
+    }
+}
+
+size_t TQueryRegistry::GetShardIndex(const std::string& key) {
+    return ComputeHash(key) % ShardCount;
+}
+
+TQueryRegistry::TQueryShard& TQueryRegistry::GetQueryShard(const std::string& key) {
+    return *QueryShards_[GetShardIndex(key)];
+}
+
+const TQueryRegistry::TQueryShard& TQueryRegistry::GetQueryShard(const std::string& key) const {
+    return *QueryShards_[GetShardIndex(key)];
+}
+
+TQueryRegistry::TSessionShard& TQueryRegistry::GetSessionShard(const std::string& sessionId) {
+    return SessionShards_[GetShardIndex(sessionId)];
+}
+
+void TQueryRegistry::Register(const std::string& key, const std::optional<std::string>& text, const std::string& sessionId) {
+    if (key.empty() || sessionId.empty()) {
+        return;
+    }
+
+    {
+        auto& shard = GetQueryShard(key);
+        std::lock_guard guard(shard.Lock);
+        auto it = shard.Queries.Find(key);
+        if (it == shard.Queries.End()) {
+            TQueryEntry entry;
+            if (text) {
+                entry.Text = *text;
+                Generation_.fetch_add(1, std::memory_order_relaxed);
+            }
+            entry.Sessions.insert(sessionId);
+            entry.Registrations = 1;
+            shard.Queries.Insert(key, std::move(entry));
+        } else {
+            if (it->Text.empty() && text) {
+                it->Text = *text;
+                Generation_.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (it->Sessions.insert(sessionId).second) {
+                it->Registrations++;
+            }
+        }
+    }
+
+    auto& sessionShard = GetSessionShard(sessionId);
+    std::lock_guard guard(sessionShard.Lock);
+    sessionShard.Queries[sessionId].insert(key);
+}
+
+void TQueryRegistry::UnregisterUnsafe(TQueryShard& shard, const std::string& key, const std::string& sessionId) {
+    auto it = shard.Queries.FindWithoutPromote(key);
+    if (it != shard.Queries.End()) {
+        it->Sessions.erase(sessionId);
+    }
+}
+
+void TQueryRegistry::Unregister(const std::string& key, const std::string& sessionId) {
+    {
+        auto& shard = GetQueryShard(key);
+        std::lock_guard guard(shard.Lock);
+        UnregisterUnsafe(shard, key, sessionId);
+    }
+
+    auto& sessionShard = GetSessionShard(sessionId);
+    std::lock_guard guard(sessionShard.Lock);
+    auto it = sessionShard.Queries.find(sessionId);
+    if (it != sessionShard.Queries.end()) {
+        it->second.erase(key);
+        if (it->second.empty()) {
+            sessionShard.Queries.erase(it);
+        }
+    }
+}
+
+void TQueryRegistry::ForgetSession(const std::string& sessionId) {
+    std::unordered_set<std::string> keys;
+    {
+        auto& sessionShard = GetSessionShard(sessionId);
+        std::lock_guard guard(sessionShard.Lock);
+        auto it = sessionShard.Queries.find(sessionId);
+        if (it == sessionShard.Queries.end()) {
+            return;
+        }
+        keys = std::move(it->second);
+        sessionShard.Queries.erase(it);
+    }
+
+    for (const auto& key : keys) {
+        auto& shard = GetQueryShard(key);
+        std::lock_guard guard(shard.Lock);
+        UnregisterUnsafe(shard, key, sessionId);
+    }
+}
+
+bool TQueryRegistry::IsPrepared(const std::string& key, const std::string& sessionId) const {
+    const auto& shard = GetQueryShard(key);
+    std::lock_guard guard(shard.Lock);
+    auto it = shard.Queries.FindWithoutPromote(key);
+    return it != shard.Queries.End() && it.Value().Sessions.contains(sessionId);
+}
+
+size_t TQueryRegistry::GetSessionCount(const std::string& key) const {
+    const auto& shard = GetQueryShard(key);
+    std::lock_guard guard(shard.Lock);
+    auto it = shard.Queries.FindWithoutPromote(key);
+    return it != shard.Queries.End() ? it.Value().Sessions.size() : 0;
+}
+
+std::vector<TQueryRegistry::TQueryInfo> TQueryRegistry::GetHotQueries(size_t limit) const {
+    std::vector<std::pair<ui64, TQueryInfo>> candidates;
+    for (const auto& shard : QueryShards_) {
+        std::lock_guard guard(shard->Lock);
+        for (auto it = shard->Queries.Begin(); it != shard->Queries.End(); ++it) {
+            const auto& entry = it.Value();
+            if (!entry.Text.empty()) {
+                candidates.emplace_back(entry.Registrations, TQueryInfo{it.Key(), entry.Text});
+            }
+        }
+    }
+
+    limit = std::min(limit, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + limit, candidates.end(),
+        [](const auto& lhs, const auto& rhs) {
+            return lhs.first > rhs.first;
+        });
+
+    std::vector<TQueryInfo> result;
+    result.reserve(limit);
+    for (size_t i = 0; i < limit; ++i) {
+        result.emplace_back(std::move(candidates[i].second));
+    }
+    return result;
+}
+
+ui64 TQueryRegistry::GetGeneration() const {
+    return Generation_.load(std::memory_order_relaxed);
+}
+
+size_t TQueryRegistry::Size() const {
+    size_t size = 0;
+    for (const auto& shard : QueryShards_) {
+        std::lock_guard guard(shard->Lock);
+        size += shard->Queries.Size();
+    }
+    return size;
+}
+
+} // namespace NSessionPool
+} // namespace NYdb
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <library/cpp/cache/cache.h>
+
+#include <util/system/types.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace NYdb {
+namespace NSessionPool {
+
+// Client wide registry of queries compiled on pooled sessions.
+// Query is identified by the same key as in the session query cache (text or text hash).
+// For each query registry knows set of sessions which have this query prepared,
+// so session pool can prefer such sessions and idle sessions can be warmed up
+// with the most used queries in background.
+// Registry is sharded by query key and by session id to reduce lock contention.
+class TQueryRegistry {
+public:
+    struct TQueryInfo {
+        std::string Key;
+        std::string Text;
+    };
+
+    explicit TQueryRegistry(size_t maxQueries);
+
+    // Remembers that query is prepared on given session.
+    // Text is optional, query without known text can't be used to warm up sessions.
+    void Register(const std::string& key, const std::optional<std::string>& text, const std::string& sessionId);
+    // Forgets that query is prepared on given session
+    void Unregister(const std::string& key, const std::string& sessionId);
+    // Forgets all queries prepared on given session, must be called when session is deleted
+    void ForgetSession(const std::string& sessionId);
+
+    bool IsPrepared(const std::string& key, const std::string& sessionId) const;
+    size_t GetSessionCount(const std::string& key) const;
+
+    // Returns up to limit queries with known text ordered by number of times they have been
+    // prepared on any session, sessions deleted since then are counted as well
+    std::vector<TQueryInfo> GetHotQueries(size_t limit) const;
+
+    // Changes each time new query with known text is added to registry.
+    // Sessions may compare it with generation of the last warm up to skip useless work.
+    ui64 GetGeneration() const;
+
+    size_t Size() const;
+
+private:
+    static constexpr size_t ShardCount = 16;
+
+    struct TQueryEntry {
+        std::string Text;
+        std::unordered_set<std::string> Sessions;
+        // Total number of registrations, never decreases
+        ui64 Registrations = 0;
+    };
+
+    struct TQueryShard {
+        explicit TQueryShard(size_t maxSize)
+            : Queries(maxSize)
+        {}
+
+        mutable std::mutex Lock;
+        TLRUCache<std::string, TQueryEntry> Queries;
+    };
+
+    struct TSessionShard {
+        mutable std::mutex Lock;
+        std::unordered_map<std::string, std::unordered_set<std::string>> Queries;
+    };
+
+    static size_t GetShardIndex(const std::string& key);
+    TQueryShard& GetQueryShard(const std::string& key);
+    const TQueryShard& GetQueryShard(const std::string& key) const;
+    TSessionShard& GetSessionShard(const std::string& sessionId);
+
+    void UnregisterUnsafe(TQueryShard& shard, const std::string& key, const std::string& sessionId);
+
+    std::vector<std::unique_ptr<TQueryShard>> QueryShards_;
+    std::array<TSessionShard, ShardCount> SessionShards_;
+    std::atomic<ui64> Generation_ = 0;
+};
+
+} // namespace NSessionPool
+} // namespace NYdb
@@ -61,31 +61,33 @@ TSessionPool::TWaitersQueue::TWaitersQueue(ui32 maxQueueSize, TDuration maxWaitS
 
 bool TSessionPool::TWaitersQueue::TryPush(std::unique_ptr<IGetSessionCtx>& p) {
     if (Waiters_.size() < MaxQueueSize_) {
-        Waiters_.insert(std::make_pair(TInstant::Now(), std::move(p)));
+        Waiters_.emplace_back(TInstant::Now(), std::move(p));
         return true;
     }
     return false;
 }
 
-std::unique_ptr<IGetSessionCtx> TSessionPool::TWaitersQueue::TryGet() {
+std::unique_ptr<IGetSessionCtx> TSessionPool::TWaitersQueue::TryGet(TDuration* waitTime) {
     if (Waiters_.empty()) {
         return {};
     }
-    auto it = Waiters_.begin();
-    auto result = std::move(it->second);
-    Waiters_.erase(it);
+    if (waitTime) {
+        *waitTime = TInstant::Now() - Waiters_.front().first;
+    }
+    auto result = std::move(Waiters_.front().second);
+    Waiters_.pop_front();
     return result;
 }
 
 void TSessionPool::TWaitersQueue::GetOld(TInstant now, std::vector<std::unique_ptr<IGetSessionCtx>>& oldWaiters) {
-    auto it = Waiters_.begin();
-    while (it != Waiters_.end()) {
-        if (now < it->first + MaxWaitSessionTimeout_)
+    while (!Waiters_.empty()) {
+        auto& front = Waiters_.front();
+        if (now < front.first + MaxWaitSessionTimeout_)
             break;
 
-        oldWaiters.emplace_back(std::move(it->second));
+        oldWaiters.emplace_back(std::move(front.second));
 
-        Waiters_.erase(it++);
+        Waiters_.pop_front();
     }
 }
 
@@ -99,6 +101,7 @@ TSessionPool::TSessionPool(ui32 maxActiveSessions)
     , WaitersQueue_(maxActiveSessions * 10)
     , ActiveSessions_(0)
     , MaxActiveSessions_(maxActiveSessions)
+    , PeriodicActionsInFlight_(std::make_shared<std::atomic<i64>>(0))
 {}
 
 static void CloseAndDeleteSession(std::unique_ptr<TKqpSessionCommon>&& impl,
@@ -120,7 +123,7 @@ void TSessionPool::ReplySessionToUser(
     ctx->ReplySessionToUser(session);
 }
 
-void TSessionPool::GetSession(std::unique_ptr<IGetSessionCtx> ctx)
+void TSessionPool::GetSession(std::unique_ptr<IGetSessionCtx> ctx, const TSessionPreference& preference)
 {
     std::unique_ptr<TKqpSessionCommon> sessionImpl;
     enum class TSessionSource {
@@ -141,6 +144,15 @@ void TSessionPool::GetSession(std::unique_ptr<IGetSessionCtx> ctx)
         }
         if (!Sessions_.empty()) {
             auto it = std::prev(Sessions_.end());
+            if (preference) {
+                auto candidate = Sessions_.rbegin();
+                for (ui64 i = 0; candidate != Sessions_.rend() && i < PREFERRED_SESSION_SCAN_LIMIT; ++candidate, ++i) {
+                    if (preference(candidate->second.get())) {
+                        it = std::prev(candidate.base());
+                        break;
+                    }
+                }
+            }
             sessionImpl = std::move(it->second);
             Sessions_.erase(it);
         }
@@ -162,17 +174,19 @@ void TSessionPool::GetSession(std::unique_ptr<IGetSessionCtx> ctx)
 
 bool TSessionPool::CheckAndFeedWaiterNewSession(bool active) {
     std::unique_ptr<IGetSessionCtx> getSessionCtx;
+    TDuration waitTime;
     {
         std::lock_guard guard(Mtx_);
         if (Closed_)
             return false;
 
-        if (auto maybeCtx = WaitersQueue_.TryGet()) {
+        if (auto maybeCtx = WaitersQueue_.TryGet(&waitTime)) {
             getSessionCtx = std::move(maybeCtx);
         } else {
             return false;
         }
     }
+    SessionWaitLatency_.Record(waitTime.MicroSeconds());
 
     if (!active) {
         // Session was IDLE. It means session has been closed during
@@ -196,12 +210,13 @@ bool TSessionPool::CheckAndFeedWaiterNewSession(bool active) {
 bool TSessionPool::ReturnSession(TKqpSessionCommon* impl, bool active) {
     // Do not call ReplySessionToUser under the session pool lock
     std::unique_ptr<IGetSessionCtx> getSessionCtx;
+    TDuration waitTime;
     {
         std::lock_guard guard(Mtx_);
         if (Closed_)
             return false;
 
-        if (auto maybeCtx = WaitersQueue_.TryGet()) {
+        if (auto maybeCtx = WaitersQueue_.TryGet(&waitTime)) {
             getSessionCtx = std::move(maybeCtx);
             if (!active)
                 IncrementActiveCounterUnsafe();
@@ -220,6 +235,7 @@ bool TSessionPool::ReturnSession(TKqpSessionCommon* impl, bool active) {
     }
 
     if (getSessionCtx) {
+        SessionWaitLatency_.Record(waitTime.MicroSeconds());
         ReplySessionToUser(impl, std::move(getSessionCtx));
     }
 
@@ -235,6 +251,7 @@ void TSessionPool::DecrementActiveCounter() {
 
 void TSessionPool::IncrementActiveCounterUnsafe() {
     ActiveSessions_++;
+    PeakActiveSessions_ = Max(PeakActiveSessions_, ActiveSessions_);
     UpdateStats();
 }
 
@@ -250,10 +267,31 @@ void TSessionPool::Drain(std::function<bool(std::unique_ptr<TKqpSessionCommon>&&
     UpdateStats();
 }
 
+size_t TSessionPool::GetBatchSize(size_t sessionsCount, const TPeriodicTaskSettings& settings) {
+    size_t batchSize = PERIODIC_ACTION_BATCH_SIZE;
+    if (settings.KeepAliveInterval) {
+        // Each session should be handled within KeepAliveInterval, take twice more to catch up after bursts
+        const ui64 actions = Max<ui64>(1, settings.KeepAliveInterval.GetValue() / PERIODIC_ACTION_INTERVAL.GetValue());
+        batchSize = Max<size_t>(batchSize, 2 * (sessionsCount + actions - 1) / actions);
+    }
+    return batchSize;
+}
+
+ui64 TSessionPool::UpdateDemandEstimateUnsafe() {
+    const ui64 decayed = DemandEstimate_ - (DemandEstimate_ + DEMAND_ESTIMATE_DECAY - 1) / DEMAND_ESTIMATE_DECAY;
+    DemandEstimate_ = Max<ui64>(decayed, PeakActiveSessions_);
+    PeakActiveSessions_ = ActiveSessions_;
+
+    return MaxActiveSessions_ ? Min<ui64>(DemandEstimate_, MaxActiveSessions_) : DemandEstimate_;
+}
+
 TPeriodicCb TSessionPool::CreatePeriodicTask(std::weak_ptr<ISessionClient> weakClient,
-    TKeepAliveCmd&& cmd, TDeletePredicate&& deletePredicate)
+    TKeepAliveCmd&& cmd, TDeletePredicate&& deletePredicate, TWarmUpPredicate&& warmUpPredicate,
+    TCreateSessionCmd&& createSessionCmd, const TPeriodicTaskSettings& settings)
 {
-    auto periodicCb = [this, weakClient, cmd=std::move(cmd), deletePredicate=std::move(deletePredicate)](NYql::TIssues&&, EStatus status) {
+    auto periodicCb = [this, weakClient, cmd=std::move(cmd), deletePredicate=std::move(deletePredicate),
+        warmUpPredicate=std::move(warmUpPredicate), createSessionCmd=std::move(createSessionCmd), settings](NYql::TIssues&&, EStatus status)
+    {
         if (status != EStatus::SUCCESS) {
             return false;
         }
@@ -264,30 +302,62 @@ TPeriodicCb TSessionPool::CreatePeriodicTask(std::weak_ptr<ISessionClient> weakC
             // moreover it is unsafe to touch this ptr!
             return false;
         } else {
-            auto keepAliveBatchSize = PERIODIC_ACTION_BATCH_SIZE;
+            // Requests started by previous actions are still running, don't overload the server
+            const i64 inFlight = PeriodicActionsInFlight_->load(std::memory_order_relaxed);
+            size_t inFlightBudget = settings.MaxInFlight > inFlight ? settings.MaxInFlight - inFlight : 0;
+
             std::vector<std::unique_ptr<TKqpSessionCommon>> sessionsToTouch;
-            sessionsToTouch.reserve(keepAliveBatchSize);
             std::vector<std::unique_ptr<TKqpSessionCommon>> sessionsToDelete;
-            sessionsToDelete.reserve(keepAliveBatchSize);
             std::vector<std::unique_ptr<IGetSessionCtx>> waitersToReplyError;
-            waitersToReplyError.reserve(keepAliveBatchSize);
+            size_t sessionsToCreate = 0;
             const auto now = TInstant::Now();
             {
                 std::lock_guard guard(Mtx_);
                 {
                     auto& sessions = Sessions_;
+                    const ui64 demand = UpdateDemandEstimateUnsafe();
+                    ui64 targetPoolSize = Max<ui64>(settings.MinPoolSize, demand);
+                    if (MaxActiveSessions_) {
+                        targetPoolSize = Min<ui64>(targetPoolSize, MaxActiveSessions_);
+                    }
+                    const ui64 refillPoolSize = settings.KeepMinPoolSizeWarm ? targetPoolSize : demand;
+                    // Sessions which are in flight are out of the pool but still alive
+                    ui64 poolSize = sessions.size() + ActiveSessions_ + inFlight;
+                    auto batchSize = Min(GetBatchSize(sessions.size(), settings), inFlightBudget);
+                    sessionsToTouch.reserve(batchSize);
 
                     auto it = sessions.begin();
-                    while (it != sessions.end() && keepAliveBatchSize--) {
+                    while (it != sessions.end() && batchSize) {
                         if (now < it->second->GetTimeToTouchFast())
                             break;
 
-                        if (deletePredicate(it->second.get(), sessions.size())) {
+                        if (poolSize > targetPoolSize && deletePredicate(it->second.get(), sessions.size())) {
                             sessionsToDelete.emplace_back(std::move(it->second));
+                            poolSize--;
                         } else {
                             sessionsToTouch.emplace_back(std::move(it->second));
+                            inFlightBudget--;
                         }
                         sessions.erase(it++);
+                        batchSize--;
+                    }
+
+                    // Sessions which are not due to touch yet but need warm up
+                    if (warmUpPredicate) {
+                        while (it != sessions.end() && batchSize) {
+                            if (warmUpPredicate(it->second.get())) {
+                                sessionsToTouch.emplace_back(std::move(it->second));
+                                sessions.erase(it++);
+                                inFlightBudget--;
+                                batchSize--;
+                            } else {
+                                ++it;
+                            }
+                        }
+                    }
+
+                    if (createSessionCmd && !Closed_ && poolSize < refillPoolSize) {
+                        sessionsToCreate = Min<ui64>(refillPoolSize - poolSize, inFlightBudget);
                     }
                 }
 
@@ -299,7 +369,7 @@ TPeriodicCb TSessionPool::CreatePeriodicTask(std::weak_ptr<ISessionClient> weakC
             for (auto& sessionImpl : sessionsToTouch) {
                 if (sessionImpl) {
                     Y_ABORT_UNLESS(sessionImpl->GetState() == TKqpSessionCommon::S_IDLE);
-                    cmd(sessionImpl.release());
+                    cmd(sessionImpl.release(), std::make_shared<TInFlightGuard>(PeriodicActionsInFlight_));
                 }
             }
 
@@ -310,6 +380,10 @@ TPeriodicCb TSessionPool::CreatePeriodicTask(std::weak_ptr<ISessionClient> weakC
                 }
             }
 
+            for (size_t i = 0; i < sessionsToCreate; ++i) {
+                createSessionCmd(std::make_shared<TInFlightGuard>(PeriodicActionsInFlight_));
+            }
+
             for (auto& waiter : waitersToReplyError) {
                 FakeSessionsCounter_.Inc();
                 waiter->ReplyError(CLIENT_RESOURCE_EXHAUSTED_ACTIVE_SESSION_LIMIT);
@@ -340,6 +414,7 @@ void TSessionPool::SetStatCollector(NSdkStats::TStatCollector::TSessionPoolStatC
     InPoolSessionsCounter_.Set(statCollector.InPoolSessions);
     FakeSessionsCounter_.Set(statCollector.FakeSessions);
     SessionWaiterCounter_.Set(statCollector.Waiters);
+    SessionWaitLatency_.Set(statCollector.WaitLatency);
 }
 
 void TSessionPool::UpdateStats() {
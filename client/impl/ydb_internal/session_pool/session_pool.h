@@ -3,6 +3,9 @@
 #include <client/impl/ydb_internal/kqp_session_common/kqp_session_common.h>
 #include <client/ydb_types/core_facility/core_facility.h>
 
+#include <atomic>
+#include <deque>
+
 
 namespace NYdb {
 
@@ -23,6 +26,9 @@ constexpr TDuration PERIODIC_ACTION_INTERVAL = TDuration::Seconds(5);
 constexpr TDuration MAX_WAIT_SESSION_TIMEOUT = TDuration::Seconds(5); //Max time to wait session
 constexpr ui64 PERIODIC_ACTION_BATCH_SIZE = 10; //Max number of tasks to perform during one interval
 constexpr TDuration CREATE_SESSION_INTERNAL_TIMEOUT = TDuration::Seconds(2); //Timeout for createSession call inside session pool
+constexpr ui64 PREFERRED_SESSION_SCAN_LIMIT = 16; //Max number of idle sessions to check for preferred one
+constexpr ui32 MAX_PERIODIC_ACTION_IN_FLIGHT = 64; //Max number of concurrent keep alive and create session requests of periodic task
+constexpr ui64 DEMAND_ESTIMATE_DECAY = 32; //Estimated session demand loses 1/DEMAND_ESTIMATE_DECAY each interval
 
 TStatus GetStatus(const TOperation& operation);
 TStatus GetStatus(const TStatus& status);
@@ -79,6 +85,41 @@ NThreading::TFuture<TResponse> InjectSessionStatusInterception(
     return promise.GetFuture();
 }
 
+// Occupies one slot of the periodic task in flight limit until destroyed.
+// Keep alive and create session commands hold it until their request is finished.
+class TInFlightGuard : private TNonCopyable {
+public:
+    explicit TInFlightGuard(std::shared_ptr<std::atomic<i64>> counter)
+        : Counter_(std::move(counter))
+    {
+        Counter_->fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~TInFlightGuard() {
+        Counter_->fetch_sub(1, std::memory_order_relaxed);
+    }
+
+private:
+    std::shared_ptr<std::atomic<i64>> Counter_;
+};
+
+using TInFlightToken = std::shared_ptr<TInFlightGuard>;
+
+struct TPeriodicTaskSettings {
+    // All idle sessions should be touched within this interval,
+    // number of sessions handled by one periodic action grows with the pool size.
+    // Zero means PERIODIC_ACTION_BATCH_SIZE sessions per action
+    TDuration KeepAliveInterval = TDuration::Zero();
+    // Max number of keep alive and create session requests in flight
+    ui32 MaxInFlight = MAX_PERIODIC_ACTION_IN_FLIGHT;
+    // Idle sessions are not deleted while pool has less than this number of sessions
+    // or the number of recently used sessions if it is greater
+    ui32 MinPoolSize = 0;
+    // Pool creates sessions in background up to MinPoolSize as well,
+    // otherwise only up to the number of recently used sessions
+    bool KeepMinPoolSizeWarm = false;
+};
+
 class TSessionPool {
 private:
     class TWaitersQueue {
@@ -88,22 +129,29 @@ private:
         // returns true and gets ownership if queue size less than limit
         // otherwise returns false and doesn't not touch ctx
         bool TryPush(std::unique_ptr<IGetSessionCtx>& p);
-        std::unique_ptr<IGetSessionCtx> TryGet();
+        // waitTime, if set, receives the time the returned waiter spent in the queue
+        std::unique_ptr<IGetSessionCtx> TryGet(TDuration* waitTime = nullptr);
         void GetOld(TInstant now, std::vector<std::unique_ptr<IGetSessionCtx>>& oldWaiters);
         ui32 Size() const;
 
     private:
         const ui32 MaxQueueSize_;
         const TDuration MaxWaitSessionTimeout_;
-        std::multimap<TInstant, std::unique_ptr<IGetSessionCtx>> Waiters_;
+        // All waiters have the same timeout, so the queue is ordered by deadline
+        std::deque<std::pair<TInstant, std::unique_ptr<IGetSessionCtx>>> Waiters_;
     };
 public:
-    using TKeepAliveCmd = std::function<void(TKqpSessionCommon* s)>;
+    using TKeepAliveCmd = std::function<void(TKqpSessionCommon* s, TInFlightToken token)>;
+    using TCreateSessionCmd = std::function<void(TInFlightToken token)>;
     using TDeletePredicate = std::function<bool(TKqpSessionCommon* s, size_t sessionsCount)>;
+    using TWarmUpPredicate = std::function<bool(TKqpSessionCommon* s)>;
+    using TSessionPreference = std::function<bool(const TKqpSessionCommon* s)>;
     TSessionPool(ui32 maxActiveSessions);
 
-    // Extracts session from pool or creates new one ising given ctx
-    void GetSession(std::unique_ptr<IGetSessionCtx> ctx);
+    // Extracts session from pool or creates new one ising given ctx.
+    // If preference is set, the most recently used of first PREFERRED_SESSION_SCAN_LIMIT
+    // idle sessions matching it is used.
+    void GetSession(std::unique_ptr<IGetSessionCtx> ctx, const TSessionPreference& preference = {});
 
     // Returns true if session returned to pool successfully
     bool ReturnSession(TKqpSessionCommon* impl, bool active);
@@ -112,7 +160,14 @@ public:
     // too feed it
     bool CheckAndFeedWaiterNewSession(bool active);
 
-    TPeriodicCb CreatePeriodicTask(std::weak_ptr<ISessionClient> weakClient, TKeepAliveCmd&& cmd, TDeletePredicate&& predicate);
+    // Idle sessions which are not yet due to keep alive but match warmUpPredicate
+    // are passed to cmd as well (within the same batch limit).
+    // If createSessionCmd is set, it is used to create sessions in background up to the
+    // estimated demand (recent peak of active sessions), or up to MinPoolSize if it is greater
+    // and KeepMinPoolSizeWarm is set. Idle sessions within the estimated demand are not deleted.
+    TPeriodicCb CreatePeriodicTask(std::weak_ptr<ISessionClient> weakClient, TKeepAliveCmd&& cmd, TDeletePredicate&& predicate,
+        TWarmUpPredicate&& warmUpPredicate = {}, TCreateSessionCmd&& createSessionCmd = {},
+        const TPeriodicTaskSettings& settings = {});
     i64 GetActiveSessions() const;
     i64 GetActiveSessionsLimit() const;
     i64 GetCurrentPoolSize() const;
@@ -124,6 +179,9 @@ public:
 
 private:
     void UpdateStats();
+    // Returns estimated demand limited by MaxActiveSessions
+    ui64 UpdateDemandEstimateUnsafe();
+    static size_t GetBatchSize(size_t sessionsCount, const TPeriodicTaskSettings& settings);
     static void ReplySessionToUser(TKqpSessionCommon* session, std::unique_ptr<IGetSessionCtx> ctx);
 
     mutable std::mutex Mtx_;
@@ -134,9 +192,14 @@ private:
 
     i64 ActiveSessions_;
     const ui32 MaxActiveSessions_;
+    // Max number of active sessions since the last periodic action
+    i64 PeakActiveSessions_ = 0;
+    ui64 DemandEstimate_ = 0;
+    std::shared_ptr<std::atomic<i64>> PeriodicActionsInFlight_;
     NSdkStats::TSessionCounter ActiveSessionsCounter_;
     NSdkStats::TSessionCounter InPoolSessionsCounter_;
     NSdkStats::TSessionCounter SessionWaiterCounter_;
+    NSdkStats::TAtomicHistogram<::NMonitoring::THistogram> SessionWaitLatency_;
     NSdkStats::TAtomicCounter<::NMonitoring::TRate> FakeSessionsCounter_;
 };
 
@@ -1,2 +1,23 @@
 #define INCLUDE_YDB_INTERNAL_H
 #include "pool.h"
+
+#include <library/cpp/threading/work_stealing/pool.h>
+
+namespace NYdb {
+
+std::unique_ptr<IThreadPool> CreateThreadPool(size_t threads, const TThreadPoolSettings& settings) {
+    const auto params = TThreadPool::TParams().SetBlocking(true).SetCatching(false);
+    std::unique_ptr<IThreadPool> queue;
+    if (!threads) {
+        queue.reset(new TAdaptiveThreadPool());
+    } else if (settings.WorkStealing_) {
+        queue.reset(new NThreading::TWorkStealingThreadPool(params, NThreading::TWorkStealingThreadPoolParams()
+            .SetSpinIterations(settings.SpinIterations_)
+            .SetPinThreads(settings.PinThreads_)));
+    } else {
+        queue.reset(new TThreadPool(params));
+    }
+    return queue;
+}
+
+} // namespace NYdb
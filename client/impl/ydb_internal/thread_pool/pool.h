@@ -2,20 +2,14 @@
 
 #include <client/impl/ydb_internal/internal_header.h>
 
+#include <client/ydb_types/thread_pool_settings.h>
+
 #include <util/thread/pool.h>
 
 #include <memory>
 
 namespace NYdb {
 
-inline std::unique_ptr<IThreadPool> CreateThreadPool(size_t threads) {
-    std::unique_ptr<IThreadPool> queue;
-    if (threads) {
-        queue.reset(new TThreadPool(TThreadPool::TParams().SetBlocking(true).SetCatching(false)));
-    } else {
-        queue.reset(new TAdaptiveThreadPool());
-    }
-    return queue;
-}
+std::unique_ptr<IThreadPool> CreateThreadPool(size_t threads, const TThreadPoolSettings& settings = {});
 
 } // namespace NYdb
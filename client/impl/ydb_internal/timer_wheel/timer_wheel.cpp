@@ -0,0 +1,258 @@
+#include "timer_wheel.h"
+
+#include <util/system/thread.h>
+
+#include <chrono>
+
+namespace NYdb {
+
+TTimerWheel::TTimerWheel(TDuration resolution, TInstant now)
+    : Resolution_(Max(resolution, TDuration::MicroSeconds(1)))
+    , Start_(now)
+{}
+
+TTimerWheel::~TTimerWheel() {
+    Stop();
+}
+
+void TTimerWheel::Start() {
+    std::lock_guard guard(Lock_);
+    if (Thread_ || Stopped_) {
+        return;
+    }
+    Thread_ = SystemThreadFactory()->Run([this] {
+        TThread::SetCurrentThreadName("ydb_timer");
+        Run();
+    });
+}
+
+void TTimerWheel::Stop() {
+    TTimers timers;
+    THolder<IThreadFactory::IThread> thread;
+    {
+        std::lock_guard guard(Lock_);
+        if (Stopped_) {
+            return;
+        }
+        Stopped_ = true;
+        for (ui32 level = 0; level < Levels; ++level) {
+            for (auto& slot : Slots_[level]) {
+                while (!slot.Empty()) {
+                    TTimer* timer = slot.PopFront();
+                    UnlinkUnsafe(timer);
+                    timers.emplace_back(timer);
+                    timer->UnRef();
+                }
+            }
+        }
+        thread = std::move(Thread_);
+    }
+    WakeUp_.notify_all();
+    if (thread) {
+        thread->Join();
+    }
+    Fire(timers, false);
+}
+
+TTimerWheel::TTimerPtr TTimerWheel::Schedule(TDuration timeout, TCallback callback) {
+    return ScheduleAt(TInstant::Now() + timeout, std::move(callback));
+}
+
+TTimerWheel::TTimerPtr TTimerWheel::ScheduleAt(TInstant deadline, TCallback callback) {
+    TTimerPtr timer = MakeIntrusive<TTimer>();
+    timer->Callback = std::move(callback);
+    // Round up, timer must not fire earlier than deadline
+    timer->ExpireTick = deadline > Start_
+        ? ((deadline - Start_).MicroSeconds() + Resolution_.MicroSeconds() - 1) / Resolution_.MicroSeconds()
+        : 0;
+
+    bool scheduled = false;
+    bool wakeUp = false;
+    {
+        std::lock_guard guard(Lock_);
+        if (!Stopped_) {
+            timer->Ref();
+            LinkUnsafe(timer.Get());
+            scheduled = true;
+            wakeUp = timer->ExpireTick < NextWakeUpTick_;
+        }
+    }
+
+    if (!scheduled) {
+        auto cb = std::move(timer->Callback);
+        cb(false);
+        return nullptr;
+    }
+
+    if (wakeUp) {
+        WakeUp_.notify_one();
+    }
+    return timer;
+}
+
+bool TTimerWheel::Cancel(const TTimerPtr& timer) {
+    if (!timer) {
+        return false;
+    }
+
+    TCallback callback;
+    {
+        std::lock_guard guard(Lock_);
+        if (!timer->Scheduled) {
+            return false;
+        }
+        timer->Unlink();
+        UnlinkUnsafe(timer.Get());
+        callback = std::move(timer->Callback);
+    }
+    timer->UnRef();
+
+    callback(false);
+    return true;
+}
+
+void TTimerWheel::Advance(TInstant now) {
+    TTimers fired;
+    {
+        std::lock_guard guard(Lock_);
+        AdvanceUnsafe(ToTick(now), fired);
+    }
+    Fire(fired, true);
+}
+
+size_t TTimerWheel::Size() const {
+    std::lock_guard guard(Lock_);
+    return Size_;
+}
+
+ui64 TTimerWheel::ToTick(TInstant time) const {
+    return time > Start_ ? (time - Start_).MicroSeconds() / Resolution_.MicroSeconds() : 0;
+}
+
+TInstant TTimerWheel::FromTick(ui64 tick) const {
+    return Start_ + TDuration::MicroSeconds(tick * Resolution_.MicroSeconds());
+}
+
+void TTimerWheel::LinkUnsafe(TTimer* timer) {
+    ui64 expire = timer->ExpireTick;
+    ui64 delta = expire > CurrentTick_ ? expire - CurrentTick_ : 0;
+    if (delta > MaxTimeout) {
+        delta = MaxTimeout;
+        expire = CurrentTick_ + MaxTimeout;
+    }
+
+    ui32 level = 0;
+    while (level + 1 < Levels && delta >= (1ull << (LevelBits * (level + 1)))) {
+        ++level;
+    }
+    // Overdue timers are placed to the current slot and fire on the next tick
+    const ui64 slotTick = delta ? expire : CurrentTick_;
+    const ui32 index = (slotTick >> (LevelBits * level)) & (SlotsPerLevel - 1);
+
+    Slots_[level][index].PushBack(timer);
+    timer->Level = level;
+    timer->Scheduled = true;
+    ++LevelSizes_[level];
+    ++Size_;
+}
+
+void TTimerWheel::UnlinkUnsafe(TTimer* timer) {
+    timer->Scheduled = false;
+    --LevelSizes_[timer->Level];
+    --Size_;
+}
+
+ui32 TTimerWheel::CascadeUnsafe(ui32 level) {
+    const ui32 index = (CurrentTick_ >> (LevelBits * level)) & (SlotsPerLevel - 1);
+    TSlot slot;
+    slot.Swap(Slots_[level][index]);
+    while (!slot.Empty()) {
+        TTimer* timer = slot.PopFront();
+        UnlinkUnsafe(timer);
+        LinkUnsafe(timer);
+    }
+    return index;
+}
+
+void TTimerWheel::AdvanceUnsafe(ui64 tick, TTimers& fired) {
+    while (CurrentTick_ <= tick) {
+        if (!Size_) {
+            CurrentTick_ = tick + 1;
+            break;
+        }
+
+        const ui32 index = CurrentTick_ & (SlotsPerLevel - 1);
+        if (index == 0) {
+            for (ui32 level = 1; level < Levels && CascadeUnsafe(level) == 0; ++level) {
+            }
+        }
+
+        auto& slot = Slots_[0][index];
+        while (!slot.Empty()) {
+            TTimer* timer = slot.PopFront();
+            UnlinkUnsafe(timer);
+            fired.emplace_back(timer);
+            timer->UnRef();
+        }
+        ++CurrentTick_;
+
+        if (!LevelSizes_[0]) {
+            // Nothing can fire until the next cascade
+            const ui64 nextCascade = (CurrentTick_ + SlotsPerLevel - 1) & ~ui64(SlotsPerLevel - 1);
+            CurrentTick_ = Min(nextCascade, tick + 1);
+        }
+    }
+}
+
+ui64 TTimerWheel::GetNextTickUnsafe() const {
+    if (!Size_) {
+        return Max<ui64>();
+    }
+    if (LevelSizes_[0]) {
+        for (ui32 offset = 0; offset < SlotsPerLevel; ++offset) {
+            if (!Slots_[0][(CurrentTick_ + offset) & (SlotsPerLevel - 1)].Empty()) {
+                return CurrentTick_ + offset;
+            }
+        }
+    }
+    return (CurrentTick_ + SlotsPerLevel - 1) & ~ui64(SlotsPerLevel - 1);
+}
+
+void TTimerWheel::Fire(TTimers& timers, bool ok) {
+    for (auto& timer : timers) {
+        auto callback = std::move(timer->Callback);
+        if (callback) {
+            callback(ok);
+        }
+    }
+    timers.clear();
+}
+
+void TTimerWheel::Run() {
+    std::unique_lock lock(Lock_);
+    while (!Stopped_) {
+        TTimers fired;
+        AdvanceUnsafe(ToTick(TInstant::Now()), fired);
+        if (!fired.empty()) {
+            lock.unlock();
+            Fire(fired, true);
+            lock.lock();
+            continue;
+        }
+
+        NextWakeUpTick_ = GetNextTickUnsafe();
+        if (NextWakeUpTick_ == Max<ui64>()) {
+            WakeUp_.wait(lock);
+        } else {
+            const auto now = TInstant::Now();
+            const auto wakeUpTime = FromTick(NextWakeUpTick_);
+            if (wakeUpTime > now) {
+                WakeUp_.wait_for(lock, std::chrono::microseconds((wakeUpTime - now).MicroSeconds()));
+            }
+        }
+        // Timers scheduled while the thread is awake are checked before the next sleep
+        NextWakeUpTick_ = 0;
+    }
+}
+
+} // namespace NYdb
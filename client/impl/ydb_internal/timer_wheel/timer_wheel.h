@@ -0,0 +1,101 @@
+#pragma once
+
+#include <util/datetime/base.h>
+#include <util/generic/intrlist.h>
+#include <util/generic/ptr.h>
+#include <util/thread/factory.h>
+
+#include <array>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace NYdb {
+
+constexpr TDuration DEFAULT_TIMER_WHEEL_RESOLUTION = TDuration::MilliSeconds(1);
+
+// Hierarchical timer wheel (see Varghese & Lauck, "Hashed and hierarchical timing wheels").
+// Timers are kept in intrusive lists of slots, so both schedule and cancel are O(1).
+// Level 0 has one slot per tick, each next level has slots which are SlotsPerLevel times wider,
+// timers are moved (cascaded) to the lower level when the wheel turns over.
+// Timeouts longer than the wheel range are clamped and cascaded again until they are due.
+// All timers due at the same moment are fired in one batch outside of the lock.
+class TTimerWheel {
+public:
+    // Callback gets true if timer fired and false if it was cancelled or wheel was stopped
+    using TCallback = std::function<void(bool)>;
+
+    class TTimer
+        : public TThrRefBase
+        , public TIntrusiveListItem<TTimer>
+    {
+        friend class TTimerWheel;
+
+        ui64 ExpireTick = 0;
+        ui32 Level = 0;
+        bool Scheduled = false;
+        TCallback Callback;
+    };
+
+    using TTimerPtr = TIntrusivePtr<TTimer>;
+
+    explicit TTimerWheel(TDuration resolution = DEFAULT_TIMER_WHEEL_RESOLUTION, TInstant now = TInstant::Now());
+    ~TTimerWheel();
+
+    // Starts thread which turns the wheel. Without it timers are fired only by Advance calls
+    void Start();
+    // Fires all pending timers with false and stops the thread
+    void Stop();
+
+    // Returns nullptr and calls callback with false if wheel is stopped
+    TTimerPtr Schedule(TDuration timeout, TCallback callback);
+    TTimerPtr ScheduleAt(TInstant deadline, TCallback callback);
+
+    // Returns true and calls callback with false if timer was pending,
+    // returns false if timer has been already fired or cancelled
+    bool Cancel(const TTimerPtr& timer);
+
+    // Fires all timers due at given moment
+    void Advance(TInstant now);
+
+    size_t Size() const;
+
+private:
+    static constexpr ui32 LevelBits = 6;
+    static constexpr ui32 SlotsPerLevel = 1 << LevelBits;
+    static constexpr ui32 Levels = 4;
+    static constexpr ui64 MaxTimeout = (1ull << (LevelBits * Levels)) - 1;
+
+    using TSlot = TIntrusiveList<TTimer>;
+    using TTimers = std::vector<TTimerPtr>;
+
+    ui64 ToTick(TInstant time) const;
+    TInstant FromTick(ui64 tick) const;
+
+    void LinkUnsafe(TTimer* timer);
+    void UnlinkUnsafe(TTimer* timer);
+    ui32 CascadeUnsafe(ui32 level);
+    void AdvanceUnsafe(ui64 tick, TTimers& fired);
+    ui64 GetNextTickUnsafe() const;
+    static void Fire(TTimers& timers, bool ok);
+
+    void Run();
+
+private:
+    const TDuration Resolution_;
+    const TInstant Start_;
+
+    mutable std::mutex Lock_;
+    std::condition_variable WakeUp_;
+    std::array<std::array<TSlot, SlotsPerLevel>, Levels> Slots_;
+    std::array<size_t, Levels> LevelSizes_ = {};
+    size_t Size_ = 0;
+    ui64 CurrentTick_ = 0;
+    ui64 NextWakeUpTick_ = Max<ui64>();
+    bool Stopped_ = false;
+
+    THolder<IThreadFactory::IThread> Thread_;
+};
+
+} // namespace NYdb
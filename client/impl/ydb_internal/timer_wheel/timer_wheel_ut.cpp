@@ -0,0 +1,90 @@
+#include <client/impl/ydb_internal/timer_wheel/timer_wheel.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+#include <library/cpp/threading/future/core/future.h>
+
+#include <vector>
+
+using namespace NYdb;
+
+Y_UNIT_TEST_SUITE(TimerWheelTest) {
+    Y_UNIT_TEST(FireInOrder) {
+        const TInstant start = TInstant::Seconds(1000);
+        TTimerWheel wheel(TDuration::MilliSeconds(1), start);
+
+        // Delays cover all levels of the wheel and timeouts longer than the wheel range
+        const std::vector<ui64> delays = {0, 1, 63, 64, 65, 4095, 4096, 5000, 262144, 300000, 16777216, 40000000};
+        std::vector<size_t> fired;
+        for (size_t i = 0; i < delays.size(); ++i) {
+            wheel.ScheduleAt(start + TDuration::MilliSeconds(delays[i]), [&fired, i](bool ok) {
+                UNIT_ASSERT(ok);
+                fired.push_back(i);
+            });
+        }
+        UNIT_ASSERT_VALUES_EQUAL(wheel.Size(), delays.size());
+
+        for (size_t i = 0; i < delays.size(); ++i) {
+            if (delays[i]) {
+                wheel.Advance(start + TDuration::MilliSeconds(delays[i] - 1));
+                UNIT_ASSERT_VALUES_EQUAL(fired.size(), i);
+            }
+            wheel.Advance(start + TDuration::MilliSeconds(delays[i]));
+            UNIT_ASSERT_VALUES_EQUAL(fired.size(), i + 1);
+            UNIT_ASSERT_VALUES_EQUAL(fired.back(), i);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(wheel.Size(), 0);
+    }
+
+    Y_UNIT_TEST(Cancel) {
+        const TInstant start = TInstant::Seconds(1000);
+        TTimerWheel wheel(TDuration::MilliSeconds(1), start);
+
+        int cancelled = 0;
+        auto timer = wheel.ScheduleAt(start + TDuration::Seconds(10), [&cancelled](bool ok) {
+            UNIT_ASSERT(!ok);
+            ++cancelled;
+        });
+        UNIT_ASSERT(wheel.Cancel(timer));
+        UNIT_ASSERT(!wheel.Cancel(timer));
+        UNIT_ASSERT_VALUES_EQUAL(cancelled, 1);
+        UNIT_ASSERT_VALUES_EQUAL(wheel.Size(), 0);
+
+        wheel.Advance(start + TDuration::Seconds(20));
+        UNIT_ASSERT_VALUES_EQUAL(cancelled, 1);
+    }
+
+    Y_UNIT_TEST(Stop) {
+        TTimerWheel wheel;
+        wheel.Start();
+
+        int stopped = 0;
+        wheel.Schedule(TDuration::Hours(1), [&stopped](bool ok) {
+            if (!ok) {
+                ++stopped;
+            }
+        });
+        wheel.Stop();
+        UNIT_ASSERT_VALUES_EQUAL(stopped, 1);
+
+        UNIT_ASSERT(!wheel.Schedule(TDuration::Zero(), [&stopped](bool ok) {
+            if (!ok) {
+                ++stopped;
+            }
+        }));
+        UNIT_ASSERT_VALUES_EQUAL(stopped, 2);
+    }
+
+    Y_UNIT_TEST(Thread) {
+        TTimerWheel wheel;
+        wheel.Start();
+
+        auto promise = NThreading::NewPromise<bool>();
+        const TInstant start = TInstant::Now();
+        wheel.Schedule(TDuration::MilliSeconds(100), [promise](bool ok) mutable {
+            promise.SetValue(ok);
+        });
+
+        UNIT_ASSERT(promise.GetFuture().GetValueSync());
+        UNIT_ASSERT(TInstant::Now() - start >= TDuration::MilliSeconds(100));
+    }
+}
@@ -11,6 +11,56 @@ const NMonitoring::TLabel SESSIONS_ON_KQP_HOST_LABEL = NMonitoring::TLabel {"sen
 const NMonitoring::TLabel TRANSPORT_ERRORS_BY_HOST_LABEL = NMonitoring::TLabel {"sensor", "TransportErrorsByYdbHost"};
 const NMonitoring::TLabel GRPC_INFLIGHT_BY_HOST_LABEL = NMonitoring::TLabel {"sensor", "Grpc/InFlightByYdbHost"};
 
+TDuration TRequestPhaseTimer::Get(ERequestPhase phase) const {
+    const double cycles = Cycles_[static_cast<size_t>(phase)];
+    return TDuration::MicroSeconds(static_cast<ui64>(cycles * 1000000 / NHPTimer::GetClockRate()));
+}
+
+TRequestTimings TRequestPhaseTimer::GetTimings() const {
+    TRequestTimings timings;
+    timings.EndpointWait = Get(ERequestPhase::EndpointWait);
+    timings.Credentials = Get(ERequestPhase::Credentials);
+    timings.Grpc = Get(ERequestPhase::Grpc);
+    timings.ResponseQueue = Get(ERequestPhase::ResponseQueue);
+    return timings;
+}
+
+static const std::array<std::string, static_cast<size_t>(ERequestPhase::COUNT)> REQUEST_PHASE_SENSORS = {
+    "Request/Phase/EndpointWait",
+    "Request/Phase/Credentials",
+    "Request/Phase/Grpc",
+    "Request/Phase/ResponseQueue",
+    "Request/Phase/Callback",
+};
+
+TStatCollector::TRequestPhaseHistograms TStatCollector::GetRequestPhaseHistograms(TMetricRegistry* registry, const string& method) {
+    {
+        std::shared_lock guard(RequestPhasesLock_);
+        auto it = RequestPhases_.find(method);
+        if (it != RequestPhases_.end()) {
+            return it->second;
+        }
+    }
+
+    TRequestPhaseHistograms histograms;
+    for (size_t i = 0; i < histograms.size(); ++i) {
+        histograms[i] = registry->HistogramRate({ DatabaseLabel_, {"sensor", REQUEST_PHASE_SENSORS[i]}, {"method", method} },
+            LatencyHistogram());
+    }
+
+    std::unique_lock guard(RequestPhasesLock_);
+    return RequestPhases_.emplace(method, histograms).first->second;
+}
+
+void TStatCollector::RecordRequestPhases(const string& method, const TRequestPhaseTimer& timer) {
+    if (TMetricRegistry* ptr = MetricRegistryPtr_.Get()) {
+        const auto histograms = GetRequestPhaseHistograms(ptr, method);
+        for (size_t i = 0; i < histograms.size(); ++i) {
+            histograms[i]->Record(timer.Get(static_cast<ERequestPhase>(i)).MicroSeconds());
+        }
+    }
+}
+
 void TStatCollector::IncSessionsOnHost(const string& host) {
     if (TMetricRegistry* ptr = MetricRegistryPtr_.Get()) {
         ptr->IntGauge({ DatabaseLabel_, SESSIONS_ON_KQP_HOST_LABEL, {"YdbHost", host} })->Inc();
@@ -1,13 +1,20 @@
 #pragma once
 
 #include <client/ydb_types/status_codes.h>
+#include <client/ydb_types/status/status.h>
 
 #include <ydb/library/grpc/client/grpc_client_low.h>
 #include <library/cpp/monlib/metrics/metric_registry.h>
 #include <library/cpp/monlib/metrics/histogram_collector.h>
 
+#include <util/system/datetime.h>
+#include <util/system/hp_timer.h>
+
+#include <array>
 #include <atomic>
 #include <memory>
+#include <shared_mutex>
+#include <unordered_map>
 
 namespace NYdb {
 
@@ -69,6 +76,18 @@ private:
     std::atomic<TPointer*> Pointer_;
 };
 
+// Range of latency histograms, buckets with 1/4 relative error don't fit into the buckets limit
+// for a wider one. Faster requests share the first bucket, slower ones the overflow bucket.
+constexpr TDuration LATENCY_HISTOGRAM_LOWEST = TDuration::MicroSeconds(512);
+constexpr TDuration LATENCY_HISTOGRAM_MAX = TDuration::Seconds(4);
+constexpr ui32 LATENCY_HISTOGRAM_PRECISION_BITS = 2;
+
+// Collector for latency histograms in microseconds: log-linear buckets and per-thread recording shards
+inline ::NMonitoring::IHistogramCollectorPtr LatencyHistogram() {
+    return ::NMonitoring::HdrHistogram(LATENCY_HISTOGRAM_MAX.MicroSeconds(), LATENCY_HISTOGRAM_PRECISION_BITS,
+        LATENCY_HISTOGRAM_LOWEST.MicroSeconds());
+}
+
 template<typename TPointer>
 class TAtomicCounter: public TAtomicPointer<TPointer> {
     public:
@@ -132,6 +151,39 @@ public:
     }
 };
 
+// Phases of unary request processing, see TRequestTimings
+enum class ERequestPhase : ui8 {
+    EndpointWait,
+    Credentials,
+    Grpc,
+    ResponseQueue,
+    Callback,
+    COUNT
+};
+
+// Breaks request latency down into phases.
+// Uses TSC timestamps, each Mark() attributes time passed since previous mark to given phase.
+// Marks are made sequentially (possibly from different threads), so no synchronization is needed.
+class TRequestPhaseTimer {
+public:
+    TRequestPhaseTimer()
+        : LastMark_(GetCycleCount())
+    { }
+
+    void Mark(ERequestPhase phase) {
+        const ui64 now = GetCycleCount();
+        Cycles_[static_cast<size_t>(phase)] += now > LastMark_ ? now - LastMark_ : 0;
+        LastMark_ = now;
+    }
+
+    TDuration Get(ERequestPhase phase) const;
+    TRequestTimings GetTimings() const;
+
+private:
+    std::array<ui64, static_cast<size_t>(ERequestPhase::COUNT)> Cycles_ = {};
+    ui64 LastMark_;
+};
+
 // Sessions count for all clients
 // Every client has 3 TSessionCounter for active, in session pool, in settler sessions
 // TSessionCounters in different clients with same role share one sensor
@@ -181,17 +233,21 @@ public:
         TSessionPoolStatCollector(::NMonitoring::TIntGauge* activeSessions = nullptr
         , ::NMonitoring::TIntGauge* inPoolSessions = nullptr
         , ::NMonitoring::TRate* fakeSessions = nullptr
-        , ::NMonitoring::TIntGauge* waiters = nullptr)
+        , ::NMonitoring::TIntGauge* waiters = nullptr
+        , ::NMonitoring::THistogram* waitLatency = nullptr)
         : ActiveSessions(activeSessions)
         , InPoolSessions(inPoolSessions)
         , FakeSessions(fakeSessions)
         , Waiters(waiters)
+        , WaitLatency(waitLatency)
         { }
 
         ::NMonitoring::TIntGauge* ActiveSessions;
         ::NMonitoring::TIntGauge* InPoolSessions;
         ::NMonitoring::TRate* FakeSessions;
         ::NMonitoring::TIntGauge* Waiters;
+        // Time spent by GetSession in the waiters queue, in microseconds
+        ::NMonitoring::THistogram* WaitLatency;
     };
 
     struct TClientRetryOperationStatCollector {
@@ -275,14 +331,23 @@ public:
         FakeSessions_.Set(sensorsRegistry->Rate({ DatabaseLabel_,                   {"sensor", "Sessions/SessionsLimitExceeded"} }));
         GRpcInFlight_.Set(sensorsRegistry->IntGauge({ DatabaseLabel_,               {"sensor", "Grpc/InFlight"} }));
 
+        // Bounds of the existing sensor are kept as they are, dashboards sum it by bucket
         RequestLatency_.Set(sensorsRegistry->HistogramRate({ DatabaseLabel_, {"sensor", "Request/Latency"} },
             ::NMonitoring::ExponentialHistogram(20, 2, 1)));
+        SessionWaitLatency_.Set(sensorsRegistry->HistogramRate({ DatabaseLabel_, {"sensor", "Sessions/WaitLatency"} },
+            LatencyHistogram()));
         QuerySize_.Set(sensorsRegistry->HistogramRate({ DatabaseLabel_, {"sensor", "Request/QuerySize"} },
             ::NMonitoring::ExponentialHistogram(20, 2, 32)));
         ParamsSize_.Set(sensorsRegistry->HistogramRate({ DatabaseLabel_, {"sensor", "Request/ParamsSize"} },
             ::NMonitoring::ExponentialHistogram(10, 2, 32)));
         ResultSize_.Set(sensorsRegistry->HistogramRate({ DatabaseLabel_, {"sensor", "Request/ResultSize"} },
             ::NMonitoring::ExponentialHistogram(20, 2, 32)));
+
+        // TSC frequency is measured on first use, do it here rather than in response callback
+        NHPTimer::GetClockRate();
+
+        std::unique_lock guard(RequestPhasesLock_);
+        RequestPhases_.clear();
     }
 
     void IncDiscoveryDuePessimization() {
@@ -313,6 +378,9 @@ public:
         RequestLatency_.Record(duration.MilliSeconds());
     }
 
+    // Records per phase latency histograms (in microseconds) of the given rpc method
+    void RecordRequestPhases(const std::string& method, const TRequestPhaseTimer& timer);
+
     void IncResultSize(const size_t& size) {
         ResultSize_.Record(size);
     }
@@ -351,7 +419,8 @@ public:
             return TSessionPoolStatCollector();
         }
 
-        return TSessionPoolStatCollector(ActiveSessions_.Get(), InPoolSessions_.Get(), FakeSessions_.Get(), Waiters_.Get());
+        return TSessionPoolStatCollector(ActiveSessions_.Get(), InPoolSessions_.Get(), FakeSessions_.Get(), Waiters_.Get(),
+            SessionWaitLatency_.Get());
     }
 
     TClientStatCollector GetClientStatCollector() {
@@ -376,6 +445,10 @@ public:
     void IncGRpcInFlightByHost(const std::string& host);
     void DecGRpcInFlightByHost(const std::string& host);
 private:
+    using TRequestPhaseHistograms = std::array<::NMonitoring::THistogram*, static_cast<size_t>(ERequestPhase::COUNT)>;
+
+    TRequestPhaseHistograms GetRequestPhaseHistograms(TMetricRegistry* registry, const std::string& method);
+
     const std::string Database_;
     const ::NMonitoring::TLabel DatabaseLabel_;
     TAtomicPointer<TMetricRegistry> MetricRegistryPtr_;
@@ -395,9 +468,12 @@ private:
     TAtomicCounter<::NMonitoring::TRate> CacheMiss_;
     TAtomicCounter<::NMonitoring::TIntGauge> GRpcInFlight_;
     TAtomicHistogram<::NMonitoring::THistogram> RequestLatency_;
+    TAtomicHistogram<::NMonitoring::THistogram> SessionWaitLatency_;
     TAtomicHistogram<::NMonitoring::THistogram> QuerySize_;
     TAtomicHistogram<::NMonitoring::THistogram> ParamsSize_;
     TAtomicHistogram<::NMonitoring::THistogram> ResultSize_;
+    std::shared_mutex RequestPhasesLock_;
+    std::unordered_map<std::string, TRequestPhaseHistograms> RequestPhases_;
 };
 
 } // namespace NSdkStats
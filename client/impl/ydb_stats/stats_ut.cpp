@@ -0,0 +1,103 @@
+#include <client/impl/ydb_stats/stats.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <util/system/hp_timer.h>
+
+using namespace NYdb;
+using namespace NYdb::NSdkStats;
+
+namespace {
+
+void WaitCycles(TDuration duration) {
+    const ui64 start = GetCycleCount();
+    const ui64 cycles = duration.MicroSeconds() * NHPTimer::GetClockRate() / 1000000;
+    while (GetCycleCount() - start < cycles) {
+    }
+}
+
+ui64 TotalCount(::NMonitoring::THistogram* histogram) {
+    auto snapshot = histogram->TakeSnapshot();
+    ui64 count = 0;
+    for (ui32 i = 0; i < snapshot->Count(); ++i) {
+        count += snapshot->Value(i);
+    }
+    return count;
+}
+
+::NMonitoring::THistogram* PhaseHistogram(::NMonitoring::TMetricRegistry& registry, const std::string& phase,
+    const std::string& method)
+{
+    // Existing histogram is returned as is, the collector is not used then
+    return registry.HistogramRate({ {"database", "/Root/db"}, {"sensor", "Request/Phase/" + phase}, {"method", method} },
+        ::NMonitoring::ExponentialHistogram(2, 2));
+}
+
+} // namespace
+
+Y_UNIT_TEST_SUITE(RequestPhaseTimerTest) {
+    Y_UNIT_TEST(Timings) {
+        TRequestPhaseTimer timer;
+        WaitCycles(TDuration::MilliSeconds(20));
+        timer.Mark(ERequestPhase::EndpointWait);
+        timer.Mark(ERequestPhase::Credentials);
+        WaitCycles(TDuration::MilliSeconds(5));
+        timer.Mark(ERequestPhase::Grpc);
+        WaitCycles(TDuration::MilliSeconds(5));
+        timer.Mark(ERequestPhase::Grpc);
+
+        const auto timings = timer.GetTimings();
+        UNIT_ASSERT_GE(timings.EndpointWait, TDuration::MilliSeconds(20));
+        UNIT_ASSERT_LT(timings.Credentials, TDuration::MilliSeconds(5));
+        // Repeated marks of a phase are summed up
+        UNIT_ASSERT_GE(timings.Grpc, TDuration::MilliSeconds(10));
+        UNIT_ASSERT_LT(timings.Grpc, timings.EndpointWait);
+        UNIT_ASSERT_VALUES_EQUAL(timings.ResponseQueue, TDuration::Zero());
+        UNIT_ASSERT_VALUES_EQUAL(timer.Get(ERequestPhase::Callback), TDuration::Zero());
+    }
+
+    Y_UNIT_TEST(PhaseSensorsByMethod) {
+        ::NMonitoring::TMetricRegistry registry;
+        TStatCollector collector("/Root/db", &registry);
+
+        TRequestPhaseTimer timer;
+        timer.Mark(ERequestPhase::EndpointWait);
+        timer.Mark(ERequestPhase::Grpc);
+        collector.RecordRequestPhases("ExecuteDataQuery", timer);
+        collector.RecordRequestPhases("ExecuteDataQuery", timer);
+        collector.RecordRequestPhases("ReadRows", timer);
+
+        for (const std::string phase : {"EndpointWait", "Credentials", "Grpc", "ResponseQueue", "Callback"}) {
+            UNIT_ASSERT_VALUES_EQUAL_C(TotalCount(PhaseHistogram(registry, phase, "ExecuteDataQuery")), 2, phase);
+            UNIT_ASSERT_VALUES_EQUAL_C(TotalCount(PhaseHistogram(registry, phase, "ReadRows")), 1, phase);
+            UNIT_ASSERT_VALUES_EQUAL_C(TotalCount(PhaseHistogram(registry, phase, "BulkUpsert")), 0, phase);
+        }
+    }
+
+    Y_UNIT_TEST(NoRegistry) {
+        TStatCollector collector("/Root/db", nullptr);
+        UNIT_ASSERT(!collector.IsCollecting());
+        collector.RecordRequestPhases("ExecuteDataQuery", TRequestPhaseTimer());
+    }
+
+    Y_UNIT_TEST(LatencyHistogramBounds) {
+        auto snapshot = LatencyHistogram()->Snapshot();
+        UNIT_ASSERT(snapshot->Count() <= ::NMonitoring::HISTOGRAM_MAX_BUCKETS_COUNT);
+        UNIT_ASSERT_VALUES_EQUAL(snapshot->UpperBound(snapshot->Count() - 1), Max<::NMonitoring::TBucketBound>());
+        UNIT_ASSERT(snapshot->UpperBound(snapshot->Count() - 2) >= LATENCY_HISTOGRAM_MAX.MicroSeconds());
+
+        const double lowest = LATENCY_HISTOGRAM_LOWEST.MicroSeconds();
+        UNIT_ASSERT_VALUES_EQUAL(snapshot->UpperBound(0), 0);
+        UNIT_ASSERT_VALUES_EQUAL(snapshot->UpperBound(1), lowest);
+        for (ui32 i = 2; i + 1 < snapshot->Count(); ++i) {
+            const auto bound = snapshot->UpperBound(i);
+            const auto width = bound - snapshot->UpperBound(i - 1);
+            if (bound <= 4 * lowest) {
+                UNIT_ASSERT_VALUES_EQUAL_C(width, lowest, "bound " << bound);
+            } else {
+                // 1/4 relative error, precision is not reduced to fit the buckets limit
+                UNIT_ASSERT_C(width <= bound / 4, "bound " << bound);
+            }
+        }
+    }
+}
@@ -64,6 +64,18 @@ public:
         Connections_->ScheduleOneTimeTask(std::move(cbGuard), timeout);
     }
 
+    NTracing::TSpanPtr StartSpan(const std::string& name, NTracing::ESpanKind kind, const std::string& traceparent) override {
+        return Connections_->StartSpan(name, kind, traceparent);
+    }
+
+    void OnRetryOperationStarted() override {
+        DbDriverState_->Admission->GetRetryBudget().OnOperation();
+    }
+
+    bool TryAcquireRetry() override {
+        return DbDriverState_->Admission->GetRetryBudget().TryAcquireRetry();
+    }
+
 protected:
     template<typename TService, typename TRequest, typename TResponse>
     using TAsyncRequest = typename NYdbGrpc::TSimpleRequestProcessor<
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <client/ydb_types/tracing/tracing.h>
+
 #include <functional>
 #include <util/datetime/base.h>
 
@@ -9,6 +11,12 @@ class IClientImplCommon {
 public:
     virtual ~IClientImplCommon() = default;
     virtual void ScheduleTask(const std::function<void()>& fn, TDuration timeout) = 0;
+    // Returns nullptr if tracer is not set in the driver or span is not sampled
+    virtual NTracing::TSpanPtr StartSpan(const std::string& name, NTracing::ESpanKind kind, const std::string& traceparent) = 0;
+    // Retry budget of the database: every retry operation is counted as base traffic,
+    // TryAcquireRetry returns false if one more retry would exceed the budget
+    virtual void OnRetryOperationStarted() = 0;
+    virtual bool TryAcquireRetry() = 0;
 };
 
 }
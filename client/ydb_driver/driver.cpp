@@ -32,6 +32,7 @@ public:
     std::string GetEndpoint() const override { return Endpoint; }
     size_t GetNetworkThreadsNum() const override { return NetworkThreadsNum; }
     size_t GetClientThreadsNum() const override { return ClientThreadsNum; }
+    TThreadPoolSettings GetClientThreadPoolSettings() const override { return ClientThreadPoolSettings; }
     size_t GetMaxQueuedResponses() const override { return MaxQueuedResponses; }
     TSslCredentials GetSslCredentials() const override { return SslCredentials; }
     std::string GetDatabase() const override { return Database; }
@@ -41,6 +42,7 @@ public:
     TTcpKeepAliveSettings GetTcpKeepAliveSettings() const override { return TcpKeepAliveSettings; }
     bool GetDrinOnDtors() const override { return DrainOnDtors; }
     TBalancingSettings GetBalancingSettings() const override { return BalancingSettings; }
+    TAdmissionControlSettings GetAdmissionControlSettings() const override { return AdmissionControlSettings; }
     TDuration GetGRpcKeepAliveTimeout() const override { return GRpcKeepAliveTimeout; }
     bool GetGRpcKeepAlivePermitWithoutCalls() const override { return GRpcKeepAlivePermitWithoutCalls; }
     TDuration GetSocketIdleTimeout() const override { return SocketIdleTimeout; }
@@ -48,11 +50,15 @@ public:
     ui64 GetMaxInboundMessageSize() const override { return MaxInboundMessageSize; }
     ui64 GetMaxOutboundMessageSize() const override { return MaxOutboundMessageSize; }
     ui64 GetMaxMessageSize() const override { return MaxMessageSize; }
+    NYdbGrpc::TChannelPoolSettings GetChannelPoolSettings() const override { return ChannelPoolSettings; }
     const TLog& GetLog() const override { return Log; }
+    TAsyncLogSettings GetAsyncLogSettings() const override { return AsyncLogSettings; }
+    std::shared_ptr<NTracing::ITracer> GetTracer() const override { return Tracer; }
 
     std::string Endpoint;
     size_t NetworkThreadsNum = 2;
     size_t ClientThreadsNum = 0;
+    TThreadPoolSettings ClientThreadPoolSettings;
     size_t MaxQueuedResponses = 0;
     TSslCredentials SslCredentials;
     std::string Database;
@@ -68,6 +74,7 @@ public:
         };
     bool DrainOnDtors = true;
     TBalancingSettings BalancingSettings = TBalancingSettings{EBalancingPolicy::UsePreferableLocation, std::string()};
+    TAdmissionControlSettings AdmissionControlSettings;
     TDuration GRpcKeepAliveTimeout;
     bool GRpcKeepAlivePermitWithoutCalls = false;
     TDuration SocketIdleTimeout = TDuration::Minutes(6);
@@ -75,7 +82,10 @@ public:
     ui64 MaxInboundMessageSize = 0;
     ui64 MaxOutboundMessageSize = 0;
     ui64 MaxMessageSize = 0;
+    NYdbGrpc::TChannelPoolSettings ChannelPoolSettings;
     TLog Log; // Null by default.
+    TAsyncLogSettings AsyncLogSettings;
+    std::shared_ptr<NTracing::ITracer> Tracer;
 };
 
 TDriverConfig::TDriverConfig(const std::string& connectionString)
@@ -103,6 +113,11 @@ TDriverConfig& TDriverConfig::SetClientThreadsNum(size_t sz) {
     return *this;
 }
 
+TDriverConfig& TDriverConfig::SetClientThreadPool(const TThreadPoolSettings& settings) {
+    Impl_->ClientThreadPoolSettings = settings;
+    return *this;
+}
+
 TDriverConfig& TDriverConfig::SetMaxClientQueueSize(size_t sz) {
     Impl_->MaxQueuedResponses = sz;
     return *this;
@@ -198,11 +213,36 @@ TDriverConfig& TDriverConfig::SetMaxMessageSize(ui64 maxMessageSize) {
     return *this;
 }
 
+TDriverConfig& TDriverConfig::SetGRpcChannelsPerEndpoint(ui32 channels) {
+    Impl_->ChannelPoolSettings.UnaryChannelsPerEndpoint = channels;
+    return *this;
+}
+
+TDriverConfig& TDriverConfig::SetGRpcStreamingChannelsPerEndpoint(ui32 channels) {
+    Impl_->ChannelPoolSettings.StreamingChannelsPerEndpoint = channels;
+    return *this;
+}
+
 TDriverConfig& TDriverConfig::SetLog(THolder<TLogBackend> log) {
     Impl_->Log.ResetBackend(std::move(log));
     return *this;
 }
 
+TDriverConfig& TDriverConfig::SetAsyncLog(const TAsyncLogSettings& settings) {
+    Impl_->AsyncLogSettings = settings;
+    return *this;
+}
+
+TDriverConfig& TDriverConfig::SetAdmissionControl(const TAdmissionControlSettings& settings) {
+    Impl_->AdmissionControlSettings = settings;
+    return *this;
+}
+
+TDriverConfig& TDriverConfig::SetTracer(std::shared_ptr<NTracing::ITracer> tracer) {
+    Impl_->Tracer = std::move(tracer);
+    return *this;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 std::shared_ptr<TGRpcConnectionsImpl> CreateInternalInterface(const TDriver connection) {
@@ -223,4 +263,8 @@ void TDriver::Stop(bool wait) {
     Impl_->Stop(wait);
 }
 
+TFuture<void> TDriver::WaitReady() const {
+    return Impl_->WaitReady();
+}
+
 } // namespace NYdb
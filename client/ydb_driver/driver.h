@@ -1,14 +1,20 @@
 #pragma once
 
 #include <client/ydb_common_client/settings.h>
+#include <client/ydb_types/admission_settings.h>
+#include <client/ydb_types/async_log_settings.h>
 #include <client/ydb_types/status_codes.h>
 #include <client/ydb_types/credentials/credentials.h>
 #include <client/ydb_types/fatal_error_handlers/handlers.h>
 #include <client/ydb_types/request_settings.h>
 #include <client/ydb_types/status/status.h>
+#include <client/ydb_types/thread_pool_settings.h>
+#include <client/ydb_types/tracing/tracing.h>
 
 #include <library/cpp/logger/backend.h>
 
+#include <util/stream/fwd.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace NYdb {
@@ -37,6 +43,9 @@ public:
     //! of this pool is blocked somewhere in user code.
     //! default: 0
     TDriverConfig& SetClientThreadsNum(size_t sz);
+    //! Set kind of client pool, e.g. work stealing pool for many client threads
+    //! default: single queue thread pool
+    TDriverConfig& SetClientThreadPool(const TThreadPoolSettings& settings);
     //! Warning: not recommended to change
     //! Set max number of queued responses. 0 - no limit
     //! There is a queue to perform async calls to user code,
@@ -117,13 +126,42 @@ public:
     //! default: 0
     TDriverConfig& SetMaxMessageSize(ui64 maxMessageSize);
 
+    //! Set max number of grpc channels (each is a separate HTTP/2 connection) per endpoint
+    //! used for unary requests. New channel is opened only when all existing channels
+    //! have requests in flight, otherwise the least loaded channel is used.
+    //! default: 1
+    TDriverConfig& SetGRpcChannelsPerEndpoint(ui32 channels);
+    //! Set max number of grpc channels per endpoint used for streaming requests (topic, scan queries etc).
+    //! Non zero value keeps long-lived streams apart from unary requests.
+    //! default: 0, streams share channels with unary requests
+    TDriverConfig& SetGRpcStreamingChannelsPerEndpoint(ui32 channels);
+
+    //! Client side load shedding: adaptive limit of requests in flight and retry budget,
+    //! see TAdmissionControlSettings.
+    //! default: disabled
+    TDriverConfig& SetAdmissionControl(const TAdmissionControlSettings& settings);
+
     //! Log backend.
     TDriverConfig& SetLog(THolder<TLogBackend> log);
+
+    //! Format hot path log records (e.g. of topic write sessions) in a background thread
+    //! or write them to a compact binary log, see TAsyncLogSettings.
+    //! default: disabled
+    TDriverConfig& SetAsyncLog(const TAsyncLogSettings& settings);
+
+    //! Tracer to open spans around retries, session acquisition, gRPC calls, stream reads
+    //! and topic write batches. Calls are linked to the caller's trace with request setting
+    //! TraceParent and W3C traceparent header is sent to the server.
+    //! default: no tracing
+    TDriverConfig& SetTracer(std::shared_ptr<NTracing::ITracer> tracer);
 private:
     class TImpl;
     std::shared_ptr<TImpl> Impl_;
 };
 
+//! Converts binary log written with TAsyncLogSettings::BinaryLogPath to text
+void DecodeBinaryLog(IInputStream& input, IOutputStream& output);
+
 ////////////////////////////////////////////////////////////////////////////////
 
 //! Represents connection pool to the database
@@ -140,6 +178,13 @@ public:
     //! client thread pool is stopped completely
     void Stop(bool wait = false);
 
+    //! Returns future which is set when driver is warmed up: discovery for the default
+    //! database is completed and clients created with non zero PrewarmSessions setting
+    //! have created their sessions (successfully or not).
+    //! Only clients created before the call are taken into account, so useful pattern is
+    //! to create all clients on startup and gate readiness (e.g. health checks) on this future.
+    NThreading::TFuture<void> WaitReady() const;
+
     template<typename TExtension>
     void AddExtension(typename TExtension::TParams params = typename TExtension::TParams());
 
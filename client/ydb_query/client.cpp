@@ -8,6 +8,7 @@
 #include <client/impl/ydb_internal/retry/retry_async.h>
 #include <client/impl/ydb_internal/retry/retry_sync.h>
 #include <client/impl/ydb_internal/session_client/session_client.h>
+#include <client/impl/ydb_internal/session_pool/query_registry.h>
 #include <client/impl/ydb_internal/session_pool/session_pool.h>
 #undef INCLUDE_YDB_INTERNAL_H
 
@@ -31,6 +32,10 @@ TCreateSessionSettings::TCreateSessionSettings() {
     ClientTimeout_ = TDuration::Seconds(5);
 };
 
+static std::string GetQueryRegistryKey(const std::string& query) {
+    return ToString(ComputeHash(query));
+}
+
 static void SetTxSettings(const TTxSettings& txSettings, Ydb::Query::TransactionSettings* proto)
 {
     switch (txSettings.Mode_) {
@@ -60,6 +65,9 @@ public:
         , Settings_(settings)
         , SessionPool_(Settings_.SessionPoolSettings_.MaxActiveSessions_)
     {
+        if (Settings_.QueryRegistrySize_) {
+            QueryRegistry_ = std::make_shared<NSessionPool::TQueryRegistry>(Settings_.QueryRegistrySize_);
+        }
     }
 
     ~TImpl() {
@@ -303,6 +311,10 @@ public:
             SessionPool_.DecrementActiveCounter();
         }
 
+        if (QueryRegistry_) {
+            QueryRegistry_->ForgetSession(sessionImpl->GetId());
+        }
+
         delete sessionImpl;
     }
 
@@ -356,7 +368,7 @@ public:
         rpcSettings);
     }
 
-    TAsyncCreateSessionResult CreateAttachedSession(TDuration timeout) {
+    TAsyncCreateSessionResult CreateAttachedSession(TDuration timeout, const std::string& preferredEndpoint = {}) {
         using namespace Ydb::Query;
 
         Ydb::Query::CreateSessionRequest request;
@@ -383,6 +395,7 @@ public:
 
         TRpcRequestSettings rpcSettings;
         rpcSettings.ClientTimeout = timeout;
+        rpcSettings.PreferredEndpoint = TEndpointKey(preferredEndpoint, 0);
 
         Connections_->Run<V1::QueryService, CreateSessionRequest, CreateSessionResponse>(
             std::move(request),
@@ -443,12 +456,39 @@ public:
             TDuration ClientTimeout;
         };
 
+        TSessionPool::TSessionPreference preference;
+        if (QueryRegistry_ && settings.QueryAffinity_) {
+            preference = [registry = QueryRegistry_, key = GetQueryRegistryKey(*settings.QueryAffinity_)]
+                (const TKqpSessionCommon* s) {
+                    return registry->IsPrepared(key, s->GetId());
+                };
+        }
+
         auto ctx = std::make_unique<TQueryClientGetSessionCtx>(shared_from_this(), settings.ClientTimeout_);
         auto future = ctx->GetFuture();
-        SessionPool_.GetSession(std::move(ctx));
+        if (auto span = StartSpan("ydb.GetSession", NTracing::ESpanKind::Internal, settings.TraceParent_)) {
+            future.Subscribe([span](const TAsyncCreateSessionResult& result) {
+                span->End(result.HasValue() ? result.GetValue().GetStatus() : EStatus::CLIENT_INTERNAL_ERROR);
+            });
+        }
+        SessionPool_.GetSession(std::move(ctx), preference);
         return future;
     }
 
+    std::function<void(const TExecuteQueryResult&, TKqpSessionCommon&)> GetQueryRegistryInterceptor(const std::string& query) {
+        if (!QueryRegistry_) {
+            return {};
+        }
+
+        return [registry = QueryRegistry_, key = GetQueryRegistryKey(query)](const TExecuteQueryResult& result, TKqpSessionCommon& session) {
+            if (result.IsSuccess()) {
+                registry->Register(key, std::nullopt, session.GetId());
+            } else if (result.GetStatus() == EStatus::BAD_SESSION || result.GetStatus() == EStatus::NOT_FOUND) {
+                registry->Unregister(key, session.GetId());
+            }
+        };
+    }
+
     i64 GetActiveSessionCount() const {
         return SessionPool_.GetActiveSessions();
     }
@@ -477,19 +517,87 @@ public:
             return false;
         };
 
-        // No need to keep-alive
-        auto keepAliveCmd = [](TKqpSessionCommon*) {
+        // No need to keep-alive, session is alive while attach stream is alive.
+        // Just return session to the pool, it will be closed after CloseIdleThreshold
+        // if the pool is larger than needed
+        auto keepAliveCmd = [this](TKqpSessionCommon* s, NSessionPool::TInFlightToken) {
+            TSession session(shared_from_this(), static_cast<TSession::TImpl*>(s));
+            s->ScheduleTimeToTouchFast(
+                NSessionPool::RandomizeThreshold(Settings_.SessionPoolSettings_.CloseIdleThreshold_), false);
         };
 
+        // Creates session in background, it returns to the pool as idle when the request is done
+        auto createSessionCmd = [this](NSessionPool::TInFlightToken token) {
+            CreateAttachedSession(NSessionPool::CREATE_SESSION_INTERNAL_TIMEOUT)
+                .Subscribe([token](TAsyncCreateSessionResult future) {
+                    ReleaseBackgroundSession(future.ExtractValue());
+                });
+        };
+
+        NSessionPool::TPeriodicTaskSettings periodicTaskSettings;
+        periodicTaskSettings.MinPoolSize = Settings_.SessionPoolSettings_.MinPoolSize_;
+        periodicTaskSettings.KeepMinPoolSizeWarm = Settings_.SessionPoolSettings_.KeepMinPoolSizeWarm_;
+
         std::weak_ptr<TQueryClient::TImpl> weak = shared_from_this();
         Connections_->AddPeriodicTask(
             SessionPool_.CreatePeriodicTask(
                 weak,
                 std::move(keepAliveCmd),
-                std::move(deletePredicate)
+                std::move(deletePredicate),
+                {},
+                std::move(createSessionCmd),
+                periodicTaskSettings
             ), NSessionPool::PERIODIC_ACTION_INTERVAL);
     }
 
+    void PrewarmSessionPool() {
+        const auto& sessionPoolSettings = Settings_.SessionPoolSettings_;
+        ui32 sessionsCount = sessionPoolSettings.PrewarmSessions_;
+        if (sessionPoolSettings.MaxActiveSessions_) {
+            sessionsCount = Min(sessionsCount, sessionPoolSettings.MaxActiveSessions_);
+        }
+        if (!sessionsCount) {
+            return;
+        }
+
+        auto readyPromise = NThreading::NewPromise<void>();
+        Connections_->AddStartupTask(readyPromise.GetFuture());
+
+        std::weak_ptr<TQueryClient::TImpl> weak = shared_from_this();
+        DbDriverState_->DiscoveryCompleted().Subscribe([weak, sessionsCount, readyPromise](const NThreading::TFuture<void>&) mutable {
+            auto strongClient = weak.lock();
+            if (!strongClient) {
+                readyPromise.SetValue();
+                return;
+            }
+
+            // All sessions are requested at once, round robin over the best endpoints
+            const auto endpoints = strongClient->DbDriverState_->EndpointPool.GetBestEndpoints();
+            std::vector<TAsyncCreateSessionResult> results;
+            results.reserve(sessionsCount);
+            for (ui32 i = 0; i < sessionsCount; ++i) {
+                results.emplace_back(strongClient->CreateAttachedSession(NSessionPool::CREATE_SESSION_INTERNAL_TIMEOUT,
+                    endpoints.empty() ? std::string() : endpoints[i % endpoints.size()].Endpoint.Get()));
+            }
+
+            auto allDone = NThreading::WaitAll(results);
+            allDone.Subscribe([results = std::move(results), readyPromise](const NThreading::TFuture<void>&) mutable {
+                for (auto& result : results) {
+                    ReleaseBackgroundSession(result.ExtractValue());
+                }
+                readyPromise.SetValue();
+            });
+        });
+    }
+
+    // Session created by client itself returns to the pool as idle, broken one is just deleted
+    static void ReleaseBackgroundSession(TCreateSessionResult result) {
+        if (result.IsSuccess()) {
+            // Session was not given to user, so it is not accounted as active
+            result.GetSession().SessionImpl_->SetNeedUpdateActiveCounter(false);
+        }
+    }
+
     void CollectRetryStatAsync(EStatus status) {
         Y_UNUSED(status);
     }
@@ -501,12 +609,14 @@ public:
 private:
     TClientSettings Settings_;
     NSessionPool::TSessionPool SessionPool_;
+    std::shared_ptr<NSessionPool::TQueryRegistry> QueryRegistry_;
 };
 
 TQueryClient::TQueryClient(const TDriver& driver, const TClientSettings& settings)
     : Impl_(new TQueryClient::TImpl(CreateInternalInterface(driver), settings))
 {
     Impl_->StartPeriodicSessionPoolTask();
+    Impl_->PrewarmSessionPool();
 }
 
 TAsyncExecuteQueryResult TQueryClient::ExecuteQuery(const std::string& query, const TTxControl& txControl,
@@ -610,9 +720,10 @@ TAsyncExecuteQueryResult TSession::ExecuteQuery(const std::string& query, const
 {
     return NSessionPool::InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->ExecuteQuery(query, txControl, {}, settings, *this),
+        Client_->ExecuteQuery(query, txControl, {}, SessionImpl_->ApplyRetryAttempt(settings), *this),
         true,
-        Client_->Settings_.SessionPoolSettings_.CloseIdleThreshold_);
+        Client_->Settings_.SessionPoolSettings_.CloseIdleThreshold_,
+        Client_->GetQueryRegistryInterceptor(query));
 }
 
 TAsyncExecuteQueryResult TSession::ExecuteQuery(const std::string& query, const TTxControl& txControl,
@@ -620,9 +731,10 @@ TAsyncExecuteQueryResult TSession::ExecuteQuery(const std::string& query, const
 {
     return NSessionPool::InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->ExecuteQuery(query, txControl, params, settings, *this),
+        Client_->ExecuteQuery(query, txControl, params, SessionImpl_->ApplyRetryAttempt(settings), *this),
         true,
-        Client_->Settings_.SessionPoolSettings_.CloseIdleThreshold_);
+        Client_->Settings_.SessionPoolSettings_.CloseIdleThreshold_,
+        Client_->GetQueryRegistryInterceptor(query));
 }
 
 TAsyncExecuteQueryIterator TSession::StreamExecuteQuery(const std::string& query, const TTxControl& txControl,
@@ -630,7 +742,7 @@ TAsyncExecuteQueryIterator TSession::StreamExecuteQuery(const std::string& query
 {
     return NSessionPool::InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->StreamExecuteQuery(query, txControl, {}, settings, *this),
+        Client_->StreamExecuteQuery(query, txControl, {}, SessionImpl_->ApplyRetryAttempt(settings), *this),
         true,
         Client_->Settings_.SessionPoolSettings_.CloseIdleThreshold_);
 }
@@ -640,7 +752,7 @@ TAsyncExecuteQueryIterator TSession::StreamExecuteQuery(const std::string& query
 {
     return NSessionPool::InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->StreamExecuteQuery(query, txControl, params, settings, *this),
+        Client_->StreamExecuteQuery(query, txControl, params, SessionImpl_->ApplyRetryAttempt(settings), *this),
         true,
         Client_->Settings_.SessionPoolSettings_.CloseIdleThreshold_);
 }
@@ -650,7 +762,7 @@ TAsyncBeginTransactionResult TSession::BeginTransaction(const TTxSettings& txSet
 {
     return NSessionPool::InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->BeginTransaction(txSettings, settings, *this),
+        Client_->BeginTransaction(txSettings, SessionImpl_->ApplyRetryAttempt(settings), *this),
         true,
         Client_->Settings_.SessionPoolSettings_.CloseIdleThreshold_);
 }
@@ -661,11 +773,11 @@ TTransaction::TTransaction(const TSession& session, const std::string& txId)
 {}
 
 TAsyncCommitTransactionResult TTransaction::Commit(const NYdb::NQuery::TCommitTxSettings& settings) {
-    return Session_.Client_->CommitTransaction(TxId_, settings, Session_);
+    return Session_.Client_->CommitTransaction(TxId_, Session_.SessionImpl_->ApplyRetryAttempt(settings), Session_);
 }
 
 TAsyncStatus TTransaction::Rollback(const TRollbackTxSettings& settings) {
-    return Session_.Client_->RollbackTransaction(TxId_, settings, Session_);
+    return Session_.Client_->RollbackTransaction(TxId_, Session_.SessionImpl_->ApplyRetryAttempt(settings), Session_);
 }
 
 TBeginTransactionResult::TBeginTransactionResult(TStatus&& status, TTransaction transaction)
@@ -23,6 +23,10 @@ namespace NYdb::NQuery {
 
 struct TCreateSessionSettings : public TSimpleRequestSettings<TCreateSessionSettings> {
     TCreateSessionSettings();
+
+    // Prefer pooled session which has already executed this query.
+    // Used only if query registry is enabled (see TClientSettings::QueryRegistrySize)
+    FLUENT_SETTING_OPTIONAL(std::string, QueryAffinity);
 };
 
 class TCreateSessionResult;
@@ -41,12 +45,26 @@ struct TSessionPoolSettings {
     // Min number of session in session pool.
     // Sessions will not be closed by CloseIdleThreshold if the number of sessions less then this limit.
     FLUENT_SETTING_DEFAULT(ui32, MinPoolSize, 10);
+
+    // Create sessions in background to keep at least MinPoolSize sessions in session pool.
+    // Otherwise sessions are created in background only up to the recent peak of active sessions
+    FLUENT_SETTING_DEFAULT(bool, KeepMinPoolSizeWarm, false);
+
+    // Number of sessions created in parallel right after client creation, spread over
+    // the best endpoints. Sessions are put to the pool as idle, see TDriver::WaitReady.
+    // Zero - create sessions on demand
+    FLUENT_SETTING_DEFAULT(ui32, PrewarmSessions, 0);
 };
 
 struct TClientSettings : public TCommonClientSettingsBase<TClientSettings> {
     using TSessionPoolSettings = TSessionPoolSettings;
     using TSelf = TClientSettings;
     FLUENT_SETTING(TSessionPoolSettings, SessionPoolSettings);
+
+    // Max number of queries in client wide registry of queries executed on pooled sessions.
+    // The registry allows GetSession to prefer session which has already executed the query.
+    // Zero - disable this feature
+    FLUENT_SETTING_DEFAULT(ui32, QueryRegistrySize, 0);
 };
 
 // ! WARNING: Experimental API
@@ -81,6 +99,8 @@ public:
     TAsyncExecuteQueryIterator StreamExecuteQuery(const std::string& query, const TTxControl& txControl,
         const TParams& params, const TExecuteQuerySettings& settings = TExecuteQuerySettings());
 
+    //! Query function may be a coroutine, e.g.
+    //! [](TSession session) -> TAsyncExecuteQueryResult { auto result = co_await session.ExecuteQuery(...); ... co_return result; }
     TAsyncExecuteQueryResult RetryQuery(TQueryFunc&& queryFunc, TRetryOperationSettings settings = TRetryOperationSettings());
 
     TAsyncExecuteQueryResult RetryQuery(const std::string& query, const TTxControl& txControl,
@@ -112,6 +132,7 @@ class TTransaction;
 class TSession {
     friend class TQueryClient;
     friend class TTransaction;
+    friend class NRetry::Async::TRetryContext<TQueryClient, TAsyncExecuteQueryResult>;
 public:
     const std::string& GetId() const;
 
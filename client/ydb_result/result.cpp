@@ -9,7 +9,12 @@
 
 #include <util/generic/mapfindptr.h>
 
+#include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/text_format.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include <mutex>
+#include <unordered_map>
 
 namespace NYdb {
 
@@ -34,6 +39,41 @@ bool operator!=(const TColumn& col1, const TColumn& col2) {
     return !(col1 == col2);
 }
 
+namespace {
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::internal::WireFormatLite;
+
+// Field numbers of Ydb::ResultSet and Ydb::Value
+constexpr ui32 ResultSetColumnsField = 1;
+constexpr ui32 ResultSetRowsField = 2;
+constexpr ui32 ResultSetTruncatedField = 3;
+constexpr ui32 ValueItemsField = 12;
+
+CodedInputStream MakeInput(std::string_view data) {
+    return CodedInputStream(reinterpret_cast<const ui8*>(data.data()), data.size());
+}
+
+// Reads length delimited field, returned slice points into data
+bool ReadLengthDelimited(CodedInputStream& input, std::string_view data, std::string_view& slice) {
+    ui32 size;
+    if (!input.ReadVarint32(&size)) {
+        return false;
+    }
+    const int offset = input.CurrentPosition();
+    if (!input.Skip(size)) {
+        return false;
+    }
+    slice = data.substr(offset, size);
+    return true;
+}
+
+bool IsLengthDelimited(ui32 tag) {
+    return WireFormatLite::GetTagWireType(tag) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+}
+
+} // namespace
+
 class TResultSet::TImpl {
 public:
     TImpl(const Ydb::ResultSet& proto)
@@ -48,6 +88,13 @@ public:
         Init();
     }
 
+    TImpl(std::string&& serialized)
+        : Serialized_(std::move(serialized))
+        , IsSerialized_(true)
+    {
+        InitSerialized();
+    }
+
     void Init() {
         ColumnsMeta_.reserve(ProtoResultSet_.columns_size());
         for (auto& meta : ProtoResultSet_.columns()) {
@@ -55,9 +102,92 @@ public:
         }
     }
 
+    void InitSerialized() {
+        if (!ScanSerialized()) {
+            ThrowFatalError("TResultSet: corrupted serialized result set");
+        }
+    }
+
+    // Only columns metadata is parsed, rows are kept as slices of the serialized message
+    bool ScanSerialized() {
+        const std::string_view data = Serialized_;
+        auto input = MakeInput(data);
+        std::string_view slice;
+        while (const ui32 tag = input.ReadTag()) {
+            const ui32 field = WireFormatLite::GetTagFieldNumber(tag);
+            if (field == ResultSetRowsField && IsLengthDelimited(tag)) {
+                if (!ReadLengthDelimited(input, data, slice)) {
+                    return false;
+                }
+                Rows_.push_back(slice);
+            } else if (field == ResultSetColumnsField && IsLengthDelimited(tag)) {
+                Ydb::Column meta;
+                if (!ReadLengthDelimited(input, data, slice) || !meta.ParseFromArray(slice.data(), slice.size())) {
+                    return false;
+                }
+                ColumnsMeta_.push_back(TColumn(meta.name(), TType(meta.type())));
+            } else if (field == ResultSetTruncatedField && WireFormatLite::GetTagWireType(tag) == WireFormatLite::WIRETYPE_VARINT) {
+                ui64 value;
+                if (!input.ReadVarint64(&value)) {
+                    return false;
+                }
+                Truncated_ = value != 0;
+            } else if (!WireFormatLite::SkipField(&input, tag)) {
+                return false;
+            }
+        }
+        return input.ConsumedEntireMessage();
+    }
+
+    size_t RowsCount() const {
+        return IsSerialized_ ? Rows_.size() : ProtoResultSet_.rows_size();
+    }
+
+    bool Truncated() const {
+        return IsSerialized_ ? Truncated_ : ProtoResultSet_.truncated();
+    }
+
+    // Fills slices of the row cells, returns false if the row is corrupted
+    bool GetRowItems(size_t rowIndex, std::vector<std::string_view>& items) const {
+        items.clear();
+        const std::string_view row = Rows_[rowIndex];
+        auto input = MakeInput(row);
+        std::string_view slice;
+        while (const ui32 tag = input.ReadTag()) {
+            if (WireFormatLite::GetTagFieldNumber(tag) == ValueItemsField && IsLengthDelimited(tag)) {
+                if (!ReadLengthDelimited(input, row, slice)) {
+                    return false;
+                }
+                items.push_back(slice);
+            } else if (!WireFormatLite::SkipField(&input, tag)) {
+                return false;
+            }
+        }
+        return input.ConsumedEntireMessage();
+    }
+
+    const Ydb::ResultSet& GetProto() const {
+        if (IsSerialized_) {
+            std::call_once(ProtoParsed_, [this] {
+                if (!ProtoResultSet_.ParseFromString(Serialized_)) {
+                    ThrowFatalError("TResultSet: corrupted serialized result set");
+                }
+            });
+        }
+        return ProtoResultSet_;
+    }
+
 public:
-    const Ydb::ResultSet ProtoResultSet_;
     std::vector<TColumn> ColumnsMeta_;
+    const std::string Serialized_;
+    const bool IsSerialized_ = false;
+    std::vector<std::string_view> Rows_;
+
+private:
+    bool Truncated_ = false;
+    // Parsed on demand if result set is created from serialized message
+    mutable Ydb::ResultSet ProtoResultSet_;
+    mutable std::once_flag ProtoParsed_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -68,16 +198,23 @@ TResultSet::TResultSet(const Ydb::ResultSet& proto)
 TResultSet::TResultSet(Ydb::ResultSet&& proto)
     : Impl_(new TResultSet::TImpl(std::move(proto))) {}
 
+TResultSet::TResultSet(std::shared_ptr<TImpl> impl)
+    : Impl_(std::move(impl)) {}
+
+TResultSet TResultSet::FromSerialized(std::string serialized) {
+    return TResultSet(std::make_shared<TImpl>(std::move(serialized)));
+}
+
 size_t TResultSet::ColumnsCount() const {
     return Impl_->ColumnsMeta_.size();
 }
 
 size_t TResultSet::RowsCount() const {
-    return Impl_->ProtoResultSet_.rows_size();
+    return Impl_->RowsCount();
 }
 
 bool TResultSet::Truncated() const {
-    return Impl_->ProtoResultSet_.truncated();
+    return Impl_->Truncated();
 }
 
 const std::vector<TColumn>& TResultSet::GetColumnsMeta() const {
@@ -85,7 +222,7 @@ const std::vector<TColumn>& TResultSet::GetColumnsMeta() const {
 }
 
 const Ydb::ResultSet& TResultSet::GetProto() const {
-    return Impl_->ProtoResultSet_;
+    return Impl_->GetProto();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -96,13 +233,21 @@ public:
         : ResultSet_(resultSet)
     {
         ColumnParsers.reserve(resultSet.ColumnsCount());
+        ColumnUsed.resize(resultSet.ColumnsCount());
 
-        auto& columnsMeta = resultSet.GetColumnsMeta();
+        // Names are owned by the result set, which is kept alive by ResultSet_
+        auto& columnsMeta = ResultSet_.GetColumnsMeta();
+        ColumnIndexMap.reserve(columnsMeta.size());
         for (size_t i = 0; i < columnsMeta.size(); ++i) {
             auto& column = columnsMeta[i];
-            ColumnIndexMap[column.Name] = i;
+            // Last column wins if names are duplicated
+            ColumnIndexMap.insert_or_assign(column.Name, i);
             ColumnParsers.emplace_back<TValueParser>(column.Type);
         }
+
+        if (IsSerialized()) {
+            Cells_.resize(columnsMeta.size());
+        }
     }
 
     size_t ColumnsCount() const {
@@ -118,17 +263,28 @@ public:
             return false;
         }
 
-        auto& row = ResultSet_.GetProto().rows()[RowIndex_];
-
-        if (static_cast<size_t>(row.items_size()) != ColumnsCount()) {
-            FatalError(TStringBuilder() << "Corrupted data: row " << RowIndex_ << " contains " << row.items_size() << " column(s), but metadata contains " << ColumnsCount() << " column(s)");
+        size_t itemsCount;
+        if (IsSerialized()) {
+            if (!ResultSet_.Impl_->GetRowItems(RowIndex_, RowItems_)) {
+                FatalError(TStringBuilder() << "Corrupted data: row " << RowIndex_ << " can't be decoded");
+            }
+            itemsCount = RowItems_.size();
+        } else {
+            itemsCount = ResultSet_.GetProto().rows()[RowIndex_].items_size();
         }
 
-        for (size_t i = 0; i < ColumnsCount(); ++i) {
-            ColumnParsers[i].Reset(row.items(i));
+        if (itemsCount != ColumnsCount()) {
+            FatalError(TStringBuilder() << "Corrupted data: row " << RowIndex_ << " contains " << itemsCount << " column(s), but metadata contains " << ColumnsCount() << " column(s)");
         }
 
         RowIndex_++;
+
+        // Only columns which were requested are bound to the row,
+        // so reading few columns of a wide result set doesn't pay for the others
+        for (size_t i : UsedColumns) {
+            BindColumn(i);
+        }
+
         return true;
     }
 
@@ -142,7 +298,15 @@ public:
             FatalError(TStringBuilder() << "Column index out of bounds: " << columnIndex);
         }
 
-        return ColumnParsers[columnIndex];
+        auto& parser = ColumnParsers[columnIndex];
+        if (!ColumnUsed[columnIndex]) {
+            ColumnUsed[columnIndex] = true;
+            UsedColumns.push_back(columnIndex);
+            if (RowIndex_ > 0) {
+                BindColumn(columnIndex);
+            }
+        }
+        return parser;
     }
 
     TValueParser& ColumnParser(const std::string& columnName) {
@@ -163,9 +327,15 @@ public:
             FatalError(TStringBuilder() << "Row position is undefined");
         }
 
-        const auto& row = ResultSet_.GetProto().rows()[RowIndex_ - 1];
         const auto& valueType = ResultSet_.GetColumnsMeta()[columnIndex].Type;
 
+        if (IsSerialized()) {
+            Ydb::Value value;
+            ParseCell(columnIndex, value);
+            return TValue(valueType, std::move(value));
+        }
+
+        const auto& row = ResultSet_.GetProto().rows()[RowIndex_ - 1];
         return TValue(valueType, row.items(columnIndex));
     }
 
@@ -183,11 +353,42 @@ private:
         ThrowFatalError(TStringBuilder() << "TResultSetParser: " << msg);
     }
 
+    bool IsSerialized() const {
+        return ResultSet_.Impl_->IsSerialized_;
+    }
+
+    // Binds column parser to the current row
+    void BindColumn(size_t columnIndex) {
+        if (IsSerialized()) {
+            // Cell messages are reused between rows, so decoding doesn't allocate
+            // once buffers of the cell have grown to the size of the largest value
+            auto& cell = Cells_[columnIndex];
+            ParseCell(columnIndex, cell);
+            ColumnParsers[columnIndex].Reset(cell);
+        } else {
+            ColumnParsers[columnIndex].Reset(ResultSet_.GetProto().rows()[RowIndex_ - 1].items(columnIndex));
+        }
+    }
+
+    void ParseCell(size_t columnIndex, Ydb::Value& value) const {
+        const std::string_view data = RowItems_[columnIndex];
+        if (!value.ParseFromArray(data.data(), data.size())) {
+            FatalError(TStringBuilder() << "Corrupted data: column " << columnIndex << " of row " << RowIndex_ - 1 << " can't be decoded");
+        }
+    }
+
 private:
     TResultSet ResultSet_;
 
-    std::map<std::string, size_t> ColumnIndexMap;
+    std::unordered_map<std::string_view, size_t> ColumnIndexMap;
     std::vector<TValueParser> ColumnParsers;
+    // Columns returned by ColumnParser, they are reset on every row
+    std::vector<bool> ColumnUsed;
+    std::vector<size_t> UsedColumns;
+
+    // Serialized result set only: slices of the current row cells and their decoded values
+    std::vector<std::string_view> RowItems_;
+    std::vector<Ydb::Value> Cells_;
 
     size_t RowIndex_ = 0;
 };
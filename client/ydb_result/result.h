@@ -35,6 +35,12 @@ public:
     TResultSet(const Ydb::ResultSet& proto);
     TResultSet(Ydb::ResultSet&& proto);
 
+    //! Creates result set from serialized Ydb::ResultSet without parsing the rows.
+    //! Cells are decoded from the wire format when they are read by TResultSetParser,
+    //! so rows and columns which are never read are not parsed at all.
+    //! Full protobuf message is parsed only if it is requested, e.g. by TProtoAccessor.
+    static TResultSet FromSerialized(std::string serialized);
+
     //! Returns number of columns
     size_t ColumnsCount() const;
 
@@ -48,10 +54,13 @@ public:
     const std::vector<TColumn>& GetColumnsMeta() const;
 
 private:
+    class TImpl;
+
+    TResultSet(std::shared_ptr<TImpl> impl);
+
     const Ydb::ResultSet& GetProto() const;
 
 private:
-    class TImpl;
     std::shared_ptr<TImpl> Impl_;
 };
 
@@ -70,12 +79,15 @@ public:
     size_t RowsCount() const;
 
     //! Set iterator to the next result row.
-    //! On success TryNextRow will reset all column parsers to the values in next row.
+    //! On success TryNextRow will reset column parsers to the values in next row.
+    //! Only parsers returned by ColumnParser are reset, columns which are never read cost nothing.
     //! Column parsers are invalid before the first TryNextRow call.
     bool TryNextRow();
 
     //! Returns index for column with specified name.
     //! If there is no column with such name, then -1 is returned.
+    //! Resolve names once before the loop and read columns by index,
+    //! as lookup by name is done on every ColumnParser and GetValue call.
     ssize_t ColumnIndex(const std::string& columnName);
 
     //! Returns column value parser for column with specified index.
@@ -195,6 +195,112 @@ Y_UNIT_TEST_SUITE(CppGrpcClientResultSetTest) {
         }
     }
 
+    Y_UNIT_TEST(ColumnParserBoundOnAccess) {
+        const std::string resultSetString =
+            "columns {\n"
+            "  name: \"key\"\n"
+            "  type {\n"
+            "    type_id: UINT64\n"
+            "  }\n"
+            "}\n"
+            "columns {\n"
+            "  name: \"value\"\n"
+            "  type {\n"
+            "    type_id: UTF8\n"
+            "  }\n"
+            "}\n"
+            "rows {\n"
+            "  items {\n"
+            "    uint64_value: 1\n"
+            "  }\n"
+            "  items {\n"
+            "    text_value: \"one\"\n"
+            "  }\n"
+            "}\n"
+            "rows {\n"
+            "  items {\n"
+            "    uint64_value: 2\n"
+            "  }\n"
+            "  items {\n"
+            "    text_value: \"two\"\n"
+            "  }\n"
+            "}\n";
+        Ydb::ResultSet rsProto;
+        google::protobuf::TextFormat::ParseFromString(resultSetString, &rsProto);
+
+        NYdb::TResultSet rs(std::move(rsProto));
+        NYdb::TResultSetParser rsParser(rs);
+        const auto valueIndex = rsParser.ColumnIndex("value");
+        UNIT_ASSERT_EQUAL(valueIndex, 1);
+
+        UNIT_ASSERT(rsParser.TryNextRow());
+        UNIT_ASSERT_EQUAL(rsParser.ColumnParser(valueIndex).GetUtf8(), "one");
+
+        // Column which is read for the first time is bound to the current row
+        UNIT_ASSERT(rsParser.TryNextRow());
+        UNIT_ASSERT_EQUAL(rsParser.ColumnParser("key").GetUint64(), 2);
+        UNIT_ASSERT_EQUAL(rsParser.ColumnParser(valueIndex).GetUtf8(), "two");
+        UNIT_ASSERT(!rsParser.TryNextRow());
+    }
+
+    Y_UNIT_TEST(SerializedResultSet) {
+        const std::string resultSetString =
+            "columns {\n"
+            "  name: \"key\"\n"
+            "  type {\n"
+            "    type_id: UINT64\n"
+            "  }\n"
+            "}\n"
+            "columns {\n"
+            "  name: \"value\"\n"
+            "  type {\n"
+            "    optional_type {\n"
+            "      item {\n"
+            "        type_id: UTF8\n"
+            "      }\n"
+            "    }\n"
+            "  }\n"
+            "}\n"
+            "rows {\n"
+            "  items {\n"
+            "    uint64_value: 1\n"
+            "  }\n"
+            "  items {\n"
+            "    text_value: \"one\"\n"
+            "  }\n"
+            "}\n"
+            "rows {\n"
+            "  items {\n"
+            "    uint64_value: 2\n"
+            "  }\n"
+            "  items {\n"
+            "    null_flag_value: NULL_VALUE\n"
+            "  }\n"
+            "}\n"
+            "truncated: true\n";
+        Ydb::ResultSet rsProto;
+        google::protobuf::TextFormat::ParseFromString(resultSetString, &rsProto);
+
+        auto rs = NYdb::TResultSet::FromSerialized(rsProto.SerializeAsString());
+        UNIT_ASSERT_EQUAL(rs.ColumnsCount(), 2);
+        UNIT_ASSERT_EQUAL(rs.RowsCount(), 2);
+        UNIT_ASSERT(rs.Truncated());
+        UNIT_ASSERT_EQUAL(rs.GetColumnsMeta()[1].Name, "value");
+
+        NYdb::TResultSetParser rsParser(rs);
+        auto& key = rsParser.ColumnParser(0);
+        UNIT_ASSERT(rsParser.TryNextRow());
+        UNIT_ASSERT_EQUAL(key.GetUint64(), 1);
+        UNIT_ASSERT_EQUAL(rsParser.ColumnParser("value").GetOptionalUtf8(), "one");
+        UNIT_ASSERT(rsParser.TryNextRow());
+        UNIT_ASSERT_EQUAL(key.GetUint64(), 2);
+        UNIT_ASSERT(!rsParser.ColumnParser("value").GetOptionalUtf8());
+        UNIT_ASSERT_EQUAL(rsParser.GetValue(0).GetProto().uint64_value(), 2);
+        UNIT_ASSERT(!rsParser.TryNextRow());
+
+        UNIT_ASSERT_EXCEPTION(NYdb::TResultSet::FromSerialized("\x12\x10"), TContractViolation);
+    }
+
     Y_UNIT_TEST(ListCorruptedResultSet) {
         const std::string resultSetString =
             "columns {\n"
@@ -3,6 +3,8 @@
 #include <client/ydb_types/fluent_settings_helpers.h>
 #include <util/datetime/base.h>
 
+#include <string>
+
 namespace NYdb::NRetry {
 
 struct TBackoffSettings {
@@ -11,6 +13,10 @@ struct TBackoffSettings {
     FLUENT_SETTING_DEFAULT(TDuration, SlotDuration, TDuration::Seconds(1));
     FLUENT_SETTING_DEFAULT(ui32, Ceiling, 6);
     FLUENT_SETTING_DEFAULT(double, UncertainRatio, 0.5);
+    // Decorrelated jitter: every delay is random between SlotDuration and three times the previous delay,
+    // up to SlotDuration * 2^Ceiling; UncertainRatio is not used then.
+    // Spreads retries of many clients hit by the same failure better than exponential backoff
+    FLUENT_SETTING_FLAG(DecorrelatedJitter);
 };
 
 struct TRetryOperationSettings {
@@ -19,11 +25,15 @@ struct TRetryOperationSettings {
     FLUENT_SETTING_DEFAULT(ui32, MaxRetries, 10);
     FLUENT_SETTING_DEFAULT(bool, RetryNotFound, true);
     FLUENT_SETTING_DEFAULT(TDuration, GetSessionClientTimeout, TDuration::Seconds(5));
+    // Deadline of the whole retry operation: every attempt gets the time left as its client and
+    // operation timeout, and no retry is made if the backoff delay would pass the deadline
     FLUENT_SETTING_DEFAULT(TDuration, MaxTimeout, TDuration::Max());
     FLUENT_SETTING_DEFAULT(TBackoffSettings, FastBackoffSettings, DefaultFastBackoffSettings());
     FLUENT_SETTING_DEFAULT(TBackoffSettings, SlowBackoffSettings, DefaultSlowBackoffSettings());
     FLUENT_SETTING_FLAG(Idempotent);
     FLUENT_SETTING_FLAG(Verbose);
+    // W3C traceparent of the caller, retry loop span becomes its child
+    FLUENT_SETTING(std::string, TraceParent);
 
     static TBackoffSettings DefaultFastBackoffSettings() {
         return TBackoffSettings()
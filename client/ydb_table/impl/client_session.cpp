@@ -6,21 +6,35 @@
 namespace NYdb {
 namespace NTable {
 
-TSession::TImpl::TImpl(const std::string& sessionId, const std::string& endpoint, bool useQueryCache, ui32 queryCacheSize, bool isOwnedBySessionPool)
+TSession::TImpl::TImpl(const std::string& sessionId, const std::string& endpoint, bool useQueryCache, ui32 queryCacheSize, bool isOwnedBySessionPool,
+    std::shared_ptr<NSessionPool::TQueryRegistry> queryRegistry)
     : TKqpSessionCommon(sessionId, endpoint, isOwnedBySessionPool)
     , UseQueryCache_(useQueryCache)
     , QueryCache_(queryCacheSize)
+    , QueryRegistry_(useQueryCache ? std::move(queryRegistry) : nullptr)
 {}
 
+TSession::TImpl::~TImpl() {
+    if (QueryRegistry_) {
+        QueryRegistry_->ForgetSession(GetId());
+    }
+}
+
 void TSession::TImpl::InvalidateQueryInCache(const std::string& key) {
     if (!UseQueryCache_) {
         return;
     }
 
-    std::lock_guard guard(Lock_);
-    auto it = QueryCache_.Find(key);
-    if (it != QueryCache_.End()) {
-        QueryCache_.Erase(it);
+    {
+        std::lock_guard guard(Lock_);
+        auto it = QueryCache_.Find(key);
+        if (it != QueryCache_.End()) {
+            QueryCache_.Erase(it);
+        }
+    }
+
+    if (QueryRegistry_) {
+        QueryRegistry_->Unregister(key, GetId());
     }
 }
 
@@ -29,8 +43,14 @@ void TSession::TImpl::InvalidateQueryCache() {
         return;
     }
 
-    std::lock_guard guard(Lock_);
-    QueryCache_.Clear();
+    {
+        std::lock_guard guard(Lock_);
+        QueryCache_.Clear();
+    }
+
+    if (QueryRegistry_) {
+        QueryRegistry_->ForgetSession(GetId());
+    }
 }
 
 std::optional<TSession::TImpl::TDataQueryInfo> TSession::TImpl::GetQueryFromCache(const std::string& query, bool allowMigration) {
@@ -62,12 +82,30 @@ void TSession::TImpl::AddQueryToCache(const TDataQuery& query) {
     auto key = query.Impl_->GetTextHash();
     TDataQueryInfo queryInfo(id, query.Impl_->GetParameterTypes());
 
-    std::lock_guard guard(Lock_);
-    auto it = QueryCache_.Find(key);
-    if (it != QueryCache_.End()) {
-        *it = queryInfo;
-    } else {
-        QueryCache_.Insert(key, queryInfo);
+    std::optional<std::string> evictedKey;
+    {
+        std::lock_guard guard(Lock_);
+        auto it = QueryCache_.Find(key);
+        if (it != QueryCache_.End()) {
+            *it = queryInfo;
+        } else {
+            if (QueryRegistry_ && QueryCache_.Size() >= QueryCache_.GetMaxSize()) {
+                // Evict explicitly to keep registry in sync with session cache
+                auto oldest = QueryCache_.FindOldest();
+                if (oldest != QueryCache_.End()) {
+                    evictedKey = oldest.Key();
+                    QueryCache_.Erase(oldest);
+                }
+            }
+            QueryCache_.Insert(key, queryInfo);
+        }
+    }
+
+    if (QueryRegistry_) {
+        if (evictedKey) {
+            QueryRegistry_->Unregister(*evictedKey, GetId());
+        }
+        QueryRegistry_->Register(key, query.Impl_->GetText(), GetId());
     }
 }
 
@@ -75,5 +113,13 @@ const TLRUCache<std::string, TSession::TImpl::TDataQueryInfo>& TSession::TImpl::
     return QueryCache_;
 }
 
+ui64 TSession::TImpl::GetWarmUpGeneration() const {
+    return WarmUpGeneration_.load(std::memory_order_relaxed);
+}
+
+void TSession::TImpl::SetWarmUpGeneration(ui64 generation) {
+    WarmUpGeneration_.store(generation, std::memory_order_relaxed);
+}
+
 } // namespace NTable
 } // namespace NYdb
@@ -2,6 +2,7 @@
 
 #include <client/ydb_table/table.h>
 #include <client/impl/ydb_internal/kqp_session_common/kqp_session_common.h>
+#include <client/impl/ydb_internal/session_pool/query_registry.h>
 #include <client/impl/ydb_endpoints/endpoints.h>
 #include <ydb/public/lib/operation_id/operation_id.h>
 
@@ -28,7 +29,8 @@ class TSession::TImpl : public TKqpSessionCommon {
 #ifdef YDB_IMPL_TABLE_CLIENT_SESSION_UT
 public:
 #endif
-    TImpl(const std::string& sessionId, const std::string& endpoint, bool useQueryCache, ui32 queryCacheSize, bool isOwnedBySessionPool);
+    TImpl(const std::string& sessionId, const std::string& endpoint, bool useQueryCache, ui32 queryCacheSize, bool isOwnedBySessionPool,
+        std::shared_ptr<NSessionPool::TQueryRegistry> queryRegistry = {});
 public:
     struct TDataQueryInfo {
         std::string QueryId;
@@ -42,7 +44,7 @@ public:
             , ParameterTypes(parameterTypes) {}
     };
 public:
-    ~TImpl() = default;
+    ~TImpl();
 
     void InvalidateQueryInCache(const std::string& key);
     void InvalidateQueryCache();
@@ -51,6 +53,10 @@ public:
 
     const TLRUCache<std::string, TDataQueryInfo>& GetQueryCacheUnsafe() const;
 
+    // Registry generation this session was warmed up with (see TTableClient::TImpl::WarmUpSession)
+    ui64 GetWarmUpGeneration() const;
+    void SetWarmUpGeneration(ui64 generation);
+
     static TSessionInspectorFn GetSessionInspector(
         NThreading::TPromise<TCreateSessionResult>& promise,
         std::shared_ptr<TTableClient::TImpl> client,
@@ -60,6 +66,8 @@ public:
 private:
     bool UseQueryCache_;
     TLRUCache<std::string, TDataQueryInfo> QueryCache_;
+    std::shared_ptr<NSessionPool::TQueryRegistry> QueryRegistry_;
+    std::atomic<ui64> WarmUpGeneration_ = 0;
 };
 
 } // namespace NTable
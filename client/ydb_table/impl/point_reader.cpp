@@ -0,0 +1,208 @@
+#include "point_reader.h"
+
+#include <client/ydb_types/exceptions/exceptions.h>
+
+namespace NYdb {
+namespace NTable {
+
+namespace {
+
+std::string GetPointKeyPart(const Ydb::Value& value) {
+    switch (value.value_case()) {
+        case Ydb::Value::kInt32Value:
+            return "i" + std::to_string(value.int32_value());
+        case Ydb::Value::kUint32Value:
+            return "i" + std::to_string(value.uint32_value());
+        case Ydb::Value::kInt64Value:
+            return "i" + std::to_string(value.int64_value());
+        case Ydb::Value::kUint64Value:
+            return "i" + std::to_string(value.uint64_value());
+        case Ydb::Value::kTextValue:
+            return "s" + value.text_value();
+        case Ydb::Value::kBytesValue:
+            return "s" + value.bytes_value();
+        default:
+            return "v" + value.SerializeAsString();
+    }
+}
+
+void AppendPointKeyPart(std::string& pointKey, const Ydb::Value& value) {
+    const auto part = GetPointKeyPart(value);
+    pointKey += std::to_string(part.size());
+    pointKey += ':';
+    pointKey += part;
+}
+
+} // namespace
+
+std::string GetPointKey(const Ydb::Value& key) {
+    std::string pointKey;
+    for (const auto& item : key.items()) {
+        AppendPointKeyPart(pointKey, item);
+    }
+    return pointKey;
+}
+
+std::unordered_map<std::string, Ydb::ResultSet> SplitByPointKey(const Ydb::ResultSet& resultSet,
+    const std::vector<std::string>& keyColumns)
+{
+    std::unordered_map<std::string, Ydb::ResultSet> parts;
+
+    std::vector<int> keyIndexes;
+    for (const auto& name : keyColumns) {
+        const auto& columns = resultSet.columns();
+        auto it = std::find_if(columns.begin(), columns.end(), [&name](const Ydb::Column& column) {
+            return column.name() == name;
+        });
+        if (it == columns.end()) {
+            return parts;
+        }
+        keyIndexes.push_back(it - columns.begin());
+    }
+
+    for (const auto& row : resultSet.rows()) {
+        std::string pointKey;
+        for (int index : keyIndexes) {
+            AppendPointKeyPart(pointKey, row.items(index));
+        }
+
+        auto [it, inserted] = parts.try_emplace(std::move(pointKey));
+        if (inserted) {
+            *it->second.mutable_columns() = resultSet.columns();
+        }
+        *it->second.add_rows() = row;
+    }
+    return parts;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TPointReader::TImpl::TImpl(const TTableClient& client, std::shared_ptr<TTableClient::TImpl> clientImpl,
+        const std::string& table, const std::vector<std::string>& columns, const TPointReaderSettings& settings)
+    : Client_(client)
+    , ClientImpl_(std::move(clientImpl))
+    , Table_(table)
+    , Settings_(settings)
+    , Columns_(columns)
+    , Pending_(settings.MaxBatchSize_)
+{
+    if (!Settings_.MaxBatchSize_) {
+        ythrow TContractViolation("MaxBatchSize of the point reader must be positive");
+    }
+}
+
+void TPointReader::TImpl::SetKeyType(const TType& type) {
+    const auto& typeProto = TProtoAccessor::GetProto(type);
+    if (!typeProto.has_struct_type()) {
+        ythrow TContractViolation("Key of the point read must be a struct of the key columns");
+    }
+
+    for (const auto& member : typeProto.struct_type().members()) {
+        KeyColumns_.push_back(member.name());
+        if (!Columns_.empty() && std::find(Columns_.begin(), Columns_.end(), member.name()) == Columns_.end()) {
+            Columns_.push_back(member.name());
+        }
+    }
+    KeyType_ = type;
+    KeyTypeId_ = typeProto.SerializeAsString();
+}
+
+TAsyncReadRowsResult TPointReader::TImpl::ReadRow(const TValue& key) {
+    auto pointKey = GetPointKey(TProtoAccessor::GetProto(key));
+
+    TAsyncReadRowsResult future;
+    TRequestBatch<TRequest>::TPushResult pushed;
+    {
+        std::lock_guard lock(Mutex_);
+        if (!KeyType_) {
+            SetKeyType(key.GetType());
+        } else if (TProtoAccessor::GetProto(key.GetType()).SerializeAsString() != KeyTypeId_) {
+            ythrow TContractViolation("Keys of the point reads must be of the same type");
+        }
+
+        auto it = InFlight_.find(pointKey);
+        if (it != InFlight_.end()) {
+            return it->second;
+        }
+
+        auto promise = NThreading::NewPromise<TReadRowsResult>();
+        future = promise.GetFuture();
+        InFlight_.emplace(pointKey, future);
+        pushed = Pending_.Push({std::move(pointKey), key, std::move(promise)});
+    }
+
+    if (!pushed.Full.empty()) {
+        Send(std::move(pushed.Full));
+    } else if (pushed.ScheduleFlush) {
+        // Pending reads keep the reader alive until they are sent
+        ClientImpl_->ScheduleCallback([self = shared_from_this()] (bool ok) {
+            self->Flush(ok);
+        }, Settings_.Window_);
+    }
+
+    return future;
+}
+
+void TPointReader::TImpl::Flush(bool ok) {
+    std::vector<TRequest> batch;
+    {
+        std::lock_guard lock(Mutex_);
+        batch = Pending_.Flush();
+    }
+
+    if (!ok) {
+        Reply(batch, TReadRowsResult(TStatus(EStatus::CLIENT_CANCELLED, NYql::TIssues{NYql::TIssue("Client is stopped")}),
+            TResultSet(Ydb::ResultSet())));
+    } else if (!batch.empty()) {
+        Send(std::move(batch));
+    }
+}
+
+void TPointReader::TImpl::Send(std::vector<TRequest>&& batch) {
+    TValueBuilder keys;
+    keys.BeginList();
+    for (const auto& request : batch) {
+        keys.AddListItem(request.Key);
+    }
+    keys.EndList();
+
+    // Columns are not changed after the first key, which is always read before
+    Client_.ReadRows(Table_, keys.Build(), Columns_, Settings_.ReadRowsSettings_).Subscribe(
+        [self = shared_from_this(), batch = std::move(batch)] (const TAsyncReadRowsResult& future) mutable {
+            self->Reply(batch, future.GetValue());
+        });
+}
+
+void TPointReader::TImpl::Reply(std::vector<TRequest>& batch, const TReadRowsResult& result) {
+    {
+        std::lock_guard lock(Mutex_);
+        for (const auto& request : batch) {
+            InFlight_.erase(request.PointKey);
+        }
+    }
+
+    const TStatus& status = result;
+    if (!status.IsSuccess()) {
+        for (auto& request : batch) {
+            request.Promise.SetValue(TReadRowsResult(TStatus(status), TResultSet(Ydb::ResultSet())));
+        }
+        return;
+    }
+
+    auto rows = TReadRowsResult(result).GetResultSet();
+    const auto& resultSet = TProtoAccessor::GetProto(rows);
+    auto parts = SplitByPointKey(resultSet, KeyColumns_);
+
+    Ydb::ResultSet notFound;
+    *notFound.mutable_columns() = resultSet.columns();
+
+    for (auto& request : batch) {
+        // Point keys are unique within a batch, so every part is taken once
+        auto it = parts.find(request.PointKey);
+        auto rowsOfKey = it != parts.end() ? TResultSet(std::move(it->second)) : TResultSet(notFound);
+        request.Promise.SetValue(TReadRowsResult(TStatus(status), std::move(rowsOfKey)));
+    }
+}
+
+} // namespace NTable
+} // namespace NYdb
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "request_batch.h"
+#include "table_client.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace NYdb {
+namespace NTable {
+
+// Identity of a key: values of the key columns. Integers and strings are compared by value,
+// as the server converts a key of another type, e.g. Uint32 for a Uint64 column
+std::string GetPointKey(const Ydb::Value& key);
+
+// Splits rows by the values of the key columns, each part has all the columns
+std::unordered_map<std::string, Ydb::ResultSet> SplitByPointKey(const Ydb::ResultSet& resultSet,
+    const std::vector<std::string>& keyColumns);
+
+////////////////////////////////////////////////////////////////////////////////
+
+class TPointReader::TImpl : public std::enable_shared_from_this<TPointReader::TImpl> {
+public:
+    TImpl(const TTableClient& client, std::shared_ptr<TTableClient::TImpl> clientImpl, const std::string& table,
+        const std::vector<std::string>& columns, const TPointReaderSettings& settings);
+
+    TAsyncReadRowsResult ReadRow(const TValue& key);
+
+private:
+    struct TRequest {
+        std::string PointKey;
+        TValue Key;
+        NThreading::TPromise<TReadRowsResult> Promise;
+    };
+
+    void SetKeyType(const TType& type);
+    // Pending reads are failed if the timer of the flush is cancelled
+    void Flush(bool ok);
+    void Send(std::vector<TRequest>&& batch);
+    void Reply(std::vector<TRequest>& batch, const TReadRowsResult& result);
+
+private:
+    TTableClient Client_;
+    std::shared_ptr<TTableClient::TImpl> ClientImpl_;
+    const std::string Table_;
+    const TPointReaderSettings Settings_;
+
+    std::mutex Mutex_;
+    std::vector<std::string> Columns_;
+    // Known after the first key
+    std::optional<TType> KeyType_;
+    std::string KeyTypeId_;
+    std::vector<std::string> KeyColumns_;
+    TRequestBatch<TRequest> Pending_;
+    // Keys waiting in the batch or being read
+    std::unordered_map<std::string, TAsyncReadRowsResult> InFlight_;
+};
+
+} // namespace NTable
+} // namespace NYdb
@@ -0,0 +1,236 @@
+#include <client/ydb_table/impl/point_reader.h>
+#include <client/ydb_types/exceptions/exceptions.h>
+
+#include <ydb/public/api/grpc/ydb_table_v1.grpc.pb.h>
+
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+#include <library/cpp/testing/unittest/tests_data.h>
+
+#include <mutex>
+
+using namespace NYdb;
+using namespace NYdb::NTable;
+
+namespace {
+
+// Row of the key is not in the table
+constexpr ui64 MISSING_ID = 404;
+
+Ydb::Value MakeKey(ui64 id, const std::string& name) {
+    Ydb::Value key;
+    key.add_items()->set_uint64_value(id);
+    key.add_items()->set_text_value(name);
+    return key;
+}
+
+TValue MakeIdKey(ui64 id) {
+    return TValueBuilder()
+        .BeginStruct()
+        .AddMember("id").Uint64(id)
+        .EndStruct()
+        .Build();
+}
+
+// Table of id Uint64 and value Utf8 columns
+class TMockTableService : public Ydb::Table::V1::TableService::Service {
+public:
+    grpc::Status ReadRows(
+        grpc::ServerContext* context,
+        const Ydb::Table::ReadRowsRequest* request,
+        Ydb::Table::ReadRowsResponse* response) override
+    {
+        Y_UNUSED(context);
+
+        const auto& keys = request->keys().value().items();
+        {
+            std::lock_guard lock(Mutex_);
+            BatchSizes_.push_back(keys.size());
+        }
+
+        auto& resultSet = *response->mutable_result_set();
+        auto& idColumn = *resultSet.add_columns();
+        idColumn.set_name("id");
+        idColumn.mutable_type()->set_type_id(Ydb::Type::UINT64);
+        auto& valueColumn = *resultSet.add_columns();
+        valueColumn.set_name("value");
+        valueColumn.mutable_type()->set_type_id(Ydb::Type::UTF8);
+
+        for (const auto& key : keys) {
+            // Key of another type is converted to the type of the column
+            const auto& item = key.items(0);
+            const ui64 id = item.has_uint32_value() ? item.uint32_value() : item.uint64_value();
+            if (id == MISSING_ID) {
+                continue;
+            }
+            auto& row = *resultSet.add_rows();
+            row.add_items()->set_uint64_value(id);
+            row.add_items()->set_text_value("v" + std::to_string(id));
+        }
+
+        response->set_status(Ydb::StatusIds::SUCCESS);
+        return grpc::Status::OK;
+    }
+
+    std::vector<int> GetBatchSizes() {
+        std::lock_guard lock(Mutex_);
+        return BatchSizes_;
+    }
+
+private:
+    std::mutex Mutex_;
+    std::vector<int> BatchSizes_;
+};
+
+class TMockTable {
+public:
+    TMockTable() {
+        TPortManager pm;
+        const std::string addr = "localhost:" + std::to_string(pm.GetPort());
+
+        grpc::ServerBuilder builder;
+        builder.AddListeningPort(addr, grpc::InsecureServerCredentials());
+        builder.RegisterService(&Service);
+        Server = builder.BuildAndStart();
+
+        Driver.emplace(TDriverConfig().SetEndpoint(addr));
+    }
+
+    TPointReader MakeReader(const TPointReaderSettings& settings) {
+        return TPointReader(TTableClient(*Driver), "table", {"value"}, settings);
+    }
+
+    TMockTableService Service;
+    std::unique_ptr<grpc::Server> Server;
+    std::optional<TDriver> Driver;
+};
+
+std::string GetValue(const TAsyncReadRowsResult& future) {
+    const auto& result = future.GetValueSync();
+    UNIT_ASSERT_C(result.IsSuccess(), result.GetIssues().ToString());
+
+    auto parser = TResultSetParser(result.GetResultSet());
+    if (!parser.TryNextRow()) {
+        return {};
+    }
+    auto value = parser.ColumnParser("value").GetUtf8();
+    UNIT_ASSERT(!parser.TryNextRow());
+    return value;
+}
+
+} // namespace
+
+Y_UNIT_TEST_SUITE(PointReaderTest) {
+    Y_UNIT_TEST(SplitByKey) {
+        Ydb::ResultSet resultSet;
+        resultSet.add_columns()->set_name("value");
+        resultSet.add_columns()->set_name("name");
+        resultSet.add_columns()->set_name("id");
+
+        for (ui64 id : {1, 2}) {
+            auto& row = *resultSet.add_rows();
+            row.add_items()->set_text_value("v" + std::to_string(id));
+            row.add_items()->set_text_value("n");
+            row.add_items()->set_uint64_value(id);
+        }
+
+        auto parts = SplitByPointKey(resultSet, {"id", "name"});
+        UNIT_ASSERT_VALUES_EQUAL(parts.size(), 2);
+
+        const auto& part = parts.at(GetPointKey(MakeKey(2, "n")));
+        UNIT_ASSERT_VALUES_EQUAL(part.columns_size(), 3);
+        UNIT_ASSERT_VALUES_EQUAL(part.rows_size(), 1);
+        UNIT_ASSERT_VALUES_EQUAL(part.rows(0).items(0).text_value(), "v2");
+
+        UNIT_ASSERT(!parts.contains(GetPointKey(MakeKey(3, "n"))));
+        UNIT_ASSERT(SplitByPointKey(resultSet, {"id", "missing"}).empty());
+    }
+
+    Y_UNIT_TEST(KeysDoNotCollide) {
+        Ydb::Value left;
+        left.add_items()->set_text_value("ab");
+        left.add_items()->set_text_value("c");
+
+        Ydb::Value right;
+        right.add_items()->set_text_value("a");
+        right.add_items()->set_text_value("bc");
+
+        UNIT_ASSERT_VALUES_UNEQUAL(GetPointKey(left), GetPointKey(right));
+    }
+
+    Y_UNIT_TEST(KeysOfOtherTypes) {
+        Ydb::Value narrow;
+        narrow.add_items()->set_uint32_value(7);
+        narrow.add_items()->set_bytes_value("n");
+        UNIT_ASSERT_VALUES_EQUAL(GetPointKey(narrow), GetPointKey(MakeKey(7, "n")));
+
+        Ydb::Value negative;
+        negative.add_items()->set_int64_value(-7);
+        negative.add_items()->set_text_value("n");
+        UNIT_ASSERT_VALUES_UNEQUAL(GetPointKey(negative), GetPointKey(MakeKey(7, "n")));
+
+        Ydb::Value null;
+        null.add_items()->set_null_flag_value(google::protobuf::NULL_VALUE);
+        null.add_items()->set_text_value("n");
+        UNIT_ASSERT_VALUES_UNEQUAL(GetPointKey(null), GetPointKey(MakeKey(0, "n")));
+    }
+
+    Y_UNIT_TEST(SameKeyIsReadOnce) {
+        TMockTable table;
+        auto reader = table.MakeReader(TPointReaderSettings().MaxBatchSize(2).Window(TDuration::Hours(1)));
+
+        auto first = reader.ReadRow(MakeIdKey(1));
+        auto second = reader.ReadRow(MakeIdKey(1));
+        // Batch is sent when it has two distinct keys
+        auto other = reader.ReadRow(MakeIdKey(2));
+
+        UNIT_ASSERT_VALUES_EQUAL(GetValue(first), "v1");
+        UNIT_ASSERT_VALUES_EQUAL(GetValue(second), "v1");
+        UNIT_ASSERT_VALUES_EQUAL(GetValue(other), "v2");
+        UNIT_ASSERT(table.Service.GetBatchSizes() == std::vector<int>({2}));
+    }
+
+    Y_UNIT_TEST(FullBatchIsSent) {
+        TMockTable table;
+        auto reader = table.MakeReader(TPointReaderSettings().MaxBatchSize(2).Window(TDuration::Hours(1)));
+
+        std::vector<TAsyncReadRowsResult> futures;
+        for (ui64 id : std::vector<ui64>{1, 2, 3, MISSING_ID}) {
+            futures.push_back(reader.ReadRow(MakeIdKey(id)));
+        }
+        auto pending = reader.ReadRow(MakeIdKey(5));
+
+        UNIT_ASSERT_VALUES_EQUAL(GetValue(futures[0]), "v1");
+        UNIT_ASSERT_VALUES_EQUAL(GetValue(futures[1]), "v2");
+        UNIT_ASSERT_VALUES_EQUAL(GetValue(futures[2]), "v3");
+        UNIT_ASSERT_VALUES_EQUAL(GetValue(futures[3]), "");
+        UNIT_ASSERT(table.Service.GetBatchSizes() == std::vector<int>({2, 2}));
+
+        // Flush of the last key is cancelled with the timer
+        UNIT_ASSERT(!pending.HasValue());
+        table.Driver->Stop(true);
+        UNIT_ASSERT_VALUES_EQUAL(pending.GetValueSync().GetStatus(), EStatus::CLIENT_CANCELLED);
+        UNIT_ASSERT(table.Service.GetBatchSizes() == std::vector<int>({2, 2}));
+    }
+
+    Y_UNIT_TEST(KeyOfOtherType) {
+        TMockTable table;
+        auto reader = table.MakeReader(TPointReaderSettings().Window(TDuration::MilliSeconds(10)));
+
+        auto narrow = TValueBuilder()
+            .BeginStruct()
+            .AddMember("id").Uint32(7)
+            .EndStruct()
+            .Build();
+        // Row of a Uint64 column is found by a Uint32 key
+        UNIT_ASSERT_VALUES_EQUAL(GetValue(reader.ReadRow(narrow)), "v7");
+
+        // Keys of one reader are of the same type
+        UNIT_ASSERT_EXCEPTION(reader.ReadRow(MakeIdKey(7)), TContractViolation);
+        UNIT_ASSERT_EXCEPTION(table.MakeReader(TPointReaderSettings()).ReadRow(TValueBuilder().Uint64(7).Build()),
+            TContractViolation);
+    }
+}
@@ -0,0 +1,242 @@
+#include "query_batcher.h"
+
+#define INCLUDE_YDB_INTERNAL_H
+#include <client/impl/ydb_internal/value_helpers/helpers.h>
+#undef INCLUDE_YDB_INTERNAL_H
+
+#include <client/ydb_types/exceptions/exceptions.h>
+
+namespace NYdb {
+namespace NTable {
+
+namespace {
+
+bool IsNameStart(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+bool IsNameChar(char c) {
+    return IsNameStart(c) || (c >= '0' && c <= '9');
+}
+
+// Returns position after the token which starts at pos and ends with terminator
+size_t SkipUntil(std::string_view query, size_t pos, std::string_view terminator) {
+    auto end = query.find(terminator, pos);
+    return end == std::string_view::npos ? query.size() : end + terminator.size();
+}
+
+size_t SkipQuoted(std::string_view query, size_t pos) {
+    const char quote = query[pos++];
+    while (pos < query.size()) {
+        if (query[pos] == '\\') {
+            pos += 2;
+        } else if (query[pos++] == quote) {
+            return pos;
+        }
+    }
+    return query.size();
+}
+
+} // namespace
+
+void AppendRenamedQuery(std::string& out, std::string_view query, std::string_view suffix) {
+    size_t pos = 0;
+    while (pos < query.size()) {
+        size_t next = pos + 1;
+        const char c = query[pos];
+        if (c == '\'' || c == '"') {
+            next = SkipQuoted(query, pos);
+        } else if (c == '`') {
+            next = SkipUntil(query, pos + 1, "`");
+        } else if (query.substr(pos, 2) == "@@") {
+            next = SkipUntil(query, pos + 2, "@@");
+        } else if (query.substr(pos, 2) == "--") {
+            next = SkipUntil(query, pos + 2, "\n");
+        } else if (query.substr(pos, 2) == "/*") {
+            next = SkipUntil(query, pos + 2, "*/");
+        } else if (c == '$' && next < query.size() && IsNameStart(query[next])) {
+            while (next < query.size() && IsNameChar(query[next])) {
+                ++next;
+            }
+            out.append(query.substr(pos, next - pos));
+            out.append(suffix);
+            pos = next;
+            continue;
+        }
+        out.append(query.substr(pos, next - pos));
+        pos = next;
+    }
+}
+
+std::vector<TDataQueryResult> SplitBatchResult(const TStatus& status, const std::optional<TDataQueryResult>& result,
+    size_t batchSize)
+{
+    std::vector<TDataQueryResult> results;
+    results.reserve(batchSize);
+
+    TStatus batchStatus = status;
+    if (batchStatus.IsSuccess() && (!result || result->GetResultSets().size() % batchSize)) {
+        batchStatus = TStatus(EStatus::CLIENT_INTERNAL_ERROR, NYql::TIssues{NYql::TIssue(
+            "Result sets of the batched query can not be split between the callers")});
+    }
+
+    if (!batchStatus.IsSuccess()) {
+        for (size_t i = 0; i < batchSize; ++i) {
+            results.emplace_back(TStatus(batchStatus), std::vector<TResultSet>(), std::nullopt, std::nullopt, false, std::nullopt);
+        }
+        return results;
+    }
+
+    const auto& resultSets = result->GetResultSets();
+    const size_t perRequest = resultSets.size() / batchSize;
+    for (size_t i = 0; i < batchSize; ++i) {
+        std::vector<TResultSet> own(resultSets.begin() + i * perRequest, resultSets.begin() + (i + 1) * perRequest);
+        results.emplace_back(TStatus(batchStatus), std::move(own), std::nullopt, std::nullopt,
+            result->IsQueryFromCache(), result->GetStats());
+    }
+    return results;
+}
+
+bool HaveSameTypes(const TParams& left, const TParams& right) {
+    const auto& leftValues = TProtoAccessor::GetProtoMap(left);
+    const auto& rightValues = TProtoAccessor::GetProtoMap(right);
+    if (leftValues.size() != rightValues.size()) {
+        return false;
+    }
+    for (const auto& [name, value] : leftValues) {
+        auto it = rightValues.find(name);
+        if (it == rightValues.end() || !TypesEqual(value.type(), it->second.type())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TDataQueryBatcher::TImpl::TImpl(const TTableClient& client, std::shared_ptr<TTableClient::TImpl> clientImpl,
+        const std::string& query, const TTxSettings& txSettings, const TDataQueryBatcherSettings& settings)
+    : Client_(client)
+    , ClientImpl_(std::move(clientImpl))
+    , Query_(query)
+    , TxSettings_(txSettings)
+    , Settings_(settings)
+    , Pending_(settings.MaxBatchSize_)
+{
+    if (!Settings_.MaxBatchSize_) {
+        ythrow TContractViolation("MaxBatchSize of the data query batcher must be positive");
+    }
+}
+
+TAsyncDataQueryResult TDataQueryBatcher::TImpl::Execute(const TParams& params) {
+    auto promise = NThreading::NewPromise<TDataQueryResult>();
+    auto future = promise.GetFuture();
+
+    TRequestBatch<TRequest>::TPushResult pushed;
+    {
+        std::lock_guard lock(Mutex_);
+        pushed = Pending_.Push({params, std::move(promise)});
+    }
+
+    if (!pushed.Full.empty()) {
+        Send(std::move(pushed.Full));
+    } else if (pushed.ScheduleFlush) {
+        // Pending requests keep the batcher alive until they are sent
+        ClientImpl_->ScheduleCallback([self = shared_from_this()] (bool ok) {
+            self->Flush(ok);
+        }, Settings_.Window_);
+    }
+
+    return future;
+}
+
+void TDataQueryBatcher::TImpl::Flush(bool ok) {
+    std::vector<TRequest> batch;
+    {
+        std::lock_guard lock(Mutex_);
+        batch = Pending_.Flush();
+    }
+
+    if (!ok) {
+        for (auto& request : batch) {
+            request.Promise.SetValue(TDataQueryResult(TStatus(EStatus::CLIENT_CANCELLED,
+                NYql::TIssues{NYql::TIssue("Client is stopped")}), {}, std::nullopt, std::nullopt, false, std::nullopt));
+        }
+    } else if (!batch.empty()) {
+        Send(std::move(batch));
+    }
+}
+
+std::string TDataQueryBatcher::TImpl::GetSuffix(size_t index) {
+    return "__b" + std::to_string(index);
+}
+
+std::string TDataQueryBatcher::TImpl::GetBatchQuery(size_t batchSize) {
+    std::lock_guard lock(Mutex_);
+    if (BatchQueries_.size() < batchSize) {
+        BatchQueries_.resize(batchSize);
+    }
+
+    auto& text = BatchQueries_[batchSize - 1];
+    if (text.empty()) {
+        for (size_t i = 0; i < batchSize; ++i) {
+            AppendRenamedQuery(text, Query_, GetSuffix(i));
+            text += '\n';
+        }
+    }
+    return text;
+}
+
+void TDataQueryBatcher::TImpl::Send(std::vector<TRequest>&& batch) {
+    // Parameters of other types would fail the declarations of the fused query for the whole batch,
+    // so a request which doesn't match the first one is sent alone
+    std::vector<TRequest> fused;
+    fused.reserve(batch.size());
+    for (auto& request : batch) {
+        if (fused.empty() || HaveSameTypes(fused.front().Params, request.Params)) {
+            fused.push_back(std::move(request));
+        } else {
+            std::vector<TRequest> single;
+            single.push_back(std::move(request));
+            SendFused(std::move(single));
+        }
+    }
+    SendFused(std::move(fused));
+}
+
+void TDataQueryBatcher::TImpl::SendFused(std::vector<TRequest>&& batch) {
+    const size_t batchSize = batch.size();
+
+    TParamsBuilder paramsBuilder;
+    for (size_t i = 0; i < batchSize; ++i) {
+        const auto suffix = GetSuffix(i);
+        for (const auto& [name, value] : batch[i].Params.GetValues()) {
+            paramsBuilder.AddParam(name + suffix, value);
+        }
+    }
+
+    auto query = GetBatchQuery(batchSize);
+    auto params = paramsBuilder.Build();
+    auto result = std::make_shared<std::optional<TDataQueryResult>>();
+
+    auto operation = [query = std::move(query), params = std::move(params), result, txSettings = TxSettings_,
+        execSettings = Settings_.ExecSettings_] (TSession session) -> TAsyncStatus
+    {
+        return session.ExecuteDataQuery(query, TTxControl::BeginTx(txSettings).CommitTx(), params, execSettings)
+            .Apply([result] (const TAsyncDataQueryResult& future) {
+                *result = future.GetValue();
+                return TStatus(**result);
+            });
+    };
+
+    Client_.RetryOperation(std::move(operation), Settings_.RetrySettings_).Subscribe(
+        [batch = std::move(batch), result] (const TAsyncStatus& future) mutable {
+            auto results = SplitBatchResult(future.GetValue(), *result, batch.size());
+            for (size_t i = 0; i < batch.size(); ++i) {
+                batch[i].Promise.SetValue(std::move(results[i]));
+            }
+        });
+}
+
+} // namespace NTable
+} // namespace NYdb
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "request_batch.h"
+#include "table_client.h"
+
+#include <mutex>
+
+namespace NYdb {
+namespace NTable {
+
+// Appends the query text with every "$name" renamed to "$name<suffix>",
+// string literals, quoted identifiers and comments are copied as is
+void AppendRenamedQuery(std::string& out, std::string_view query, std::string_view suffix);
+
+// Splits result of the fused query between batchSize requests, each one gets the same number of
+// result sets. On failure, or if result sets can't be split evenly, every request gets the error.
+std::vector<TDataQueryResult> SplitBatchResult(const TStatus& status, const std::optional<TDataQueryResult>& result,
+    size_t batchSize);
+
+// Parameters of the same names and types, so the copies of the query declare them the same way
+bool HaveSameTypes(const TParams& left, const TParams& right);
+
+////////////////////////////////////////////////////////////////////////////////
+
+class TDataQueryBatcher::TImpl : public std::enable_shared_from_this<TDataQueryBatcher::TImpl> {
+public:
+    TImpl(const TTableClient& client, std::shared_ptr<TTableClient::TImpl> clientImpl, const std::string& query,
+        const TTxSettings& txSettings, const TDataQueryBatcherSettings& settings);
+
+    TAsyncDataQueryResult Execute(const TParams& params);
+
+private:
+    struct TRequest {
+        TParams Params;
+        NThreading::TPromise<TDataQueryResult> Promise;
+    };
+
+    // Pending requests are failed if the timer of the flush is cancelled
+    void Flush(bool ok);
+    void Send(std::vector<TRequest>&& batch);
+    void SendFused(std::vector<TRequest>&& batch);
+    std::string GetBatchQuery(size_t batchSize);
+
+    static std::string GetSuffix(size_t index);
+
+private:
+    TTableClient Client_;
+    std::shared_ptr<TTableClient::TImpl> ClientImpl_;
+    const std::string Query_;
+    const TTxSettings TxSettings_;
+    const TDataQueryBatcherSettings Settings_;
+
+    std::mutex Mutex_;
+    TRequestBatch<TRequest> Pending_;
+    // Fused texts by batch size - 1
+    std::vector<std::string> BatchQueries_;
+};
+
+} // namespace NTable
+} // namespace NYdb
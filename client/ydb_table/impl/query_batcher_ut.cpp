@@ -0,0 +1,145 @@
+#include <client/ydb_table/impl/query_batcher.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+
+using namespace NYdb;
+using namespace NYdb::NTable;
+
+namespace {
+
+TResultSet MakeResultSet(const std::string& column) {
+    Ydb::ResultSet proto;
+    proto.add_columns()->set_name(column);
+    return TResultSet(std::move(proto));
+}
+
+TDataQueryResult MakeResult(std::vector<TResultSet>&& resultSets) {
+    return TDataQueryResult(TStatus(EStatus::SUCCESS, NYql::TIssues()), std::move(resultSets), std::nullopt,
+        std::nullopt, true, std::nullopt);
+}
+
+} // namespace
+
+Y_UNIT_TEST_SUITE(DataQueryBatcherTest) {
+    Y_UNIT_TEST(RenameQuery) {
+        const std::string query = R"(
+            DECLARE $key AS Uint64; -- $key is a lookup key
+            $table = "t";
+            /* $key */
+            SELECT '$key', "\"$key", `$key`, @@$key@@, $key FROM $table WHERE key = $key AND $ = 1;
+        )";
+
+        std::string out;
+        AppendRenamedQuery(out, query, "__b1");
+        UNIT_ASSERT_VALUES_EQUAL(out, R"(
+            DECLARE $key__b1 AS Uint64; -- $key is a lookup key
+            $table__b1 = "t";
+            /* $key */
+            SELECT '$key', "\"$key", `$key`, @@$key@@, $key__b1 FROM $table__b1 WHERE key = $key__b1 AND $ = 1;
+        )");
+    }
+
+    Y_UNIT_TEST(RenameUnterminated) {
+        std::string out;
+        AppendRenamedQuery(out, "SELECT $a, 'abc", "_x");
+        UNIT_ASSERT_VALUES_EQUAL(out, "SELECT $a_x, 'abc");
+    }
+
+    Y_UNIT_TEST(SplitResult) {
+        auto result = MakeResult({MakeResultSet("a0"), MakeResultSet("b0"), MakeResultSet("a1"), MakeResultSet("b1")});
+        auto results = SplitBatchResult(result, result, 2);
+
+        UNIT_ASSERT_VALUES_EQUAL(results.size(), 2);
+        for (size_t i = 0; i < results.size(); ++i) {
+            UNIT_ASSERT(results[i].IsSuccess());
+            UNIT_ASSERT(results[i].IsQueryFromCache());
+            const auto& resultSets = results[i].GetResultSets();
+            UNIT_ASSERT_VALUES_EQUAL(resultSets.size(), 2);
+            UNIT_ASSERT_VALUES_EQUAL(resultSets[0].GetColumnsMeta()[0].Name, "a" + std::to_string(i));
+            UNIT_ASSERT_VALUES_EQUAL(resultSets[1].GetColumnsMeta()[0].Name, "b" + std::to_string(i));
+        }
+    }
+
+    Y_UNIT_TEST(SplitUneven) {
+        auto result = MakeResult({MakeResultSet("a0"), MakeResultSet("a1"), MakeResultSet("a2")});
+        auto results = SplitBatchResult(result, result, 2);
+
+        UNIT_ASSERT_VALUES_EQUAL(results.size(), 2);
+        for (const auto& r : results) {
+            UNIT_ASSERT_VALUES_EQUAL(r.GetStatus(), EStatus::CLIENT_INTERNAL_ERROR);
+            UNIT_ASSERT(r.GetResultSets().empty());
+        }
+    }
+
+    Y_UNIT_TEST(SplitFailure) {
+        TStatus status(EStatus::OVERLOADED, NYql::TIssues{NYql::TIssue("overloaded")});
+        auto results = SplitBatchResult(status, std::nullopt, 3);
+
+        UNIT_ASSERT_VALUES_EQUAL(results.size(), 3);
+        for (const auto& r : results) {
+            UNIT_ASSERT_VALUES_EQUAL(r.GetStatus(), EStatus::OVERLOADED);
+            UNIT_ASSERT_VALUES_EQUAL(r.GetIssues().Size(), 1);
+        }
+    }
+
+    Y_UNIT_TEST(SameTypes) {
+        auto makeParams = [](ui64 key, const std::string& name) {
+            return TParamsBuilder()
+                .AddParam("$key").Uint64(key).Build()
+                .AddParam("$name").Utf8(name).Build()
+                .Build();
+        };
+        UNIT_ASSERT(HaveSameTypes(makeParams(1, "a"), makeParams(2, "b")));
+
+        // other type of a value
+        auto otherType = TParamsBuilder()
+            .AddParam("$key").Uint32(1).Build()
+            .AddParam("$name").Utf8("a").Build()
+            .Build();
+        UNIT_ASSERT(!HaveSameTypes(makeParams(1, "a"), otherType));
+
+        // missing and renamed parameters
+        auto missing = TParamsBuilder()
+            .AddParam("$key").Uint64(1).Build()
+            .Build();
+        UNIT_ASSERT(!HaveSameTypes(makeParams(1, "a"), missing));
+        UNIT_ASSERT(!HaveSameTypes(missing, makeParams(1, "a")));
+
+        auto renamed = TParamsBuilder()
+            .AddParam("$key").Uint64(1).Build()
+            .AddParam("$title").Utf8("a").Build()
+            .Build();
+        UNIT_ASSERT(!HaveSameTypes(makeParams(1, "a"), renamed));
+
+        // optional value is of other type than the plain one
+        auto optional = TParamsBuilder()
+            .AddParam("$key").OptionalUint64(1).Build()
+            .AddParam("$name").Utf8("a").Build()
+            .Build();
+        UNIT_ASSERT(!HaveSameTypes(makeParams(1, "a"), optional));
+    }
+
+    Y_UNIT_TEST(BatchFlush) {
+        TRequestBatch<int> batch(3);
+
+        auto pushed = batch.Push(1);
+        UNIT_ASSERT(pushed.ScheduleFlush);
+        UNIT_ASSERT(pushed.Full.empty());
+
+        pushed = batch.Push(2);
+        UNIT_ASSERT(!pushed.ScheduleFlush);
+        UNIT_ASSERT(pushed.Full.empty());
+
+        // full batch is sent right away
+        pushed = batch.Push(3);
+        UNIT_ASSERT(pushed.Full == std::vector<int>({1, 2, 3}));
+
+        // flush scheduled for the first batch is still pending
+        pushed = batch.Push(4);
+        UNIT_ASSERT(!pushed.ScheduleFlush);
+        UNIT_ASSERT(batch.Flush() == std::vector<int>({4}));
+
+        UNIT_ASSERT(batch.Flush().empty());
+        UNIT_ASSERT(batch.Push(5).ScheduleFlush);
+    }
+}
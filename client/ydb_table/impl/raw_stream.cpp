@@ -0,0 +1,131 @@
+#include "raw_stream.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
+namespace NYdb {
+namespace NTable {
+
+namespace {
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::internal::WireFormatLite;
+
+// Field numbers of ReadTableResponse and ExecuteScanQueryPartialResponse and of their results
+constexpr ui32 ResponseResultField = 3;
+constexpr ui32 ResultResultSetField = 1;
+
+const char* const StreamReadTableMethod = "/Ydb.Table.V1.TableService/StreamReadTable";
+const char* const StreamExecuteScanQueryMethod = "/Ydb.Table.V1.TableService/StreamExecuteScanQuery";
+
+bool DumpBuffer(const grpc::ByteBuffer& buffer, std::string& data) {
+    std::vector<grpc::Slice> slices;
+    if (!buffer.Dump(&slices).ok()) {
+        return false;
+    }
+    data.clear();
+    data.reserve(buffer.Length());
+    for (const auto& slice : slices) {
+        data.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+    }
+    return true;
+}
+
+} // namespace
+
+TRawTableService::Stub::Stub(const std::shared_ptr<grpc::ChannelInterface>& channel)
+    : Channel_(channel)
+    , StreamReadTable_(StreamReadTableMethod, grpc::internal::RpcMethod::SERVER_STREAMING, channel)
+    , StreamExecuteScanQuery_(StreamExecuteScanQueryMethod, grpc::internal::RpcMethod::SERVER_STREAMING, channel)
+{}
+
+std::unique_ptr<grpc::ClientAsyncReader<grpc::ByteBuffer>> TRawTableService::Stub::AsyncStreamReadTable(
+    grpc::ClientContext* context, const Ydb::Table::ReadTableRequest& request, grpc::CompletionQueue* cq, void* tag)
+{
+    return std::unique_ptr<grpc::ClientAsyncReader<grpc::ByteBuffer>>(
+        grpc::internal::ClientAsyncReaderFactory<grpc::ByteBuffer>::Create(
+            Channel_.get(), cq, StreamReadTable_, context, request, true, tag));
+}
+
+std::unique_ptr<grpc::ClientAsyncReader<grpc::ByteBuffer>> TRawTableService::Stub::AsyncStreamExecuteScanQuery(
+    grpc::ClientContext* context, const Ydb::Table::ExecuteScanQueryRequest& request, grpc::CompletionQueue* cq, void* tag)
+{
+    return std::unique_ptr<grpc::ClientAsyncReader<grpc::ByteBuffer>>(
+        grpc::internal::ClientAsyncReaderFactory<grpc::ByteBuffer>::Create(
+            Channel_.get(), cq, StreamExecuteScanQuery_, context, request, true, tag));
+}
+
+std::unique_ptr<TRawTableService::Stub> TRawTableService::NewStub(const std::shared_ptr<grpc::ChannelInterface>& channel) {
+    return std::make_unique<Stub>(channel);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool CutField(std::string_view message, ui32 field, std::string& rest, std::optional<std::string_view>& value) {
+    CodedInputStream input(reinterpret_cast<const ui8*>(message.data()), message.size());
+    rest.clear();
+    value.reset();
+
+    int begin = 0;
+    while (const ui32 tag = input.ReadTag()) {
+        if (WireFormatLite::GetTagFieldNumber(tag) == field
+            && WireFormatLite::GetTagWireType(tag) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED)
+        {
+            ui32 size;
+            if (value || !input.ReadVarint32(&size)) {
+                return false;
+            }
+            const int offset = input.CurrentPosition();
+            if (!input.Skip(size)) {
+                return false;
+            }
+            value = message.substr(offset, size);
+        } else {
+            if (!WireFormatLite::SkipField(&input, tag)) {
+                return false;
+            }
+            rest.append(message.substr(begin, input.CurrentPosition() - begin));
+        }
+        begin = input.CurrentPosition();
+    }
+    return input.ConsumedEntireMessage();
+}
+
+template <typename TResponse>
+bool ParseStreamPart(const grpc::ByteBuffer& buffer, TResponse& response, std::optional<std::string>& resultSet) {
+    resultSet.reset();
+
+    std::string data;
+    if (!DumpBuffer(buffer, data)) {
+        return false;
+    }
+
+    std::string rest;
+    std::string resultRest;
+    std::optional<std::string_view> result;
+    std::optional<std::string_view> resultSetValue;
+    if (!CutField(data, ResponseResultField, rest, result)
+        || (result && !CutField(*result, ResultResultSetField, resultRest, resultSetValue)))
+    {
+        return response.ParseFromString(data);
+    }
+
+    if (!response.ParseFromString(rest)) {
+        return false;
+    }
+    if (result && !response.mutable_result()->ParseFromString(resultRest)) {
+        return false;
+    }
+    if (resultSetValue) {
+        resultSet.emplace(*resultSetValue);
+    }
+    return true;
+}
+
+template bool ParseStreamPart(const grpc::ByteBuffer& buffer, Ydb::Table::ReadTableResponse& response,
+    std::optional<std::string>& resultSet);
+template bool ParseStreamPart(const grpc::ByteBuffer& buffer, Ydb::Table::ExecuteScanQueryPartialResponse& response,
+    std::optional<std::string>& resultSet);
+
+} // namespace NTable
+} // namespace NYdb
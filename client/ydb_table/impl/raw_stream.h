@@ -0,0 +1,50 @@
+#pragma once
+
+#include <ydb/public/api/grpc/ydb_table_v1.grpc.pb.h>
+
+#include <grpc++/grpc++.h>
+#include <grpc++/support/async_stream.h>
+
+#include <util/system/types.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace NYdb {
+namespace NTable {
+
+// Server streams of the table service whose parts are read as raw bytes,
+// result sets of the parts are given to TResultSet::FromSerialized without parsing the rows
+struct TRawTableService {
+    class Stub {
+    public:
+        explicit Stub(const std::shared_ptr<grpc::ChannelInterface>& channel);
+
+        std::unique_ptr<grpc::ClientAsyncReader<grpc::ByteBuffer>> AsyncStreamReadTable(grpc::ClientContext* context,
+            const Ydb::Table::ReadTableRequest& request, grpc::CompletionQueue* cq, void* tag);
+
+        std::unique_ptr<grpc::ClientAsyncReader<grpc::ByteBuffer>> AsyncStreamExecuteScanQuery(grpc::ClientContext* context,
+            const Ydb::Table::ExecuteScanQueryRequest& request, grpc::CompletionQueue* cq, void* tag);
+
+    private:
+        const std::shared_ptr<grpc::ChannelInterface> Channel_;
+        const grpc::internal::RpcMethod StreamReadTable_;
+        const grpc::internal::RpcMethod StreamExecuteScanQuery_;
+    };
+
+    static std::unique_ptr<Stub> NewStub(const std::shared_ptr<grpc::ChannelInterface>& channel);
+};
+
+// Splits serialized message into the rest of the message and the value of a length delimited field.
+// Returns false if the message is corrupted or the field occurs more than once (protobuf merges such values).
+bool CutField(std::string_view message, ui32 field, std::string& rest, std::optional<std::string_view>& value);
+
+// Parses part of ReadTable or ExecuteScanQuery stream except for result.result_set,
+// whose serialized value is returned separately. Messages which can't be split are parsed entirely,
+// result set is left in the response then. Returns false if the part is not a valid message.
+template <typename TResponse>
+bool ParseStreamPart(const grpc::ByteBuffer& buffer, TResponse& response, std::optional<std::string>& resultSet);
+
+} // namespace NTable
+} // namespace NYdb
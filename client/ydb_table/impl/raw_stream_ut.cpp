@@ -0,0 +1,146 @@
+#include <client/ydb_table/impl/raw_stream.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+
+using namespace NYdb;
+using namespace NYdb::NTable;
+
+namespace {
+
+// Bytes of the message are split into several slices as grpc may receive them
+grpc::ByteBuffer MakeBuffer(const std::string& data) {
+    const size_t half = data.size() / 2;
+    grpc::Slice slices[] = {
+        grpc::Slice(data.substr(0, half)),
+        grpc::Slice(data.substr(half)),
+    };
+    return grpc::ByteBuffer(slices, 2);
+}
+
+Ydb::ResultSet MakeResultSet(ui64 firstId, size_t rows) {
+    Ydb::ResultSet resultSet;
+    auto& column = *resultSet.add_columns();
+    column.set_name("id");
+    column.mutable_type()->set_type_id(Ydb::Type::UINT64);
+    for (size_t i = 0; i < rows; ++i) {
+        resultSet.add_rows()->add_items()->set_uint64_value(firstId + i);
+    }
+    return resultSet;
+}
+
+} // namespace
+
+Y_UNIT_TEST_SUITE(RawStreamTest) {
+    Y_UNIT_TEST(CutField) {
+        Ydb::Table::ReadTableResponse response;
+        response.set_status(Ydb::StatusIds::SUCCESS);
+        *response.mutable_result()->mutable_result_set() = MakeResultSet(1, 2);
+        response.mutable_snapshot()->set_plan_step(42);
+
+        const std::string message = response.SerializeAsString();
+        std::string rest;
+        std::optional<std::string_view> value;
+        UNIT_ASSERT(NTable::CutField(message, 3, rest, value));
+        UNIT_ASSERT(value);
+        UNIT_ASSERT_VALUES_EQUAL(std::string(*value), response.result().SerializeAsString());
+
+        Ydb::Table::ReadTableResponse restMessage;
+        UNIT_ASSERT(restMessage.ParseFromString(rest));
+        UNIT_ASSERT_VALUES_EQUAL(restMessage.status(), Ydb::StatusIds::SUCCESS);
+        UNIT_ASSERT_VALUES_EQUAL(restMessage.snapshot().plan_step(), 42);
+        UNIT_ASSERT(!restMessage.has_result());
+
+        std::string restOfRest;
+        UNIT_ASSERT(NTable::CutField(rest, 3, restOfRest, value));
+        UNIT_ASSERT(!value);
+        UNIT_ASSERT_VALUES_EQUAL(restOfRest, rest);
+
+        // Repeated field can't be cut out, the values are merged by protobuf
+        UNIT_ASSERT(!NTable::CutField(message + message, 3, rest, value));
+        // Length of the field is out of the message
+        UNIT_ASSERT(!NTable::CutField(std::string("\x1a\x10" "abc"), 3, rest, value));
+    }
+
+    Y_UNIT_TEST(ScanQueryPart) {
+        Ydb::Table::ExecuteScanQueryPartialResponse response;
+        response.set_status(Ydb::StatusIds::SUCCESS);
+        response.add_issues()->set_message("warning");
+        auto& result = *response.mutable_result();
+        *result.mutable_result_set() = MakeResultSet(1, 3);
+        result.mutable_query_stats()->set_process_cpu_time_us(7);
+        result.set_query_full_diagnostics("plan");
+
+        Ydb::Table::ExecuteScanQueryPartialResponse parsed;
+        std::optional<std::string> resultSet;
+        UNIT_ASSERT(ParseStreamPart(MakeBuffer(response.SerializeAsString()), parsed, resultSet));
+
+        UNIT_ASSERT(resultSet);
+        UNIT_ASSERT_VALUES_EQUAL(*resultSet, result.result_set().SerializeAsString());
+        UNIT_ASSERT(!parsed.result().has_result_set());
+
+        UNIT_ASSERT_VALUES_EQUAL(parsed.status(), Ydb::StatusIds::SUCCESS);
+        UNIT_ASSERT_VALUES_EQUAL(parsed.issues_size(), 1);
+        UNIT_ASSERT_VALUES_EQUAL(parsed.issues(0).message(), "warning");
+        UNIT_ASSERT_VALUES_EQUAL(parsed.result().query_stats().process_cpu_time_us(), 7);
+        UNIT_ASSERT_VALUES_EQUAL(parsed.result().query_full_diagnostics(), "plan");
+    }
+
+    Y_UNIT_TEST(ReadTablePart) {
+        Ydb::Table::ReadTableResponse response;
+        response.set_status(Ydb::StatusIds::SUCCESS);
+        *response.mutable_result()->mutable_result_set() = MakeResultSet(10, 2);
+        response.mutable_snapshot()->set_plan_step(1);
+        response.mutable_snapshot()->set_tx_id(2);
+
+        // Previous part is not left in the parsed message
+        Ydb::Table::ReadTableResponse parsed;
+        parsed.add_issues()->set_message("previous");
+
+        std::optional<std::string> resultSet;
+        UNIT_ASSERT(ParseStreamPart(MakeBuffer(response.SerializeAsString()), parsed, resultSet));
+        UNIT_ASSERT(resultSet);
+        UNIT_ASSERT_VALUES_EQUAL(*resultSet, response.result().result_set().SerializeAsString());
+        UNIT_ASSERT_VALUES_EQUAL(parsed.issues_size(), 0);
+        UNIT_ASSERT_VALUES_EQUAL(parsed.snapshot().plan_step(), 1);
+        UNIT_ASSERT_VALUES_EQUAL(parsed.snapshot().tx_id(), 2);
+    }
+
+    Y_UNIT_TEST(PartWithoutResultSet) {
+        Ydb::Table::ExecuteScanQueryPartialResponse response;
+        response.set_status(Ydb::StatusIds::SUCCESS);
+        response.mutable_result()->mutable_query_stats()->set_process_cpu_time_us(7);
+
+        Ydb::Table::ExecuteScanQueryPartialResponse parsed;
+        std::optional<std::string> resultSet = "previous";
+        UNIT_ASSERT(ParseStreamPart(MakeBuffer(response.SerializeAsString()), parsed, resultSet));
+        UNIT_ASSERT(!resultSet);
+        UNIT_ASSERT(parsed.has_result());
+        UNIT_ASSERT_VALUES_EQUAL(parsed.result().query_stats().process_cpu_time_us(), 7);
+
+        response.clear_result();
+        UNIT_ASSERT(ParseStreamPart(MakeBuffer(response.SerializeAsString()), parsed, resultSet));
+        UNIT_ASSERT(!resultSet);
+        UNIT_ASSERT(!parsed.has_result());
+    }
+
+    Y_UNIT_TEST(MergedPartIsParsedEntirely) {
+        Ydb::Table::ReadTableResponse first;
+        *first.mutable_result()->mutable_result_set() = MakeResultSet(1, 2);
+        Ydb::Table::ReadTableResponse second;
+        *second.mutable_result()->mutable_result_set() = MakeResultSet(3, 1);
+
+        Ydb::Table::ReadTableResponse parsed;
+        std::optional<std::string> resultSet;
+        UNIT_ASSERT(ParseStreamPart(MakeBuffer(first.SerializeAsString() + second.SerializeAsString()), parsed, resultSet));
+        UNIT_ASSERT(!resultSet);
+        UNIT_ASSERT_VALUES_EQUAL(parsed.result().result_set().rows_size(), 3);
+        UNIT_ASSERT_VALUES_EQUAL(parsed.result().result_set().rows(2).items(0).uint64_value(), 3);
+    }
+
+    Y_UNIT_TEST(CorruptedPart) {
+        Ydb::Table::ReadTableResponse parsed;
+        std::optional<std::string> resultSet;
+        UNIT_ASSERT(!ParseStreamPart(MakeBuffer(std::string("\x1a\x10" "abc")), parsed, resultSet));
+        UNIT_ASSERT(!resultSet);
+    }
+}
@@ -8,6 +8,27 @@ namespace NTable {
 
 using namespace NThreading;
 
+namespace {
+
+template <typename TResponse>
+TResultSet ExtractResultSet(TResponse& response, std::optional<std::string>& serialized) {
+    if (serialized) {
+        return TResultSet::FromSerialized(std::move(*serialized));
+    }
+    return TResultSet(std::move(*response.mutable_result()->mutable_result_set()));
+}
+
+// Malformed part fails the stream as if the message was not deserialized by grpc
+template <typename TResponse>
+void ParsePart(const grpc::ByteBuffer& part, TResponse& response, std::optional<std::string>& resultSet,
+    NYdbGrpc::TGrpcStatus& grpcStatus)
+{
+    if (grpcStatus.Ok() && !ParseStreamPart(part, response, resultSet)) {
+        grpcStatus = NYdbGrpc::TGrpcStatus::Internal("Failed to parse part of the stream");
+    }
+}
+
+} // namespace
 
 TTablePartIterator::TReaderImpl::TReaderImpl(TStreamProcessorPtr streamProcessor, const std::string& endpoint)
     : StreamProcessor_(streamProcessor)
@@ -27,6 +48,9 @@ TAsyncSimpleStreamPart<TResultSet> TTablePartIterator::TReaderImpl::ReadNext(std
     auto promise = NThreading::NewPromise<TSimpleStreamPart<TResultSet>>();
     // Capture self - guarantee no dtor call during the read
     auto readCb = [self, promise](TGRpcStatus&& grpcStatus) mutable {
+        std::optional<std::string> resultSet;
+        ParsePart(self->Part_, self->Response_, resultSet, grpcStatus);
+
         std::optional<TReadTableSnapshot> snapshot;
         if (self->Response_.has_snapshot()) {
             snapshot.emplace(
@@ -35,19 +59,19 @@ TAsyncSimpleStreamPart<TResultSet> TTablePartIterator::TReaderImpl::ReadNext(std
         }
         if (!grpcStatus.Ok()) {
             self->Finished_ = true;
-            promise.SetValue({TResultSet(std::move(*self->Response_.mutable_result()->mutable_result_set())),
+            promise.SetValue({ExtractResultSet(self->Response_, resultSet),
                             TStatus(TPlainStatus(grpcStatus, self->Endpoint_)),
                             snapshot});
         } else {
             NYql::TIssues issues;
             NYql::IssuesFromMessage(self->Response_.issues(), issues);
             EStatus clientStatus = static_cast<EStatus>(self->Response_.status());
-            promise.SetValue({TResultSet(std::move(*self->Response_.mutable_result()->mutable_result_set())),
+            promise.SetValue({ExtractResultSet(self->Response_, resultSet),
                             TStatus(clientStatus, std::move(issues)),
                             snapshot});
         }
     };
-    StreamProcessor_->Read(&Response_, readCb);
+    StreamProcessor_->Read(&Part_, readCb);
     return promise.GetFuture();
 }
 
@@ -71,6 +95,9 @@ TAsyncScanQueryPart TScanQueryPartIterator::TReaderImpl::ReadNext(std::shared_pt
     auto promise = NThreading::NewPromise<TScanQueryPart>();
     // Capture self - guarantee no dtor call during the read
     auto readCb = [self, promise](TGRpcStatus&& grpcStatus) mutable {
+        std::optional<std::string> resultSet;
+        ParsePart(self->Part_, self->Response_, resultSet, grpcStatus);
+
         if (!grpcStatus.Ok()) {
             self->Finished_ = true;
             promise.SetValue({TStatus(TPlainStatus(grpcStatus, self->Endpoint_))});
@@ -90,15 +117,15 @@ TAsyncScanQueryPart TScanQueryPartIterator::TReaderImpl::ReadNext(std::shared_pt
 
             diagnostics = self->Response_.result().query_full_diagnostics();
 
-            if (self->Response_.result().has_result_set()) {
+            if (resultSet || self->Response_.result().has_result_set()) {
                 promise.SetValue({std::move(status),
-                    TResultSet(std::move(*self->Response_.mutable_result()->mutable_result_set())), queryStats, diagnostics});
+                    ExtractResultSet(self->Response_, resultSet), queryStats, diagnostics});
             } else {
                 promise.SetValue({std::move(status), queryStats, diagnostics});
             }
         }
     };
-    StreamProcessor_->Read(&Response_, readCb);
+    StreamProcessor_->Read(&Part_, readCb);
     return promise.GetFuture();
 }
 
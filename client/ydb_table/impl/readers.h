@@ -9,6 +9,7 @@
 
 #include "client_session.h"
 #include "data_query.h"
+#include "raw_stream.h"
 #include "request_migrator.h"
 
 
@@ -22,8 +23,9 @@ class TTablePartIterator::TReaderImpl {
 public:
     using TSelf = TTablePartIterator::TReaderImpl;
     using TResponse = Ydb::Table::ReadTableResponse;
-    using TStreamProcessorPtr = NYdbGrpc::IStreamRequestReadProcessor<TResponse>::TPtr;
-    using TReadCallback = NYdbGrpc::IStreamRequestReadProcessor<TResponse>::TReadCallback;
+    // Parts are read as raw bytes to make result sets of them without parsing the rows
+    using TStreamProcessorPtr = NYdbGrpc::IStreamRequestReadProcessor<grpc::ByteBuffer>::TPtr;
+    using TReadCallback = NYdbGrpc::IStreamRequestReadProcessor<grpc::ByteBuffer>::TReadCallback;
     using TGRpcStatus = NYdbGrpc::TGrpcStatus;
     using TBatchReadResult = std::pair<TResponse, TGRpcStatus>;
 
@@ -34,6 +36,7 @@ public:
 
 private:
     TStreamProcessorPtr StreamProcessor_;
+    grpc::ByteBuffer Part_;
     TResponse Response_;
     bool Finished_;
     std::string Endpoint_;
@@ -44,8 +47,9 @@ class TScanQueryPartIterator::TReaderImpl {
 public:
     using TSelf = TScanQueryPartIterator::TReaderImpl;
     using TResponse = Ydb::Table::ExecuteScanQueryPartialResponse;
-    using TStreamProcessorPtr = NYdbGrpc::IStreamRequestReadProcessor<TResponse>::TPtr;
-    using TReadCallback = NYdbGrpc::IStreamRequestReadProcessor<TResponse>::TReadCallback;
+    // Parts are read as raw bytes to make result sets of them without parsing the rows
+    using TStreamProcessorPtr = NYdbGrpc::IStreamRequestReadProcessor<grpc::ByteBuffer>::TPtr;
+    using TReadCallback = NYdbGrpc::IStreamRequestReadProcessor<grpc::ByteBuffer>::TReadCallback;
     using TGRpcStatus = NYdbGrpc::TGrpcStatus;
     using TBatchReadResult = std::pair<TResponse, TGRpcStatus>;
 
@@ -56,6 +60,7 @@ public:
 
 private:
     TStreamProcessorPtr StreamProcessor_;
+    grpc::ByteBuffer Part_;
     TResponse Response_;
     bool Finished_;
     std::string Endpoint_;
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace NYdb {
+namespace NTable {
+
+// Requests collected within a time window, the batch is sent when the window is over
+// or as soon as it is full. Not thread safe, owner keeps it under its lock.
+template <typename TRequest>
+class TRequestBatch {
+public:
+    struct TPushResult {
+        // Whole batch if it became full, it must be sent right away
+        std::vector<TRequest> Full;
+        // Set for the first request of the batch, flush must be scheduled at the end of the window
+        bool ScheduleFlush = false;
+    };
+
+    explicit TRequestBatch(size_t maxSize)
+        : MaxSize_(maxSize)
+    {}
+
+    TPushResult Push(TRequest&& request) {
+        TPushResult result;
+        Pending_.push_back(std::move(request));
+        if (Pending_.size() >= MaxSize_) {
+            result.Full.swap(Pending_);
+        } else if (!FlushScheduled_) {
+            FlushScheduled_ = true;
+            result.ScheduleFlush = true;
+        }
+        return result;
+    }
+
+    // Called at the end of the window, returns the requests collected so far
+    std::vector<TRequest> Flush() {
+        FlushScheduled_ = false;
+        std::vector<TRequest> batch;
+        batch.swap(Pending_);
+        return batch;
+    }
+
+private:
+    const size_t MaxSize_;
+    std::vector<TRequest> Pending_;
+    bool FlushScheduled_ = false;
+};
+
+} // namespace NTable
+} // namespace NYdb
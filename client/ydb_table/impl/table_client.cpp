@@ -7,6 +7,7 @@ namespace NTable {
 using namespace NThreading;
 
 const TKeepAliveSettings TTableClient::TImpl::KeepAliveSettings = TKeepAliveSettings().ClientTimeout(KEEP_ALIVE_CLIENT_TIMEOUT);
+const TPrepareDataQuerySettings TTableClient::TImpl::WarmUpPrepareSettings = TPrepareDataQuerySettings().ClientTimeout(KEEP_ALIVE_CLIENT_TIMEOUT);
 
 
 TDuration GetMinTimeToTouch(const TSessionPoolSettings& settings) {
@@ -22,6 +23,10 @@ TTableClient::TImpl::TImpl(std::shared_ptr<TGRpcConnectionsImpl>&& connections,
     , Settings_(settings)
     , SessionPool_(Settings_.SessionPoolSettings_.MaxActiveSessions_)
 {
+    if (Settings_.UseQueryCache_) {
+        QueryRegistry_ = std::make_shared<NSessionPool::TQueryRegistry>(Settings_.QueryCacheSize_);
+    }
+
     if (!DbDriverState_->StatCollector.IsCollecting()) {
         return;
     }
@@ -82,6 +87,10 @@ void TTableClient::TImpl::ScheduleTaskUnsafe(std::function<void()>&& fn, TDurati
     Connections_->ScheduleOneTimeTask(std::move(fn), timeout);
 }
 
+void TTableClient::TImpl::ScheduleCallback(std::function<void(bool)>&& callback, TDuration timeout) {
+    Connections_->ScheduleCallback(timeout, std::move(callback));
+}
+
 void TTableClient::TImpl::StartPeriodicSessionPoolTask() {
     // Session pool guarantees than client is alive during call callbacks
     auto deletePredicate = [this](TKqpSessionCommon* s, size_t sessionsCount) {
@@ -98,7 +107,7 @@ void TTableClient::TImpl::StartPeriodicSessionPoolTask() {
         return false;
     };
 
-    auto keepAliveCmd = [this](TKqpSessionCommon* s) {
+    auto keepAliveCmd = [this](TKqpSessionCommon* s, NSessionPool::TInFlightToken token) {
         auto strongClient = shared_from_this();
         TSession session(
             strongClient,
@@ -109,6 +118,11 @@ void TTableClient::TImpl::StartPeriodicSessionPoolTask() {
 
         Y_ABORT_UNLESS(!session.GetId().empty());
 
+        if (NeedWarmUp(s) && WarmUpSession(session, token)) {
+            // Prepare request touches session as well as keep alive
+            return;
+        }
+
         const auto sessionPoolSettings = session.Client_->Settings_.SessionPoolSettings_;
         const auto spentTime = session.SessionImpl_->GetTimeToTouchFast() - session.SessionImpl_->GetTimeInPastFast();
 
@@ -130,7 +144,7 @@ void TTableClient::TImpl::StartPeriodicSessionPoolTask() {
             // We just need to reschedule time to next call because InjectSessionStatusInterception doesn't
             // update timeInPast for calls from internal keep alive routine
             session.KeepAlive(KeepAliveSettings)
-                .Subscribe([spentTime, session, maxTimeToTouch, calcTimeToNextTouch](TAsyncKeepAliveResult asyncResult) {
+                .Subscribe([spentTime, session, maxTimeToTouch, calcTimeToNextTouch, token](TAsyncKeepAliveResult asyncResult) {
                     if (!asyncResult.GetValue().IsSuccess())
                         return;
 
@@ -149,15 +163,133 @@ void TTableClient::TImpl::StartPeriodicSessionPoolTask() {
         );
     };
 
+    NSessionPool::TSessionPool::TWarmUpPredicate warmUpPredicate;
+    if (QueryRegistry_ && Settings_.QueryCacheWarmUpSize_) {
+        warmUpPredicate = [this](TKqpSessionCommon* s) {
+            return NeedWarmUp(s);
+        };
+    }
+
+    // Creates session in background, it returns to the pool as idle when the request is done
+    auto createSessionCmd = [this](NSessionPool::TInFlightToken token) {
+        TCreateSessionSettings settings;
+        settings.ClientTimeout(KEEP_ALIVE_CLIENT_TIMEOUT);
+        CreateSession(settings, false)
+            .Subscribe([token](const TAsyncCreateSessionResult&) {
+            });
+    };
+
+    NSessionPool::TPeriodicTaskSettings periodicTaskSettings;
+    periodicTaskSettings.KeepAliveInterval = Settings_.SessionPoolSettings_.KeepAliveIdleThreshold_;
+    periodicTaskSettings.MinPoolSize = Settings_.SessionPoolSettings_.MinPoolSize_;
+    periodicTaskSettings.KeepMinPoolSizeWarm = Settings_.SessionPoolSettings_.KeepMinPoolSizeWarm_;
+
     std::weak_ptr<TTableClient::TImpl> weak = shared_from_this();
     Connections_->AddPeriodicTask(
         SessionPool_.CreatePeriodicTask(
             weak,
             std::move(keepAliveCmd),
-            std::move(deletePredicate)
+            std::move(deletePredicate),
+            std::move(warmUpPredicate),
+            std::move(createSessionCmd),
+            periodicTaskSettings
         ), NSessionPool::PERIODIC_ACTION_INTERVAL);
 }
 
+void TTableClient::TImpl::PrewarmSessionPool() {
+    const auto& sessionPoolSettings = Settings_.SessionPoolSettings_;
+    ui32 sessionsCount = sessionPoolSettings.PrewarmSessions_;
+    if (sessionPoolSettings.MaxActiveSessions_) {
+        sessionsCount = Min(sessionsCount, sessionPoolSettings.MaxActiveSessions_);
+    }
+    if (!sessionsCount) {
+        return;
+    }
+
+    auto readyPromise = NewPromise<void>();
+    Connections_->AddStartupTask(readyPromise.GetFuture());
+
+    std::weak_ptr<TTableClient::TImpl> weak = shared_from_this();
+    DbDriverState_->DiscoveryCompleted().Subscribe([weak, sessionsCount, readyPromise](const TFuture<void>&) mutable {
+        auto strongClient = weak.lock();
+        if (!strongClient) {
+            readyPromise.SetValue();
+            return;
+        }
+
+        // All sessions are requested at once, round robin over the best endpoints
+        const auto endpoints = strongClient->DbDriverState_->EndpointPool.GetBestEndpoints();
+        TCreateSessionSettings settings;
+        settings.ClientTimeout(KEEP_ALIVE_CLIENT_TIMEOUT);
+
+        std::vector<TAsyncCreateSessionResult> results;
+        results.reserve(sessionsCount);
+        for (ui32 i = 0; i < sessionsCount; ++i) {
+            auto endpoint = endpoints.empty() ? std::string() : endpoints[i % endpoints.size()].Endpoint.Get();
+            results.emplace_back(strongClient->CreateSession(settings, false, std::move(endpoint)));
+        }
+
+        auto allDone = NThreading::WaitAll(results);
+        allDone.Subscribe([results = std::move(results), readyPromise](const TFuture<void>&) mutable {
+            for (auto& result : results) {
+                // Session returns to the pool as idle, broken one is just deleted
+                result.ExtractValue();
+            }
+            readyPromise.SetValue();
+        });
+    });
+}
+
+bool TTableClient::TImpl::NeedWarmUp(const TKqpSessionCommon* s) const {
+    if (!QueryRegistry_ || !Settings_.QueryCacheWarmUpSize_) {
+        return false;
+    }
+    return static_cast<const TSession::TImpl*>(s)->GetWarmUpGeneration() != QueryRegistry_->GetGeneration();
+}
+
+bool TTableClient::TImpl::WarmUpSession(const TSession& session, const NSessionPool::TInFlightToken& token) {
+    // Queries are prepared one by one since session can't serve concurrent requests.
+    // Session returns to the pool when the last prepare is done or failed.
+    const ui64 generation = QueryRegistry_->GetGeneration();
+    auto queries = std::make_shared<std::vector<std::string>>();
+    for (auto& query : QueryRegistry_->GetHotQueries(Settings_.QueryCacheWarmUpSize_)) {
+        if (!QueryRegistry_->IsPrepared(query.Key, session.GetId())) {
+            queries->emplace_back(std::move(query.Text));
+        }
+    }
+    session.SessionImpl_->SetWarmUpGeneration(generation);
+    if (queries->empty()) {
+        return false;
+    }
+
+    struct TPrepareChain {
+        static void Run(TSession session, std::shared_ptr<std::vector<std::string>> queries, size_t idx,
+            NSessionPool::TInFlightToken token)
+        {
+            if (idx >= queries->size()) {
+                return;
+            }
+
+            auto client = session.Client_;
+            auto prepared = ::NYdb::NSessionPool::InjectSessionStatusInterception(
+                session.SessionImpl_,
+                client->PrepareDataQuery(session, (*queries)[idx], WarmUpPrepareSettings),
+                true,
+                GetMinTimeToTouch(client->Settings_.SessionPoolSettings_));
+
+            prepared.Subscribe([session, queries, idx, token](const TAsyncPrepareQueryResult& result) mutable {
+                if (!result.GetValue().IsSuccess()) {
+                    return;
+                }
+                Run(std::move(session), std::move(queries), idx + 1, std::move(token));
+            });
+        }
+    };
+
+    TPrepareChain::Run(session, std::move(queries), 0, token);
+    return true;
+}
+
 ui64 TTableClient::TImpl::ScanForeignLocations(std::shared_ptr<TTableClient::TImpl> client) {
     size_t max = 0;
     ui64 result = 0;
@@ -339,9 +471,22 @@ TAsyncCreateSessionResult TTableClient::TImpl::GetSession(const TCreateSessionSe
         const TDuration ClientTimeout;
     };
 
+    NSessionPool::TSessionPool::TSessionPreference preference;
+    if (QueryRegistry_ && settings.QueryAffinity_) {
+        preference = [registry = QueryRegistry_, key = EncodeQuery(*settings.QueryAffinity_, Settings_.AllowRequestMigration_)]
+            (const TKqpSessionCommon* s) {
+                return registry->IsPrepared(key, s->GetId());
+            };
+    }
+
     auto ctx = std::make_unique<TTableClientGetSessionCtx>(shared_from_this(), settings.ClientTimeout_);
     auto future = ctx->GetFuture();
-    SessionPool_.GetSession(std::move(ctx));
+    if (auto span = StartSpan("ydb.GetSession", NTracing::ESpanKind::Internal, settings.TraceParent_)) {
+        future.Subscribe([span](const TAsyncCreateSessionResult& result) {
+            span->End(result.HasValue() ? result.GetValue().GetStatus() : EStatus::CLIENT_INTERNAL_ERROR);
+        });
+    }
+    SessionPool_.GetSession(std::move(ctx), preference);
     return future;
 }
 
@@ -788,12 +933,12 @@ NThreading::TFuture<std::pair<TPlainStatus, TTableClient::TImpl::TReadTableStrea
 
     auto promise = NewPromise<std::pair<TPlainStatus, TReadTableStreamProcessorPtr>>();
 
-    Connections_->StartReadStream<Ydb::Table::V1::TableService, Ydb::Table::ReadTableRequest, Ydb::Table::ReadTableResponse>(
+    Connections_->StartReadStream<TRawTableService, Ydb::Table::ReadTableRequest, grpc::ByteBuffer>(
         std::move(request),
         [promise] (TPlainStatus status, TReadTableStreamProcessorPtr processor) mutable {
             promise.SetValue(std::make_pair(status, processor));
         },
-        &Ydb::Table::V1::TableService::Stub::AsyncStreamReadTable,
+        &TRawTableService::Stub::AsyncStreamReadTable,
         DbDriverState_,
         TRpcRequestSettings::Make(settings));
 
@@ -1007,15 +1152,15 @@ TFuture<std::pair<TPlainStatus, TTableClient::TImpl::TScanQueryProcessorPtr>> TT
     auto promise = NewPromise<std::pair<TPlainStatus, TScanQueryProcessorPtr>>();
 
     Connections_->StartReadStream<
-        Ydb::Table::V1::TableService,
+        TRawTableService,
         Ydb::Table::ExecuteScanQueryRequest,
-        Ydb::Table::ExecuteScanQueryPartialResponse>
+        grpc::ByteBuffer>
     (
         std::move(request),
         [promise] (TPlainStatus status, TScanQueryProcessorPtr processor) mutable {
             promise.SetValue(std::make_pair(status, processor));
         },
-        &Ydb::Table::V1::TableService::Stub::AsyncStreamExecuteScanQuery,
+        &TRawTableService::Stub::AsyncStreamExecuteScanQuery,
         DbDriverState_,
         TRpcRequestSettings::Make(settings)
     );
@@ -42,7 +42,10 @@ public:
     NThreading::TFuture<void> Drain();
     NThreading::TFuture<void> Stop();
     void ScheduleTaskUnsafe(std::function<void()>&& fn, TDuration timeout);
+    // Callback gets false instead of being dropped if the timer is cancelled, e.g. when the driver is stopped
+    void ScheduleCallback(std::function<void(bool)>&& callback, TDuration timeout);
     void StartPeriodicSessionPoolTask();
+    void PrewarmSessionPool();
     static ui64 ScanForeignLocations(std::shared_ptr<TTableClient::TImpl> client);
     static std::pair<ui64, size_t> ScanLocation(std::shared_ptr<TTableClient::TImpl> client,
         std::unordered_map<ui64, size_t>& sessions, bool allNodes);
@@ -56,6 +59,9 @@ public:
     TAsyncCreateSessionResult CreateSession(const TCreateSessionSettings& settings, bool standalone,
         std::string preferredLocation = std::string());
     TAsyncKeepAliveResult KeepAlive(const TSession::TImpl* session, const TKeepAliveSettings& settings);
+    bool NeedWarmUp(const TKqpSessionCommon* session) const;
+    // Returns false if session already has all hot queries prepared
+    bool WarmUpSession(const TSession& session, const NSessionPool::TInFlightToken& token);
 
     TFuture<TStatus> CreateTable(Ydb::Table::CreateTableRequest&& request, const TCreateTableSettings& settings);
     TFuture<TStatus> AlterTable(Ydb::Table::AlterTableRequest&& request, const TAlterTableSettings& settings);
@@ -149,6 +155,8 @@ public:
 
 public:
     TClientSettings Settings_;
+    // Client wide registry of prepared queries, exists only with enabled client query cache
+    std::shared_ptr<NSessionPool::TQueryRegistry> QueryRegistry_;
 
 private:
     static void SetParams(
@@ -293,6 +301,7 @@ private:
     NSessionPool::TSessionPool SessionPool_;
     TRequestMigrator RequestMigrator_;
     static const TKeepAliveSettings KeepAliveSettings;
+    static const TPrepareDataQuerySettings WarmUpPrepareSettings;
 };
 
 }
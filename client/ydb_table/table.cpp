@@ -16,6 +16,8 @@
 #include <client/ydb_value/value.h>
 #include <client/ydb_table/impl/client_session.h>
 #include <client/ydb_table/impl/data_query.h>
+#include <client/ydb_table/impl/point_reader.h>
+#include <client/ydb_table/impl/query_batcher.h>
 #include <client/ydb_table/impl/request_migrator.h>
 #include <client/ydb_table/impl/table_client.h>
 #include <client/resources/ydb_resources.h>
@@ -1355,6 +1357,7 @@ TSessionInspectorFn TSession::TImpl::GetSessionInspector(
 TTableClient::TTableClient(const TDriver& driver, const TClientSettings& settings)
     : Impl_(new TImpl(CreateInternalInterface(driver), settings)) {
     Impl_->StartPeriodicSessionPoolTask();
+    Impl_->PrewarmSessionPool();
     Impl_->StartPeriodicHostScanTask();
     Impl_->InitStopper();
 }
@@ -1557,7 +1560,8 @@ TSession::TSession(std::shared_ptr<TTableClient::TImpl> client, const std::strin
             endpointId,
             client->Settings_.UseQueryCache_,
             client->Settings_.QueryCacheSize_,
-            isOwnedBySessionPool),
+            isOwnedBySessionPool,
+            client->QueryRegistry_),
         TSession::TImpl::GetSmartDeleter(client))
 {
     if (!endpointId.empty()) {
@@ -1573,25 +1577,27 @@ TSession::TSession(std::shared_ptr<TTableClient::TImpl> client, std::shared_ptr<
 TFuture<TStatus> TSession::CreateTable(const std::string& path, TTableDescription&& tableDesc,
         const TCreateTableSettings& settings)
 {
-    auto request = MakeOperationRequest<Ydb::Table::CreateTableRequest>(settings);
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
+    auto request = MakeOperationRequest<Ydb::Table::CreateTableRequest>(attemptSettings);
     request.set_session_id(SessionImpl_->GetId());
     request.set_path(path);
 
     tableDesc.SerializeTo(request);
 
-    ConvertCreateTableSettingsToProto(settings, request.mutable_profile());
+    ConvertCreateTableSettingsToProto(attemptSettings, request.mutable_profile());
 
     return InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->CreateTable(std::move(request), settings),
+        Client_->CreateTable(std::move(request), attemptSettings),
         false,
         GetMinTimeToTouch(Client_->Settings_.SessionPoolSettings_));
 }
 
 TFuture<TStatus> TSession::DropTable(const std::string& path, const TDropTableSettings& settings) {
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
     return InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->DropTable(SessionImpl_->GetId(), path, settings),
+        Client_->DropTable(SessionImpl_->GetId(), path, attemptSettings),
         false,
         GetMinTimeToTouch(Client_->Settings_.SessionPoolSettings_));
 }
@@ -1700,27 +1706,30 @@ static Ydb::Table::AlterTableRequest MakeAlterTableProtoRequest(
 }
 
 TAsyncStatus TSession::AlterTable(const std::string& path, const TAlterTableSettings& settings) {
-    auto request = MakeAlterTableProtoRequest(path, settings, SessionImpl_->GetId());
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
+    auto request = MakeAlterTableProtoRequest(path, attemptSettings, SessionImpl_->GetId());
 
     return InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->AlterTable(std::move(request), settings),
+        Client_->AlterTable(std::move(request), attemptSettings),
         false,
         GetMinTimeToTouch(Client_->Settings_.SessionPoolSettings_));
 }
 
 TAsyncOperation TSession::AlterTableLong(const std::string& path, const TAlterTableSettings& settings) {
-    auto request = MakeAlterTableProtoRequest(path, settings, SessionImpl_->GetId());
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
+    auto request = MakeAlterTableProtoRequest(path, attemptSettings, SessionImpl_->GetId());
 
     return InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->AlterTableLong(std::move(request), settings),
+        Client_->AlterTableLong(std::move(request), attemptSettings),
         false,
         GetMinTimeToTouch(Client_->Settings_.SessionPoolSettings_));
 }
 
 TAsyncStatus TSession::RenameTables(const std::vector<TRenameItem>& renameItems, const TRenameTablesSettings& settings) {
-    auto request = MakeOperationRequest<Ydb::Table::RenameTablesRequest>(settings);
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
+    auto request = MakeOperationRequest<Ydb::Table::RenameTablesRequest>(attemptSettings);
     request.set_session_id(SessionImpl_->GetId());
 
     for (const auto& item: renameItems) {
@@ -1732,13 +1741,14 @@ TAsyncStatus TSession::RenameTables(const std::vector<TRenameItem>& renameItems,
 
     return InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->RenameTables(std::move(request), settings),
+        Client_->RenameTables(std::move(request), attemptSettings),
         false,
         GetMinTimeToTouch(Client_->Settings_.SessionPoolSettings_));
 }
 
 TAsyncStatus TSession::CopyTables(const std::vector<TCopyItem>& copyItems, const TCopyTablesSettings& settings) {
-    auto request = MakeOperationRequest<Ydb::Table::CopyTablesRequest>(settings);
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
+    auto request = MakeOperationRequest<Ydb::Table::CopyTablesRequest>(attemptSettings);
     request.set_session_id(SessionImpl_->GetId());
 
     for (const auto& item: copyItems) {
@@ -1750,46 +1760,51 @@ TAsyncStatus TSession::CopyTables(const std::vector<TCopyItem>& copyItems, const
 
     return InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->CopyTables(std::move(request), settings),
+        Client_->CopyTables(std::move(request), attemptSettings),
         false,
         GetMinTimeToTouch(Client_->Settings_.SessionPoolSettings_));
 }
 
 TFuture<TStatus> TSession::CopyTable(const std::string& src, const std::string& dst, const TCopyTableSettings& settings) {
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
     return InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->CopyTable(SessionImpl_->GetId(), src, dst, settings),
+        Client_->CopyTable(SessionImpl_->GetId(), src, dst, attemptSettings),
         false,
         GetMinTimeToTouch(Client_->Settings_.SessionPoolSettings_));
 }
 
 TAsyncDescribeTableResult TSession::DescribeTable(const std::string& path, const TDescribeTableSettings& settings) {
-    return Client_->DescribeTable(SessionImpl_->GetId(), path, settings);
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
+    return Client_->DescribeTable(SessionImpl_->GetId(), path, attemptSettings);
 }
 
 TAsyncDataQueryResult TSession::ExecuteDataQuery(const std::string& query, const TTxControl& txControl,
     const TExecDataQuerySettings& settings)
 {
-    return Client_->ExecuteDataQuery(*this, query, txControl, nullptr, settings);
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
+    return Client_->ExecuteDataQuery(*this, query, txControl, nullptr, attemptSettings);
 }
 
 TAsyncDataQueryResult TSession::ExecuteDataQuery(const std::string& query, const TTxControl& txControl,
     TParams&& params, const TExecDataQuerySettings& settings)
 {
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
     auto paramsPtr = params.Empty() ? nullptr : params.GetProtoMapPtr();
-    return Client_->ExecuteDataQuery(*this, query, txControl, paramsPtr, settings);
+    return Client_->ExecuteDataQuery(*this, query, txControl, paramsPtr, attemptSettings);
 }
 
 TAsyncDataQueryResult TSession::ExecuteDataQuery(const std::string& query, const TTxControl& txControl,
     const TParams& params, const TExecDataQuerySettings& settings)
 {
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
     if (params.Empty()) {
         return Client_->ExecuteDataQuery(
             *this,
             query,
             txControl,
             nullptr,
-            settings);
+            attemptSettings);
     } else {
         using TProtoParamsType = const ::google::protobuf::Map<std::string, Ydb::TypedValue>;
         return Client_->ExecuteDataQuery<TProtoParamsType&>(
@@ -1797,11 +1812,12 @@ TAsyncDataQueryResult TSession::ExecuteDataQuery(const std::string& query, const
             query,
             txControl,
             params.GetProtoMap(),
-            settings);
+            attemptSettings);
     }
 }
 
 TAsyncPrepareQueryResult TSession::PrepareDataQuery(const std::string& query, const TPrepareDataQuerySettings& settings) {
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
     auto maybeQuery = SessionImpl_->GetQueryFromCache(query, Client_->Settings_.AllowRequestMigration_);
     if (maybeQuery) {
         TStatus status(EStatus::SUCCESS, NYql::TIssues());
@@ -1814,15 +1830,16 @@ TAsyncPrepareQueryResult TSession::PrepareDataQuery(const std::string& query, co
 
     return InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->PrepareDataQuery(*this, query, settings),
+        Client_->PrepareDataQuery(*this, query, attemptSettings),
         true,
         GetMinTimeToTouch(Client_->Settings_.SessionPoolSettings_));
 }
 
 TAsyncStatus TSession::ExecuteSchemeQuery(const std::string& query, const TExecSchemeQuerySettings& settings) {
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
     return InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->ExecuteSchemeQuery(SessionImpl_->GetId(), query, settings),
+        Client_->ExecuteSchemeQuery(SessionImpl_->GetId(), query, attemptSettings),
         true,
         GetMinTimeToTouch(Client_->Settings_.SessionPoolSettings_));
 }
@@ -1830,9 +1847,10 @@ TAsyncStatus TSession::ExecuteSchemeQuery(const std::string& query, const TExecS
 TAsyncBeginTransactionResult TSession::BeginTransaction(const TTxSettings& txSettings,
     const TBeginTxSettings& settings)
 {
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
     return InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->BeginTransaction(*this, txSettings, settings),
+        Client_->BeginTransaction(*this, txSettings, attemptSettings),
         true,
         GetMinTimeToTouch(Client_->Settings_.SessionPoolSettings_));
 }
@@ -1840,9 +1858,10 @@ TAsyncBeginTransactionResult TSession::BeginTransaction(const TTxSettings& txSet
 TAsyncExplainDataQueryResult TSession::ExplainDataQuery(const std::string& query,
     const TExplainDataQuerySettings& settings)
 {
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
     return InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->ExplainDataQuery(*this, query, settings),
+        Client_->ExplainDataQuery(*this, query, attemptSettings),
         true,
         GetMinTimeToTouch(Client_->Settings_.SessionPoolSettings_));
 }
@@ -1850,6 +1869,7 @@ TAsyncExplainDataQueryResult TSession::ExplainDataQuery(const std::string& query
 TAsyncTablePartIterator TSession::ReadTable(const std::string& path,
     const TReadTableSettings& settings)
 {
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
     auto promise = NThreading::NewPromise<TTablePartIterator>();
     auto readTableIteratorBuilder = [promise](NThreading::TFuture<std::pair<TPlainStatus, TTableClient::TImpl::TReadTableStreamProcessorPtr>> future) mutable {
         Y_ASSERT(future.HasValue());
@@ -1859,7 +1879,7 @@ TAsyncTablePartIterator TSession::ReadTable(const std::string& path,
                 pair.second, pair.first.Endpoint) : nullptr, std::move(pair.first))
             );
     };
-    Client_->ReadTable(SessionImpl_->GetId(), path, settings).Subscribe(readTableIteratorBuilder);
+    Client_->ReadTable(SessionImpl_->GetId(), path, attemptSettings).Subscribe(readTableIteratorBuilder);
     return InjectSessionStatusInterception(
         SessionImpl_,
         promise.GetFuture(),
@@ -1872,13 +1892,15 @@ void TSession::InvalidateQueryCache() {
 }
 
 TAsyncStatus TSession::Close(const TCloseSessionSettings& settings) {
-    return Client_->Close(SessionImpl_.get(), settings);
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
+    return Client_->Close(SessionImpl_.get(), attemptSettings);
 }
 
 TAsyncKeepAliveResult TSession::KeepAlive(const TKeepAliveSettings &settings) {
+    const auto attemptSettings = SessionImpl_->ApplyRetryAttempt(settings);
     return InjectSessionStatusInterception(
         SessionImpl_,
-        Client_->KeepAlive(SessionImpl_.get(), settings),
+        Client_->KeepAlive(SessionImpl_.get(), attemptSettings),
         true,
         GetMinTimeToTouch(Client_->Settings_.SessionPoolSettings_));
 }
@@ -1917,11 +1939,13 @@ TTransaction::TTransaction(const TSession& session, const std::string& txId)
 {}
 
 TAsyncCommitTransactionResult TTransaction::Commit(const TCommitTxSettings& settings) {
-    return Session_.Client_->CommitTransaction(Session_, *this, settings);
+    const auto attemptSettings = Session_.SessionImpl_->ApplyRetryAttempt(settings);
+    return Session_.Client_->CommitTransaction(Session_, *this, attemptSettings);
 }
 
 TAsyncStatus TTransaction::Rollback(const TRollbackTxSettings& settings) {
-    return Session_.Client_->RollbackTransaction(Session_, *this, settings);
+    const auto attemptSettings = Session_.SessionImpl_->ApplyRetryAttempt(settings);
+    return Session_.Client_->RollbackTransaction(Session_, *this, attemptSettings);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1952,32 +1976,35 @@ TParamsBuilder TDataQuery::GetParamsBuilder() const {
 TAsyncDataQueryResult TDataQuery::Execute(const TTxControl& txControl,
     const TExecDataQuerySettings& settings)
 {
-    return Impl_->Session_.Client_->ExecuteDataQuery(Impl_->Session_, *this, txControl, nullptr, settings, false);
+    const auto attemptSettings = Impl_->Session_.SessionImpl_->ApplyRetryAttempt(settings);
+    return Impl_->Session_.Client_->ExecuteDataQuery(Impl_->Session_, *this, txControl, nullptr, attemptSettings, false);
 }
 
 TAsyncDataQueryResult TDataQuery::Execute(const TTxControl& txControl, TParams&& params,
     const TExecDataQuerySettings& settings)
 {
+    const auto attemptSettings = Impl_->Session_.SessionImpl_->ApplyRetryAttempt(settings);
     auto paramsPtr = params.Empty() ? nullptr : params.GetProtoMapPtr();
     return Impl_->Session_.Client_->ExecuteDataQuery(
         Impl_->Session_,
         *this,
         txControl,
         paramsPtr,
-        settings,
+        attemptSettings,
         false);
 }
 
 TAsyncDataQueryResult TDataQuery::Execute(const TTxControl& txControl, const TParams& params,
     const TExecDataQuerySettings& settings)
 {
+    const auto attemptSettings = Impl_->Session_.SessionImpl_->ApplyRetryAttempt(settings);
     if (params.Empty()) {
         return Impl_->Session_.Client_->ExecuteDataQuery(
             Impl_->Session_,
             *this,
             txControl,
             nullptr,
-            settings,
+            attemptSettings,
             false);
     } else {
         using TProtoParamsType = const ::google::protobuf::Map<std::string, Ydb::TypedValue>;
@@ -1986,7 +2013,7 @@ TAsyncDataQueryResult TDataQuery::Execute(const TTxControl& txControl, const TPa
             *this,
             txControl,
             params.GetProtoMap(),
-            settings,
+            attemptSettings,
             false);
     }
 }
@@ -2844,5 +2871,27 @@ TReadRowsResult::TReadRowsResult(TStatus&& status, TResultSet&& resultSet)
     , ResultSet(std::move(resultSet))
 {}
 
+////////////////////////////////////////////////////////////////////////////////
+
+TDataQueryBatcher::TDataQueryBatcher(const TTableClient& client, const std::string& query, const TTxSettings& txSettings,
+        const TDataQueryBatcherSettings& settings)
+    : Impl_(std::make_shared<TImpl>(client, client.Impl_, query, txSettings, settings))
+{}
+
+TAsyncDataQueryResult TDataQueryBatcher::Execute(const TParams& params) {
+    return Impl_->Execute(params);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TPointReader::TPointReader(const TTableClient& client, const std::string& table, const std::vector<std::string>& columns,
+        const TPointReaderSettings& settings)
+    : Impl_(std::make_shared<TImpl>(client, client.Impl_, table, columns, settings))
+{}
+
+TAsyncReadRowsResult TPointReader::ReadRow(const TValue& key) {
+    return Impl_->ReadRow(key);
+}
+
 } // namespace NTable
 } // namespace NYdb
@@ -897,7 +897,11 @@ using TAsyncScanQueryPartIterator = NThreading::TFuture<TScanQueryPartIterator>;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-struct TCreateSessionSettings : public TOperationRequestSettings<TCreateSessionSettings> {};
+struct TCreateSessionSettings : public TOperationRequestSettings<TCreateSessionSettings> {
+    // Prefer pooled session which already has this query prepared.
+    // Used only by TTableClient::GetSession with enabled client query cache.
+    FLUENT_SETTING_OPTIONAL(std::string, QueryAffinity);
+};
 
 using TBackoffSettings = NYdb::NRetry::TBackoffSettings;
 using TRetryOperationSettings = NYdb::NRetry::TRetryOperationSettings;
@@ -922,6 +926,15 @@ struct TSessionPoolSettings {
     // Min number of session in session pool.
     // Sessions will not be closed by CloseIdleThreshold if the number of sessions less then this limit.
     FLUENT_SETTING_DEFAULT(ui32, MinPoolSize, 10);
+
+    // Create sessions in background to keep at least MinPoolSize sessions in session pool.
+    // Otherwise sessions are created in background only up to the recent peak of active sessions
+    FLUENT_SETTING_DEFAULT(bool, KeepMinPoolSizeWarm, false);
+
+    // Number of sessions created in parallel right after client creation, spread over
+    // the best endpoints. Sessions are put to the pool as idle, see TDriver::WaitReady.
+    // Zero - create sessions on demand
+    FLUENT_SETTING_DEFAULT(ui32, PrewarmSessions, 0);
 };
 
 struct TClientSettings : public TCommonClientSettingsBase<TClientSettings> {
@@ -938,6 +951,10 @@ struct TClientSettings : public TCommonClientSettingsBase<TClientSettings> {
     FLUENT_SETTING_DEFAULT(bool, UseQueryCache, false);
     FLUENT_SETTING_DEFAULT(ui32, QueryCacheSize, 1000);
     FLUENT_SETTING_DEFAULT(bool, KeepDataQueryText, true);
+    // Number of the most used queries of the client query cache which are prepared
+    // in background on idle pooled sessions which don't have them yet.
+    // Works only with enabled client query cache. Zero - disable this feature
+    FLUENT_SETTING_DEFAULT(ui32, QueryCacheWarmUpSize, 0);
 
     // Min allowed session variation coefficient (%) to start session balancing.
     // Variation coefficient is a ratio of the standard deviation sigma to the mean
@@ -964,6 +981,18 @@ struct TBulkUpsertSettings : public TOperationRequestSettings<TBulkUpsertSetting
 struct TReadRowsSettings : public TOperationRequestSettings<TReadRowsSettings> {
 };
 
+struct TPointReaderSettings {
+    using TSelf = TPointReaderSettings;
+
+    //! Keys which arrive within the window after the first one are read in one request
+    FLUENT_SETTING_DEFAULT(TDuration, Window, TDuration::MilliSeconds(1));
+
+    //! Batch is sent at once when it has that many distinct keys
+    FLUENT_SETTING_DEFAULT(ui32, MaxBatchSize, 1000);
+
+    FLUENT_SETTING_DEFAULT(TReadRowsSettings, ReadRowsSettings, TReadRowsSettings());
+};
+
 struct TStreamExecScanQuerySettings : public TRequestSettings<TStreamExecScanQuerySettings> {
     // Return query plan without actual query execution
     FLUENT_SETTING_DEFAULT(bool, Explain, false);
@@ -987,6 +1016,8 @@ class TTableClient {
     friend class TSession;
     friend class TTransaction;
     friend class TSessionPool;
+    friend class TDataQueryBatcher;
+    friend class TPointReader;
     friend class NRetry::Sync::TRetryContext<TTableClient, TStatus>;
     friend class NRetry::Async::TRetryContext<TTableClient, TAsyncStatus>;
 
@@ -1026,6 +1057,9 @@ public:
     //! Returns new type builder
     TTypeBuilder GetTypeBuilder();
 
+    //! Operation may be a coroutine, e.g.
+    //! [](TSession session) -> TAsyncStatus { auto result = co_await session.ExecuteDataQuery(...); ... co_return result; }
+    //! Note: objects captured by reference are used after suspension, so they must outlive the returned future.
     TAsyncStatus RetryOperation(TOperationFunc&& operation,
         const TRetryOperationSettings& settings = TRetryOperationSettings());
 
@@ -1543,6 +1577,21 @@ struct TExecDataQuerySettings : public TOperationRequestSettings<TExecDataQueryS
     FLUENT_SETTING_OPTIONAL(ECollectQueryStatsMode, CollectQueryStats);
 };
 
+struct TDataQueryBatcherSettings {
+    using TSelf = TDataQueryBatcherSettings;
+
+    //! Queries which arrive within the window after the first one are sent in one request
+    FLUENT_SETTING_DEFAULT(TDuration, Window, TDuration::MilliSeconds(1));
+
+    //! Batch is sent at once when it has that many queries
+    FLUENT_SETTING_DEFAULT(ui32, MaxBatchSize, 16);
+
+    //! Fused query text depends only on the batch size, so it is worth keeping in the server cache
+    FLUENT_SETTING_DEFAULT(TExecDataQuerySettings, ExecSettings, TExecDataQuerySettings().KeepInQueryCache(true));
+
+    FLUENT_SETTING_DEFAULT(TRetryOperationSettings, RetrySettings, TRetryOperationSettings());
+};
+
 struct TExecSchemeQuerySettings : public TOperationRequestSettings<TExecSchemeQuerySettings> {};
 
 struct TBeginTxSettings : public TOperationRequestSettings<TBeginTxSettings> {};
@@ -1585,6 +1634,8 @@ class TSession {
     friend class TDataQuery;
     friend class TTransaction;
     friend class TSessionPool;
+    friend class NRetry::Sync::TRetryContext<TTableClient, TStatus>;
+    friend class NRetry::Async::TRetryContext<TTableClient, TAsyncStatus>;
 
 public:
     //! The following methods perform corresponding calls.
@@ -2004,6 +2055,47 @@ class TReadRowsResult : public TStatus {
     }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+
+//! Fuses concurrent executions of one parameterized data query into a single request.
+//! The batch is one query with a copy of the text per caller, where every parameter and
+//! named expression "$name" of the i-th copy is renamed to "$name__b<i>", so the text must stay
+//! valid when repeated. The batch runs in one transaction, which begins and commits with the request,
+//! and is retried as a whole. Each caller gets its own result sets, a failure is reported to all of them.
+//! Intended for small independent reads, e.g. point lookups issued by many callers at once.
+class TDataQueryBatcher {
+public:
+    TDataQueryBatcher(const TTableClient& client, const std::string& query, const TTxSettings& txSettings,
+        const TDataQueryBatcherSettings& settings = TDataQueryBatcherSettings());
+
+    //! Query statistics of the result, if requested, cover the whole batch
+    TAsyncDataQueryResult Execute(const TParams& params);
+
+private:
+    class TImpl;
+    std::shared_ptr<TImpl> Impl_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+//! Coalesces concurrent single key reads of one table into ReadRows calls.
+//! Identical keys read at the same time share one read and one result.
+//! A failed request is reported to every key of the batch.
+class TPointReader {
+public:
+    //! Key columns are always read, they are added to the columns if missing
+    TPointReader(const TTableClient& client, const std::string& table, const std::vector<std::string>& columns = {},
+        const TPointReaderSettings& settings = TPointReaderSettings());
+
+    //! Key is a struct of the key columns, all keys must be of the same type.
+    //! Result set has the row of the key or no rows if there is no such key
+    TAsyncReadRowsResult ReadRow(const TValue& key);
+
+private:
+    class TImpl;
+    std::shared_ptr<TImpl> Impl_;
+};
+
 } // namespace NTable
 } // namespace NYdb
 
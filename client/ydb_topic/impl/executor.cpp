@@ -68,6 +68,10 @@ IExecutor::TPtr CreateThreadPoolExecutor(size_t threads) {
     return MakeIntrusive<TThreadPoolExecutor>(threads);
 }
 
+IExecutor::TPtr CreateThreadPoolExecutor(size_t threads, const TThreadPoolSettings& settings) {
+    return MakeIntrusive<TThreadPoolExecutor>(threads, settings);
+}
+
 IExecutor::TPtr CreateGenericExecutor() {
     return CreateThreadPoolExecutor(1);
 }
@@ -82,8 +86,8 @@ TThreadPoolExecutor::TThreadPoolExecutor(std::shared_ptr<IThreadPool> threadPool
     IsFakeThreadPool = dynamic_cast<TFakeThreadPool*>(ThreadPool.get()) != nullptr;
 }
 
-TThreadPoolExecutor::TThreadPoolExecutor(size_t threadsCount)
-    : TThreadPoolExecutor(CreateThreadPool(threadsCount))
+TThreadPoolExecutor::TThreadPoolExecutor(size_t threadsCount, const TThreadPoolSettings& settings)
+    : TThreadPoolExecutor(CreateThreadPool(threadsCount, settings))
 {
     Y_ABORT_UNLESS(threadsCount > 0);
     ThreadsCount = threadsCount;
@@ -30,7 +30,7 @@ private:
 
 public:
     TThreadPoolExecutor(std::shared_ptr<IThreadPool> threadPool);
-    TThreadPoolExecutor(size_t threadsCount);
+    TThreadPoolExecutor(size_t threadsCount, const TThreadPoolSettings& settings = {});
     ~TThreadPoolExecutor() = default;
 
     bool IsAsync() const override {
@@ -39,6 +39,9 @@ TWriterCounters::TWriterCounters(const TIntrusivePtr<::NMonitoring::TDynamicCoun
     TotalBytesInflightUsageByTime = counters->GetHistogram("totalBytesInflightUsageByTime", HISTOGRAM_SETUP);
     UncompressedBytesInflightUsageByTime = counters->GetHistogram("uncompressedBytesInflightUsageByTime", HISTOGRAM_SETUP);
     CompressedBytesInflightUsageByTime = counters->GetHistogram("compressedBytesInflightUsageByTime", HISTOGRAM_SETUP);
+
+    // 1/4 relative error from 2 ms to 16 s, a wider range doesn't fit into the buckets limit
+    AckLatencyMs = counters->GetHistogram("ackLatencyMs", ::NMonitoring::HdrHistogram(TDuration::Seconds(16).MilliSeconds(), 2, 2));
 }
 #undef HISTOGRAM_SETUP
 
@@ -678,7 +681,8 @@ void TWriteSessionImpl::ReadFromProcessor() {
 }
 
 void TWriteSessionImpl::OnWriteDone(NYdbGrpc::TGrpcStatus&& status, size_t connectionGeneration) {
-    LOG_LAZY(DbDriverState->Log, TLOG_DEBUG, LogPrefix() << "Write session: OnWriteDone " << status.ToDebugString());
+    LOG_STRUCTURED(DbDriverState->StructuredLog, TLOG_DEBUG, "Write session: OnWriteDone",
+        {"SessionId", SessionId}, {"GrpcStatus", status.GRpcStatusCode}, {"Message", status.Msg});
 
     THandleResult handleResult;
     {
@@ -697,7 +701,8 @@ void TWriteSessionImpl::OnWriteDone(NYdbGrpc::TGrpcStatus&& status, size_t conne
 }
 
 void TWriteSessionImpl::OnReadDone(NYdbGrpc::TGrpcStatus&& grpcStatus, size_t connectionGeneration) {
-    LOG_LAZY(DbDriverState->Log, TLOG_DEBUG, LogPrefix() << "Write session: OnReadDone " << grpcStatus.ToDebugString());
+    LOG_STRUCTURED(DbDriverState->StructuredLog, TLOG_DEBUG, "Write session: OnReadDone",
+        {"SessionId", SessionId}, {"GrpcStatus", grpcStatus.GRpcStatusCode}, {"Message", grpcStatus.Msg});
 
     TPlainStatus errorStatus;
     TProcessSrvMessageResult processResult;
@@ -833,10 +838,9 @@ TWriteSessionImpl::TProcessSrvMessageResult TWriteSessionImpl::ProcessServerMess
         case TServerMessage::kWriteResponse: {
             TWriteSessionEvent::TAcksEvent acksEvent;
             const auto& batchWriteResponse = ServerMessage->write_response();
-            LOG_LAZY(DbDriverState->Log,
-                TLOG_DEBUG,
-                LogPrefix() << "Write session got write response: " << batchWriteResponse.ShortDebugString()
-            );
+            LOG_STRUCTURED(DbDriverState->StructuredLog, TLOG_DEBUG, "Write session got write response",
+                {"SessionId", SessionId}, {"PartitionId", batchWriteResponse.partition_id()},
+                {"Acks", batchWriteResponse.acks_size()});
             TWriteStat::TPtr writeStat = new TWriteStat{};
             const auto& stat = batchWriteResponse.write_statistics();
 
@@ -894,7 +898,8 @@ TWriteSessionImpl::TProcessSrvMessageResult TWriteSessionImpl::ProcessServerMess
 
 bool TWriteSessionImpl::CleanupOnAcknowledged(ui64 id) {
     bool result = false;
-    LOG_LAZY(DbDriverState->Log, TLOG_DEBUG, LogPrefix() << "Write session: acknoledged message " << id);
+    LOG_STRUCTURED(DbDriverState->StructuredLog, TLOG_DEBUG, "Write session: acknowledged message",
+        {"SessionId", SessionId}, {"Id", id});
     UpdateTimedCountersImpl();
     const auto& sentFront = SentOriginalMessages.front();
     ui64 size = 0;
@@ -930,8 +935,18 @@ bool TWriteSessionImpl::CleanupOnAcknowledged(ui64 id) {
 
     Y_ABORT_UNLESS(sentFront.Id == id);
 
+    if (Counters->AckLatencyMs) {
+        const auto now = TInstant::Now();
+        Counters->AckLatencyMs->Collect(now > sentFront.CreatedAt ? (now - sentFront.CreatedAt).MilliSeconds() : 0);
+    }
+
     (*Counters->BytesInflightTotal) = MemoryUsage;
     SentOriginalMessages.pop();
+
+    while (!WriteBatchSpans.empty() && WriteBatchSpans.front().first <= id) {
+        WriteBatchSpans.front().second->End(EStatus::SUCCESS);
+        WriteBatchSpans.pop_front();
+    }
     return result;
 }
 
@@ -1036,6 +1051,8 @@ void TWriteSessionImpl::ResetForRetryImpl() {
     Y_ABORT_UNLESS(Lock.IsLocked());
 
     SessionEstablished = false;
+    // Unacknowledged messages are resent, new requests get their own spans
+    EndWriteBatchSpansImpl(EStatus::UNAVAILABLE);
     const size_t totalPackedMessages = PackedMessagesToSend.size() + SentPackedMessage.size();
     const size_t totalOriginalMessages = OriginalMessagesToSend.size() + SentOriginalMessages.size();
     while (!SentPackedMessage.empty()) {
@@ -1081,11 +1098,9 @@ void TWriteSessionImpl::FlushWriteIfRequiredImpl() {
 size_t TWriteSessionImpl::WriteBatchImpl() {
     Y_ABORT_UNLESS(Lock.IsLocked());
 
-    LOG_LAZY(DbDriverState->Log,
-        TLOG_DEBUG,
-        LogPrefix() << "Write " << CurrentBatch.Messages.size() << " messages with Id from "
-            << CurrentBatch.Messages.begin()->Id << " to " << CurrentBatch.Messages.back().Id
-    );
+    LOG_STRUCTURED(DbDriverState->StructuredLog, TLOG_DEBUG, "Write messages",
+        {"SessionId", SessionId}, {"Count", CurrentBatch.Messages.size()},
+        {"FirstId", CurrentBatch.Messages.begin()->Id}, {"LastId", CurrentBatch.Messages.back().Id});
 
     Y_ABORT_UNLESS(CurrentBatch.Messages.size() <= MaxBlockMessageCount);
 
@@ -1243,16 +1258,29 @@ void TWriteSessionImpl::SendImpl() {
             PackedMessagesToSend.pop();
         }
         UpdateTokenIfNeededImpl();
-        LOG_LAZY(DbDriverState->Log,
-            TLOG_DEBUG,
-            LogPrefix() << "Send " << writeRequest->messages_size() << " message(s) ("
-                << OriginalMessagesToSend.size() << " left), first sequence number is "
-                << writeRequest->messages(0).seq_no()
-        );
+        LOG_STRUCTURED(DbDriverState->StructuredLog, TLOG_DEBUG, "Send messages",
+            {"SessionId", SessionId}, {"Count", writeRequest->messages_size()},
+            {"Left", OriginalMessagesToSend.size()}, {"FirstSeqNo", writeRequest->messages(0).seq_no()});
+        if (auto span = Connections->StartSpan("ydb.WriteBatch", NTracing::ESpanKind::Internal, Settings.TraceParent_)) {
+            span->SetAttribute("messaging.system", "ydb");
+            span->SetAttribute("messaging.destination.name", Settings.Path_);
+            span->SetAttribute("messaging.batch.message_count", static_cast<i64>(writeRequest->messages_size()));
+            span->SetAttribute("messaging.message.body.size", static_cast<i64>(clientMessage.ByteSizeLong()));
+            WriteBatchSpans.emplace_back(SentOriginalMessages.back().Id, std::move(span));
+        }
         Processor->Write(std::move(clientMessage));
     }
 }
 
+void TWriteSessionImpl::EndWriteBatchSpansImpl(EStatus status) {
+    Y_ABORT_UNLESS(Lock.IsLocked());
+
+    for (auto& [id, span] : WriteBatchSpans) {
+        span->End(status);
+    }
+    WriteBatchSpans.clear();
+}
+
 // Client method, no Lock
 bool TWriteSessionImpl::Close(TDuration closeTimeout) {
     if (AtomicGet(Aborting)) {
@@ -1377,6 +1405,7 @@ void TWriteSessionImpl::AbortImpl() {
         NPersQueue::Cancel(ConnectDelayContext);
         if (Processor)
             Processor->Cancel();
+        EndWriteBatchSpansImpl(EStatus::CLIENT_CANCELLED);
 
         NPersQueue::Cancel(ClientContext);
         ClientContext.reset(); // removes context from contexts set from underlying gRPC-client.
@@ -403,6 +403,7 @@ private:
     ui64 GetSeqNoImpl(ui64 id);
     ui64 GetIdImpl(ui64 seqNo);
     void SendImpl();
+    void EndWriteBatchSpansImpl(EStatus status);
     void AbortImpl();
     void CloseImpl(EStatus statusCode, NYql::TIssues&& issues);
     void CloseImpl(EStatus statusCode, const std::string& message);
@@ -460,6 +461,8 @@ private:
     //! Messages that are sent but yet not acknowledged
     std::queue<TOriginalMessage> SentOriginalMessages;
     std::queue<TBlock> SentPackedMessage;
+    //! Spans of sent write requests with id of the last message in request, span ends when this message is acknowledged
+    std::deque<std::pair<ui64, NTracing::TSpanPtr>> WriteBatchSpans;
 
     const size_t MaxBlockSize = std::numeric_limits<size_t>::max();
     const size_t MaxBlockMessageCount = 1; //!< Max message count that can be packed into a single block. In block version 0 is equal to 1 for compatibility
@@ -714,6 +714,9 @@ struct TWriterCounters : public TThrRefBase {
     ::NMonitoring::THistogramPtr UncompressedBytesInflightUsageByTime;
     //! Memory usage by compressed messages pending for write:
     ::NMonitoring::THistogramPtr CompressedBytesInflightUsageByTime;
+
+    //! Time from message creation (CreateTimestamp or Write call) to its acknowledgement, in milliseconds.
+    ::NMonitoring::THistogramPtr AckLatencyMs;
 };
 
 struct TReaderCounters: public TThrRefBase {
@@ -1211,6 +1214,8 @@ private:
 IExecutor::TPtr CreateThreadPoolExecutorAdapter(
     std::shared_ptr<IThreadPool> threadPool); // Thread pool is expected to have been started.
 IExecutor::TPtr CreateThreadPoolExecutor(size_t threads);
+//! E.g. work stealing thread pool, see TThreadPoolSettings.
+IExecutor::TPtr CreateThreadPoolExecutor(size_t threads, const TThreadPoolSettings& settings);
 
 IExecutor::TPtr CreateSyncExecutor();
 
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "fluent_settings_helpers.h"
+
+#include <util/system/types.h>
+
+namespace NYdb {
+
+//! Client side admission control of a driver, applied per database
+struct TAdmissionControlSettings {
+    using TSelf = TAdmissionControlSettings;
+
+    //! Adaptive limit of unary requests in flight, kept per database and per endpoint.
+    //! The limit grows by one per round trip while latency stays close to the minimal observed one,
+    //! and is multiplied by BackoffRatio (once per round trip) on OVERLOADED, UNAVAILABLE, TIMEOUT,
+    //! transport errors or latency above LatencyTolerance times the minimal one of the same RPC method.
+    //! Requests above the limit fail with CLIENT_RESOURCE_EXHAUSTED instead of being queued.
+    //! Streaming requests are not limited.
+    FLUENT_SETTING_DEFAULT(bool, ConcurrencyLimitEnabled, false);
+    FLUENT_SETTING_DEFAULT(ui32, InitialLimit, 100);
+    FLUENT_SETTING_DEFAULT(ui32, MinLimit, 10);
+    FLUENT_SETTING_DEFAULT(ui32, MaxLimit, 10000);
+    FLUENT_SETTING_DEFAULT(double, BackoffRatio, 0.9);
+    FLUENT_SETTING_DEFAULT(double, LatencyTolerance, 2.0);
+
+    //! Retries made by RetryOperation may not exceed this share of operations
+    //! (0.1 means 10%) plus MinRetriesPerSecond, otherwise the last error is returned.
+    //! 0 disables retry budget.
+    FLUENT_SETTING_DEFAULT(double, RetryBudgetRatio, 0.0);
+    FLUENT_SETTING_DEFAULT(ui32, MinRetriesPerSecond, 10);
+};
+
+} // namespace NYdb
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "fluent_settings_helpers.h"
+
+#include <library/cpp/logger/priority.h>
+
+#include <util/datetime/base.h>
+
+#include <string>
+
+namespace NYdb {
+
+//! Asynchronous structured logging of SDK hot paths (e.g. topic write sessions)
+struct TAsyncLogSettings {
+    using TSelf = TAsyncLogSettings;
+
+    //! Records with typed fields are put to a lock free ring buffer by the caller
+    //! and formatted by a background thread, so enabling debug logs doesn't slow down the caller.
+    FLUENT_SETTING_DEFAULT(bool, Enabled, false);
+    //! Records which don't fit into the buffer are dropped, the number of dropped records is logged
+    FLUENT_SETTING_DEFAULT(size_t, QueueSize, 64 * 1024);
+    FLUENT_SETTING_DEFAULT(TDuration, FlushPeriod, TDuration::MilliSeconds(100));
+    //! If set, records are appended to this file in compact binary form instead of
+    //! the log backend of the driver, use DecodeBinaryLog to convert it to text
+    FLUENT_SETTING(std::string, BinaryLogPath);
+    FLUENT_SETTING_DEFAULT(ELogPriority, BinaryLogPriority, TLOG_DEBUG);
+};
+
+} // namespace NYdb
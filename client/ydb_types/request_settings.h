@@ -15,6 +15,8 @@ struct TRequestSettings {
     using THeader = std::vector<std::pair<std::string, std::string>>;
 
     FLUENT_SETTING(std::string, TraceId);
+    // W3C traceparent of the caller's span, SDK spans of the request become it's children
+    FLUENT_SETTING(std::string, TraceParent);
     FLUENT_SETTING(std::string, RequestType);
     FLUENT_SETTING(THeader, Header);
     FLUENT_SETTING(TDuration, ClientTimeout);
@@ -24,6 +26,7 @@ struct TRequestSettings {
     template <typename T>
     explicit TRequestSettings(const TRequestSettings<T>& other)
         : TraceId_(other.TraceId_)
+        , TraceParent_(other.TraceParent_)
         , RequestType_(other.RequestType_)
         , Header_(other.Header_)
         , ClientTimeout_(other.ClientTimeout_)
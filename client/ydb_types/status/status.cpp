@@ -15,61 +15,70 @@ public:
     TImpl(TPlainStatus&& status)
         : Status(std::move(status))
     { }
+};
 
-    void CheckStatusOk(const std::string& str) const {
-        if (!Status.Ok()) {
-            ThrowFatalError(std::string("Attempt to use result with not successfull status. ") + str + "\n");
-        }
-    }
+namespace {
 
-    void RaiseError(const std::string& str) const {
-        ythrow TContractViolation(str);
-    }
-};
+const NYql::TIssues EmptyIssues;
+const std::multimap<std::string, std::string> EmptyMetadata;
+
+} // namespace
 
 TStatus::TStatus(EStatus statusCode, NYql::TIssues&& issues)
-    : Impl_(std::make_shared<TImpl>(TPlainStatus{statusCode, std::move(issues)}))
+    : TStatus(TPlainStatus{statusCode, std::move(issues)})
 { }
 
 TStatus::TStatus(TPlainStatus&& plain)
-    : Impl_(std::make_shared<TImpl>(std::move(plain)))
-{ }
+    : Status_(plain.Status)
+    , Endpoint_(&plain.Endpoint.Get())
+    , RequestTimings_(plain.RequestTimings)
+{
+    if (plain.HasDetails()) {
+        Impl_ = std::make_shared<TImpl>(std::move(plain));
+    }
+}
 
 const NYql::TIssues& TStatus::GetIssues() const {
-    return Impl_->Status.Issues;
+    return Impl_ ? Impl_->Status.Issues : EmptyIssues;
 }
 
 EStatus TStatus::GetStatus() const {
-    return Impl_->Status.Status;
+    return Status_;
 }
 
 bool TStatus::IsSuccess() const {
-    return Impl_->Status.Status == EStatus::SUCCESS;
+    return Status_ == EStatus::SUCCESS;
 }
 
 bool TStatus::IsTransportError() const {
-    return static_cast<size_t>(Impl_->Status.Status) >= TRANSPORT_STATUSES_FIRST
-        && static_cast<size_t>(Impl_->Status.Status) <= TRANSPORT_STATUSES_LAST;
+    return static_cast<size_t>(Status_) >= TRANSPORT_STATUSES_FIRST
+        && static_cast<size_t>(Status_) <= TRANSPORT_STATUSES_LAST;
 }
 
 void TStatus::CheckStatusOk(const std::string& str) const {
-    Impl_->CheckStatusOk(str);
+    if (!IsSuccess()) {
+        ThrowFatalError(std::string("Attempt to use result with not successfull status. ") + str + "\n");
+    }
 }
 
 void TStatus::RaiseError(const std::string& str) const {
-    Impl_->RaiseError(str);
+    ythrow TContractViolation(str);
 }
 
 const std::string& TStatus::GetEndpoint() const {
-    return Impl_->Status.Endpoint;
+    return *Endpoint_;
 }
 
 const std::multimap<std::string, std::string>& TStatus::GetResponseMetadata() const {
-    return Impl_->Status.Metadata;
+    return Impl_ ? Impl_->Status.Metadata : EmptyMetadata;
 }
 
 float TStatus::GetConsumedRu() const {
-    return Impl_->Status.ConstInfo.consumed_units();
+    return Impl_ ? Impl_->Status.ConstInfo.consumed_units() : 0;
+}
+
+const std::optional<TRequestTimings>& TStatus::GetRequestTimings() const {
+    return RequestTimings_;
 }
 
 IOutputStream& operator<<(IOutputStream& out, const TStatus& st) {
@@ -7,11 +7,26 @@
 
 #include <library/cpp/threading/future/future.h>
 
+#include <optional>
+
 namespace NYdb {
 
 //! Internal status representation
 struct TPlainStatus;
 
+//! Time spent by request in the SDK and on the wire, phase by phase.
+//! Collected only when driver has metric registry attached.
+struct TRequestTimings {
+    //! Waiting for endpoint discovery and connection to endpoint
+    TDuration EndpointWait;
+    //! Preparing call metadata, including credentials fetch
+    TDuration Credentials;
+    //! gRPC call: transport and server processing
+    TDuration Grpc;
+    //! Waiting in the response thread pool queue
+    TDuration ResponseQueue;
+};
+
 //! Represents status of call
 class TStatus {
 public:
@@ -25,6 +40,7 @@ public:
     const std::string& GetEndpoint() const;
     const std::multimap<std::string, std::string>& GetResponseMetadata() const;
     float GetConsumedRu() const;
+    const std::optional<TRequestTimings>& GetRequestTimings() const;
 
     friend IOutputStream& operator<<(IOutputStream& out, const TStatus& st);
 
@@ -33,7 +49,13 @@ protected:
     void RaiseError(const std::string& str) const;
 private:
     class TImpl;
+    EStatus Status_;
+    // Interned by the SDK, never freed
+    const std::string* Endpoint_;
+    // Issues, metadata and cost info, empty for a plain success
     std::shared_ptr<TImpl> Impl_;
+    // Set for every response while stats are collected, so it is kept out of Impl_
+    std::optional<TRequestTimings> RequestTimings_;
 };
 
 using TAsyncStatus = NThreading::TFuture<TStatus>;
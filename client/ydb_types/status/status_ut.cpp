@@ -0,0 +1,76 @@
+#include <client/ydb_types/status/status.h>
+
+#define INCLUDE_YDB_INTERNAL_H
+#include <client/impl/ydb_internal/plain_status/status.h>
+#undef INCLUDE_YDB_INTERNAL_H
+
+#include <library/cpp/testing/unittest/registar.h>
+
+using namespace NYdb;
+
+namespace {
+
+TPlainStatus MakeSuccess(const std::string& endpoint) {
+    return TPlainStatus{EStatus::SUCCESS, NYql::TIssues{}, endpoint, {}};
+}
+
+// Getters of a status without the shared implementation return the same empty values
+bool HasSharedEmpties(const TStatus& status) {
+    const TStatus plain(MakeSuccess("other:2135"));
+    return &status.GetIssues() == &plain.GetIssues()
+        && &status.GetResponseMetadata() == &plain.GetResponseMetadata();
+}
+
+} // namespace
+
+Y_UNIT_TEST_SUITE(StatusTest) {
+    Y_UNIT_TEST(PlainSuccess) {
+        const TStatus status(MakeSuccess("localhost:2135"));
+        UNIT_ASSERT(status.IsSuccess());
+        UNIT_ASSERT_VALUES_EQUAL(status.GetEndpoint(), "localhost:2135");
+        UNIT_ASSERT(status.GetIssues().Empty());
+        UNIT_ASSERT(status.GetResponseMetadata().empty());
+        UNIT_ASSERT_VALUES_EQUAL(status.GetConsumedRu(), 0);
+        UNIT_ASSERT(!status.GetRequestTimings());
+        UNIT_ASSERT(HasSharedEmpties(status));
+
+        // Copy keeps the status without the implementation
+        const TStatus copy = status;
+        UNIT_ASSERT(HasSharedEmpties(copy));
+        UNIT_ASSERT_VALUES_EQUAL(&copy.GetEndpoint(), &status.GetEndpoint());
+    }
+
+    Y_UNIT_TEST(TimingsAreInline) {
+        TPlainStatus plain = MakeSuccess("localhost:2135");
+        plain.RequestTimings = TRequestTimings{.Grpc = TDuration::MilliSeconds(3)};
+
+        const TStatus status(std::move(plain));
+        UNIT_ASSERT(status.GetRequestTimings());
+        UNIT_ASSERT_VALUES_EQUAL(status.GetRequestTimings()->Grpc, TDuration::MilliSeconds(3));
+        UNIT_ASSERT(HasSharedEmpties(status));
+
+        const TStatus copy = status;
+        UNIT_ASSERT_VALUES_EQUAL(copy.GetRequestTimings()->Grpc, TDuration::MilliSeconds(3));
+    }
+
+    Y_UNIT_TEST(Details) {
+        NYql::TIssues issues;
+        issues.AddIssue(NYql::TIssue("failed"));
+        const TStatus withIssues(EStatus::BAD_REQUEST, std::move(issues));
+        UNIT_ASSERT(!HasSharedEmpties(withIssues));
+        UNIT_ASSERT_STRING_CONTAINS(withIssues.GetIssues().ToString(), "failed");
+
+        TPlainStatus plain = MakeSuccess("localhost:2135");
+        plain.Metadata.emplace("key", "value");
+        const TStatus withMetadata(std::move(plain));
+        UNIT_ASSERT(!HasSharedEmpties(withMetadata));
+        UNIT_ASSERT_VALUES_EQUAL(withMetadata.GetResponseMetadata().size(), 1);
+
+        plain = MakeSuccess("localhost:2135");
+        Ydb::CostInfo costInfo;
+        costInfo.set_consumed_units(1.5);
+        plain.SetCostInfo(costInfo);
+        const TStatus withCost(std::move(plain));
+        UNIT_ASSERT_VALUES_EQUAL(withCost.GetConsumedRu(), 1.5);
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "fluent_settings_helpers.h"
+
+#include <cstddef>
+
+namespace NYdb {
+
+//! Thread pool which runs SDK callbacks (responses, topic handlers, compression)
+struct TThreadPoolSettings {
+    using TSelf = TThreadPoolSettings;
+
+    //! Every thread has its own task queue and idle threads steal tasks from the others,
+    //! instead of all threads sharing one queue under a mutex.
+    //! Scales better with many threads, but tasks are not run in FIFO order.
+    //! Doesn't make sense for adaptive thread pool (0 threads).
+    FLUENT_SETTING_DEFAULT(bool, WorkStealing, false);
+    //! Idle thread polls queues this many times before it sleeps
+    FLUENT_SETTING_DEFAULT(size_t, SpinIterations, 256);
+    //! Pin threads to cpu cores, linux only
+    FLUENT_SETTING_DEFAULT(bool, PinThreads, false);
+};
+
+} // namespace NYdb
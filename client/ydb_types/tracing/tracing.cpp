@@ -0,0 +1,108 @@
+#include "tracing.h"
+
+#include <algorithm>
+
+namespace NYdb::NTracing {
+
+namespace {
+
+constexpr char HexDigits[] = "0123456789abcdef";
+
+template <size_t N>
+std::string ToHex(const std::array<ui8, N>& bytes) {
+    std::string result;
+    result.reserve(N * 2);
+    for (ui8 byte : bytes) {
+        result.push_back(HexDigits[byte >> 4]);
+        result.push_back(HexDigits[byte & 0xF]);
+    }
+    return result;
+}
+
+int FromHexDigit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+template <size_t N>
+bool FromHex(std::string_view hex, std::array<ui8, N>& bytes) {
+    if (hex.size() != N * 2) {
+        return false;
+    }
+    for (size_t i = 0; i < N; ++i) {
+        const int hi = FromHexDigit(hex[i * 2]);
+        const int lo = FromHexDigit(hex[i * 2 + 1]);
+        if (hi < 0 || lo < 0) {
+            return false;
+        }
+        bytes[i] = (hi << 4) | lo;
+    }
+    return true;
+}
+
+template <size_t N>
+bool IsZero(const std::array<ui8, N>& bytes) {
+    return std::all_of(bytes.begin(), bytes.end(), [](ui8 byte) { return byte == 0; });
+}
+
+} // namespace
+
+bool TSpanContext::IsValid() const {
+    return !IsZero(TraceId) && !IsZero(SpanId);
+}
+
+std::string TSpanContext::GetTraceIdHex() const {
+    return ToHex(TraceId);
+}
+
+std::string TSpanContext::GetSpanIdHex() const {
+    return ToHex(SpanId);
+}
+
+std::string TSpanContext::ToTraceparent() const {
+    std::string result = "00-";
+    result += GetTraceIdHex();
+    result += '-';
+    result += GetSpanIdHex();
+    result += Sampled ? "-01" : "-00";
+    return result;
+}
+
+std::optional<TSpanContext> TSpanContext::FromTraceparent(std::string_view traceparent) {
+    // version "-" trace-id "-" parent-id "-" trace-flags
+    constexpr size_t Size = 2 + 1 + 32 + 1 + 16 + 1 + 2;
+    if (traceparent.size() < Size || traceparent[2] != '-' || traceparent[35] != '-' || traceparent[52] != '-') {
+        return std::nullopt;
+    }
+
+    std::array<ui8, 1> version;
+    std::array<ui8, 1> flags;
+    TSpanContext context;
+    if (!FromHex(traceparent.substr(0, 2), version)
+        || !FromHex(traceparent.substr(3, 32), context.TraceId)
+        || !FromHex(traceparent.substr(36, 16), context.SpanId)
+        || !FromHex(traceparent.substr(53, 2), flags))
+    {
+        return std::nullopt;
+    }
+
+    // version 00 has fixed size, future versions may only append fields
+    if (version[0] == 0xFF || (version[0] == 0 && traceparent.size() != Size)
+        || (traceparent.size() > Size && traceparent[Size] != '-'))
+    {
+        return std::nullopt;
+    }
+
+    context.Sampled = flags[0] & 0x01;
+    if (!context.IsValid()) {
+        return std::nullopt;
+    }
+    return context;
+}
+
+} // namespace NYdb::NTracing
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <client/ydb_types/status_codes.h>
+
+#include <util/system/types.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace NYdb::NTracing {
+
+//! W3C trace context (https://www.w3.org/TR/trace-context/) of a span
+struct TSpanContext {
+    std::array<ui8, 16> TraceId = {};
+    std::array<ui8, 8> SpanId = {};
+    bool Sampled = false;
+
+    //! Context with all zero trace id or span id is invalid
+    bool IsValid() const;
+
+    std::string GetTraceIdHex() const;
+    std::string GetSpanIdHex() const;
+
+    //! Value of the traceparent header, e.g. "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01"
+    std::string ToTraceparent() const;
+    //! Parses traceparent header value, returns nothing if value is malformed
+    static std::optional<TSpanContext> FromTraceparent(std::string_view traceparent);
+};
+
+enum class ESpanKind {
+    //! Internal operation of the SDK, e.g. retry loop or session acquisition
+    Internal,
+    //! Outgoing request to the server
+    Client,
+};
+
+//! Span of an SDK operation, must be finished with End() exactly once
+class ISpan {
+public:
+    virtual ~ISpan() = default;
+
+    virtual const TSpanContext& GetContext() const = 0;
+
+    virtual void SetAttribute(const std::string& key, const std::string& value) = 0;
+    virtual void SetAttribute(const std::string& key, i64 value) = 0;
+    virtual void AddEvent(const std::string& name) = 0;
+
+    //! Finishes span, unsuccessful status marks span as failed
+    virtual void End(EStatus status) = 0;
+};
+
+using TSpanPtr = std::shared_ptr<ISpan>;
+
+//! Tracer is set to the driver with TDriverConfig::SetTracer and is called by SDK
+//! around retries, session acquisition, each gRPC call, stream reads and topic write batches.
+//! Must be thread safe.
+class ITracer {
+public:
+    virtual ~ITracer() = default;
+
+    //! Starts new span, parent is the span of the caller if any.
+    //! May return nullptr if span is not sampled, SDK then skips all the span bookkeeping.
+    virtual TSpanPtr StartSpan(const std::string& name, ESpanKind kind, const TSpanContext* parent) = 0;
+};
+
+} // namespace NYdb::NTracing
@@ -0,0 +1,60 @@
+#include <client/ydb_types/tracing/tracing.h>
+
+#include <library/cpp/testing/unittest/registar.h>
+
+using namespace NYdb::NTracing;
+
+Y_UNIT_TEST_SUITE(TraceparentTest) {
+    Y_UNIT_TEST(Valid) {
+        const std::string traceparent = "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01";
+        auto context = TSpanContext::FromTraceparent(traceparent);
+        UNIT_ASSERT(context);
+        UNIT_ASSERT(context->IsValid());
+        UNIT_ASSERT_VALUES_EQUAL(context->GetTraceIdHex(), "4bf92f3577b34da6a3ce929d0e0e4736");
+        UNIT_ASSERT_VALUES_EQUAL(context->GetSpanIdHex(), "00f067aa0ba902b7");
+        UNIT_ASSERT(context->Sampled);
+        UNIT_ASSERT_VALUES_EQUAL(context->ToTraceparent(), traceparent);
+
+        context = TSpanContext::FromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-00");
+        UNIT_ASSERT(context);
+        UNIT_ASSERT(!context->Sampled);
+
+        // Only the sampled bit of the flags is known
+        context = TSpanContext::FromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-03");
+        UNIT_ASSERT(context);
+        UNIT_ASSERT(context->Sampled);
+    }
+
+    Y_UNIT_TEST(Version) {
+        // Unknown version is parsed as version 00, it may only have more fields after the known ones
+        UNIT_ASSERT(TSpanContext::FromTraceparent("01-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01"));
+        UNIT_ASSERT(TSpanContext::FromTraceparent("cc-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01-what"));
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("cc-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01what"));
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01-what"));
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("ff-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01"));
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("0x-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01"));
+    }
+
+    Y_UNIT_TEST(Length) {
+        UNIT_ASSERT(!TSpanContext::FromTraceparent(""));
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-0"));
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e473-00f067aa0ba902b7-01"));
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b-01"));
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e47360-00f067aa0ba902b7-01"));
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("00_4bf92f3577b34da6a3ce929d0e0e4736_00f067aa0ba902b7_01"));
+    }
+
+    Y_UNIT_TEST(Hex) {
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e473g-00f067aa0ba902b7-01"));
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902-7-01"));
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-0z"));
+        // Only lowercase is allowed
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("00-4BF92F3577B34DA6A3CE929D0E0E4736-00f067aa0ba902b7-01"));
+    }
+
+    Y_UNIT_TEST(ZeroIds) {
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("00-00000000000000000000000000000000-00f067aa0ba902b7-01"));
+        UNIT_ASSERT(!TSpanContext::FromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e4736-0000000000000000-01"));
+        UNIT_ASSERT(!TSpanContext().IsValid());
+    }
+}
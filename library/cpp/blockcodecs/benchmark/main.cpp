@@ -0,0 +1,77 @@
+#include <library/cpp/blockcodecs/codecs.h>
+
+#include <benchmark/benchmark.h>
+
+#include <util/generic/xrange.h>
+
+namespace {
+    const std::string& Block(size_t size) {
+        static const std::string data = [] {
+            std::string data;
+            for (const auto i : xrange(100000)) {
+                data += "{\"id\":" + std::to_string(i) + ",\"name\":\"message " + std::to_string(i % 131) + "\"}";
+            }
+            return data;
+        }();
+        static std::string block;
+        block = data.substr(0, size);
+        return block;
+    }
+
+    void CodecCompress(benchmark::State& state, const char* name) {
+        const NBlockCodecs::ICodec* codec = NBlockCodecs::Codec(name);
+        const std::string block = Block(state.range(0));
+        std::string compressed;
+        for (auto _ : state) {
+            codec->Encode(block, compressed);
+            benchmark::DoNotOptimize(compressed);
+        }
+        state.SetBytesProcessed(state.iterations() * block.size());
+    }
+
+    void ContextCompress(benchmark::State& state, const char* name) {
+        NBlockCodecs::TCodecContextPtr context = NBlockCodecs::Codec(name)->CreateContext();
+        const std::string block = Block(state.range(0));
+        std::string compressed;
+        for (auto _ : state) {
+            context->Encode(block, compressed);
+            benchmark::DoNotOptimize(compressed);
+        }
+        state.SetBytesProcessed(state.iterations() * block.size());
+    }
+
+    void CodecDecompress(benchmark::State& state, const char* name) {
+        const NBlockCodecs::ICodec* codec = NBlockCodecs::Codec(name);
+        const std::string compressed = codec->Encode(Block(state.range(0)));
+        std::string block;
+        for (auto _ : state) {
+            codec->Decode(compressed, block);
+            benchmark::DoNotOptimize(block);
+        }
+        state.SetBytesProcessed(state.iterations() * block.size());
+    }
+
+    void ContextDecompress(benchmark::State& state, const char* name) {
+        NBlockCodecs::TCodecContextPtr context = NBlockCodecs::Codec(name)->CreateContext();
+        const std::string compressed = context->Codec()->Encode(Block(state.range(0)));
+        std::string block;
+        for (auto _ : state) {
+            context->Decode(compressed, block);
+            benchmark::DoNotOptimize(block);
+        }
+        state.SetBytesProcessed(state.iterations() * block.size());
+    }
+}
+
+// Small blocks, like topic messages and http bodies, are where per call state allocation shows up
+#define CODEC_BENCHMARKS(func)                                                                      \
+    BENCHMARK_CAPTURE(func, zstd_1, "zstd_1")->RangeMultiplier(8)->Range(512, 256 << 10);           \
+    BENCHMARK_CAPTURE(func, zstd_6, "zstd_6")->RangeMultiplier(8)->Range(512, 256 << 10);           \
+    BENCHMARK_CAPTURE(func, lz4, "lz4")->RangeMultiplier(8)->Range(512, 256 << 10);                 \
+    BENCHMARK_CAPTURE(func, brotli_1, "brotli_1")->RangeMultiplier(8)->Range(512, 256 << 10);       \
+    BENCHMARK_CAPTURE(func, snappy, "snappy")->RangeMultiplier(8)->Range(512, 256 << 10);
+
+CODEC_BENCHMARKS(CodecCompress)
+CODEC_BENCHMARKS(ContextCompress)
+CODEC_BENCHMARKS(CodecDecompress)
+CODEC_BENCHMARKS(ContextDecompress)
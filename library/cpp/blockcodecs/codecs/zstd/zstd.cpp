@@ -2,8 +2,13 @@
 #include <library/cpp/blockcodecs/core/common.h>
 #include <library/cpp/blockcodecs/core/register.h>
 
+#include <util/generic/hash.h>
+#include <util/generic/singleton.h>
 #include <util/string/builder.h>
 
+#include <memory>
+#include <mutex>
+
 #define ZSTD_STATIC_LINKING_ONLY
 #include <zstd.h>
 
@@ -45,10 +50,134 @@ namespace {
             return MyName;
         }
 
+        TCodecContextPtr CreateContext() const override;
+        TCodecContextPtr CreateDictionaryContext(const std::string_view& dictionary) const override;
+
         const unsigned Level;
         const std::string MyName;
     };
 
+    // Digested dictionaries are shared by all contexts and are kept forever, like the dictionaries
+    class TZStdDictionaries {
+    public:
+        inline const ZSTD_CDict* CDict(const std::string_view& name, unsigned level) {
+            std::lock_guard guard(Lock_);
+
+            auto& dict = CDicts_[std::make_pair(std::string(name), level)];
+
+            if (!dict) {
+                const TData data = Dictionary(name);
+
+                dict = ZSTD_createCDict(data.data(), data.size(), level);
+
+                if (!dict) {
+                    ythrow yexception() << "can not create zstd dictionary " << name;
+                }
+            }
+
+            return dict;
+        }
+
+        inline const ZSTD_DDict* DDict(const std::string_view& name) {
+            std::lock_guard guard(Lock_);
+
+            auto& dict = DDicts_[std::string(name)];
+
+            if (!dict) {
+                const TData data = Dictionary(name);
+
+                dict = ZSTD_createDDict(data.data(), data.size());
+
+                if (!dict) {
+                    ythrow yexception() << "can not create zstd dictionary " << name;
+                }
+            }
+
+            return dict;
+        }
+
+    private:
+        std::mutex Lock_;
+        THashMap<std::pair<std::string, unsigned>, ZSTD_CDict*> CDicts_;
+        THashMap<std::string, ZSTD_DDict*> DDicts_;
+    };
+
+    // Keeps compression and decompression contexts of zstd between blocks,
+    // they are created on the first use since most streams only compress or decompress
+    struct TZStd08Context: public TAddLengthCodecContext<TZStd08Context> {
+        struct TCCtxDeleter {
+            void operator()(ZSTD_CCtx* ctx) const noexcept {
+                ZSTD_freeCCtx(ctx);
+            }
+        };
+
+        struct TDCtxDeleter {
+            void operator()(ZSTD_DCtx* ctx) const noexcept {
+                ZSTD_freeDCtx(ctx);
+            }
+        };
+
+        inline TZStd08Context(const TZStd08Codec* codec, const ZSTD_CDict* cdict = nullptr, const ZSTD_DDict* ddict = nullptr)
+            : TAddLengthCodecContext<TZStd08Context>(codec)
+            , Level(codec->Level)
+            , CDict(cdict)
+            , DDict(ddict)
+        {
+        }
+
+        inline size_t DoCompress(const TData& in, void* out) {
+            if (!CCtx) {
+                CCtx.reset(ZSTD_createCCtx());
+
+                if (!CCtx) {
+                    ythrow yexception() << "can not create zstd compression context";
+                }
+            }
+
+            const size_t bound = TZStd08Codec::DoMaxCompressedLength(in.size());
+
+            if (CDict) {
+                return TZStd08Codec::CheckError(ZSTD_compress_usingCDict(CCtx.get(), out, bound, in.data(), in.size(), CDict), "compress");
+            }
+
+            return TZStd08Codec::CheckError(ZSTD_compressCCtx(CCtx.get(), out, bound, in.data(), in.size(), Level), "compress");
+        }
+
+        inline void DoDecompress(const TData& in, void* out, size_t dsize) {
+            if (!DCtx) {
+                DCtx.reset(ZSTD_createDCtx());
+
+                if (!DCtx) {
+                    ythrow yexception() << "can not create zstd decompression context";
+                }
+            }
+
+            const size_t res = DDict
+                ? ZSTD_decompress_usingDDict(DCtx.get(), out, dsize, in.data(), in.size(), DDict)
+                : ZSTD_decompressDCtx(DCtx.get(), out, dsize, in.data(), in.size());
+
+            if (TZStd08Codec::CheckError(res, "decompress") != dsize) {
+                ythrow TDecompressError(dsize, res);
+            }
+        }
+
+        const unsigned Level;
+        const ZSTD_CDict* const CDict;
+        const ZSTD_DDict* const DDict;
+        std::unique_ptr<ZSTD_CCtx, TCCtxDeleter> CCtx;
+        std::unique_ptr<ZSTD_DCtx, TDCtxDeleter> DCtx;
+    };
+
+    TCodecContextPtr TZStd08Codec::CreateContext() const {
+        return MakeHolder<TZStd08Context>(this);
+    }
+
+    TCodecContextPtr TZStd08Codec::CreateDictionaryContext(const std::string_view& dictionary) const {
+        auto* dictionaries = Singleton<TZStdDictionaries>();
+
+        return MakeHolder<TZStd08Context>(this, dictionaries->CDict(dictionary, Level), dictionaries->DDict(dictionary));
+    }
+
     struct TZStd08Registrar {
         TZStd08Registrar() {
             for (int i = 1; i <= ZSTD_maxCLevel(); ++i) {
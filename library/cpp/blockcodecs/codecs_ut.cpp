@@ -6,6 +6,7 @@
 #include <util/stream/str.h>
 #include <util/string/join.h>
 #include <util/digest/multi.h>
+#include <util/thread/pool.h>
 
 Y_UNIT_TEST_SUITE(TBlockCodecsTest) {
     using namespace NBlockCodecs;
@@ -270,6 +271,47 @@ Y_UNIT_TEST_SUITE(TBlockCodecsTest) {
         TestStreams(20, 19);
     }
 
+    Y_UNIT_TEST(TestParallelStreams) {
+        std::vector<std::string> datas;
+        std::string res;
+
+        for (size_t i = 0; i < 256; ++i) {
+            datas.push_back(std::string(i, (char)(i % 128)));
+            res += datas.back();
+        }
+
+        TThreadPool pool;
+        pool.Start(4);
+
+        for (const auto& name : {"null", "lz4", "zstd_1", "snappy"}) {
+            const ICodec* c = Codec(name);
+
+            TStringStream expected;
+            TStringStream ss;
+
+            {
+                TCodedOutput out(&expected, c, 1234);
+                TParallelCodedOutput parallelOut(&ss, c, 1234, &pool, 3);
+
+                for (size_t j = 0; j < datas.size(); ++j) {
+                    out << datas[j];
+                    parallelOut << datas[j];
+
+                    if (j % 100 == 0) {
+                        out.Flush();
+                        parallelOut.Flush();
+                    }
+                }
+
+                out.Finish();
+                parallelOut.Finish();
+            }
+
+            UNIT_ASSERT_EQUAL(ss.Str(), expected.Str());
+            UNIT_ASSERT_EQUAL(TParallelDecodedInput(&ss, &pool, 3, c).ReadAll(), res);
+        }
+    }
+
     Y_UNIT_TEST(TestMaxPossibleDecompressedSize) {
 
         UNIT_ASSERT_VALUES_EQUAL(GetMaxPossibleDecompressedLength(), Max<size_t>());
@@ -337,4 +379,45 @@ Y_UNIT_TEST_SUITE(TBlockCodecsTest) {
             UNIT_ASSERT_VALUES_EQUAL(decoded, data);
         }
     }
+
+    Y_UNIT_TEST(TestContexts) {
+        std::string data;
+
+        for (size_t i = 0; i < 1000; ++i) {
+            data += "na gorshke sidel korol " + std::to_string(i % 17);
+        }
+
+        for (const auto& codec : ListAllCodecs()) {
+            const ICodec* c = Codec(codec);
+            TCodecContextPtr ctx = c->CreateContext();
+
+            UNIT_ASSERT_EQUAL(ctx->Codec(), c);
+
+            // contexts are reused for many blocks and produce the same blocks as the codec
+            for (size_t i = 0; i < 3; ++i) {
+                std::string encoded;
+                ctx->Encode(data, encoded);
+
+                UNIT_ASSERT_VALUES_EQUAL(c->Decode(encoded), data);
+
+                std::string decoded;
+                ctx->Decode(c->Encode(data), decoded);
+
+                UNIT_ASSERT_VALUES_EQUAL(decoded, data);
+            }
+        }
+
+        RegisterDictionary("test", std::string_view("na gorshke sidel korol 1na gorshke sidel korol 2"));
+        UNIT_ASSERT_EXCEPTION(RegisterDictionary("test", std::string_view("other")), TCodecError);
+
+        TCodecContextPtr ctx = Codec("zstd_1")->CreateDictionaryContext("test");
+        std::string encoded;
+        std::string decoded;
+        ctx->Encode(std::string_view("na gorshke sidel korol 3"), encoded);
+        Codec("zstd_1")->CreateDictionaryContext("test")->Decode(encoded, decoded);
+
+        UNIT_ASSERT_VALUES_EQUAL(decoded, "na gorshke sidel korol 3");
+        UNIT_ASSERT_EXCEPTION(Codec("zstd_1")->CreateDictionaryContext("unknown"), TNotFound);
+        UNIT_ASSERT_EXCEPTION(Codec("lz4")->CreateDictionaryContext("test"), TNotFound);
+    }
 }
@@ -18,6 +18,8 @@
 #include <util/generic/algorithm.h>
 #include <util/generic/mem_copy.h>
 
+#include <mutex>
+
 using namespace NBlockCodecs;
 
 namespace {
@@ -59,12 +61,36 @@ namespace {
             Registry[Tmp.back()] = Registry[to];
         }
 
+        inline void AddDictionary(std::string_view name, const TData& dictionary) {
+            std::lock_guard guard(DictionariesLock);
+
+            // contexts keep pointers to the data, so it is never replaced
+            if (!Dictionaries.emplace(name, dictionary).second) {
+                ythrow TCodecError() << "dictionary " << name << " is already registered";
+            }
+        }
+
+        inline TData FindDictionary(const std::string_view& name) const {
+            std::lock_guard guard(DictionariesLock);
+
+            auto it = Dictionaries.find(name);
+
+            if (it == Dictionaries.end()) {
+                ythrow TNotFound() << "can not found " << name << " dictionary";
+            }
+
+            return it->second;
+        }
+
         TDeque<std::string> Tmp;
         TNullCodec Null;
         std::vector<TCodecPtr> Codecs;
         typedef THashMap<std::string_view, ICodec*> TRegistry;
         TRegistry Registry;
 
+        mutable std::mutex DictionariesLock;
+        THashMap<std::string, std::string> Dictionaries;
+
         // SEARCH-8344: Global decompressed size limiter (to prevent remote DoS)
         size_t MaxPossibleDecompressedLength = Max<size_t>();
     };
@@ -102,6 +128,45 @@ size_t NBlockCodecs::GetMaxPossibleDecompressedLength() {
     return Singleton<TCodecFactory>()->MaxPossibleDecompressedLength;
 }
 
+void NBlockCodecs::RegisterDictionary(std::string_view name, const TData& dictionary) {
+    Singleton<TCodecFactory>()->AddDictionary(name, dictionary);
+}
+
+TData NBlockCodecs::Dictionary(const std::string_view& name) {
+    return Singleton<TCodecFactory>()->FindDictionary(name);
+}
+
+namespace {
+    struct TStatelessContext: public ICodecContext {
+        inline TStatelessContext(const ICodec* codec)
+            : C(codec)
+        {
+        }
+
+        size_t Compress(const TData& in, void* out) override {
+            return C->Compress(in, out);
+        }
+
+        size_t Decompress(const TData& in, void* out) override {
+            return C->Decompress(in, out);
+        }
+
+        const ICodec* Codec() const noexcept override {
+            return C;
+        }
+
+        const ICodec* C;
+    };
+}
+
+TCodecContextPtr ICodec::CreateContext() const {
+    return MakeHolder<TStatelessContext>(this);
+}
+
+TCodecContextPtr ICodec::CreateDictionaryContext(const std::string_view& dictionary) const {
+    ythrow TNotFound() << Name() << " codec doesn't support dictionaries, can not use " << dictionary;
+}
+
 size_t ICodec::GetDecompressedLength(const TData& in) const {
     const size_t len = DecompressedLength(in);
 
@@ -146,3 +211,37 @@ void ICodec::Decode(const TData& in, std::string& out) const {
 }
 
 ICodec::~ICodec() = default;
+
+void ICodecContext::Encode(const TData& in, TBuffer& out) {
+    const size_t maxLen = Codec()->MaxCompressedLength(in);
+
+    out.Reserve(maxLen);
+    out.Resize(Compress(in, out.Data()));
+}
+
+void ICodecContext::Decode(const TData& in, TBuffer& out) {
+    const size_t len = Codec()->GetDecompressedLength(in);
+
+    out.Reserve(len);
+    out.Resize(Decompress(in, out.Data()));
+}
+
+void ICodecContext::Encode(const TData& in, std::string& out) {
+    const size_t maxLen = Codec()->MaxCompressedLength(in);
+    out.resize(maxLen);
+
+    size_t actualLen = Compress(in, out.data());
+    Y_ASSERT(actualLen <= maxLen);
+    out.resize(actualLen);
+}
+
+void ICodecContext::Decode(const TData& in, std::string& out) {
+    const size_t maxLen = Codec()->GetDecompressedLength(in);
+    out.resize(maxLen);
+
+    size_t actualLen = Decompress(in, out.data());
+    Y_ASSERT(actualLen <= maxLen);
+    out.resize(actualLen);
+}
+
+ICodecContext::~ICodecContext() = default;
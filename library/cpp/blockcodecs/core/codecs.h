@@ -35,6 +35,30 @@ namespace NBlockCodecs {
     struct TDataError: public TCodecError {
     };
 
+    struct ICodec;
+
+    // Reusable state of a codec, e.g. zstd compression and decompression contexts which
+    // are allocated and initialized on every call of ICodec::Compress otherwise.
+    // Context is not thread safe, keep one per thread and reuse it for many blocks.
+    struct ICodecContext {
+        virtual ~ICodecContext();
+
+        // same as in ICodec, blocks are compatible with the codec unless a dictionary is used
+        virtual size_t Compress(const TData& in, void* out) = 0;
+        virtual size_t Decompress(const TData& in, void* out) = 0;
+
+        virtual const ICodec* Codec() const noexcept = 0;
+
+        // some useful helpers
+        void Encode(const TData& in, TBuffer& out);
+        void Decode(const TData& in, TBuffer& out);
+
+        void Encode(const TData& in, std::string& out);
+        void Decode(const TData& in, std::string& out);
+    };
+
+    using TCodecContextPtr = THolder<ICodecContext>;
+
     struct ICodec {
         virtual ~ICodec();
 
@@ -46,6 +70,13 @@ namespace NBlockCodecs {
 
         virtual std::string_view Name() const noexcept = 0;
 
+        // codecs without reusable state return context which calls the codec
+        virtual TCodecContextPtr CreateContext() const;
+        // context which compresses with the dictionary registered by RegisterDictionary,
+        // such blocks can be decompressed only by a context with the same dictionary,
+        // throws TNotFound if the codec doesn't support dictionaries
+        virtual TCodecContextPtr CreateDictionaryContext(const std::string_view& dictionary) const;
+
         // some useful helpers
         void Encode(const TData& in, TBuffer& out) const;
         void Decode(const TData& in, TBuffer& out) const;
@@ -69,6 +100,8 @@ namespace NBlockCodecs {
             return out;
         }
     private:
+        friend struct ICodecContext;
+
         size_t GetDecompressedLength(const TData& in) const;
     };
 
@@ -76,6 +109,11 @@ namespace NBlockCodecs {
 
     const ICodec* Codec(const std::string_view& name);
 
+    // Dictionary is registered once, usually at startup, and is kept until the program exits
+    void RegisterDictionary(std::string_view name, const TData& dictionary);
+    // throws TNotFound for unknown dictionary
+    TData Dictionary(const std::string_view& name);
+
     // some aux methods
     typedef std::vector<std::string_view> TCodecList;
     TCodecList ListAllCodecs();
@@ -60,33 +60,25 @@ namespace NBlockCodecs {
         }
     };
 
-    template <class T>
-    struct TAddLengthCodec: public ICodec {
+    // Block is 8 bytes of decompressed length followed by data compressed by T::DoCompress
+    struct TAddLength {
         static inline void Check(const TData& in) {
             if (in.size() < sizeof(ui64)) {
                 ythrow TDataError() << "too small input";
             }
         }
 
-        size_t DecompressedLength(const TData& in) const override {
-            Check(in);
-
-            return ReadUnaligned<ui64>(in.data());
-        }
-
-        size_t MaxCompressedLength(const TData& in) const override {
-            return T::DoMaxCompressedLength(in.size()) + sizeof(ui64);
-        }
-
-        size_t Compress(const TData& in, void* out) const override {
+        template <class T>
+        static inline size_t Compress(T& base, const TData& in, void* out) {
             ui64* ptr = (ui64*)out;
 
             WriteUnaligned<ui64>(ptr, (ui64) in.size());
 
-            return Base()->DoCompress(in.empty() ? TData(std::string_view("")) : in, ptr + 1) + sizeof(*ptr);
+            return base.DoCompress(in.empty() ? TData(std::string_view("")) : in, ptr + 1) + sizeof(*ptr);
         }
 
-        size_t Decompress(const TData& in, void* out) const override {
+        template <class T>
+        static inline size_t Decompress(T& base, const TData& in, void* out) {
             Check(in);
 
             const auto len = ReadUnaligned<ui64>(in.data());
@@ -95,12 +87,64 @@ namespace NBlockCodecs {
                 return 0;
             TData inCopy(in);
             inCopy.remove_prefix(sizeof(len));
-            Base()->DoDecompress(inCopy, out, len);
+            base.DoDecompress(inCopy, out, len);
             return len;
         }
+    };
+
+    template <class T>
+    struct TAddLengthCodec: public ICodec {
+        static inline void Check(const TData& in) {
+            TAddLength::Check(in);
+        }
+
+        size_t DecompressedLength(const TData& in) const override {
+            Check(in);
+
+            return ReadUnaligned<ui64>(in.data());
+        }
+
+        size_t MaxCompressedLength(const TData& in) const override {
+            return T::DoMaxCompressedLength(in.size()) + sizeof(ui64);
+        }
+
+        size_t Compress(const TData& in, void* out) const override {
+            return TAddLength::Compress(*Base(), in, out);
+        }
+
+        size_t Decompress(const TData& in, void* out) const override {
+            return TAddLength::Decompress(*Base(), in, out);
+        }
 
         inline const T* Base() const noexcept {
             return static_cast<const T*>(this);
         }
     };
+
+    // Context of TAddLengthCodec, T keeps the state and implements DoCompress and DoDecompress
+    template <class T>
+    struct TAddLengthCodecContext: public ICodecContext {
+        inline TAddLengthCodecContext(const ICodec* codec)
+            : C(codec)
+        {
+        }
+
+        size_t Compress(const TData& in, void* out) override {
+            return TAddLength::Compress(*Base(), in, out);
+        }
+
+        size_t Decompress(const TData& in, void* out) override {
+            return TAddLength::Decompress(*Base(), in, out);
+        }
+
+        const ICodec* Codec() const noexcept override {
+            return C;
+        }
+
+        inline T* Base() noexcept {
+            return static_cast<T*>(this);
+        }
+
+        const ICodec* C;
+    };
 }
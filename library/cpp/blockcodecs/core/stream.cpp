@@ -7,8 +7,13 @@
 #include <util/generic/hash.h>
 #include <util/generic/singleton.h>
 #include <util/stream/mem.h>
+#include <util/thread/pool.h>
 #include <util/ysaveload.h>
 
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
 using namespace NBlockCodecs;
 
 namespace {
@@ -62,10 +67,157 @@ namespace {
     const ICodec* CodecByID(TCodecID id) {
         return Singleton<TIds>()->Find(id);
     }
+
+    // Block of the stream is codec id, compressed length and compressed data
+    void CompressBlock(ICodecContext& ctx, const TBuffer& data, TBuffer& out) {
+        const ICodec* c = ctx.Codec();
+        const size_t payload = sizeof(TCodecID) + sizeof(TBlockLen);
+        out.Reserve(c->MaxCompressedLength(data) + payload);
+
+        void* compressed = out.Data() + payload;
+        const size_t olen = ctx.Compress(data, compressed);
+
+        {
+            TMemoryOutput mo(out.Data(), payload);
+
+            ::Save(&mo, CodecID(c));
+            ::Save(&mo, SafeIntegerCast<TBlockLen>(olen));
+        }
+
+        out.Resize(payload + olen);
+    }
+
+    // Returns false on zero length block which marks end of the stream
+    bool ReadBlock(IInputStream* in, const ICodec* expected, const ICodec*& codec, TBuffer& block) {
+        TCodecID codecId;
+        TBlockLen blockLen;
+
+        {
+            const size_t payload = sizeof(TCodecID) + sizeof(TBlockLen);
+            char buf[32];
+
+            in->LoadOrFail(buf, payload);
+
+            TMemoryInput mi(buf, payload);
+
+            ::Load(&mi, codecId);
+            ::Load(&mi, blockLen);
+        }
+
+        if (!blockLen) {
+            return false;
+        }
+
+        if (Y_UNLIKELY(blockLen > 1024 * 1024 * 1024)) {
+            ythrow yexception() << "block size exceeds 1 GiB";
+        }
+
+        block.Resize(blockLen);
+
+        in->LoadOrFail(block.Data(), blockLen);
+
+        codec = CodecByID(codecId);
+
+        if (expected) {
+            Y_ENSURE(expected->Name() == codec->Name(), std::string_view("incorrect stream codec"));
+        }
+
+        if (codec->DecompressedLength(block) > MAX_BUF_LEN) {
+            ythrow yexception() << "broken stream";
+        }
+
+        return true;
+    }
+
+    // Blocks of a stream may be compressed by different codecs
+    ICodecContext& ContextFor(const ICodec* codec, TCodecContextPtr& ctx) {
+        if (!ctx || ctx->Codec() != codec) {
+            ctx = codec->CreateContext();
+        }
+
+        return *ctx;
+    }
+}
+
+namespace NBlockCodecs {
+    struct TParallelBlock {
+        TBuffer Input;
+        TBuffer Output;
+
+        std::mutex Lock;
+        std::condition_variable CondVar;
+        bool Done = false;
+        std::exception_ptr Error;
+
+        // Used by the task which owns the block
+        TCodecContextPtr Context;
+
+        // Runs func on the pool, or in the calling thread if the pool doesn't accept tasks
+        template <typename TFunc>
+        static void Run(IThreadPool* pool, std::shared_ptr<TParallelBlock> block, TFunc func) {
+            block->Done = false;
+            block->Error = nullptr;
+
+            auto job = [block, func] {
+                std::exception_ptr error;
+                try {
+                    func(*block);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+
+                std::lock_guard guard(block->Lock);
+                block->Error = error;
+                block->Done = true;
+                block->CondVar.notify_all();
+            };
+
+            if (!pool->AddFunc(job)) {
+                job();
+            }
+        }
+
+        // Rethrows error of the codec
+        void Wait() {
+            {
+                std::unique_lock guard(Lock);
+                CondVar.wait(guard, [this] {
+                    return Done;
+                });
+            }
+
+            if (Error) {
+                std::rethrow_exception(std::exchange(Error, nullptr));
+            }
+        }
+    };
+}
+
+namespace {
+    std::shared_ptr<TParallelBlock> AcquireBlock(std::vector<std::shared_ptr<TParallelBlock>>& free) {
+        if (free.empty()) {
+            return std::make_shared<TParallelBlock>();
+        }
+
+        auto block = std::move(free.back());
+        free.pop_back();
+        return block;
+    }
+
+    void WaitBlocks(std::deque<std::shared_ptr<TParallelBlock>>& inFlight) noexcept {
+        for (auto& block : inFlight) {
+            try {
+                block->Wait();
+            } catch (...) {
+            }
+        }
+        inFlight.clear();
+    }
 }
 
 TCodedOutput::TCodedOutput(IOutputStream* out, const ICodec* c, size_t bufLen)
     : C_(c)
+    , Ctx_(c->CreateContext())
     , D_(bufLen)
     , S_(out)
 {
@@ -106,20 +258,9 @@ void TCodedOutput::DoWrite(const void* buf, size_t len) {
 
 bool TCodedOutput::FlushImpl() {
     const bool ret = !D_.Empty();
-    const size_t payload = sizeof(TCodecID) + sizeof(TBlockLen);
-    O_.Reserve(C_->MaxCompressedLength(D_) + payload);
-
-    void* out = O_.Data() + payload;
-    const size_t olen = C_->Compress(D_, out);
 
-    {
-        TMemoryOutput mo(O_.Data(), payload);
-
-        ::Save(&mo, CodecID(C_));
-        ::Save(&mo, SafeIntegerCast<TBlockLen>(olen));
-    }
-
-    S_->Write(O_.Data(), payload + olen);
+    CompressBlock(*Ctx_, D_, O_);
+    S_->Write(O_.Data(), O_.Size());
 
     D_.Clear();
     O_.Clear();
@@ -165,48 +306,191 @@ size_t TDecodedInput::DoUnboundedNext(const void** ptr) {
         return 0;
     }
 
-    TCodecID codecId;
-    TBlockLen blockLen;
+    const ICodec* codec = nullptr;
+    TBuffer block;
 
-    {
-        const size_t payload = sizeof(TCodecID) + sizeof(TBlockLen);
-        char buf[32];
+    if (!ReadBlock(S_, C_, codec, block)) {
+        S_ = nullptr;
 
-        S_->LoadOrFail(buf, payload);
+        return 0;
+    }
 
-        TMemoryInput in(buf, payload);
+    ContextFor(codec, Ctx_).Decode(block, D_);
+    *ptr = D_.Data();
 
-        ::Load(&in, codecId);
-        ::Load(&in, blockLen);
+    return D_.Size();
+}
+
+TParallelCodedOutput::TParallelCodedOutput(IOutputStream* out, const ICodec* c, size_t bufLen, IThreadPool* pool, size_t maxInFlight)
+    : C_(c)
+    , D_(bufLen)
+    // Blocks must be split at the same offsets as in TCodedOutput, which fills the whole capacity of its buffer
+    , BlockLen_(D_.Capacity())
+    , Pool_(pool)
+    , MaxInFlight_(Max<size_t>(maxInFlight, 1))
+    , S_(out)
+{
+    if (bufLen > MAX_BUF_LEN) {
+        ythrow yexception() << std::string_view("too big buffer size: ") << bufLen;
     }
+}
 
-    if (!blockLen) {
-        S_ = nullptr;
+TParallelCodedOutput::~TParallelCodedOutput() {
+    try {
+        Finish();
+    } catch (...) {
+    }
 
-        return 0;
+    // Blocks are still compressed if Finish has failed
+    WaitBlocks(InFlight_);
+}
+
+void TParallelCodedOutput::DoWrite(const void* buf, size_t len) {
+    const char* in = (const char*)buf;
+
+    while (len) {
+        const size_t avail = BlockLen_ - D_.Size();
+
+        if (len < avail) {
+            D_.Append(in, len);
+
+            return;
+        }
+
+        D_.Append(in, avail);
+
+        in += avail;
+        len -= avail;
+
+        Y_ABORT_UNLESS(Submit(), "flush on writing failed");
     }
+}
+
+bool TParallelCodedOutput::Submit() {
+    const bool ret = !D_.Empty();
+
+    WriteBlocks(MaxInFlight_);
 
-    if (Y_UNLIKELY(blockLen > 1024 * 1024 * 1024)) {
-        ythrow yexception() << "block size exceeds 1 GiB";
+    auto block = AcquireBlock(Free_);
+    block->Input.Swap(D_);
+    D_.Clear();
+    D_.Reserve(BlockLen_);
+
+    TParallelBlock::Run(Pool_, block, [codec = C_](TParallelBlock& block) {
+        CompressBlock(ContextFor(codec, block.Context), block.Input, block.Output);
+    });
+    InFlight_.push_back(std::move(block));
+
+    // Don't keep blocks which are already compressed
+    WriteBlocks(MaxInFlight_);
+
+    return ret;
+}
+
+void TParallelCodedOutput::WriteBlocks(size_t maxInFlight) {
+    while (!InFlight_.empty()) {
+        auto& block = InFlight_.front();
+        if (InFlight_.size() < maxInFlight) {
+            std::lock_guard guard(block->Lock);
+            if (!block->Done) {
+                return;
+            }
+        }
+
+        block->Wait();
+        S_->Write(block->Output.Data(), block->Output.Size());
+        block->Input.Clear();
+        block->Output.Clear();
+
+        Free_.push_back(std::move(block));
+        InFlight_.pop_front();
     }
+}
 
-    TBuffer block;
-    block.Resize(blockLen);
+void TParallelCodedOutput::DoFlush() {
+    if (S_) {
+        if (!D_.Empty()) {
+            Submit();
+        }
 
-    S_->LoadOrFail(block.Data(), blockLen);
+        WriteBlocks(0);
+    }
+}
+
+void TParallelCodedOutput::DoFinish() {
+    if (S_) {
+        Y_DEFER {
+            S_ = nullptr;
+        };
 
-    auto codec = CodecByID(codecId);
+        if (Submit()) {
+            //always write zero-length block as eos marker
+            Submit();
+        }
 
-    if (C_) {
-        Y_ENSURE(C_->Name() == codec->Name(), std::string_view("incorrect stream codec"));
+        WriteBlocks(0);
     }
+}
+
+TParallelDecodedInput::TParallelDecodedInput(IInputStream* in, IThreadPool* pool, size_t maxInFlight, const ICodec* codec)
+    : S_(in)
+    , C_(codec)
+    , Pool_(pool)
+    , MaxInFlight_(Max<size_t>(maxInFlight, 1))
+{
+}
+
+TParallelDecodedInput::~TParallelDecodedInput() {
+    WaitBlocks(InFlight_);
+}
+
+size_t TParallelDecodedInput::DoUnboundedNext(const void** ptr) {
+    ReadAhead();
 
-    if (codec->DecompressedLength(block) > MAX_BUF_LEN) {
-        ythrow yexception() << "broken stream";
+    if (InFlight_.empty()) {
+        return 0;
     }
 
-    codec->Decode(block, D_);
+    auto block = std::move(InFlight_.front());
+    InFlight_.pop_front();
+
+    Y_DEFER {
+        block->Input.Clear();
+        Free_.push_back(std::move(block));
+    };
+
+    block->Wait();
+    D_.Swap(block->Output);
+
+    // Next block is decompressed while the caller consumes this one
+    ReadAhead();
+
     *ptr = D_.Data();
 
     return D_.Size();
 }
+
+void TParallelDecodedInput::ReadAhead() {
+    while (S_ && InFlight_.size() < MaxInFlight_) {
+        auto block = AcquireBlock(Free_);
+        const ICodec* codec = nullptr;
+
+        if (!ReadBlock(S_, C_, codec, block->Input)) {
+            S_ = nullptr;
+            Free_.push_back(std::move(block));
+
+            return;
+        }
+
+        // Empty block is written by TCodedOutput at the end of the stream only,
+        // so nothing after it is read, like TDecodedInput does
+        if (!codec->DecompressedLength(block->Input)) {
+            S_ = nullptr;
+        }
+
+        TParallelBlock::Run(Pool_, block, [codec](TParallelBlock& block) {
+            ContextFor(codec, block.Context).Decode(block.Input, block.Output);
+        });
+        InFlight_.push_back(std::move(block));
+    }
+}
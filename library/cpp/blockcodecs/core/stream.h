@@ -5,9 +5,18 @@
 #include <util/stream/output.h>
 #include <util/stream/zerocopy.h>
 #include <util/generic/buffer.h>
+#include <util/generic/ptr.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+class IThreadPool;
 
 namespace NBlockCodecs {
     struct ICodec;
+    struct ICodecContext;
+    struct TParallelBlock;
 
     class TCodedOutput: public IOutputStream {
     public:
@@ -23,6 +32,7 @@ namespace NBlockCodecs {
 
     private:
         const ICodec* C_;
+        THolder<ICodecContext> Ctx_;
         TBuffer D_;
         TBuffer O_;
         IOutputStream* S_;
@@ -42,5 +52,55 @@ namespace NBlockCodecs {
         TBuffer D_;
         IInputStream* S_;
         const ICodec* C_;
+        THolder<ICodecContext> Ctx_;
+    };
+
+    // Writes the same stream as TCodedOutput, byte to byte, but compresses blocks on the thread pool.
+    // At most maxInFlight blocks are kept in memory, Write waits for the oldest one when all are busy.
+    class TParallelCodedOutput: public IOutputStream {
+    public:
+        TParallelCodedOutput(IOutputStream* out, const ICodec* c, size_t bufLen, IThreadPool* pool, size_t maxInFlight);
+        ~TParallelCodedOutput() override;
+
+    private:
+        void DoWrite(const void* buf, size_t len) override;
+        void DoFlush() override;
+        void DoFinish() override;
+
+        bool Submit();
+        // Writes compressed blocks in order until less than maxInFlight are left
+        void WriteBlocks(size_t maxInFlight);
+
+    private:
+        const ICodec* C_;
+        TBuffer D_;
+        const size_t BlockLen_;
+        IThreadPool* Pool_;
+        const size_t MaxInFlight_;
+        std::deque<std::shared_ptr<TParallelBlock>> InFlight_;
+        std::vector<std::shared_ptr<TParallelBlock>> Free_;
+        IOutputStream* S_;
+    };
+
+    // Reads stream of TCodedOutput, next maxInFlight blocks are decompressed on the thread pool
+    // while the caller consumes the current one
+    class TParallelDecodedInput: public IWalkInput {
+    public:
+        TParallelDecodedInput(IInputStream* in, IThreadPool* pool, size_t maxInFlight, const ICodec* codec = nullptr);
+        ~TParallelDecodedInput() override;
+
+    private:
+        size_t DoUnboundedNext(const void** ptr) override;
+
+        void ReadAhead();
+
+    private:
+        TBuffer D_;
+        IInputStream* S_;
+        const ICodec* C_;
+        IThreadPool* Pool_;
+        const size_t MaxInFlight_;
+        std::deque<std::shared_ptr<TParallelBlock>> InFlight_;
+        std::vector<std::shared_ptr<TParallelBlock>> Free_;
     };
 }
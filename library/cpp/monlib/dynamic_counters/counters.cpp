@@ -5,6 +5,8 @@
 
 #include <util/generic/cast.h>
 
+#include <algorithm>
+
 using namespace NMonitoring;
 
 namespace {
@@ -143,7 +145,7 @@ TIntrusivePtr<TDynamicCounters> TDynamicCounters::GetSubgroup(const std::string&
 }
 
 TIntrusivePtr<TDynamicCounters> TDynamicCounters::FindSubgroup(const std::string& name, const std::string& value) const {
-    TReadGuard g(Lock);
+    TLightReadGuard g(Lock);
     const auto it = Counters.find({name, value});
     return it != Counters.end() ? AsDynamicCounters(it->second) : nullptr;
 }
@@ -175,7 +177,7 @@ void TDynamicCounters::MergeWithSubgroup(const std::string& name, const std::str
 }
 
 void TDynamicCounters::ResetCounters(bool derivOnly) {
-    TReadGuard g(Lock);
+    TLightReadGuard g(Lock);
     for (auto& [key, value] : Counters) {
         if (auto counter = AsCounter(value)) {
             if (!derivOnly || counter->ForDerivative()) {
@@ -207,7 +209,7 @@ void TDynamicCounters::OutputHtml(IOutputStream& os) const {
 }
 
 void TDynamicCounters::EnumerateSubgroups(const std::function<void(const std::string& name, const std::string& value)>& output) const {
-    TReadGuard g(Lock);
+    TLightReadGuard g(Lock);
     for (const auto& [key, value] : Counters) {
         if (AsDynamicCounters(value)) {
             output(key.LabelName, key.LabelValue);
@@ -276,7 +278,19 @@ void TDynamicCounters::RemoveExpired() const {
         return;
     }
 
-    TWriteGuard g(Lock);
+    // Look for expired counters under shared lock first, so scrapes don't block
+    // concurrent lookups while nothing has expired
+    {
+        TLightReadGuard g(Lock);
+        const bool hasExpired = std::any_of(Counters.begin(), Counters.end(), [](const auto& item) {
+            return IsExpiringCounter(item.second) && item.second->RefCount() == 1;
+        });
+        if (!hasExpired) {
+            return;
+        }
+    }
+
+    TLightWriteGuard g(Lock);
     TAtomicBase count = 0;
 
     for (auto it = Counters.begin(); it != Counters.end();) {
@@ -294,7 +308,7 @@ void TDynamicCounters::RemoveExpired() const {
 template <bool expiring, class TCounterType, class... TArgs>
 TDynamicCounters::TCountablePtr TDynamicCounters::GetNamedCounterImpl(const std::string& name, const std::string& value, TArgs&&... args) {
     {
-        TReadGuard g(Lock);
+        TLightReadGuard g(Lock);
         auto it = Counters.find({name, value});
         if (it != Counters.end()) {
             return it->second;
@@ -316,7 +330,7 @@ TDynamicCounters::TCountablePtr TDynamicCounters::GetNamedCounterImpl(const std:
 
 template <class TCounterType>
 TDynamicCounters::TCountablePtr TDynamicCounters::FindNamedCounterImpl(const std::string& name, const std::string& value) const {
-    TReadGuard g(Lock);
+    TLightReadGuard g(Lock);
     auto it = Counters.find({name, value});
     return it != Counters.end() ? it->second : nullptr;
 }
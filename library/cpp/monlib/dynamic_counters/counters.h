@@ -194,7 +194,9 @@ namespace NMonitoring {
         using TOnLookupPtr = void (*)(const char *methodName, const std::string &name, const std::string &value);
 
     private:
-        TRWMutex Lock;
+        // Lookups of existing counters are far more frequent than updates, light lock
+        // takes shared ownership with a single atomic operation without a syscall
+        TLightRWLock Lock;
         TCounterPtr LookupCounter; // Counts lookups by name
         TOnLookupPtr OnLookup = nullptr; // Called on each lookup if not nullptr, intended for lightweight tracing.
 
@@ -243,17 +245,17 @@ namespace NMonitoring {
 
         // This counter allows to track lookups by name within the whole subtree
         void SetLookupCounter(TCounterPtr lookupCounter) {
-            TWriteGuard g(Lock);
+            TLightWriteGuard g(Lock);
             LookupCounter = lookupCounter;
         }
 
         void SetOnLookup(TOnLookupPtr onLookup) {
-            TWriteGuard g(Lock);
+            TLightWriteGuard g(Lock);
             OnLookup = onLookup;
         }
 
-        TWriteGuard LockForUpdate(const char *method, const std::string& name, const std::string& value) {
-            auto res = TWriteGuard(Lock);
+        TLightWriteGuard LockForUpdate(const char *method, const std::string& name, const std::string& value) {
+            auto res = TLightWriteGuard(Lock);
             if (LookupCounter) {
                 ++*LookupCounter;
             }
@@ -265,7 +267,7 @@ namespace NMonitoring {
 
         TStackVec<TCounters::value_type, 256> ReadSnapshot() const {
             RemoveExpired();
-            TReadGuard g(Lock);
+            TLightReadGuard g(Lock);
             TStackVec<TCounters::value_type, 256> items(Counters.begin(), Counters.end());
             return items;
         }
@@ -357,7 +359,7 @@ namespace NMonitoring {
     private:
         TCounters Resign() {
             TCounters counters;
-            TWriteGuard g(Lock);
+            TLightWriteGuard g(Lock);
             Counters.swap(counters);
             return counters;
         }
@@ -14,4 +14,14 @@ namespace NMonitoring {
 
     using IMetricEncoderPtr = THolder<IMetricEncoder>;
 
+    // Encoder which is used many times for similar sets of metrics, e.g. on each
+    // scrape of the same registry, and keeps caches between encodings.
+    // Reset() starts next encoding into the given stream, Close() finishes it.
+    class IReusableMetricEncoder: public IMetricEncoder {
+    public:
+        virtual void Reset(IOutputStream* out) = 0;
+    };
+
+    using IReusableMetricEncoderPtr = THolder<IReusableMetricEncoder>;
+
 }
@@ -13,6 +13,11 @@ namespace NMonitoring {
 
     IMetricEncoderPtr EncoderPrometheus(IOutputStream* out, std::string_view metricNameLabel = "sensor");
 
+    // Prometheus encoder for repeated encoding of the same registry.
+    // Rendered names and labels of metrics are kept between encodings,
+    // so for already known metrics only values are formatted.
+    IReusableMetricEncoderPtr CachingEncoderPrometheus(std::string_view metricNameLabel = "sensor");
+
     void DecodePrometheus(std::string_view data, IMetricConsumer* c, std::string_view metricNameLabel = "sensor");
 
 }
@@ -7,11 +7,90 @@
 #include <library/cpp/monlib/metrics/metric_value.h>
 
 #include <util/string/cast.h>
+#include <util/stream/str.h>
+#include <util/generic/hash.h>
 #include <util/generic/hash_set.h>
 
 
 namespace NMonitoring {
     namespace {
+        // will replace invalid chars with '_'
+        void WriteMetricName(IOutputStream* out, std::string_view name) {
+            Y_ENSURE(!name.empty(), "trying to write metric with empty name");
+
+            char ch = name[0];
+            if (NPrometheus::IsValidMetricNameStart(ch)) {
+                out->Write(ch);
+            } else {
+                out->Write('_');
+            }
+
+            for (size_t i = 1, len = name.length(); i < len; i++) {
+                ch = name[i];
+                if (NPrometheus::IsValidMetricNameContinuation(ch)) {
+                    out->Write(ch);
+                } else {
+                    out->Write('_');
+                }
+            }
+        }
+
+        void WriteLabelValue(IOutputStream* out, std::string_view value) {
+            out->Write('"');
+            for (char ch: value) {
+                if (ch == '"') {
+                    out->Write("\\\"");
+                } else if (ch == '\\') {
+                    out->Write("\\\\");
+                } else if (ch == '\n') {
+                    out->Write("\\n");
+                } else {
+                    out->Write(ch);
+                }
+            }
+            out->Write('"');
+        }
+
+        void WriteValueAndTime(IOutputStream* out, TInstant time, double value) {
+            char buf[512];
+            {
+                size_t len = FloatToString(value, buf, Y_ARRAY_SIZE(buf));
+                out->Write(buf, len);
+            }
+
+            if (ui64 timeMillis = time.MilliSeconds()) {
+                out->Write(' ');
+                size_t len = IntToString<10>(timeMillis, buf, Y_ARRAY_SIZE(buf));
+                out->Write(buf, len);
+            }
+            out->Write('\n');
+        }
+
+        void WriteTypeName(IOutputStream* out, EMetricType type, std::string_view name) {
+            switch (type) {
+            case EMetricType::GAUGE:
+            case EMetricType::IGAUGE:
+                out->Write("gauge");
+                break;
+            case EMetricType::RATE:
+            case EMetricType::COUNTER:
+                out->Write("counter");
+                break;
+            case EMetricType::HIST:
+            case EMetricType::HIST_RATE:
+                out->Write("histogram");
+                break;
+            case EMetricType::LOGHIST:
+                // TODO(@kbalakirev): implement this case
+                break;
+            case EMetricType::DSUMMARY:
+                ythrow yexception() << "writing summary type is forbiden";
+            case EMetricType::UNKNOWN:
+                ythrow yexception() << "unknown metric type: " << MetricTypeToStr(type)
+                                    << ", name: " << name;
+            }
+        }
+
         ///////////////////////////////////////////////////////////////////////
         // TPrometheusWriter
         ///////////////////////////////////////////////////////////////////////
@@ -30,140 +109,19 @@ namespace NMonitoring {
                 }
 
                 Out_->Write("# TYPE ");
-                WriteMetricName(name);
+                WriteMetricName(Out_, name);
                 Out_->Write(' ');
-
-                switch (type) {
-                case EMetricType::GAUGE:
-                case EMetricType::IGAUGE:
-                    Out_->Write("gauge");
-                    break;
-                case EMetricType::RATE:
-                case EMetricType::COUNTER:
-                    Out_->Write("counter");
-                    break;
-                case EMetricType::HIST:
-                case EMetricType::HIST_RATE:
-                    Out_->Write("histogram");
-                    break;
-                case EMetricType::LOGHIST:
-                    // TODO(@kbalakirev): implement this case
-                    break;
-                case EMetricType::DSUMMARY:
-                    ythrow yexception() << "writing summary type is forbiden";
-                case EMetricType::UNKNOWN:
-                    ythrow yexception() << "unknown metric type: " << MetricTypeToStr(type)
-                                        << ", name: " << name;
-                }
+                WriteTypeName(Out_, type, name);
                 Out_->Write('\n');
             }
 
-            void WriteDouble(std::string_view name, const TLabels& labels, TInstant time, double value) {
-                WriteValue(name, "", labels, "", "", time, value);
-            }
-
-            void WriteHistogram(std::string_view name, const TLabels& labels, TInstant time, IHistogramSnapshot* h) {
-                Y_ENSURE(!labels.Has(NPrometheus::BUCKET_LABEL),
-                         "histogram metric " << name << " has label '" <<
-                         NPrometheus::BUCKET_LABEL << "' which is reserved in Prometheus");
-
-                double totalCount = 0;
-                for (ui32 i = 0, count = h->Count(); i < count; i++) {
-                    TBucketBound bound = h->UpperBound(i);
-                    std::string_view boundStr;
-                    if (bound == HISTOGRAM_INF_BOUND) {
-                        boundStr = std::string_view("+Inf");
-                    } else {
-                        size_t len = FloatToString(bound, TmpBuf_, Y_ARRAY_SIZE(TmpBuf_));
-                        boundStr = std::string_view(TmpBuf_, len);
-                    }
-
-                    TBucketValue value = h->Value(i);
-                    totalCount += static_cast<double>(value);
-
-                    WriteValue(
-                        name, NPrometheus::BUCKET_SUFFIX,
-                        labels, NPrometheus::BUCKET_LABEL, boundStr,
-                        time,
-                        totalCount);
-                }
-
-                WriteValue(name, NPrometheus::COUNT_SUFFIX, labels, "", "", time, totalCount);
-            }
-
-            void WriteSummaryDouble(std::string_view name, const TLabels& labels, TInstant time, ISummaryDoubleSnapshot* s) {
-                WriteValue(name, NPrometheus::SUM_SUFFIX, labels, "", "", time, s->GetSum());
-                WriteValue(name, NPrometheus::MIN_SUFFIX, labels, "", "", time, s->GetMin());
-                WriteValue(name, NPrometheus::MAX_SUFFIX, labels, "", "", time, s->GetMax());
-                WriteValue(name, NPrometheus::LAST_SUFFIX, labels, "", "", time, s->GetLast());
-                WriteValue(name, NPrometheus::COUNT_SUFFIX, labels, "", "", time, s->GetCount());
-            }
-
-            void WriteLn() {
-                Out_->Write('\n');
-            }
-
-        private:
-            // will replace invalid chars with '_'
-            void WriteMetricName(std::string_view name) {
-                Y_ENSURE(!name.empty(), "trying to write metric with empty name");
-
-                char ch = name[0];
-                if (NPrometheus::IsValidMetricNameStart(ch)) {
-                    Out_->Write(ch);
-                } else {
-                    Out_->Write('_');
-                }
-
-                for (size_t i = 1, len = name.length(); i < len; i++) {
-                    ch = name[i];
-                    if (NPrometheus::IsValidMetricNameContinuation(ch)) {
-                        Out_->Write(ch);
-                    } else {
-                        Out_->Write('_');
-                    }
-                }
-            }
-
-            void WriteLabels(const TLabels& labels, std::string_view addLabelKey, std::string_view addLabelValue) {
-                Out_->Write('{');
-                for (auto&& l: labels) {
-                    Out_->Write(l.Name());
-                    Out_->Write('=');
-                    WriteLabelValue(l.Value());
-                    Out_->Write(", "); // trailign comma is supported in parsers
-                }
-                if (!addLabelKey.empty() && !addLabelValue.empty()) {
-                    Out_->Write(addLabelKey);
-                    Out_->Write('=');
-                    WriteLabelValue(addLabelValue);
-                }
-                Out_->Write('}');
-            }
-
-            void WriteLabelValue(std::string_view value) {
-                Out_->Write('"');
-                for (char ch: value) {
-                    if (ch == '"') {
-                        Out_->Write("\\\"");
-                    } else if (ch == '\\') {
-                        Out_->Write("\\\\");
-                    } else if (ch == '\n') {
-                        Out_->Write("\\n");
-                    } else {
-                        Out_->Write(ch);
-                    }
-                }
-                Out_->Write('"');
-            }
-
             void WriteValue(
                     std::string_view name, std::string_view suffix,
                     const TLabels& labels, std::string_view addLabelKey, std::string_view addLabelValue,
                     TInstant time, double value)
             {
                 // (1) name
-                WriteMetricName(name);
+                WriteMetricName(Out_, name);
                 if (!suffix.empty()) {
                     Out_->Write(suffix);
                 }
@@ -174,25 +132,30 @@ namespace NMonitoring {
                 }
                 Out_->Write(' ');
 
-                // (3) value
-                {
-                    size_t len = FloatToString(value, TmpBuf_, Y_ARRAY_SIZE(TmpBuf_));
-                    Out_->Write(TmpBuf_, len);
-                }
+                // (3) value and (4) time
+                WriteValueAndTime(Out_, time, value);
+            }
 
-                // (4) time
-                if (ui64 timeMillis = time.MilliSeconds()) {
-                    Out_->Write(' ');
-                    size_t len = IntToString<10>(timeMillis, TmpBuf_, Y_ARRAY_SIZE(TmpBuf_));
-                    Out_->Write(TmpBuf_, len);
+        private:
+            void WriteLabels(const TLabels& labels, std::string_view addLabelKey, std::string_view addLabelValue) {
+                Out_->Write('{');
+                for (auto&& l: labels) {
+                    Out_->Write(l.Name());
+                    Out_->Write('=');
+                    WriteLabelValue(Out_, l.Value());
+                    Out_->Write(", "); // trailign comma is supported in parsers
                 }
-                Out_->Write('\n');
+                if (!addLabelKey.empty() && !addLabelValue.empty()) {
+                    Out_->Write(addLabelKey);
+                    Out_->Write('=');
+                    WriteLabelValue(Out_, addLabelValue);
+                }
+                Out_->Write('}');
             }
 
         private:
             IOutputStream* Out_;
             THashSet<std::string> WrittenTypes_;
-            char TmpBuf_[512]; // used to convert doubles to strings
         };
 
         ///////////////////////////////////////////////////////////////////////
@@ -246,16 +209,64 @@ namespace NMonitoring {
         };
 
         ///////////////////////////////////////////////////////////////////////
-        // TPrometheusEncoder
+        // TPrometheusEncoderBase
         ///////////////////////////////////////////////////////////////////////
-        class TPrometheusEncoder final: public IMetricEncoder {
-        public:
-            explicit TPrometheusEncoder(IOutputStream* out, std::string_view metricNameLabel)
-                : Writer_(out)
+        // Stream and value callbacks shared by the encoders, labels are handled by derived classes
+        template <typename TInterface>
+        class TPrometheusEncoderBase: public TInterface {
+        protected:
+            explicit TPrometheusEncoderBase(IOutputStream* out, std::string_view metricNameLabel)
+                : Out_(out)
                 , MetricNameLabel_(metricNameLabel)
             {
             }
 
+            // Called on metric begin after the state is cleared
+            virtual void PrepareMetric() {
+            }
+
+            // Called on metric end for metrics with value, time is already set
+            virtual void WriteMetric() = 0;
+
+            // Calls writeValue(suffix, addLabelKey, addLabelValue, value) for each line of the metric value
+            template <typename TWriteValue>
+            void WriteMetricValue(std::string_view name, bool hasBucketLabel, TWriteValue&& writeValue) {
+                EMetricType type = MetricState_.Type;
+                if (type == EMetricType::HIST || type == EMetricType::HIST_RATE) {
+                    Y_ENSURE(MetricState_.ValueType == EMetricValueType::HISTOGRAM,
+                             "invalid value type for histogram: " << int(MetricState_.ValueType)); // TODO: to string conversion
+                    Y_ENSURE(!hasBucketLabel,
+                             "histogram metric " << name << " has label '" <<
+                             NPrometheus::BUCKET_LABEL << "' which is reserved in Prometheus");
+
+                    IHistogramSnapshot* h = MetricState_.Value.AsHistogram();
+                    double totalCount = 0;
+                    for (ui32 i = 0, count = h->Count(); i < count; i++) {
+                        TBucketBound bound = h->UpperBound(i);
+                        std::string_view boundStr;
+                        if (bound == HISTOGRAM_INF_BOUND) {
+                            boundStr = std::string_view("+Inf");
+                        } else {
+                            size_t len = FloatToString(bound, TmpBuf_, Y_ARRAY_SIZE(TmpBuf_));
+                            boundStr = std::string_view(TmpBuf_, len);
+                        }
+
+                        totalCount += static_cast<double>(h->Value(i));
+                        writeValue(NPrometheus::BUCKET_SUFFIX, NPrometheus::BUCKET_LABEL, boundStr, totalCount);
+                    }
+                    writeValue(NPrometheus::COUNT_SUFFIX, "", "", totalCount);
+                } else if (type == EMetricType::DSUMMARY) {
+                    ISummaryDoubleSnapshot* s = MetricState_.Value.AsSummaryDouble();
+                    writeValue(NPrometheus::SUM_SUFFIX, "", "", s->GetSum());
+                    writeValue(NPrometheus::MIN_SUFFIX, "", "", s->GetMin());
+                    writeValue(NPrometheus::MAX_SUFFIX, "", "", s->GetMax());
+                    writeValue(NPrometheus::LAST_SUFFIX, "", "", s->GetLast());
+                    writeValue(NPrometheus::COUNT_SUFFIX, "", "", s->GetCount());
+                } else {
+                    writeValue("", "", "", MetricState_.Value.AsDouble(MetricState_.ValueType));
+                }
+            }
+
         private:
             void OnStreamBegin() override {
                 State_.Expect(TEncoderState::EState::ROOT);
@@ -263,7 +274,7 @@ namespace NMonitoring {
 
             void OnStreamEnd() override {
                 State_.Expect(TEncoderState::EState::ROOT);
-                Writer_.WriteLn();
+                Out_->Write('\n');
             }
 
             void OnCommonTime(TInstant time) override {
@@ -275,13 +286,77 @@ namespace NMonitoring {
                 State_.Switch(TEncoderState::EState::ROOT, TEncoderState::EState::METRIC);
                 MetricState_.Clear();
                 MetricState_.Type = type;
+                PrepareMetric();
             }
 
             void OnMetricEnd() override {
                 State_.Switch(TEncoderState::EState::METRIC, TEncoderState::EState::ROOT);
+                if (MetricState_.ValueType == EMetricValueType::UNKNOWN) {
+                    return;
+                }
+                if (MetricState_.Time == TInstant::Zero()) {
+                    MetricState_.Time = CommonTime_;
+                }
                 WriteMetric();
             }
 
+            void OnDouble(TInstant time, double value) override {
+                State_.Expect(TEncoderState::EState::METRIC);
+                MetricState_.Time = time;
+                MetricState_.SetValue(value);
+            }
+
+            void OnInt64(TInstant time, i64 value) override {
+                State_.Expect(TEncoderState::EState::METRIC);
+                MetricState_.Time = time;
+                MetricState_.SetValue(value);
+            }
+
+            void OnUint64(TInstant time, ui64 value) override {
+                State_.Expect(TEncoderState::EState::METRIC);
+                MetricState_.Time = time;
+                MetricState_.SetValue(value);
+            }
+
+            void OnHistogram(TInstant time, IHistogramSnapshotPtr snapshot) override {
+                State_.Expect(TEncoderState::EState::METRIC);
+                MetricState_.Time = time;
+                MetricState_.SetValue(snapshot.Get());
+            }
+
+            void OnSummaryDouble(TInstant time, ISummaryDoubleSnapshotPtr snapshot) override {
+                State_.Expect(TEncoderState::EState::METRIC);
+                MetricState_.Time = time;
+                MetricState_.SetValue(snapshot.Get());
+            }
+
+            void OnLogHistogram(TInstant, TLogHistogramSnapshotPtr) override {
+                // TODO(@kbalakirev): implement this function
+            }
+
+        protected:
+            IOutputStream* Out_;
+            TEncoderState State_;
+            std::string MetricNameLabel_;
+            TInstant CommonTime_ = TInstant::Zero();
+            TMetricState MetricState_;
+
+        private:
+            char TmpBuf_[512]; // used to convert doubles to strings
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // TPrometheusEncoder
+        ///////////////////////////////////////////////////////////////////////
+        class TPrometheusEncoder final: public TPrometheusEncoderBase<IMetricEncoder> {
+        public:
+            explicit TPrometheusEncoder(IOutputStream* out, std::string_view metricNameLabel)
+                : TPrometheusEncoderBase(out, metricNameLabel)
+                , Writer_(out)
+            {
+            }
+
+        private:
             void OnLabelsBegin() override {
                 if (State_ == TEncoderState::EState::METRIC) {
                     State_ = TEncoderState::EState::METRIC_LABELS;
@@ -322,101 +397,273 @@ namespace NMonitoring {
                 return std::make_pair(nameLabel->Index, valueLabel->Index);
             }
 
-            void OnDouble(TInstant time, double value) override {
-                State_.Expect(TEncoderState::EState::METRIC);
-                MetricState_.Time = time;
-                MetricState_.SetValue(value);
+            void Close() override {
             }
 
-            void OnInt64(TInstant time, i64 value) override {
-                State_.Expect(TEncoderState::EState::METRIC);
-                MetricState_.Time = time;
-                MetricState_.SetValue(value);
+            void WriteMetric() override {
+                // XXX: poor performace
+                for (auto&& l: CommonLabels_) {
+                    MetricState_.Labels.Add(l.Name(), l.Value());
+                }
+
+                std::optional<TLabel> nameLabel = MetricState_.Labels.Extract(MetricNameLabel_);
+                Y_ENSURE(nameLabel,
+                         "labels " << MetricState_.Labels <<
+                         " does not contain label '" << MetricNameLabel_ << '\'');
+
+                const std::string& metricName = ToString(nameLabel->Value());
+                if (MetricState_.Type != EMetricType::DSUMMARY) {
+                    Writer_.WriteType(MetricState_.Type, metricName);
+                }
+
+                const bool hasBucketLabel = MetricState_.Labels.Has(NPrometheus::BUCKET_LABEL);
+                WriteMetricValue(metricName, hasBucketLabel,
+                    [&](std::string_view suffix, std::string_view addLabelKey, std::string_view addLabelValue, double value) {
+                        Writer_.WriteValue(
+                            metricName, suffix,
+                            MetricState_.Labels, addLabelKey, addLabelValue,
+                            MetricState_.Time,
+                            value);
+                    });
             }
 
-            void OnUint64(TInstant time, ui64 value) override {
-                State_.Expect(TEncoderState::EState::METRIC);
-                MetricState_.Time = time;
-                MetricState_.SetValue(value);
+        private:
+            TPrometheusWriter Writer_;
+            TLabels CommonLabels_;
+
+            TStringPoolBuilder LabelNamesPool_;
+            TStringPoolBuilder LabelValuesPool_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // TCachingPrometheusEncoder
+        ///////////////////////////////////////////////////////////////////////
+        class TCachingPrometheusEncoder final: public TPrometheusEncoderBase<IReusableMetricEncoder> {
+        public:
+            explicit TCachingPrometheusEncoder(std::string_view metricNameLabel)
+                : TPrometheusEncoderBase(nullptr, metricNameLabel)
+            {
             }
 
-            void OnHistogram(TInstant time, IHistogramSnapshotPtr snapshot) override {
-                State_.Expect(TEncoderState::EState::METRIC);
-                MetricState_.Time = time;
-                MetricState_.SetValue(snapshot.Get());
+            void Reset(IOutputStream* out) override {
+                Out_ = out;
+                State_ = TEncoderState::EState::ROOT;
+                CommonTime_ = TInstant::Zero();
+                CommonLabelsKey_.clear();
+                CommonLabelsChecked_ = false;
+                ++Generation_;
             }
 
-            void OnSummaryDouble(TInstant time, ISummaryDoubleSnapshotPtr snapshot) override {
-                State_.Expect(TEncoderState::EState::METRIC);
-                MetricState_.Time = time;
-                MetricState_.SetValue(snapshot.Get());
+        private:
+            // Rendered name and labels of a metric, common labels are already merged in
+            struct TCachedMetric {
+                std::string Name;
+                std::string NameText;
+                // 'name="value", ' for each label
+                std::string LabelsText;
+                bool HasLabels = false;
+                bool HasBucketLabel = false;
+                ui64 Generation = 0;
+            };
+
+            void PrepareMetric() override {
+                if (!CommonLabelsChecked_) {
+                    CheckCommonLabels();
+                }
+                Metric_ = nullptr;
             }
 
-            void OnLogHistogram(TInstant, TLogHistogramSnapshotPtr) override {
-                // TODO(@kbalakirev): implement this function
+            void OnLabelsBegin() override {
+                if (State_ == TEncoderState::EState::METRIC) {
+                    State_ = TEncoderState::EState::METRIC_LABELS;
+                    LabelsKey_.clear();
+                } else if (State_ == TEncoderState::EState::ROOT) {
+                    State_ = TEncoderState::EState::COMMON_LABELS;
+                    CommonLabelsKey_.clear();
+                } else {
+                    State_.ThrowInvalid("expected METRIC or ROOT");
+                }
+            }
+
+            void OnLabelsEnd() override {
+                if (State_ == TEncoderState::EState::METRIC_LABELS) {
+                    State_ = TEncoderState::EState::METRIC;
+                    Metric_ = GetMetric(LabelsKey_);
+                } else if (State_ == TEncoderState::EState::COMMON_LABELS) {
+                    State_ = TEncoderState::EState::ROOT;
+                } else {
+                    State_.ThrowInvalid("expected LABELS or COMMON_LABELS");
+                }
+            }
+
+            void OnLabel(std::string_view name, std::string_view value) override {
+                std::string* key;
+                if (State_ == TEncoderState::EState::METRIC_LABELS) {
+                    key = &LabelsKey_;
+                } else if (State_ == TEncoderState::EState::COMMON_LABELS) {
+                    key = &CommonLabelsKey_;
+                } else {
+                    State_.ThrowInvalid("expected LABELS or COMMON_LABELS");
+                }
+                key->append(name);
+                key->push_back('\0');
+                key->append(value);
+                key->push_back('\0');
             }
 
             void Close() override {
+                // Once most of cached metrics are gone, cache is dropped and filled again on next encoding
+                size_t stale = 0;
+                for (const auto& [key, metric] : Cache_) {
+                    stale += metric.Generation != Generation_;
+                }
+                if (stale * 2 > Cache_.size()) {
+                    Cache_.clear();
+                    WrittenTypes_.clear();
+                }
+                Out_ = nullptr;
             }
 
-            void WriteMetric() {
-                if (MetricState_.ValueType == EMetricValueType::UNKNOWN) {
+            const TCachedMetric* GetMetric(const std::string& key) {
+                THashMap<std::string, TCachedMetric>::insert_ctx ctx;
+                auto it = Cache_.find(key, ctx);
+                if (it == Cache_.end()) {
+                    it = Cache_.emplace_direct(ctx, key, RenderMetric(key));
+                }
+                it->second.Generation = Generation_;
+                return &it->second;
+            }
+
+            // Cached metrics are rendered with common labels, so cache is dropped if they change
+            void CheckCommonLabels() {
+                CommonLabelsChecked_ = true;
+                if (CommonLabelsKey_ == CachedCommonLabelsKey_) {
                     return;
                 }
+                CachedCommonLabelsKey_ = CommonLabelsKey_;
+                Cache_.clear();
+                CommonLabels_.Clear();
+                ForEachLabel(CommonLabelsKey_, [this](std::string_view name, std::string_view value) {
+                    CommonLabels_.Add(name, value);
+                });
+            }
+
+            template <typename TConsumer>
+            static void ForEachLabel(std::string_view key, TConsumer&& consumer) {
+                while (!key.empty()) {
+                    const size_t nameEnd = key.find('\0');
+                    const size_t valueEnd = key.find('\0', nameEnd + 1);
+                    consumer(key.substr(0, nameEnd), key.substr(nameEnd + 1, valueEnd - nameEnd - 1));
+                    key.remove_prefix(valueEnd + 1);
+                }
+            }
 
-                // XXX: poor performace
+            TCachedMetric RenderMetric(std::string_view key) const {
+                TLabels labels;
+                ForEachLabel(key, [&labels](std::string_view name, std::string_view value) {
+                    labels.Add(name, value);
+                });
                 for (auto&& l: CommonLabels_) {
-                    MetricState_.Labels.Add(l.Name(), l.Value());
+                    labels.Add(l.Name(), l.Value());
                 }
 
-                std::optional<TLabel> nameLabel = MetricState_.Labels.Extract(MetricNameLabel_);
+                std::optional<TLabel> nameLabel = labels.Extract(MetricNameLabel_);
                 Y_ENSURE(nameLabel,
-                         "labels " << MetricState_.Labels <<
+                         "labels " << labels <<
                          " does not contain label '" << MetricNameLabel_ << '\'');
 
-                const std::string& metricName = ToString(nameLabel->Value());
+                TCachedMetric metric;
+                metric.Name = ToString(nameLabel->Value());
+                {
+                    TStringOutput out(metric.NameText);
+                    WriteMetricName(&out, metric.Name);
+                }
+                {
+                    TStringOutput out(metric.LabelsText);
+                    for (auto&& l: labels) {
+                        out.Write(l.Name());
+                        out.Write('=');
+                        WriteLabelValue(&out, l.Value());
+                        out.Write(", "); // trailign comma is supported in parsers
+                    }
+                }
+                metric.HasLabels = !labels.Empty();
+                metric.HasBucketLabel = labels.Has(NPrometheus::BUCKET_LABEL);
+                return metric;
+            }
+
+            void WriteMetric() override {
+                if (!Metric_) {
+                    LabelsKey_.clear();
+                    Metric_ = GetMetric(LabelsKey_);
+                }
+                const TCachedMetric& metric = *Metric_;
+
                 if (MetricState_.Type != EMetricType::DSUMMARY) {
-                    Writer_.WriteType(MetricState_.Type, metricName);
+                    WriteType(MetricState_.Type, metric);
                 }
 
-                if (MetricState_.Time == TInstant::Zero()) {
-                    MetricState_.Time = CommonTime_;
+                WriteMetricValue(metric.Name, metric.HasBucketLabel,
+                    [&](std::string_view suffix, std::string_view addLabelKey, std::string_view addLabelValue, double value) {
+                        WriteValue(metric, suffix, addLabelKey, addLabelValue, value);
+                    });
+            }
+
+            void WriteType(EMetricType type, const TCachedMetric& metric) {
+                THashMap<std::string, ui64>::insert_ctx ctx;
+                auto it = WrittenTypes_.find(metric.Name, ctx);
+                if (it == WrittenTypes_.end()) {
+                    it = WrittenTypes_.emplace_direct(ctx, metric.Name, 0);
+                } else if (it->second == Generation_) {
+                    // type for this metric was already written
+                    return;
                 }
+                it->second = Generation_;
 
-                EMetricType type = MetricState_.Type;
-                if (type == EMetricType::HIST || type == EMetricType::HIST_RATE) {
-                    Y_ENSURE(MetricState_.ValueType == EMetricValueType::HISTOGRAM,
-                             "invalid value type for histogram: " << int(MetricState_.ValueType)); // TODO: to string conversion
-                    Writer_.WriteHistogram(
-                        metricName,
-                        MetricState_.Labels,
-                        MetricState_.Time,
-                        MetricState_.Value.AsHistogram());
-                } else if (type == EMetricType::DSUMMARY) {
-                    Writer_.WriteSummaryDouble(
-                        metricName,
-                        MetricState_.Labels,
-                        MetricState_.Time,
-                        MetricState_.Value.AsSummaryDouble());
-                } else {
-                    Writer_.WriteDouble(
-                        metricName,
-                        MetricState_.Labels,
-                        MetricState_.Time,
-                        MetricState_.Value.AsDouble(MetricState_.ValueType));
+                Out_->Write("# TYPE ");
+                Out_->Write(metric.NameText);
+                Out_->Write(' ');
+                WriteTypeName(Out_, type, metric.Name);
+                Out_->Write('\n');
+            }
+
+            void WriteValue(
+                    const TCachedMetric& metric, std::string_view suffix,
+                    std::string_view addLabelKey, std::string_view addLabelValue,
+                    double value)
+            {
+                Out_->Write(metric.NameText);
+                if (!suffix.empty()) {
+                    Out_->Write(suffix);
                 }
+
+                if (metric.HasLabels || !addLabelKey.empty()) {
+                    Out_->Write('{');
+                    Out_->Write(metric.LabelsText);
+                    if (!addLabelKey.empty() && !addLabelValue.empty()) {
+                        Out_->Write(addLabelKey);
+                        Out_->Write('=');
+                        WriteLabelValue(Out_, addLabelValue);
+                    }
+                    Out_->Write('}');
+                }
+                Out_->Write(' ');
+
+                WriteValueAndTime(Out_, MetricState_.Time, value);
             }
 
         private:
-            TEncoderState State_;
-            TPrometheusWriter Writer_;
-            std::string MetricNameLabel_;
-            TInstant CommonTime_ = TInstant::Zero();
+            std::string CommonLabelsKey_;
+            std::string CachedCommonLabelsKey_;
             TLabels CommonLabels_;
-            TMetricState MetricState_;
+            bool CommonLabelsChecked_ = false;
 
-            TStringPoolBuilder LabelNamesPool_;
-            TStringPoolBuilder LabelValuesPool_;
+            THashMap<std::string, TCachedMetric> Cache_;
+            THashMap<std::string, ui64> WrittenTypes_;
+            ui64 Generation_ = 0;
+
+            std::string LabelsKey_;
+            const TCachedMetric* Metric_ = nullptr;
         };
     }
 
@@ -424,4 +671,8 @@ namespace NMonitoring {
         return MakeHolder<TPrometheusEncoder>(out, metricNameLabel);
     }
 
+    IReusableMetricEncoderPtr CachingEncoderPrometheus(std::string_view metricNameLabel) {
+        return MakeHolder<TCachingPrometheusEncoder>(metricNameLabel);
+    }
+
 } // namespace NMonitoring
@@ -411,4 +411,49 @@ two{labels="l2", project="solomon", } 42 1500000000000
 
 )");
     }
+
+    Y_UNIT_TEST(CachingEncoderReuse) {
+        auto writeMetrics = [](IMetricEncoder* e, ui64 value) {
+            e->OnStreamBegin();
+            {
+                e->OnLabelsBegin();
+                e->OnLabel("project", "solomon");
+                e->OnLabelsEnd();
+            }
+            {
+                e->OnMetricBegin(EMetricType::COUNTER);
+                e->OnLabelsBegin();
+                e->OnLabel("sensor", "requests");
+                e->OnLabel("host", "man-01");
+                e->OnLabelsEnd();
+                e->OnUint64(TInstant::Zero(), value);
+                e->OnMetricEnd();
+            }
+            {
+                e->OnMetricBegin(EMetricType::GAUGE);
+                e->OnLabelsBegin();
+                e->OnLabel("sensor", "load");
+                e->OnLabelsEnd();
+                e->OnDouble(TInstant::Zero(), value / 2.0);
+                e->OnMetricEnd();
+            }
+            e->OnStreamEnd();
+        };
+
+        std::string cached;
+        TStringOutput out(cached);
+        IReusableMetricEncoderPtr encoder = CachingEncoderPrometheus();
+
+        for (ui64 value: {1, 10, 100}) {
+            cached.clear();
+            encoder->Reset(&out);
+            writeMetrics(encoder.Get(), value);
+            encoder->Close();
+
+            auto expected = EncodeToString([&](IMetricEncoder* e) {
+                writeMetrics(e, value);
+            });
+            UNIT_ASSERT_STRINGS_EQUAL(cached, expected);
+        }
+    }
 }
@@ -110,6 +110,15 @@ namespace NMonitoring {
         std::string_view metricNameLabel = "name"
     );
 
+    // Spack v1.1 encoder for repeated encoding of the same registry.
+    // Label strings pools and encoded label sets are kept between encodings,
+    // so for already known metrics only values are encoded.
+    // Unlike EncoderSpackV1 it does not merge metrics with equal labels.
+    IReusableMetricEncoderPtr CachingEncoderSpackV1(
+        ETimePrecision timePrecision,
+        ECompression compression
+    );
+
     void DecodeSpackV1(IInputStream* in, IMetricConsumer* c, std::string_view metricNameLabel = "name");
 
 }
@@ -6,18 +6,163 @@
 
 #include <util/generic/cast.h>
 #include <util/datetime/base.h>
+#include <util/generic/hash.h>
+#include <util/stream/str.h>
 #include <util/string/builder.h>
 
+#include <algorithm>
+
 #ifndef _little_endian_
 #error Unsupported platform
 #endif
 
 namespace NMonitoring {
     namespace {
+        ///////////////////////////////////////////////////////////////////////
+        // TSpackV1Writer
+        ///////////////////////////////////////////////////////////////////////
+        class TSpackV1Writer {
+        protected:
+            TSpackV1Writer(IOutputStream* out, ETimePrecision timePrecision)
+                : Out_(out)
+                , TimePrecision_(timePrecision)
+            {
+            }
+
+            // store metric type and values type in one byte
+            static ui8 PackTypes(EMetricType metricType, const TMetricTimeSeries& timeSeries) {
+                EValueType valueType;
+                if (timeSeries.Empty()) {
+                    valueType = EValueType::NONE;
+                } else if (timeSeries.Size() == 1) {
+                    TInstant time = timeSeries[0].GetTime();
+                    valueType = (time == TInstant::Zero())
+                                    ? EValueType::ONE_WITHOUT_TS
+                                    : EValueType::ONE_WITH_TS;
+                } else {
+                    valueType = EValueType::MANY_WITH_TS;
+                }
+                return (static_cast<ui8>(metricType) << 2) | static_cast<ui8>(valueType);
+            }
+
+            void WriteTimeSeries(EMetricType metricType, const TMetricTimeSeries& ts) {
+                switch (ts.Size()) {
+                    case 0:
+                        break;
+                    case 1: {
+                        const auto& point = ts[0];
+                        if (point.GetTime() != TInstant::Zero()) {
+                            WriteTime(point.GetTime());
+                        }
+                        EMetricValueType valueType = ts.GetValueType();
+                        WriteValue(metricType, valueType, point.GetValue());
+                        break;
+                    }
+                    default:
+                        WriteVarUInt32(Out_, static_cast<ui32>(ts.Size()));
+                        ts.ForEach([this, metricType](TInstant time, EMetricValueType valueType, TMetricValue value) {
+                            // workaround for GCC bug
+                            // https://gcc.gnu.org/bugzilla/show_bug.cgi?id=61636
+                            this->WriteTime(time);
+                            this->WriteValue(metricType, valueType, value);
+                        });
+                        break;
+                }
+            }
+
+            void WriteValue(EMetricType metricType, EMetricValueType valueType, TMetricValue value) {
+                switch (metricType) {
+                    case EMetricType::GAUGE:
+                        WriteFixed(value.AsDouble(valueType));
+                        break;
+
+                    case EMetricType::IGAUGE:
+                        WriteFixed(value.AsInt64(valueType));
+                        break;
+
+                    case EMetricType::COUNTER:
+                    case EMetricType::RATE:
+                        WriteFixed(value.AsUint64(valueType));
+                        break;
+
+                    case EMetricType::HIST:
+                    case EMetricType::HIST_RATE:
+                        WriteHistogram(*value.AsHistogram());
+                        break;
+
+                    case EMetricType::DSUMMARY:
+                        WriteSummaryDouble(*value.AsSummaryDouble());
+                        break;
+
+                    case EMetricType::LOGHIST:
+                        WriteLogHistogram(*value.AsLogHistogram());
+                        break;
+
+                    default:
+                        ythrow yexception() << "unsupported metric type: " << metricType;
+                }
+            }
+
+            void WriteTime(TInstant instant) {
+                switch (TimePrecision_) {
+                    case ETimePrecision::SECONDS: {
+                        ui32 time = static_cast<ui32>(instant.Seconds());
+                        Out_->Write(&time, sizeof(time));
+                        break;
+                    }
+                    case ETimePrecision::MILLIS: {
+                        ui64 time = static_cast<ui64>(instant.MilliSeconds());
+                        Out_->Write(&time, sizeof(time));
+                    }
+                }
+            }
+
+            template <typename T>
+            void WriteFixed(T value) {
+                Out_->Write(&value, sizeof(value));
+            }
+
+            void WriteHistogram(const IHistogramSnapshot& histogram) {
+                ui32 count = histogram.Count();
+                WriteVarUInt32(Out_, count);
+
+                for (ui32 i = 0; i < count; i++) {
+                    double bound = histogram.UpperBound(i);
+                    Out_->Write(&bound, sizeof(bound));
+                }
+                for (ui32 i = 0; i < count; i++) {
+                    ui64 value = histogram.Value(i);
+                    Out_->Write(&value, sizeof(value));
+                }
+            }
+
+            void WriteLogHistogram(const TLogHistogramSnapshot& logHist) {
+                WriteFixed(logHist.Base());
+                WriteFixed(logHist.ZerosCount());
+                WriteVarUInt32(Out_, static_cast<ui32>(logHist.StartPower()));
+                WriteVarUInt32(Out_, logHist.Count());
+                for (ui32 i = 0; i < logHist.Count(); ++i) {
+                    WriteFixed(logHist.Bucket(i));
+                }
+            }
+
+            void WriteSummaryDouble(const ISummaryDoubleSnapshot& summary) {
+                WriteFixed(summary.GetCount());
+                WriteFixed(summary.GetSum());
+                WriteFixed(summary.GetMin());
+                WriteFixed(summary.GetMax());
+                WriteFixed(summary.GetLast());
+            }
+
+        protected:
+            IOutputStream* Out_;
+            ETimePrecision TimePrecision_;
+        };
+
         ///////////////////////////////////////////////////////////////////////
         // TEncoderSpackV1
         ///////////////////////////////////////////////////////////////////////
-        class TEncoderSpackV1 final: public TBufferedEncoderBase {
+        class TEncoderSpackV1 final: public TBufferedEncoderBase, private TSpackV1Writer {
         public:
             TEncoderSpackV1(
                 IOutputStream* out,
@@ -27,8 +172,7 @@ namespace NMonitoring {
                 ESpackV1Version version,
                 std::string_view metricNameLabel
             )
-                : Out_(out)
-                , TimePrecision_(timePrecision)
+                : TSpackV1Writer(out, timePrecision)
                 , Compression_(compression)
                 , Version_(version)
                 , MetricName_(Version_ >= SV1_02 ? LabelNamesPool_.PutIfAbsent(metricNameLabel) : nullptr)
@@ -125,7 +269,7 @@ namespace NMonitoring {
                 // metrics count already written in header
                 for (TMetric& metric : Metrics_) {
                     // (5.1) types byte
-                    ui8 typesByte = PackTypes(metric);
+                    ui8 typesByte = PackTypes(metric.MetricType, metric.TimeSeries);
                     Out_->Write(&typesByte, sizeof(typesByte));
 
                     // TODO: implement
@@ -147,49 +291,10 @@ namespace NMonitoring {
                     WriteLabels(metric.Labels, MetricName_);
 
                     // (5.3) values
-                    switch (metric.TimeSeries.Size()) {
-                        case 0:
-                            break;
-                        case 1: {
-                            const auto& point = metric.TimeSeries[0];
-                            if (point.GetTime() != TInstant::Zero()) {
-                                WriteTime(point.GetTime());
-                            }
-                            EMetricValueType valueType = metric.TimeSeries.GetValueType();
-                            WriteValue(metric.MetricType, valueType, point.GetValue());
-                            break;
-                        }
-                        default:
-                            WriteVarUInt32(Out_, static_cast<ui32>(metric.TimeSeries.Size()));
-                            const TMetricTimeSeries& ts = metric.TimeSeries;
-                            EMetricType metricType = metric.MetricType;
-                            ts.ForEach([this, metricType](TInstant time, EMetricValueType valueType, TMetricValue value) {
-                                // workaround for GCC bug
-                                // https://gcc.gnu.org/bugzilla/show_bug.cgi?id=61636
-                                this->WriteTime(time);
-                                this->WriteValue(metricType, valueType, value);
-                            });
-                            break;
-                    }
+                    WriteTimeSeries(metric.MetricType, metric.TimeSeries);
                 }
             }
 
-            // store metric type and values type in one byte
-            ui8 PackTypes(const TMetric& metric) {
-                EValueType valueType;
-                if (metric.TimeSeries.Empty()) {
-                    valueType = EValueType::NONE;
-                } else if (metric.TimeSeries.Size() == 1) {
-                    TInstant time = metric.TimeSeries[0].GetTime();
-                    valueType = (time == TInstant::Zero())
-                                    ? EValueType::ONE_WITHOUT_TS
-                                    : EValueType::ONE_WITH_TS;
-                } else {
-                    valueType = EValueType::MANY_WITH_TS;
-                }
-                return (static_cast<ui8>(metric.MetricType) << 2) | static_cast<ui8>(valueType);
-            }
-
             void WriteLabels(const TPooledLabels& labels, const TPooledStr* skipKey) {
                 WriteVarUInt32(Out_, static_cast<ui32>(skipKey ? labels.size() - 1 : labels.size()));
                 for (auto&& label : labels) {
@@ -201,97 +306,279 @@ namespace NMonitoring {
                 }
             }
 
-            void WriteValue(EMetricType metricType, EMetricValueType valueType, TMetricValue value) {
-                switch (metricType) {
-                    case EMetricType::GAUGE:
-                        WriteFixed(value.AsDouble(valueType));
-                        break;
+        private:
+            ECompression Compression_;
+            ESpackV1Version Version_;
+            const TPooledStr* MetricName_;
+            bool Closed_ = false;
+        };
 
-                    case EMetricType::IGAUGE:
-                        WriteFixed(value.AsInt64(valueType));
-                        break;
+        ///////////////////////////////////////////////////////////////////////
+        // TCachingEncoderSpackV1
+        ///////////////////////////////////////////////////////////////////////
+        class TCachingEncoderSpackV1 final: public IReusableMetricEncoder, private TSpackV1Writer {
+        public:
+            TCachingEncoderSpackV1(ETimePrecision timePrecision, ECompression compression)
+                : TSpackV1Writer(nullptr, timePrecision)
+                , Compression_(compression)
+                , MetricsOut_(Metrics_)
+            {
+                Out_ = &MetricsOut_;
+            }
 
-                    case EMetricType::COUNTER:
-                    case EMetricType::RATE:
-                        WriteFixed(value.AsUint64(valueType));
-                        break;
+            void Reset(IOutputStream* out) override {
+                Output_ = out;
+                State_ = TEncoderState::EState::ROOT;
+                CommonTime_ = TInstant::Zero();
+                CommonLabels_.clear();
+                Metrics_.clear();
+                MetricCount_ = 0;
+                PointsCount_ = 0;
+                ++Generation_;
+                Closed_ = false;
+            }
 
-                    case EMetricType::HIST:
-                    case EMetricType::HIST_RATE:
-                        WriteHistogram(*value.AsHistogram());
-                        break;
+        private:
+            // Strings are never reordered, so indexes in cached label sets stay valid
+            struct TAppendOnlyPool {
+                THashMap<std::string, ui32> Index;
+                std::string Data;
+
+                ui32 Put(std::string_view str) {
+                    THashMap<std::string, ui32>::insert_ctx ctx;
+                    auto it = Index.find(str, ctx);
+                    if (it == Index.end()) {
+                        it = Index.emplace_direct(ctx, std::string{str}, static_cast<ui32>(Index.size()));
+                        Data.append(str);
+                        Data.push_back('\0');
+                    }
+                    return it->second;
+                }
 
-                    case EMetricType::DSUMMARY:
-                        WriteSummaryDouble(*value.AsSummaryDouble());
-                        break;
+                void Clear() {
+                    Index.clear();
+                    Data.clear();
+                }
+            };
 
-                    case EMetricType::LOGHIST:
-                        WriteLogHistogram(*value.AsLogHistogram());
-                        break;
+            struct TCachedLabels {
+                std::string Encoded;
+                ui64 Generation = 0;
+            };
 
-                    default:
-                        ythrow yexception() << "unsupported metric type: " << metricType;
+            void OnStreamBegin() override {
+                State_.Expect(TEncoderState::EState::ROOT);
+            }
+
+            void OnStreamEnd() override {
+                State_.Expect(TEncoderState::EState::ROOT);
+            }
+
+            void OnCommonTime(TInstant time) override {
+                State_.Expect(TEncoderState::EState::ROOT);
+                CommonTime_ = time;
+            }
+
+            void OnMetricBegin(EMetricType type) override {
+                State_.Switch(TEncoderState::EState::ROOT, TEncoderState::EState::METRIC);
+                MetricType_ = type;
+                MetricLabels_ = nullptr;
+                TimeSeries_.Clear();
+            }
+
+            void OnMetricEnd() override {
+                State_.Switch(TEncoderState::EState::METRIC, TEncoderState::EState::ROOT);
+
+                if (TimeSeries_.Size() > 1) {
+                    TimeSeries_.SortByTs();
+                }
+
+                ui8 typesByte = PackTypes(MetricType_, TimeSeries_);
+                Out_->Write(&typesByte, sizeof(typesByte));
+                ui8 flagsByte = 0x00;
+                Out_->Write(&flagsByte, sizeof(flagsByte));
+
+                if (MetricLabels_) {
+                    Out_->Write(*MetricLabels_);
+                } else {
+                    WriteVarUInt32(Out_, 0);
                 }
+
+                WriteTimeSeries(MetricType_, TimeSeries_);
+
+                ++MetricCount_;
+                PointsCount_ += TimeSeries_.Size();
+                TimeSeries_.Clear();
             }
 
-            void WriteTime(TInstant instant) {
-                switch (TimePrecision_) {
-                    case ETimePrecision::SECONDS: {
-                        ui32 time = static_cast<ui32>(instant.Seconds());
-                        Out_->Write(&time, sizeof(time));
-                        break;
-                    }
-                    case ETimePrecision::MILLIS: {
-                        ui64 time = static_cast<ui64>(instant.MilliSeconds());
-                        Out_->Write(&time, sizeof(time));
+            void OnLabelsBegin() override {
+                if (State_ == TEncoderState::EState::METRIC) {
+                    State_ = TEncoderState::EState::METRIC_LABELS;
+                } else if (State_ == TEncoderState::EState::ROOT) {
+                    State_ = TEncoderState::EState::COMMON_LABELS;
+                } else {
+                    State_.ThrowInvalid("expected METRIC or ROOT");
+                }
+                LabelsKey_.clear();
+            }
+
+            void OnLabelsEnd() override {
+                if (State_ == TEncoderState::EState::METRIC_LABELS) {
+                    State_ = TEncoderState::EState::METRIC;
+
+                    THashMap<std::string, TCachedLabels>::insert_ctx ctx;
+                    auto it = LabelsCache_.find(LabelsKey_, ctx);
+                    if (it == LabelsCache_.end()) {
+                        it = LabelsCache_.emplace_direct(ctx, LabelsKey_, TCachedLabels{EncodeLabels(LabelsKey_), 0});
                     }
+                    it->second.Generation = Generation_;
+                    MetricLabels_ = &it->second.Encoded;
+                } else if (State_ == TEncoderState::EState::COMMON_LABELS) {
+                    State_ = TEncoderState::EState::ROOT;
+                    CommonLabels_ = EncodeLabels(LabelsKey_);
+                } else {
+                    State_.ThrowInvalid("expected LABELS or COMMON_LABELS");
                 }
             }
 
-            template <typename T>
-            void WriteFixed(T value) {
-                Out_->Write(&value, sizeof(value));
+            void OnLabel(std::string_view name, std::string_view value) override {
+                if (State_ != TEncoderState::EState::METRIC_LABELS && State_ != TEncoderState::EState::COMMON_LABELS) {
+                    State_.ThrowInvalid("expected LABELS or COMMON_LABELS");
+                }
+                // Label set is cached by its text, names and values can't contain zero bytes
+                // anyway as they are written to zero terminated pools
+                LabelsKey_.append(name);
+                LabelsKey_.push_back('\0');
+                LabelsKey_.append(value);
+                LabelsKey_.push_back('\0');
             }
 
-            void WriteHistogram(const IHistogramSnapshot& histogram) {
-                ui32 count = histogram.Count();
-                WriteVarUInt32(Out_, count);
+            void OnDouble(TInstant time, double value) override {
+                State_.Expect(TEncoderState::EState::METRIC);
+                TimeSeries_.Add(time, value);
+            }
 
-                for (ui32 i = 0; i < count; i++) {
-                    double bound = histogram.UpperBound(i);
-                    Out_->Write(&bound, sizeof(bound));
+            void OnInt64(TInstant time, i64 value) override {
+                State_.Expect(TEncoderState::EState::METRIC);
+                TimeSeries_.Add(time, value);
+            }
+
+            void OnUint64(TInstant time, ui64 value) override {
+                State_.Expect(TEncoderState::EState::METRIC);
+                TimeSeries_.Add(time, value);
+            }
+
+            void OnHistogram(TInstant time, IHistogramSnapshotPtr snapshot) override {
+                State_.Expect(TEncoderState::EState::METRIC);
+                TimeSeries_.Add(time, snapshot.Get());
+            }
+
+            void OnSummaryDouble(TInstant time, ISummaryDoubleSnapshotPtr snapshot) override {
+                State_.Expect(TEncoderState::EState::METRIC);
+                TimeSeries_.Add(time, snapshot.Get());
+            }
+
+            void OnLogHistogram(TInstant time, TLogHistogramSnapshotPtr snapshot) override {
+                State_.Expect(TEncoderState::EState::METRIC);
+                TimeSeries_.Add(time, snapshot.Get());
+            }
+
+            void Close() override {
+                if (Closed_) {
+                    return;
                 }
-                for (ui32 i = 0; i < count; i++) {
-                    ui64 value = histogram.Value(i);
-                    Out_->Write(&value, sizeof(value));
+                Closed_ = true;
+                Y_ENSURE(Output_, "Reset() must be called before encoding");
+
+                // (1) write header
+                TSpackHeader header;
+                header.Version = SV1_01;
+                header.TimePrecision = EncodeTimePrecision(TimePrecision_);
+                header.Compression = EncodeCompression(Compression_);
+                header.LabelNamesSize = static_cast<ui32>(LabelNames_.Data.size());
+                header.LabelValuesSize = static_cast<ui32>(LabelValues_.Data.size());
+                header.MetricCount = MetricCount_;
+                header.PointsCount = PointsCount_;
+                Output_->Write(&header, sizeof(header));
+
+                // if compression enabled all below writes must go throught compressor
+                auto compressedOut = CompressedOutput(Output_, Compression_);
+                Out_ = compressedOut ? compressedOut.Get() : Output_;
+
+                // (2) write string pools, they may contain strings of metrics which are already gone
+                Out_->Write(LabelNames_.Data);
+                Out_->Write(LabelValues_.Data);
+
+                // (3) write common time
+                WriteTime(CommonTime_);
+
+                // (4) write common labels' indexes
+                if (CommonLabels_.empty()) {
+                    WriteVarUInt32(Out_, 0);
+                } else {
+                    Out_->Write(CommonLabels_);
                 }
+
+                // (5) write metrics encoded while walking
+                Out_->Write(Metrics_);
+
+                compressedOut.Reset();
+                Out_ = &MetricsOut_;
+                Output_ = nullptr;
+
+                EvictStaleLabels();
             }
 
-            void WriteLogHistogram(const TLogHistogramSnapshot& logHist) {
-                WriteFixed(logHist.Base());
-                WriteFixed(logHist.ZerosCount());
-                WriteVarUInt32(Out_, static_cast<ui32>(logHist.StartPower()));
-                WriteVarUInt32(Out_, logHist.Count());
-                for (ui32 i = 0; i < logHist.Count(); ++i) {
-                    WriteFixed(logHist.Bucket(i));
+            std::string EncodeLabels(std::string_view key) {
+                std::string encoded;
+                TStringOutput out(encoded);
+                WriteVarUInt32(&out, static_cast<ui32>(std::count(key.begin(), key.end(), '\0') / 2));
+                while (!key.empty()) {
+                    const size_t nameEnd = key.find('\0');
+                    const size_t valueEnd = key.find('\0', nameEnd + 1);
+                    WriteVarUInt32(&out, LabelNames_.Put(key.substr(0, nameEnd)));
+                    WriteVarUInt32(&out, LabelValues_.Put(key.substr(nameEnd + 1, valueEnd - nameEnd - 1)));
+                    key.remove_prefix(valueEnd + 1);
                 }
+                return encoded;
             }
 
-            void WriteSummaryDouble(const ISummaryDoubleSnapshot& summary) {
-                WriteFixed(summary.GetCount());
-                WriteFixed(summary.GetSum());
-                WriteFixed(summary.GetMin());
-                WriteFixed(summary.GetMax());
-                WriteFixed(summary.GetLast());
+            // Pools can't be shrunk without reencoding of all label sets, so once most of cached
+            // label sets are not used anymore, all caches are dropped and filled again on next encoding
+            void EvictStaleLabels() {
+                size_t stale = 0;
+                for (const auto& [key, labels] : LabelsCache_) {
+                    stale += labels.Generation != Generation_;
+                }
+                if (stale * 2 > LabelsCache_.size()) {
+                    LabelsCache_.clear();
+                    LabelNames_.Clear();
+                    LabelValues_.Clear();
+                }
             }
 
         private:
-            IOutputStream* Out_;
-            ETimePrecision TimePrecision_;
             ECompression Compression_;
-            ESpackV1Version Version_;
-            const TPooledStr* MetricName_;
-            bool Closed_ = false;
+            IOutputStream* Output_ = nullptr;
+            TEncoderState State_;
+            bool Closed_ = true;
+
+            TAppendOnlyPool LabelNames_;
+            TAppendOnlyPool LabelValues_;
+            THashMap<std::string, TCachedLabels> LabelsCache_;
+            ui64 Generation_ = 0;
+
+            // per encoding state, buffers keep their capacity between encodings
+            TInstant CommonTime_ = TInstant::Zero();
+            std::string CommonLabels_;
+            std::string LabelsKey_;
+            EMetricType MetricType_ = EMetricType::UNKNOWN;
+            const std::string* MetricLabels_ = nullptr;
+            TMetricTimeSeries TimeSeries_;
+            std::string Metrics_;
+            TStringOutput MetricsOut_;
+            ui32 MetricCount_ = 0;
+            ui32 PointsCount_ = 0;
         };
 
     }
@@ -315,4 +602,11 @@ namespace NMonitoring {
         Y_ENSURE(!metricNameLabel.empty(), "metricNameLabel can't be empty");
         return MakeHolder<TEncoderSpackV1>(out, timePrecision, compression, mergingMode, SV1_02, metricNameLabel);
     }
+
+    IReusableMetricEncoderPtr CachingEncoderSpackV1(
+        ETimePrecision timePrecision,
+        ECompression compression
+    ) {
+        return MakeHolder<TCachingEncoderSpackV1>(timePrecision, compression);
+    }
 }
@@ -842,4 +842,44 @@ Y_UNIT_TEST_SUITE(TSpackTest) {
             yexception,
             "metric name label 's' not found, all metric labels '{m=v, project=solomon}'");
     }
+
+    Y_UNIT_TEST(CachingEncoderReuse) {
+        auto writeMetrics = [](IMetricEncoder* e, ui64 value) {
+            e->OnStreamBegin();
+            {
+                e->OnLabelsBegin();
+                e->OnLabel("project", "solomon");
+                e->OnLabelsEnd();
+            }
+            {
+                e->OnMetricBegin(EMetricType::COUNTER);
+                e->OnLabelsBegin();
+                e->OnLabel("name", "requests");
+                e->OnLabel("host", "man-01");
+                e->OnLabelsEnd();
+                e->OnUint64(TInstant::Zero(), value);
+                e->OnMetricEnd();
+            }
+            e->OnStreamEnd();
+            e->Close();
+        };
+
+        TBuffer cached;
+        TBufferOutput cachedOut(cached);
+        IReusableMetricEncoderPtr encoder = CachingEncoderSpackV1(ETimePrecision::SECONDS, ECompression::IDENTITY);
+
+        for (ui64 value: {1, 10, 100}) {
+            cached.Clear();
+            encoder->Reset(&cachedOut);
+            writeMetrics(encoder.Get(), value);
+
+            TBuffer expected;
+            TBufferOutput expectedOut(expected);
+            auto e = EncoderSpackV1(&expectedOut, ETimePrecision::SECONDS, ECompression::IDENTITY);
+            writeMetrics(e.Get(), value);
+
+            UNIT_ASSERT_VALUES_EQUAL(cached.Size(), expected.Size());
+            UNIT_ASSERT(::memcmp(cached.Data(), expected.Data(), expected.Size()) == 0);
+        }
+    }
 }
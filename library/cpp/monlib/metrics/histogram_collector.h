@@ -116,4 +116,34 @@ namespace NMonitoring {
     IHistogramCollectorPtr LinearHistogram(
         ui32 bucketsCount, TBucketBound startValue, TBucketBound bucketWidth);
 
+    /**
+     * <p>Creates log-linear (HDR-like) histogram collector for values in
+     * range {@code [0, maxValue]}.</p>
+     *
+     * <p>Each power of two range {@code [2^k, 2^(k+1))} is split into
+     * {@code 2^precisionBits} buckets of equal width, so the relative error
+     * of a recorded value is at most {@code 2^-precisionBits}. Values below
+     * {@code 2^(precisionBits+1)} units are recorded exactly, fractional units
+     * are rounded up and values greater than {@code maxValue} go to the
+     * overflow bucket.</p>
+     *
+     * <p>Values are counted in units of {@code lowestValue} rounded down to a
+     * power of two, so the buckets start from it instead of 1 and the same
+     * number of buckets covers a wider range with the given precision.</p>
+     *
+     * <p>Each thread records into its own shard, shards are merged on
+     * snapshot. Bucket bounds depend only on the parameters: if there would be
+     * more than {@code HISTOGRAM_MAX_BUCKETS_COUNT} buckets, precision is
+     * reduced at construction until they fit, e.g. with precisionBits = 2
+     * the buckets cover about 2^13 units.</p>
+     *
+     * @param maxValue      the highest value recorded with given precision.
+     *                      The value must be >= 1 and below 2^49 units.
+     * @param precisionBits log2 of number of buckets per power of two.
+     *                      The value must be in [1, 10].
+     * @param lowestValue   the lowest value distinguished from zero.
+     *                      The value must be in [1, maxValue].
+     */
+    IHistogramCollectorPtr HdrHistogram(ui64 maxValue, ui32 precisionBits = 3, ui64 lowestValue = 1);
+
 } // namespace NMonitoring
@@ -0,0 +1,130 @@
+#include "histogram_collector.h"
+#include "atomics_array.h"
+
+#include <util/generic/bitops.h>
+#include <util/generic/yexception.h>
+#include <util/generic/ylimits.h>
+#include <util/system/align.h>
+
+#include <atomic>
+
+namespace NMonitoring {
+    ///////////////////////////////////////////////////////////////////////////
+    // THdrHistogramCollector
+    ///////////////////////////////////////////////////////////////////////////
+    class THdrHistogramCollector: public IHistogramCollector {
+    public:
+        static constexpr size_t ShardCount = 8;
+
+        THdrHistogramCollector(ui64 maxValue, ui32 precisionBits, ui32 unitBits)
+            : PrecisionBits_(precisionBits)
+            , UnitBits_(unitBits)
+            , MaxValue_(maxValue)
+            // one more bucket for values greater than maxValue
+            , BucketsCount_(BucketIndex(ToUnits(maxValue, unitBits), precisionBits) + 2)
+            // shards are padded to the cache line size
+            , ShardStride_(AlignUp<size_t>(BucketsCount_, 64 / sizeof(ui64)))
+            , Values_(ShardStride_ * ShardCount)
+        {
+            // bounds never depend on recorded values, so snapshots of different
+            // collectors with the same parameters can be summed bucket by bucket
+            Bounds_.reserve(BucketsCount_);
+            for (size_t i = 0; i + 1 < BucketsCount_; ++i) {
+                Bounds_.push_back(UpperBound(i) * (ui64(1) << UnitBits_));
+            }
+            Bounds_.push_back(Max<TBucketBound>());
+        }
+
+        // Returns the highest precision not greater than precisionBits which keeps
+        // the number of buckets within HISTOGRAM_MAX_BUCKETS_COUNT
+        static ui32 FitPrecision(ui64 maxValue, ui32 precisionBits, ui32 unitBits) {
+            const ui64 maxUnits = ToUnits(maxValue, unitBits);
+            while (precisionBits > 0 && BucketIndex(maxUnits, precisionBits) + 2 > HISTOGRAM_MAX_BUCKETS_COUNT) {
+                --precisionBits;
+            }
+            Y_ENSURE(BucketIndex(maxUnits, precisionBits) + 2 <= HISTOGRAM_MAX_BUCKETS_COUNT,
+                     "max value is too big for " << HISTOGRAM_MAX_BUCKETS_COUNT << " buckets, got: " << maxValue);
+            return precisionBits;
+        }
+
+        void Collect(double value, ui64 count) override {
+            size_t index = 0;
+            if (value > MaxValue_) {
+                index = BucketsCount_ - 1;
+            } else if (value > 0) {
+                index = BucketIndex(ToUnits(static_cast<ui64>(std::ceil(value)), UnitBits_));
+            }
+            Values_.Add(ShardIndex() * ShardStride_ + index, count);
+        }
+
+        void Reset() override {
+            Values_.Reset();
+        }
+
+        IHistogramSnapshotPtr Snapshot() const override {
+            TBucketValues values(BucketsCount_, 0);
+            for (size_t shard = 0; shard < ShardCount; ++shard) {
+                for (size_t i = 0; i < BucketsCount_; ++i) {
+                    values[i] += Values_[shard * ShardStride_ + i];
+                }
+            }
+
+            return ExplicitHistogramSnapshot(Bounds_, values);
+        }
+
+    private:
+        // Values are rounded up to the whole units
+        static ui64 ToUnits(ui64 value, ui32 unitBits) {
+            return (value >> unitBits) + ((value & ((ui64(1) << unitBits) - 1)) ? 1 : 0);
+        }
+
+        static size_t BucketIndex(ui64 value, ui32 precisionBits) {
+            const ui64 subBuckets = ui64(1) << precisionBits;
+            if (value < 2 * subBuckets) {
+                return value;
+            }
+            const ui32 shift = MostSignificantBit(value) - precisionBits;
+            return (shift + 1) * subBuckets + ((value >> shift) - subBuckets);
+        }
+
+        size_t BucketIndex(ui64 value) const {
+            return BucketIndex(value, PrecisionBits_);
+        }
+
+        TBucketBound UpperBound(size_t index) const {
+            const ui64 subBuckets = ui64(1) << PrecisionBits_;
+            if (index < 2 * subBuckets) {
+                return index;
+            }
+            const ui32 shift = index / subBuckets - 1;
+            return ((subBuckets + index % subBuckets + 1) << shift) - 1;
+        }
+
+        static size_t ShardIndex() noexcept {
+            static std::atomic<size_t> nextIndex{0};
+            thread_local const size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed) % ShardCount;
+            return index;
+        }
+
+    private:
+        const ui32 PrecisionBits_;
+        const ui32 UnitBits_;
+        const ui64 MaxValue_;
+        const size_t BucketsCount_;
+        const size_t ShardStride_;
+        TAtomicsArray Values_;
+        TBucketBounds Bounds_;
+    };
+
+    IHistogramCollectorPtr HdrHistogram(ui64 maxValue, ui32 precisionBits, ui64 lowestValue) {
+        Y_ENSURE(maxValue >= 1, "max value must be >= 1, got: " << maxValue);
+        Y_ENSURE(precisionBits >= 1 && precisionBits <= 10,
+                 "precision bits must be in [1, 10], got: " << precisionBits);
+        Y_ENSURE(lowestValue >= 1 && lowestValue <= maxValue,
+                 "lowest value must be in [1, " << maxValue << "], got: " << lowestValue);
+
+        const ui32 unitBits = MostSignificantBit(lowestValue);
+        return MakeHolder<THdrHistogramCollector>(maxValue,
+            THdrHistogramCollector::FitPrecision(maxValue, precisionBits, unitBits), unitBits);
+    }
+}
@@ -2,6 +2,8 @@
 
 #include <library/cpp/testing/unittest/registar.h>
 
+#include <map>
+
 using namespace NMonitoring;
 
 Y_UNIT_TEST_SUITE(THistogramCollectorTest) {
@@ -92,6 +94,92 @@ Y_UNIT_TEST_SUITE(THistogramCollectorTest) {
         CheckSnapshot(*histogram->Snapshot(), expectedBounds, expectedValues);
     }
 
+    Y_UNIT_TEST(Hdr) {
+        auto histogram = HdrHistogram(1000, 2);
+        histogram->Collect(-1);
+        histogram->Collect(0);
+        histogram->Collect(0.5);
+        histogram->Collect(3);
+        histogram->Collect(7);
+        histogram->Collect(8);
+        histogram->Collect(9);
+        histogram->Collect(100, 2);
+        histogram->Collect(1000);
+        histogram->Collect(1001);
+
+        // exact values below 8, then 4 buckets per power of two, e.g. (95, 111] for 100
+        std::map<TBucketBound, TBucketValue> expected = {
+            {0, 2}, {1, 1}, {3, 1}, {7, 1}, {9, 2}, {111, 2}, {1023, 1}, {Max<TBucketBound>(), 1}};
+
+        auto snapshot = histogram->Snapshot();
+        UNIT_ASSERT_VALUES_EQUAL(snapshot->Count(), 37);
+        for (ui32 i = 0; i < snapshot->Count(); ++i) {
+            auto it = expected.find(snapshot->UpperBound(i));
+            UNIT_ASSERT_VALUES_EQUAL_C(snapshot->Value(i), it == expected.end() ? 0 : it->second,
+                "bound " << snapshot->UpperBound(i));
+        }
+    }
+
+    Y_UNIT_TEST(HdrFixedBounds) {
+        auto empty = HdrHistogram(1 << 20, 4);
+        auto histogram = HdrHistogram(1 << 20, 4);
+        for (ui64 i = 0; i < 1000; ++i) {
+            histogram->Collect(i * 1000);
+        }
+
+        // precision is reduced to fit the buckets limit, bounds don't depend on values
+        auto emptySnapshot = empty->Snapshot();
+        auto snapshot = histogram->Snapshot();
+        UNIT_ASSERT(snapshot->Count() <= HISTOGRAM_MAX_BUCKETS_COUNT);
+        UNIT_ASSERT_VALUES_EQUAL(snapshot->Count(), emptySnapshot->Count());
+
+        ui64 total = 0;
+        for (ui32 i = 0; i < snapshot->Count(); ++i) {
+            UNIT_ASSERT_VALUES_EQUAL(snapshot->UpperBound(i), emptySnapshot->UpperBound(i));
+            total += snapshot->Value(i);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(total, 1000);
+    }
+
+    Y_UNIT_TEST(HdrLowestValue) {
+        // units of 4, exact values below 8 units, then 4 buckets per power of two
+        auto histogram = HdrHistogram(100, 2, 5);
+        histogram->Collect(1);
+        histogram->Collect(4);
+        histogram->Collect(5);
+        histogram->Collect(28);
+        histogram->Collect(29);
+        histogram->Collect(100);
+        histogram->Collect(101);
+
+        std::map<TBucketBound, TBucketValue> expected = {
+            {4, 2}, {8, 1}, {28, 1}, {36, 1}, {108, 1}, {Max<TBucketBound>(), 1}};
+
+        auto snapshot = histogram->Snapshot();
+        UNIT_ASSERT_VALUES_EQUAL(snapshot->Count(), 16);
+        for (ui32 i = 0; i < snapshot->Count(); ++i) {
+            auto it = expected.find(snapshot->UpperBound(i));
+            UNIT_ASSERT_VALUES_EQUAL_C(snapshot->Value(i), it == expected.end() ? 0 : it->second,
+                "bound " << snapshot->UpperBound(i));
+        }
+    }
+
+    Y_UNIT_TEST(HdrPrecisionWithLowestValue) {
+        // 2^13 units fit into the buckets limit with precision 2, e.g. ack latency of topic writes
+        auto snapshot = HdrHistogram(16000, 2, 2)->Snapshot();
+        UNIT_ASSERT(snapshot->Count() <= HISTOGRAM_MAX_BUCKETS_COUNT);
+        UNIT_ASSERT_VALUES_EQUAL(snapshot->UpperBound(snapshot->Count() - 1), Max<TBucketBound>());
+        UNIT_ASSERT(snapshot->UpperBound(snapshot->Count() - 2) >= 16000);
+
+        for (ui32 i = 1; i + 1 < snapshot->Count(); ++i) {
+            const auto bound = snapshot->UpperBound(i);
+            const auto width = bound - snapshot->UpperBound(i - 1);
+            // buckets are one unit wide below 4 units, then their width is at most 1/4 of the bound
+            // (precision reduced to 1 would give buckets up to 1/3 of the bound)
+            UNIT_ASSERT_C(bound < 8 ? width == 2 : width <= bound / 4, "bound " << bound);
+        }
+    }
+
     Y_UNIT_TEST(SnapshotOutput) {
         auto histogram = ExplicitHistogram({0, 1, 2, 5, 10, 20});
         histogram->Collect(-2);
@@ -5,6 +5,9 @@
 #include <util/datetime/base.h>
 #include <util/generic/ptr.h>
 
+#include <array>
+#include <atomic>
+
 namespace NMonitoring {
     ///////////////////////////////////////////////////////////////////////////////
     // IMetric
@@ -278,6 +281,57 @@ namespace NMonitoring {
         std::atomic_uint64_t Value_;
     };
 
+    ///////////////////////////////////////////////////////////////////////////////
+    // TStripedCounter
+    ///////////////////////////////////////////////////////////////////////////////
+    // Counter for very hot increments from many threads. Each thread increments
+    // its own cache line sized stripe, stripes are summed up on read.
+    // Note: Add() and Inc() return the value of the calling thread's stripe,
+    // not the total value, use Get() to read the total.
+    class TStripedCounter final: public ICounter {
+    public:
+        static constexpr size_t StripeCount = 16;
+
+        explicit TStripedCounter(ui64 value = 0) {
+            Stripes_[0].Value.store(value, std::memory_order_relaxed);
+        }
+
+        ui64 Add(ui64 n) noexcept override {
+            return Stripes_[StripeIndex()].Value.fetch_add(n, std::memory_order_relaxed) + n;
+        }
+
+        ui64 Get() const noexcept override {
+            ui64 value = 0;
+            for (const auto& stripe : Stripes_) {
+                value += stripe.Value.load(std::memory_order_relaxed);
+            }
+            return value;
+        }
+
+        void Reset() noexcept override {
+            for (auto& stripe : Stripes_) {
+                stripe.Value.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        void Accept(TInstant time, IMetricConsumer* consumer) const override {
+            consumer->OnUint64(time, Get());
+        }
+
+    private:
+        struct alignas(64) TStripe {
+            std::atomic_uint64_t Value{0};
+        };
+
+        static size_t StripeIndex() noexcept {
+            static std::atomic<size_t> nextIndex{0};
+            thread_local const size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed) % StripeCount;
+            return index;
+        }
+
+        std::array<TStripe, StripeCount> Stripes_;
+    };
+
     ///////////////////////////////////////////////////////////////////////////////
     // TLazyCounter
     ///////////////////////////////////////////////////////////////////////////////
@@ -1,6 +1,8 @@
 #include "metric_registry.h"
 
+#include <algorithm>
 #include <memory>
+#include <typeinfo>
 
 namespace NMonitoring {
     namespace {
@@ -118,6 +120,14 @@ namespace NMonitoring {
         return Metric<TLazyRate, EMetricType::RATE>(std::move(labels), std::move(supplier));
     }
 
+    TStripedCounter* TMetricRegistry::StripedCounter(TLabels labels) {
+        return Metric<TStripedCounter, EMetricType::COUNTER>(std::move(labels));
+    }
+
+    TStripedCounter* TMetricRegistry::StripedCounter(ILabelsPtr labels) {
+        return Metric<TStripedCounter, EMetricType::COUNTER>(std::move(labels));
+    }
+
     THistogram* TMetricRegistry::HistogramCounter(TLabels labels, IHistogramCollectorPtr collector) {
         return Metric<THistogram, EMetricType::HIST>(std::move(labels), std::move(collector), false);
     }
@@ -151,8 +161,8 @@ namespace NMonitoring {
     }
 
     void TMetricRegistry::Reset() {
-        TWriteGuard g{*Lock_};
-        for (auto& [label, metric] : Metrics_) {
+        for (auto& [labels, entry] : Snapshot()) {
+            IMetricPtr& metric = entry.Metric;
             switch (metric->Type()) {
             case EMetricType::GAUGE:
                 static_cast<TGauge*>(metric.Get())->Set(.0);
@@ -161,7 +171,10 @@ namespace NMonitoring {
                 static_cast<TIntGauge*>(metric.Get())->Set(0);
                 break;
             case EMetricType::COUNTER:
-                static_cast<TCounter*>(metric.Get())->Reset();
+                // lazy counters have nothing to reset
+                if (auto* counter = dynamic_cast<ICounter*>(metric.Get())) {
+                    counter->Reset();
+                }
                 break;
             case EMetricType::RATE:
                 static_cast<TRate*>(metric.Get())->Reset();
@@ -179,43 +192,85 @@ namespace NMonitoring {
     }
 
     void TMetricRegistry::Clear() {
-        TWriteGuard g{*Lock_};
-        Metrics_.clear();
+        for (auto& shard : Shards_->Shards) {
+            TLightWriteGuard g{shard.Lock};
+            shard.Metrics.clear();
+        }
+    }
+
+    template <typename TLabelsType>
+    TMetricRegistry::TShard& TMetricRegistry::GetShard(const TLabelsType& labels) const {
+        size_t hash;
+        if constexpr (std::is_convertible_v<TLabelsType, ILabelsPtr>) {
+            hash = labels->Hash();
+        } else {
+            hash = labels.Hash();
+        }
+        return Shards_->Shards[hash % ShardCount];
+    }
+
+    TMetricRegistry::TMetricsSnapshot TMetricRegistry::Snapshot() const {
+        TMetricsSnapshot snapshot;
+        for (auto& shard : Shards_->Shards) {
+            TLightReadGuard g{shard.Lock};
+            snapshot.insert(snapshot.end(), shard.Metrics.begin(), shard.Metrics.end());
+        }
+
+        std::sort(snapshot.begin(), snapshot.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.second.Order < rhs.second.Order;
+        });
+        return snapshot;
     }
 
     template <typename TMetric, EMetricType type, typename TLabelsType, typename... Args>
     TMetric* TMetricRegistry::Metric(TLabelsType&& labels, Args&&... args) {
+        TShard& shard = GetShard(labels);
+
+        auto checkType = [&](const IMetricPtr& metric) {
+            Y_ENSURE(metric->Type() == type, "cannot create metric " << labels
+                    << " with type " << MetricTypeToStr(type)
+                    << ", because registry already has same metric with type " << MetricTypeToStr(metric->Type()));
+            // different implementations of the same metric type (e.g. TCounter and TStripedCounter)
+            Y_ENSURE(typeid(*metric) == typeid(TMetric), "cannot create metric " << labels
+                    << ", because registry already has same metric of another kind");
+            return static_cast<TMetric*>(metric.Get());
+        };
+
         {
-            TReadGuard g{*Lock_};
-
-            auto it = Metrics_.find(labels);
-            if (it != Metrics_.end()) {
-                Y_ENSURE(it->second->Type() == type, "cannot create metric " << labels
-                        << " with type " << MetricTypeToStr(type)
-                        << ", because registry already has same metric with type " << MetricTypeToStr(it->second->Type()));
-                return static_cast<TMetric*>(it->second.Get());
+            TLightReadGuard g{shard.Lock};
+
+            auto it = shard.Metrics.find(labels);
+            if (it != shard.Metrics.end()) {
+                return checkType(it->second.Metric);
             }
         }
 
         {
-            IMetricPtr metric = MakeIntrusive<TMetric>(std::forward<Args>(args)...);
+            TMetricEntry entry;
+            entry.Metric = MakeIntrusive<TMetric>(std::forward<Args>(args)...);
+
+            TLightWriteGuard g{shard.Lock};
+            auto it = shard.Metrics.find(labels);
+            if (it != shard.Metrics.end()) {
+                // metric was created concurrently
+                return checkType(it->second.Metric);
+            }
 
-            TWriteGuard g{*Lock_};
-            // decltype(Metrics_)::iterator breaks build on windows
-            THashMap<ILabelsPtr, IMetricPtr>::iterator it;
+            entry.Order = Shards_->NextOrder.fetch_add(1, std::memory_order_relaxed);
             if constexpr (!std::is_convertible_v<TLabelsType, ILabelsPtr>) {
-                it = Metrics_.emplace(new TLabels{std::forward<TLabelsType>(labels)}, std::move(metric)).first;
+                it = shard.Metrics.emplace(new TLabels{std::forward<TLabelsType>(labels)}, std::move(entry)).first;
             } else {
-                it = Metrics_.emplace(std::forward<TLabelsType>(labels), std::move(metric)).first;
+                it = shard.Metrics.emplace(std::forward<TLabelsType>(labels), std::move(entry)).first;
             }
 
-            return static_cast<TMetric*>(it->second.Get());
+            return static_cast<TMetric*>(it->second.Metric.Get());
         }
     }
 
     void TMetricRegistry::RemoveMetric(const ILabels& labels) noexcept {
-        TWriteGuard g{*Lock_};
-        Metrics_.erase(labels);
+        TShard& shard = GetShard(labels);
+        TLightWriteGuard g{shard.Lock};
+        shard.Metrics.erase(labels);
     }
 
     void TMetricRegistry::Accept(TInstant time, IMetricConsumer* consumer) const {
@@ -227,19 +282,9 @@ namespace NMonitoring {
             consumer->OnLabelsEnd();
         }
 
-        std::vector<std::pair<ILabelsPtr, IMetricPtr>> tmpMetrics;
-
-        {
-            TReadGuard g{*Lock_};
-            tmpMetrics.reserve(Metrics_.size());
-            for (const auto& it: Metrics_) {
-                tmpMetrics.push_back(it);
-            }
-        }
-
-        for (const auto& it: tmpMetrics) {
+        for (const auto& it: Snapshot()) {
             ILabels* labels = it.first.Get();
-            IMetric* metric = it.second.Get();
+            IMetric* metric = it.second.Metric.Get();
             ConsumeMetric(time, consumer, metric, [&]() {
                 ConsumeLabels(consumer, *labels);
             });
@@ -249,11 +294,9 @@ namespace NMonitoring {
     }
 
     void TMetricRegistry::Append(TInstant time, IMetricConsumer* consumer) const {
-        TReadGuard g{*Lock_};
-
-        for (const auto& it: Metrics_) {
+        for (const auto& it: Snapshot()) {
             ILabels* labels = it.first.Get();
-            IMetric* metric = it.second.Get();
+            IMetric* metric = it.second.Metric.Get();
             ConsumeMetric(time, consumer, metric, [&]() {
                 ConsumeLabels(consumer, CommonLabels_);
                 ConsumeLabels(consumer, *labels);
@@ -7,6 +7,9 @@
 
 #include <library/cpp/threading/light_rw_lock/lightrwlock.h>
 
+#include <array>
+#include <atomic>
+#include <vector>
 
 namespace NMonitoring {
     class IMetricFactory {
@@ -87,6 +90,13 @@ namespace NMonitoring {
         TRate* Rate(TLabels labels);
         TLazyRate* LazyRate(TLabels labels, std::function<ui64()> supplier);
 
+        /**
+         * Counter optimized for concurrent increments from many threads,
+         * see TStripedCounter.
+         */
+        TStripedCounter* StripedCounter(TLabels labels);
+        TStripedCounter* StripedCounter(ILabelsPtr labels);
+
         THistogram* HistogramCounter(
                 TLabels labels,
                 IHistogramCollectorPtr collector);
@@ -148,8 +158,36 @@ namespace NMonitoring {
                 std::function<IHistogramCollectorPtr()> makeHistogramCollector) override;
 
     private:
-        THolder<TRWMutex> Lock_ = MakeHolder<TRWMutex>();
-        THashMap<ILabelsPtr, IMetricPtr> Metrics_;
+        // Metrics are spread over shards by labels hash, so lookups of existing
+        // metrics take only a shared lock on one shard and rarely contend.
+        static constexpr size_t ShardCount = 16;
+
+        struct TMetricEntry {
+            IMetricPtr Metric;
+            // Creation order, keeps encoded metrics in a stable order
+            ui64 Order = 0;
+        };
+
+        struct TShard {
+            TLightRWLock Lock;
+            THashMap<ILabelsPtr, TMetricEntry> Metrics;
+        };
+
+        struct TShards {
+            std::array<TShard, ShardCount> Shards;
+            std::atomic<ui64> NextOrder = 0;
+        };
+
+        using TMetricsSnapshot = std::vector<std::pair<ILabelsPtr, TMetricEntry>>;
+
+        template <typename TLabelsType>
+        TShard& GetShard(const TLabelsType& labels) const;
+
+        // Copies metric pointers under a short shared lock of each shard,
+        // so metrics are encoded without blocking concurrent writers
+        TMetricsSnapshot Snapshot() const;
+
+        THolder<TShards> Shards_ = MakeHolder<TShards>();
 
         template <typename TMetric, EMetricType type, typename TLabelsType, typename... Args>
         TMetric* Metric(TLabelsType&& labels, Args&&... args);
@@ -8,6 +8,8 @@
 
 #include <util/stream/str.h>
 
+#include <thread>
+
 using namespace NMonitoring;
 
 template<>
@@ -154,6 +156,29 @@ Y_UNIT_TEST_SUITE(TMetricRegistryTest) {
         UNIT_ASSERT_VALUES_EQUAL(c->Get(), 42);
     }
 
+    Y_UNIT_TEST(StripedCounter) {
+        TMetricRegistry registry(TLabels{{"common", "label"}});
+        TStripedCounter* c = EnsureIdempotent([&] { return registry.StripedCounter({{"my", "counter"}}); });
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < 4; ++i) {
+            threads.emplace_back([&] {
+                for (size_t j = 0; j < 1000; ++j) {
+                    registry.StripedCounter({{"my", "counter"}})->Inc();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        UNIT_ASSERT_VALUES_EQUAL(c->Get(), 4000);
+        UNIT_ASSERT_EXCEPTION(registry.Counter({{"my", "counter"}}), yexception);
+
+        registry.Reset();
+        UNIT_ASSERT_VALUES_EQUAL(c->Get(), 0);
+    }
+
     Y_UNIT_TEST(LazyRate) {
         TMetricRegistry registry(TLabels{{"common", "label"}});
         ui64 val = 0;
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "future.h"
+
+#include <coroutine>
+
+// C++20 coroutine support for NThreading futures:
+//  * function returning TFuture<T> may be a coroutine (use co_return to set the value,
+//    exception escaped from the body is stored into the future);
+//  * TFuture<T> may be awaited with co_await, the result is the future value
+//    (or exception is rethrown).
+//
+// Awaiting coroutine is resumed in the thread which sets the value, exactly as
+// a subscribed callback would be called. Ready future is not suspended at all.
+
+namespace NThreading::NImpl {
+
+    template <typename T>
+    class TFutureAwaitable {
+    public:
+        explicit TFutureAwaitable(const TFuture<T>& future) noexcept
+            : Future_(future)
+        {
+        }
+
+        bool await_ready() const noexcept {
+            return Future_.HasValue() || Future_.HasException();
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            // Callback may be called in place if the value is set concurrently, so the coroutine
+            // (and this awaitable within it's frame) may be already destroyed when Subscribe returns.
+            // Use local copy of the future to not touch the frame after that.
+            // The callback holds just a handle, so it fits into std::function small buffer.
+            const TFuture<T> future = Future_;
+            future.NoexceptSubscribe([handle](const TFuture<T>&) {
+                handle.resume();
+            });
+            return true;
+        }
+
+        decltype(auto) await_resume() const {
+            if constexpr (std::is_void_v<T>) {
+                Future_.TryRethrow();
+            } else {
+                return Future_.GetValue();
+            }
+        }
+
+    private:
+        TFuture<T> Future_;
+    };
+
+    template <typename T>
+    class TFuturePromiseBase {
+    public:
+        TFuture<T> get_return_object() {
+            return Promise_.GetFuture();
+        }
+
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        void unhandled_exception() {
+            Promise_.SetException(std::current_exception());
+        }
+
+    protected:
+        TPromise<T> Promise_ = NewPromise<T>();
+    };
+
+    template <typename T>
+    class TFuturePromise: public TFuturePromiseBase<T> {
+    public:
+        template <typename U = T>
+        void return_value(U&& value) {
+            this->Promise_.SetValue(std::forward<U>(value));
+        }
+    };
+
+    template <>
+    class TFuturePromise<void>: public TFuturePromiseBase<void> {
+    public:
+        void return_void() {
+            Promise_.SetValue();
+        }
+    };
+
+}
+
+namespace NThreading {
+
+    template <typename T>
+    NImpl::TFutureAwaitable<T> operator co_await(const TFuture<T>& future) noexcept {
+        return NImpl::TFutureAwaitable<T>(future);
+    }
+
+}
+
+template <typename T, typename... TArgs>
+struct std::coroutine_traits<NThreading::TFuture<T>, TArgs...> {
+    using promise_type = NThreading::NImpl::TFuturePromise<T>;
+};
@@ -4,6 +4,7 @@
 #error "you should never include future-inl.h directly"
 #endif // INCLUDE_FUTURE_INL_H
 
+#include <atomic>
 #include <mutex>
 
 namespace NThreading {
@@ -13,33 +14,238 @@ namespace NThreading {
         template <typename T>
         using TCallback = std::function<void(const TFuture<T>&)>;
 
-        template <typename T>
-        using TCallbackList = std::vector<TCallback<T>>; // TODO: small vector
-
         ////////////////////////////////////////////////////////////////////////////////
 
         [[noreturn]] void ThrowFutureException(std::string_view message, const TSourceLocation& source);
 
+        // Blocks while word == value or until deadline, returns false on timeout.
+        // Spurious wake ups are possible, caller should recheck the word.
+        bool FutexWait(std::atomic<ui32>& word, ui32 value, TInstant deadline);
+        void FutexWakeAll(std::atomic<ui32>& word);
+
+        ////////////////////////////////////////////////////////////////////////////////
+
+        // State word of a future, waiting threads sleep on it with futex.
+        // Four lowest values are not ready states, the rest are ready states defined by the future.
+        // Waiting flavour of not ready states tells the setter to wake waiters up,
+        // so there is no syscall if nobody waits.
+        class TFutureStateWord {
+        public:
+            enum : ui32 {
+                NotReady,
+                NotReadyWaiting,
+                Setting, // value or exception is being constructed by the setter
+                SettingWaiting,
+                FirstReady,
+            };
+
+            explicit TFutureStateWord(ui32 state)
+                : State_(state)
+            {
+            }
+
+            ui32 Load() const {
+                return State_.load(std::memory_order_acquire);
+            }
+
+            static bool IsReady(ui32 state) {
+                return state >= FirstReady;
+            }
+
+            bool CompareExchange(ui32& expected, ui32 desired) {
+                return State_.compare_exchange_strong(expected, desired, std::memory_order_acq_rel);
+            }
+
+            // Only one setter wins, the others fail without touching the state
+            bool TryStartSetting() {
+                ui32 state = State_.load(std::memory_order_acquire);
+                while (state == NotReady || state == NotReadyWaiting) {
+                    if (State_.compare_exchange_weak(state, state + Setting, std::memory_order_acquire)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void CancelSetting() {
+                ui32 state = State_.load(std::memory_order_relaxed);
+                while (!State_.compare_exchange_weak(state, state - Setting, std::memory_order_release)) {
+                }
+            }
+
+            void FinishSetting(ui32 readyState) {
+                if (State_.exchange(readyState, std::memory_order_acq_rel) == SettingWaiting) {
+                    FutexWakeAll(State_);
+                }
+            }
+
+            bool Wait(TInstant deadline) const {
+                ui32 state = State_.load(std::memory_order_acquire);
+                while (!IsReady(state)) {
+                    if (state == NotReady || state == Setting) {
+                        if (!State_.compare_exchange_weak(state, state + 1, std::memory_order_acquire)) {
+                            continue;
+                        }
+                        ++state;
+                    }
+                    if (!FutexWait(State_, state, deadline)) {
+                        return IsReady(State_.load(std::memory_order_acquire));
+                    }
+                    state = State_.load(std::memory_order_acquire);
+                }
+                return true;
+            }
+
+        private:
+            mutable std::atomic<ui32> State_;
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+
+        // Lock free stack of callbacks, closed when the future becomes ready.
+        // The first callback is stored inside the future state, so the common case
+        // of a single subscriber doesn't allocate a list node.
+        template <typename T>
+        class TCallbackStack {
+            struct TNode {
+                template <typename F>
+                explicit TNode(F&& func)
+                    : Callback(std::forward<F>(func))
+                {
+                }
+
+                TCallback<T> Callback;
+                TNode* Next = nullptr;
+            };
+
+        public:
+            explicit TCallbackStack(bool closed)
+                : Head_(closed ? Closed() : nullptr)
+                , InlineUsed_(closed)
+            {
+            }
+
+            ~TCallbackStack() {
+                TNode* head = Head_.load(std::memory_order_acquire);
+                if (head != Closed()) {
+                    DestroyList(head);
+                }
+            }
+
+            // Returns false if the stack is already closed, func is untouched in that case
+            template <typename F, typename TState>
+            bool Push(F&& func, TState* state) {
+                TNode* head = Head_.load(std::memory_order_acquire);
+                if (head == Closed()) {
+                    return false;
+                }
+
+                TNode* node = NewNode(std::forward<F>(func));
+                do {
+                    if (head == Closed()) {
+                        // Closed concurrently, func is already consumed so call it in place
+                        InvokeAndDestroy(node, TFuture<T>(state));
+                        return true;
+                    }
+                    node->Next = head;
+                } while (!Head_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_acquire));
+                return true;
+            }
+
+            // Closes the stack and calls all callbacks in subscription order
+            template <typename TState>
+            void CloseAndRun(TState* state) {
+                TNode* head = Head_.exchange(Closed(), std::memory_order_acq_rel);
+                if (!head) {
+                    return;
+                }
+
+                TNode* list = nullptr;
+                while (head) {
+                    TNode* next = head->Next;
+                    head->Next = list;
+                    list = head;
+                    head = next;
+                }
+
+                const TFuture<T> future(state);
+                while (list) {
+                    TNode* next = list->Next;
+                    try {
+                        InvokeAndDestroy(list, future);
+                    } catch (...) {
+                        DestroyList(next);
+                        throw;
+                    }
+                    list = next;
+                }
+            }
+
+        private:
+            static TNode* Closed() {
+                return reinterpret_cast<TNode*>(alignof(TNode));
+            }
+
+            template <typename F>
+            TNode* NewNode(F&& func) {
+                if (!InlineUsed_.load(std::memory_order_relaxed) && !InlineUsed_.exchange(true, std::memory_order_relaxed)) {
+                    return new (&InlineNode_) TNode(std::forward<F>(func));
+                }
+                return new TNode(std::forward<F>(func));
+            }
+
+            void DestroyNode(TNode* node) {
+                if (node == reinterpret_cast<TNode*>(&InlineNode_)) {
+                    node->~TNode();
+                } else {
+                    delete node;
+                }
+            }
+
+            void InvokeAndDestroy(TNode* node, const TFuture<T>& future) {
+                try {
+                    node->Callback(future);
+                } catch (...) {
+                    DestroyNode(node);
+                    throw;
+                }
+                DestroyNode(node);
+            }
+
+            void DestroyList(TNode* node) {
+                while (node) {
+                    TNode* next = node->Next;
+                    DestroyNode(node);
+                    node = next;
+                }
+            }
+
+        private:
+            std::atomic<TNode*> Head_;
+            std::atomic<bool> InlineUsed_;
+            alignas(TNode) char InlineNode_[sizeof(TNode)];
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////
+
         enum class TError {
             Error
         };
 
         template <typename T>
         class TFutureState: public TAtomicRefCount<TFutureState<T>> {
-            enum {
-                NotReady,
-                ExceptionSet,
+            enum : ui32 {
+                NotReady = TFutureStateWord::NotReady,
+                ExceptionSet = TFutureStateWord::FirstReady,
                 ValueMoved, // keep the ordering of this and following values
                 ValueSet,
                 ValueRead,
             };
 
         private:
-            mutable TAtomic State;
-            mutable TAdaptiveLock StateLock;
+            mutable TFutureStateWord State;
 
-            TCallbackList<T> Callbacks;
-            mutable THolder<TSystemEvent> ReadyEvent;
+            TCallbackStack<T> Callbacks;
 
             std::exception_ptr Exception;
 
@@ -48,10 +254,10 @@ namespace NThreading {
                 T Value;
             };
 
-            void AccessValue(TDuration timeout, int acquireState) const {
+            void AccessValue(TDuration timeout, ui32 acquireState) const {
                 using namespace std::literals;
-                TAtomicBase state = AtomicGet(State);
-                if (Y_UNLIKELY(state == NotReady)) {
+                ui32 state = State.Load();
+                if (Y_UNLIKELY(!TFutureStateWord::IsReady(state))) {
                     if (timeout == TDuration::Zero()) {
                         ::NThreading::NImpl::ThrowFutureException("value not set"sv, __LOCATION__);
                     }
@@ -60,12 +266,14 @@ namespace NThreading {
                         ::NThreading::NImpl::ThrowFutureException("wait timeout"sv, __LOCATION__);
                     }
 
-                    state = AtomicGet(State);
+                    state = State.Load();
                 }
 
                 TryRethrowWithState(state);
 
-                switch (AtomicGetAndCas(&State, acquireState, ValueSet)) {
+                ui32 prevState = ValueSet;
+                State.CompareExchange(prevState, acquireState);
+                switch (prevState) {
                     case ValueSet:
                         break;
                     case ValueRead:
@@ -80,9 +288,15 @@ namespace NThreading {
                 }
             }
 
+            void FinishSetting(ui32 state) {
+                State.FinishSetting(state);
+                Callbacks.CloseAndRun(this);
+            }
+
         public:
             TFutureState()
                 : State(NotReady)
+                , Callbacks(false)
                 , NullValue(0)
             {
             }
@@ -90,34 +304,35 @@ namespace NThreading {
             template <typename TT>
             TFutureState(TT&& value)
                 : State(ValueSet)
+                , Callbacks(true)
                 , Value(std::forward<TT>(value))
             {
             }
 
             TFutureState(std::exception_ptr exception, TError)
                 : State(ExceptionSet)
+                , Callbacks(true)
                 , Exception(std::move(exception))
                 , NullValue(0)
             {
             }
 
             ~TFutureState() {
-                if (State >= ValueMoved) { // ValueMoved, ValueSet, ValueRead
+                if (State.Load() >= ValueMoved) { // ValueMoved, ValueSet, ValueRead
                     Value.~T();
                 }
             }
 
             bool HasValue() const {
-                return AtomicGet(State) >= ValueMoved; // ValueMoved, ValueSet, ValueRead
+                return State.Load() >= ValueMoved; // ValueMoved, ValueSet, ValueRead
             }
 
             void TryRethrow() const {
-                TAtomicBase state = AtomicGet(State);
-                TryRethrowWithState(state);
+                TryRethrowWithState(State.Load());
             }
 
             bool HasException() const {
-                return AtomicGet(State) == ExceptionSet;
+                return State.Load() == ExceptionSet;
             }
 
             const T& GetValue(TDuration timeout = TDuration::Zero()) const {
@@ -141,35 +356,18 @@ namespace NThreading {
 
             template <typename TT>
             bool TrySetValue(TT&& value) {
-                TSystemEvent* readyEvent = nullptr;
-                TCallbackList<T> callbacks;
-
-                {
-                    std::lock_guard guard(StateLock);
-                    TAtomicBase state = AtomicGet(State);
-                    if (Y_UNLIKELY(state != NotReady)) {
-                        return false;
-                    }
-
-                    new (&Value) T(std::forward<TT>(value));
-
-                    readyEvent = ReadyEvent.Get();
-                    callbacks = std::move(Callbacks);
-
-                    AtomicSet(State, ValueSet);
-                }
-
-                if (readyEvent) {
-                    readyEvent->Signal();
+                if (Y_UNLIKELY(!State.TryStartSetting())) {
+                    return false;
                 }
 
-                if (!callbacks.empty()) {
-                    TFuture<T> temp(this);
-                    for (auto& callback : callbacks) {
-                        callback(temp);
-                    }
+                try {
+                    new (&Value) T(std::forward<TT>(value));
+                } catch (...) {
+                    State.CancelSetting();
+                    throw;
                 }
 
+                FinishSetting(ValueSet);
                 return true;
             }
 
@@ -182,47 +380,19 @@ namespace NThreading {
             }
 
             bool TrySetException(std::exception_ptr e) {
-                TSystemEvent* readyEvent;
-                TCallbackList<T> callbacks;
-
-                {
-                    std::lock_guard guard(StateLock);
-                    TAtomicBase state = AtomicGet(State);
-                    if (Y_UNLIKELY(state != NotReady)) {
-                        return false;
-                    }
-
-                    Exception = std::move(e);
-
-                    readyEvent = ReadyEvent.Get();
-                    callbacks = std::move(Callbacks);
-
-                    AtomicSet(State, ExceptionSet);
-                }
-
-                if (readyEvent) {
-                    readyEvent->Signal();
+                if (Y_UNLIKELY(!State.TryStartSetting())) {
+                    return false;
                 }
 
-                if (!callbacks.empty()) {
-                    TFuture<T> temp(this);
-                    for (auto& callback : callbacks) {
-                        callback(temp);
-                    }
-                }
+                Exception = std::move(e);
 
+                FinishSetting(ExceptionSet);
                 return true;
             }
 
             template <typename F>
             bool Subscribe(F&& func) {
-                std::lock_guard guard(StateLock);
-                TAtomicBase state = AtomicGet(State);
-                if (state == NotReady) {
-                    Callbacks.emplace_back(std::forward<F>(func));
-                    return true;
-                }
-                return false;
+                return Callbacks.Push(std::forward<F>(func), this);
             }
 
             void Wait() const {
@@ -234,26 +404,10 @@ namespace NThreading {
             }
 
             bool Wait(TInstant deadline) const {
-                TSystemEvent* readyEvent = nullptr;
-
-                {
-                    std::lock_guard guard{StateLock};
-                    TAtomicBase state = AtomicGet(State);
-                    if (state != NotReady) {
-                        return true;
-                    }
-
-                    if (!ReadyEvent) {
-                        ReadyEvent.Reset(new TSystemEvent());
-                    }
-                    readyEvent = ReadyEvent.Get();
-                }
-
-                Y_ASSERT(readyEvent);
-                return readyEvent->WaitD(deadline);
+                return State.Wait(deadline);
             }
 
-            void TryRethrowWithState(TAtomicBase state) const {
+            void TryRethrowWithState(ui32 state) const {
                 if (Y_UNLIKELY(state == ExceptionSet)) {
                     Y_ASSERT(Exception);
                     std::rethrow_exception(Exception);
@@ -265,50 +419,54 @@ namespace NThreading {
 
         template <>
         class TFutureState<void>: public TAtomicRefCount<TFutureState<void>> {
-            enum {
-                NotReady,
-                ValueSet,
+            enum : ui32 {
+                NotReady = TFutureStateWord::NotReady,
+                ValueSet = TFutureStateWord::FirstReady,
                 ExceptionSet,
             };
 
         private:
-            TAtomic State;
-            mutable TAdaptiveLock StateLock;
+            TFutureStateWord State;
 
-            TCallbackList<void> Callbacks;
-            mutable THolder<TSystemEvent> ReadyEvent;
+            TCallbackStack<void> Callbacks;
 
             std::exception_ptr Exception;
 
+            void FinishSetting(ui32 state) {
+                State.FinishSetting(state);
+                Callbacks.CloseAndRun(this);
+            }
+
         public:
             TFutureState(bool valueSet = false)
                 : State(valueSet ? ValueSet : NotReady)
+                , Callbacks(valueSet)
             {
             }
 
             TFutureState(std::exception_ptr exception, TError)
                 : State(ExceptionSet)
+                , Callbacks(true)
                 , Exception(std::move(exception))
             {
             }
 
             bool HasValue() const {
-                return AtomicGet(State) == ValueSet;
+                return State.Load() == ValueSet;
             }
 
             void TryRethrow() const {
-                TAtomicBase state = AtomicGet(State);
-                TryRethrowWithState(state);
+                TryRethrowWithState(State.Load());
             }
 
             bool HasException() const {
-                return AtomicGet(State) == ExceptionSet;
+                return State.Load() == ExceptionSet;
             }
 
             void GetValue(TDuration timeout = TDuration::Zero()) const {
                 using namespace std::literals;
-                TAtomicBase state = AtomicGet(State);
-                if (Y_UNLIKELY(state == NotReady)) {
+                ui32 state = State.Load();
+                if (Y_UNLIKELY(!TFutureStateWord::IsReady(state))) {
                     if (timeout == TDuration::Zero()) {
                         ::NThreading::NImpl::ThrowFutureException("value not set"sv, __LOCATION__);
                     }
@@ -317,7 +475,7 @@ namespace NThreading {
                         ::NThreading::NImpl::ThrowFutureException("wait timeout"sv, __LOCATION__);
                     }
 
-                    state = AtomicGet(State);
+                    state = State.Load();
                 }
 
                 TryRethrowWithState(state);
@@ -334,33 +492,11 @@ namespace NThreading {
             }
 
             bool TrySetValue() {
-                TSystemEvent* readyEvent = nullptr;
-                TCallbackList<void> callbacks;
-
-                {
-                    std::lock_guard guard(StateLock);
-                    TAtomicBase state = AtomicGet(State);
-                    if (Y_UNLIKELY(state != NotReady)) {
-                        return false;
-                    }
-
-                    readyEvent = ReadyEvent.Get();
-                    callbacks = std::move(Callbacks);
-
-                    AtomicSet(State, ValueSet);
-                }
-
-                if (readyEvent) {
-                    readyEvent->Signal();
-                }
-
-                if (!callbacks.empty()) {
-                    TFuture<void> temp(this);
-                    for (auto& callback : callbacks) {
-                        callback(temp);
-                    }
+                if (Y_UNLIKELY(!State.TryStartSetting())) {
+                    return false;
                 }
 
+                FinishSetting(ValueSet);
                 return true;
             }
 
@@ -373,47 +509,19 @@ namespace NThreading {
             }
 
             bool TrySetException(std::exception_ptr e) {
-                TSystemEvent* readyEvent = nullptr;
-                TCallbackList<void> callbacks;
-
-                {
-                    std::lock_guard guard(StateLock);
-                    TAtomicBase state = AtomicGet(State);
-                    if (Y_UNLIKELY(state != NotReady)) {
-                        return false;
-                    }
-
-                    Exception = std::move(e);
-
-                    readyEvent = ReadyEvent.Get();
-                    callbacks = std::move(Callbacks);
-
-                    AtomicSet(State, ExceptionSet);
-                }
-
-                if (readyEvent) {
-                    readyEvent->Signal();
+                if (Y_UNLIKELY(!State.TryStartSetting())) {
+                    return false;
                 }
 
-                if (!callbacks.empty()) {
-                    TFuture<void> temp(this);
-                    for (auto& callback : callbacks) {
-                        callback(temp);
-                    }
-                }
+                Exception = std::move(e);
 
+                FinishSetting(ExceptionSet);
                 return true;
             }
 
             template <typename F>
             bool Subscribe(F&& func) {
-                std::lock_guard guard(StateLock);
-                TAtomicBase state = AtomicGet(State);
-                if (state == NotReady) {
-                    Callbacks.emplace_back(std::forward<F>(func));
-                    return true;
-                }
-                return false;
+                return Callbacks.Push(std::forward<F>(func), this);
             }
 
             void Wait() const {
@@ -425,26 +533,10 @@ namespace NThreading {
             }
 
             bool Wait(TInstant deadline) const {
-                TSystemEvent* readyEvent = nullptr;
-
-                {
-                    std::lock_guard guard{StateLock};
-                    TAtomicBase state = AtomicGet(State);
-                    if (state != NotReady) {
-                        return true;
-                    }
-
-                    if (!ReadyEvent) {
-                        ReadyEvent.Reset(new TSystemEvent());
-                    }
-                    readyEvent = ReadyEvent.Get();
-                }
-
-                Y_ASSERT(readyEvent);
-                return readyEvent->WaitD(deadline);
+                return State.Wait(deadline);
             }
 
-            void TryRethrowWithState(TAtomicBase state) const {
+            void TryRethrowWithState(ui32 state) const {
                 if (Y_UNLIKELY(state == ExceptionSet)) {
                     Y_ASSERT(Exception);
                     std::rethrow_exception(Exception);
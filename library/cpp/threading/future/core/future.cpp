@@ -1,7 +1,83 @@
 #include "future.h"
 
+#if defined(_linux_)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+
+    #include <cerrno>
+    #include <ctime>
+#else
+    #include <array>
+    #include <condition_variable>
+#endif
+
 namespace NThreading::NImpl {
     [[noreturn]] void ThrowFutureException(std::string_view message, const TSourceLocation& source) {
         throw source + TFutureException() << message;
     }
+
+#if defined(_linux_)
+    bool FutexWait(std::atomic<ui32>& word, ui32 value, TInstant deadline) {
+        struct timespec timeout;
+        struct timespec* timeoutPtr = nullptr;
+        if (deadline != TInstant::Max()) {
+            const TInstant now = TInstant::Now();
+            if (now >= deadline) {
+                return false;
+            }
+            const TDuration left = deadline - now;
+            timeout.tv_sec = left.Seconds();
+            timeout.tv_nsec = left.NanoSecondsOfSecond();
+            timeoutPtr = &timeout;
+        }
+
+        if (syscall(SYS_futex, reinterpret_cast<ui32*>(&word), FUTEX_WAIT_PRIVATE, value, timeoutPtr, nullptr, 0) == -1) {
+            // EAGAIN - word is already changed, EINTR - caller rechecks the word anyway
+            return errno != ETIMEDOUT;
+        }
+        return true;
+    }
+
+    void FutexWakeAll(std::atomic<ui32>& word) {
+        syscall(SYS_futex, reinterpret_cast<ui32*>(&word), FUTEX_WAKE_PRIVATE, Max<int>(), nullptr, nullptr, 0);
+    }
+#else
+    namespace {
+        // Waiters are rare, so they share a small striped table of condition variables
+        struct TWaitBucket {
+            std::mutex Lock;
+            std::condition_variable CondVar;
+        };
+
+        std::array<TWaitBucket, 64> WaitBuckets;
+
+        TWaitBucket& GetWaitBucket(const std::atomic<ui32>& word) {
+            return WaitBuckets[(reinterpret_cast<uintptr_t>(&word) >> 3) % WaitBuckets.size()];
+        }
+    }
+
+    bool FutexWait(std::atomic<ui32>& word, ui32 value, TInstant deadline) {
+        auto& bucket = GetWaitBucket(word);
+        std::unique_lock guard(bucket.Lock);
+        while (word.load(std::memory_order_acquire) == value) {
+            if (deadline == TInstant::Max()) {
+                bucket.CondVar.wait(guard);
+            } else {
+                const TInstant now = TInstant::Now();
+                if (now >= deadline) {
+                    return false;
+                }
+                bucket.CondVar.wait_for(guard, std::chrono::microseconds((deadline - now).MicroSeconds()));
+            }
+        }
+        return true;
+    }
+
+    void FutexWakeAll(std::atomic<ui32>& word) {
+        auto& bucket = GetWaitBucket(word);
+        std::lock_guard guard(bucket.Lock);
+        bucket.CondVar.notify_all();
+    }
+#endif
 }
@@ -0,0 +1,80 @@
+#include "core/coroutine_traits.h"
+
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <util/generic/yexception.h>
+
+namespace NThreading {
+
+namespace {
+
+    TFuture<int> Sum(TFuture<int> lhs, TFuture<int> rhs) {
+        const int l = co_await lhs;
+        const int r = co_await rhs;
+        co_return l + r;
+    }
+
+    TFuture<void> Store(TFuture<int> value, int* result) {
+        *result = co_await value;
+    }
+
+    TFuture<int> Throw(TFuture<void> trigger) {
+        co_await trigger;
+        ythrow yexception() << "coroutine failed";
+    }
+
+    TFuture<std::string> Rethrow(TFuture<int> value) {
+        try {
+            co_await value;
+        } catch (const yexception& e) {
+            co_return std::string(e.what());
+        }
+        co_return std::string();
+    }
+
+}
+
+Y_UNIT_TEST_SUITE(TFutureCoroutineTest) {
+    Y_UNIT_TEST(ReadyFutures) {
+        auto future = Sum(MakeFuture(1), MakeFuture(2));
+        UNIT_ASSERT(future.HasValue());
+        UNIT_ASSERT_VALUES_EQUAL(future.GetValue(), 3);
+    }
+
+    Y_UNIT_TEST(ResumeOnSetValue) {
+        auto lhs = NewPromise<int>();
+        auto rhs = NewPromise<int>();
+        auto future = Sum(lhs.GetFuture(), rhs.GetFuture());
+        UNIT_ASSERT(!future.HasValue());
+
+        rhs.SetValue(5);
+        UNIT_ASSERT(!future.HasValue());
+
+        lhs.SetValue(4);
+        UNIT_ASSERT(future.HasValue());
+        UNIT_ASSERT_VALUES_EQUAL(future.GetValue(), 9);
+    }
+
+    Y_UNIT_TEST(VoidCoroutine) {
+        auto promise = NewPromise<int>();
+        int result = 0;
+        auto future = Store(promise.GetFuture(), &result);
+        UNIT_ASSERT(!future.HasValue());
+
+        promise.SetValue(42);
+        UNIT_ASSERT(future.HasValue());
+        UNIT_ASSERT_VALUES_EQUAL(result, 42);
+    }
+
+    Y_UNIT_TEST(Exception) {
+        auto promise = NewPromise();
+        auto future = Throw(promise.GetFuture());
+        promise.SetValue();
+        UNIT_ASSERT(future.HasException());
+        UNIT_ASSERT_EXCEPTION_CONTAINS(future.GetValue(), yexception, "coroutine failed");
+
+        UNIT_ASSERT_STRING_CONTAINS(Rethrow(Throw(MakeFuture())).GetValue(), "coroutine failed");
+    }
+}
+
+}
@@ -1,4 +1,5 @@
 #pragma once
 
 #include "core/future.h"
+#include "core/coroutine_traits.h"
 #include "wait/wait.h"
@@ -211,5 +211,40 @@ Y_UNIT_TEST_SUITE(TFutureMultiThreadedTest) {
                 };
             });
     }
-}
 
+    Y_UNIT_TEST(SubscribeRacesWithSetValue) {
+        auto pool = MakePool();
+
+        for (size_t i : xrange(1000)) {
+            Y_UNUSED(i);
+            auto promise = NewPromise<i64>();
+            std::atomic<i64> called = 0;
+            std::atomic<i64> finished = 0;
+            TRelaxedBarrier barrier(5);
+
+            for (size_t j : xrange(4)) {
+                Y_UNUSED(j);
+                UNIT_ASSERT(pool->AddFunc([&]() {
+                    barrier.Arrive();
+                    for (size_t k : xrange(4)) {
+                        Y_UNUSED(k);
+                        promise.GetFuture().Subscribe([&called](const TFuture<i64>& future) {
+                            called.fetch_add(future.GetValue(), std::memory_order_relaxed);
+                        });
+                    }
+                    finished.fetch_add(1);
+                }));
+            }
+            UNIT_ASSERT(pool->AddFunc([&]() {
+                barrier.Arrive();
+                promise.SetValue(1);
+                finished.fetch_add(1);
+            }));
+
+            while (finished.load() != 5) {
+            }
+            // each callback is called exactly once, either by setter or in place by subscriber
+            UNIT_ASSERT_VALUES_EQUAL(called.load(), 16);
+        }
+    }
+}
@@ -48,3 +48,78 @@ Y_CPU_BENCHMARK(SetPromiseUI64, iface) {
 Y_CPU_BENCHMARK(SetPromiseStroka, iface) {
     TestSetPromise<std::string>(iface, "test test test");
 }
+
+// Typical rpc: promise is created, the future is subscribed and later the value is set
+template <typename T>
+void TestSubscribeSetPromise(const NBench::NCpu::TParams& iface, T value) {
+    for (const auto it : xrange(iface.Iterations())) {
+        Y_UNUSED(it);
+        auto promise = NewPromise<T>();
+        promise.GetFuture().Subscribe([](const TFuture<T>& future) {
+            Y_DO_NOT_OPTIMIZE_AWAY(future.GetValue());
+        });
+        promise.SetValue(value);
+    }
+}
+
+Y_CPU_BENCHMARK(SubscribeSetPromiseUI64, iface) {
+    TestSubscribeSetPromise<ui64>(iface, 1234567890ull);
+}
+
+Y_CPU_BENCHMARK(SubscribeSetPromiseStroka, iface) {
+    TestSubscribeSetPromise<std::string>(iface, "test test test");
+}
+
+Y_CPU_BENCHMARK(SubscribeSetPromiseVoid, iface) {
+    for (const auto it : xrange(iface.Iterations())) {
+        Y_UNUSED(it);
+        auto promise = NewPromise();
+        promise.GetFuture().Subscribe([](const TFuture<void>& future) {
+            Y_DO_NOT_OPTIMIZE_AWAY(future.HasValue());
+        });
+        promise.SetValue();
+    }
+}
+
+Y_CPU_BENCHMARK(SubscribeMany, iface) {
+    for (const auto it : xrange(iface.Iterations())) {
+        Y_UNUSED(it);
+        auto promise = NewPromise<ui64>();
+        for (size_t i = 0; i < 4; ++i) {
+            promise.GetFuture().Subscribe([](const TFuture<ui64>& future) {
+                Y_DO_NOT_OPTIMIZE_AWAY(future.GetValue());
+            });
+        }
+        promise.SetValue(1234567890ull);
+    }
+}
+
+Y_CPU_BENCHMARK(SubscribeReadyFuture, iface) {
+    const auto ready = MakeFuture<ui64>(1234567890ull);
+    for (const auto it : xrange(iface.Iterations())) {
+        Y_UNUSED(it);
+        ready.Subscribe([](const TFuture<ui64>& future) {
+            Y_DO_NOT_OPTIMIZE_AWAY(future.GetValue());
+        });
+    }
+}
+
+Y_CPU_BENCHMARK(ApplyChain, iface) {
+    for (const auto it : xrange(iface.Iterations())) {
+        Y_UNUSED(it);
+        auto promise = NewPromise<ui64>();
+        auto result = promise.GetFuture()
+            .Apply([](const TFuture<ui64>& future) { return future.GetValue() + 1; })
+            .Apply([](const TFuture<ui64>& future) { return future.GetValue() * 2; });
+        promise.SetValue(1234567890ull);
+        Y_DO_NOT_OPTIMIZE_AWAY(result.GetValue());
+    }
+}
+
+Y_CPU_BENCHMARK(WaitReadyFuture, iface) {
+    const auto future = MakeFuture<ui64>(1234567890ull);
+    for (const auto it : xrange(iface.Iterations())) {
+        Y_UNUSED(it);
+        Y_DO_NOT_OPTIMIZE_AWAY(future.GetValueSync());
+    }
+}
@@ -0,0 +1,63 @@
+#include <library/cpp/testing/benchmark/bench.h>
+#include <library/cpp/threading/work_stealing/pool.h>
+
+#include <util/generic/xrange.h>
+#include <util/thread/pool.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace NThreading;
+
+// Several producers add small tasks to the pool at once, like network threads of the SDK
+// posting response callbacks. Half of the tasks add one more task from the worker.
+template <typename TPool>
+void TestContention(const NBench::NCpu::TParams& iface, size_t workers, size_t producers) {
+    TPool pool;
+    pool.Start(workers);
+
+    std::atomic<size_t> done = 0;
+    const size_t tasksPerProducer = iface.Iterations();
+    std::vector<std::thread> threads;
+    for (const auto producer : xrange(producers)) {
+        Y_UNUSED(producer);
+        threads.emplace_back([&] {
+            for (const auto i : xrange(tasksPerProducer)) {
+                Y_ABORT_UNLESS(pool.AddFunc([&pool, &done, i] {
+                    if (i % 2) {
+                        Y_ABORT_UNLESS(pool.AddFunc([&done] {
+                            done.fetch_add(1, std::memory_order_relaxed);
+                        }));
+                    }
+                    done.fetch_add(1, std::memory_order_relaxed);
+                }));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const size_t total = producers * (tasksPerProducer + tasksPerProducer / 2);
+    while (done.load() != total) {
+        std::this_thread::yield();
+    }
+    pool.Stop();
+}
+
+Y_CPU_BENCHMARK(ThreadPool_4x4, iface) {
+    TestContention<TThreadPool>(iface, 4, 4);
+}
+
+Y_CPU_BENCHMARK(WorkStealingThreadPool_4x4, iface) {
+    TestContention<TWorkStealingThreadPool>(iface, 4, 4);
+}
+
+Y_CPU_BENCHMARK(ThreadPool_16x8, iface) {
+    TestContention<TThreadPool>(iface, 16, 8);
+}
+
+Y_CPU_BENCHMARK(WorkStealingThreadPool_16x8, iface) {
+    TestContention<TWorkStealingThreadPool>(iface, 16, 8);
+}
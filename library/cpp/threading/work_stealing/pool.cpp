@@ -0,0 +1,505 @@
+#include "pool.h"
+
+#include <util/generic/yexception.h>
+#include <util/generic/scope.h>
+#include <util/random/fast.h>
+#include <util/stream/debug.h>
+#include <util/string/cast.h>
+#include <util/system/info.h>
+#include <util/system/spinlock.h>
+#include <util/system/thread.h>
+#include <util/system/yield.h>
+
+#if defined(_linux_)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace NThreading {
+    namespace {
+        // Chase-Lev deque, see "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al.).
+        // Push and Pop are called by the owner only, Steal by any thread.
+        class TWorkDeque {
+            struct TArray {
+                explicit TArray(size_t capacity)
+                    : Mask(capacity - 1)
+                    , Items(new std::atomic<IObjectInQueue*>[capacity])
+                {
+                }
+
+                size_t Capacity() const {
+                    return Mask + 1;
+                }
+
+                IObjectInQueue* Get(i64 index) const {
+                    return Items[index & Mask].load(std::memory_order_relaxed);
+                }
+
+                void Put(i64 index, IObjectInQueue* obj) {
+                    Items[index & Mask].store(obj, std::memory_order_relaxed);
+                }
+
+                const size_t Mask;
+                std::unique_ptr<std::atomic<IObjectInQueue*>[]> Items;
+            };
+
+        public:
+            TWorkDeque()
+                : Current_(std::make_unique<TArray>(InitialCapacity))
+                , Array_(Current_.get())
+            {
+            }
+
+            void Push(IObjectInQueue* obj) {
+                const i64 bottom = Bottom_.load(std::memory_order_relaxed);
+                const i64 top = Top_.load(std::memory_order_acquire);
+                TArray* array = Array_.load(std::memory_order_relaxed);
+                if (bottom - top >= static_cast<i64>(array->Capacity())) {
+                    array = Grow(array, top, bottom);
+                }
+                array->Put(bottom, obj);
+                Bottom_.store(bottom + 1, std::memory_order_release);
+            }
+
+            IObjectInQueue* Pop() {
+                const i64 bottom = Bottom_.load(std::memory_order_relaxed) - 1;
+                TArray* array = Array_.load(std::memory_order_relaxed);
+                Bottom_.store(bottom, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                i64 top = Top_.load(std::memory_order_relaxed);
+
+                if (top > bottom) {
+                    Bottom_.store(bottom + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                IObjectInQueue* obj = array->Get(bottom);
+                if (top == bottom) {
+                    // Last task, race with thieves for it
+                    if (!Top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                        obj = nullptr;
+                    }
+                    Bottom_.store(bottom + 1, std::memory_order_relaxed);
+                }
+                return obj;
+            }
+
+            // Returns nullptr if the deque is empty or the task was taken by someone else
+            IObjectInQueue* Steal() {
+                i64 top = Top_.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const i64 bottom = Bottom_.load(std::memory_order_acquire);
+
+                if (top >= bottom) {
+                    return nullptr;
+                }
+
+                IObjectInQueue* obj = Array_.load(std::memory_order_acquire)->Get(top);
+                if (!Top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    return nullptr;
+                }
+                return obj;
+            }
+
+            size_t Size() const {
+                const i64 size = Bottom_.load(std::memory_order_relaxed) - Top_.load(std::memory_order_relaxed);
+                return size > 0 ? size : 0;
+            }
+
+        private:
+            TArray* Grow(TArray* array, i64 top, i64 bottom) {
+                auto grown = std::make_unique<TArray>(array->Capacity() * 2);
+                for (i64 i = top; i < bottom; ++i) {
+                    grown->Put(i, array->Get(i));
+                }
+                // Thieves may still read the old array, it is freed with the deque
+                Retired_.push_back(std::move(Current_));
+                Current_ = std::move(grown);
+                Array_.store(Current_.get(), std::memory_order_release);
+                return Current_.get();
+            }
+
+        private:
+            static constexpr size_t InitialCapacity = 256;
+
+            alignas(64) std::atomic<i64> Top_ = 0;
+            alignas(64) std::atomic<i64> Bottom_ = 0;
+            std::unique_ptr<TArray> Current_;
+            std::atomic<TArray*> Array_;
+            std::vector<std::unique_ptr<TArray>> Retired_;
+        };
+    }
+
+    class TWorkStealingThreadPool::TImpl {
+        struct TWorker: public IThreadFactory::IThreadAble {
+            TWorker(TImpl* pool, size_t index)
+                : Pool(pool)
+                , Index(index)
+            {
+            }
+
+            void DoExecute() override {
+                Pool->Run(*this);
+            }
+
+            TImpl* const Pool;
+            const size_t Index;
+            TWorkDeque Deque;
+
+            // Tasks added from other threads
+            alignas(64) TAdaptiveLock InboxLock;
+            std::deque<IObjectInQueue*> Inbox;
+            std::atomic<size_t> InboxSize = 0;
+
+            THolder<IThreadFactory::IThread> Thread;
+        };
+
+    public:
+        TImpl(TWorkStealingThreadPool* parent, const TParams& params, const TWorkStealingThreadPoolParams& workStealingParams)
+            : Parent_(parent)
+            , Params_(params)
+            , WorkStealingParams_(workStealingParams)
+        {
+        }
+
+        ~TImpl() {
+            Stop();
+        }
+
+        bool Add(IObjectInQueue* obj) {
+            // Stop waits for the Adds which have passed the check before it drains and frees the workers
+            AddsInFlight_.fetch_add(1);
+            Y_DEFER {
+                AddsInFlight_.fetch_sub(1);
+            };
+
+            if (Stopping_.load()) {
+                return false;
+            }
+
+            if (Workers_.empty()) {
+                TTsr tsr(Parent_);
+                obj->Process(tsr);
+                return true;
+            }
+
+            if (MaxQueueSize_ && !ReserveQueueSlot()) {
+                return false;
+            }
+
+            if (CurrentWorker_ && CurrentWorker_->Pool == this) {
+                CurrentWorker_->Deque.Push(obj);
+            } else {
+                auto& worker = *Workers_[NextWorker_.fetch_add(1, std::memory_order_relaxed) % Workers_.size()];
+                with_lock (worker.InboxLock) {
+                    worker.Inbox.push_back(obj);
+                    worker.InboxSize.store(worker.Inbox.size(), std::memory_order_relaxed);
+                }
+            }
+
+            WakeUp();
+            return true;
+        }
+
+        void Start(size_t threadCount, size_t queueSizeLimit) {
+            Y_ENSURE(Workers_.empty(), "Thread pool is already started");
+
+            Stopping_.store(false);
+            MaxQueueSize_ = queueSizeLimit;
+
+            // All workers must exist before any of them starts stealing
+            for (size_t i = 0; i < threadCount; ++i) {
+                Workers_.push_back(std::make_unique<TWorker>(this, i));
+            }
+
+            try {
+                for (auto& worker : Workers_) {
+                    worker->Thread = Params_.Factory_->Run(worker.get());
+                }
+            } catch (...) {
+                Stop();
+                throw;
+            }
+        }
+
+        void Stop() {
+            {
+                std::lock_guard guard(ParkLock_);
+                Stopping_.store(true);
+            }
+            ParkCondVar_.notify_all();
+            {
+                std::lock_guard guard(SpaceLock_);
+            }
+            SpaceCondVar_.notify_all();
+
+            // Blocked Adds are woken up above, the rest only finish pushing their tasks
+            while (AddsInFlight_.load()) {
+                ThreadYield();
+            }
+
+            for (auto& worker : Workers_) {
+                if (worker->Thread) {
+                    worker->Thread->Join();
+                }
+            }
+
+            // Tasks added to the inboxes before the Adds have finished may be left after the workers exit
+            if (!Workers_.empty()) {
+                TTsr tsr(Parent_);
+                for (auto& worker : Workers_) {
+                    for (IObjectInQueue* obj : worker->Inbox) {
+                        Process(obj, tsr);
+                    }
+                }
+            }
+
+            Workers_.clear();
+            MaxQueueSize_ = 0;
+            Queued_.store(0);
+        }
+
+        size_t Size() const {
+            size_t size = 0;
+            for (auto& worker : Workers_) {
+                size += worker->Deque.Size() + worker->InboxSize.load(std::memory_order_relaxed);
+            }
+            return size;
+        }
+
+    private:
+        void Run(TWorker& worker) {
+            CurrentWorker_ = &worker;
+            SetupThread(worker);
+            TFastRng64 rng(worker.Index);
+            TTsr tsr(Parent_);
+
+            while (true) {
+                IObjectInQueue* obj = FindTask(worker, rng);
+                for (size_t i = 0; !obj && i < WorkStealingParams_.SpinIterations_; ++i) {
+                    SpinLockPause();
+                    obj = FindTask(worker, rng);
+                }
+
+                if (obj) {
+                    Process(obj, tsr);
+                    continue;
+                }
+
+                // Tasks added after the epoch is read either are found by the next FindTask
+                // or change the epoch, so the worker doesn't sleep with a task in a queue
+                const ui64 epoch = Epoch_.load();
+                if ((obj = FindTask(worker, rng))) {
+                    Process(obj, tsr);
+                    continue;
+                }
+
+                if (Stopping_.load()) {
+                    // Task can be missed by FindTask if a steal has lost a race
+                    if (HasTasks()) {
+                        continue;
+                    }
+                    break;
+                }
+
+                std::unique_lock guard(ParkLock_);
+                Sleepers_.fetch_add(1);
+                ParkCondVar_.wait(guard, [&] {
+                    return Epoch_.load() != epoch || Stopping_.load();
+                });
+                Sleepers_.fetch_sub(1);
+            }
+
+            CurrentWorker_ = nullptr;
+        }
+
+        IObjectInQueue* FindTask(TWorker& worker, TFastRng64& rng) {
+            if (IObjectInQueue* obj = worker.Deque.Pop()) {
+                return obj;
+            }
+            if (IObjectInQueue* obj = TakeFromInbox(worker, false)) {
+                return obj;
+            }
+
+            const size_t count = Workers_.size();
+            const size_t start = rng.Uniform(count);
+            for (size_t i = 0; i < count; ++i) {
+                auto& victim = *Workers_[(start + i) % count];
+                if (&victim == &worker) {
+                    continue;
+                }
+                if (IObjectInQueue* obj = victim.Deque.Steal()) {
+                    return obj;
+                }
+                if (IObjectInQueue* obj = TakeFromInbox(victim, true)) {
+                    return obj;
+                }
+            }
+            return nullptr;
+        }
+
+        IObjectInQueue* TakeFromInbox(TWorker& worker, bool steal) {
+            if (!worker.InboxSize.load(std::memory_order_relaxed)) {
+                return nullptr;
+            }
+
+            if (steal) {
+                if (!worker.InboxLock.TryAcquire()) {
+                    return nullptr;
+                }
+            } else {
+                worker.InboxLock.Acquire();
+            }
+
+            IObjectInQueue* obj = nullptr;
+            if (!worker.Inbox.empty()) {
+                obj = worker.Inbox.front();
+                worker.Inbox.pop_front();
+                // Owner moves a batch to its deque, where the tasks can be stolen without locks
+                for (size_t i = 0; !steal && i < InboxBatchSize && !worker.Inbox.empty(); ++i) {
+                    worker.Deque.Push(worker.Inbox.front());
+                    worker.Inbox.pop_front();
+                }
+                worker.InboxSize.store(worker.Inbox.size(), std::memory_order_relaxed);
+            }
+            worker.InboxLock.Release();
+            return obj;
+        }
+
+        bool HasTasks() const {
+            return Size() > 0;
+        }
+
+        void Process(IObjectInQueue* obj, void* tsr) {
+            if (MaxQueueSize_) {
+                Queued_.fetch_sub(1);
+                if (SpaceWaiters_.load()) {
+                    std::lock_guard guard(SpaceLock_);
+                    SpaceCondVar_.notify_one();
+                }
+            }
+
+            if (Params_.Catching_) {
+                try {
+                    try {
+                        obj->Process(tsr);
+                    } catch (...) {
+                        Cdbg << "[ws queue] " << CurrentExceptionMessage() << Endl;
+                    }
+                } catch (...) {
+                    // ¯\_(ツ)_/¯
+                }
+            } else {
+                obj->Process(tsr);
+            }
+        }
+
+        bool ReserveQueueSlot() {
+            if (Queued_.load() >= MaxQueueSize_) {
+                if (!Params_.Blocking_) {
+                    return false;
+                }
+
+                std::unique_lock guard(SpaceLock_);
+                SpaceWaiters_.fetch_add(1);
+                SpaceCondVar_.wait(guard, [this] {
+                    return Queued_.load() < MaxQueueSize_ || Stopping_.load();
+                });
+                SpaceWaiters_.fetch_sub(1);
+
+                if (Stopping_.load()) {
+                    return false;
+                }
+            }
+            Queued_.fetch_add(1);
+            return true;
+        }
+
+        void WakeUp() {
+            Epoch_.fetch_add(1);
+            if (Sleepers_.load()) {
+                std::lock_guard guard(ParkLock_);
+                ParkCondVar_.notify_one();
+            }
+        }
+
+        void SetupThread(const TWorker& worker) {
+            if (!Params_.ThreadName_.empty()) {
+                if (Params_.EnumerateThreads_) {
+                    TThread::SetCurrentThreadName((Params_.ThreadName_ + ::ToString(worker.Index)).c_str());
+                } else {
+                    TThread::SetCurrentThreadName(Params_.ThreadName_.c_str());
+                }
+            }
+
+#if defined(_linux_)
+            if (WorkStealingParams_.PinThreads_) {
+                cpu_set_t cpus;
+                CPU_ZERO(&cpus);
+                CPU_SET(worker.Index % NSystemInfo::CachedNumberOfCpus(), &cpus);
+                pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+            }
+#endif
+        }
+
+    private:
+        static constexpr size_t InboxBatchSize = 32;
+
+        TWorkStealingThreadPool* const Parent_;
+        const TParams Params_;
+        const TWorkStealingThreadPoolParams WorkStealingParams_;
+
+        std::vector<std::unique_ptr<TWorker>> Workers_;
+        std::atomic<size_t> NextWorker_ = 0;
+        // Tasks are rejected until the pool is started
+        std::atomic<bool> Stopping_ = true;
+        std::atomic<size_t> AddsInFlight_ = 0;
+
+        // Changed by every Add, parked workers wait for it to change
+        alignas(64) std::atomic<ui64> Epoch_ = 0;
+        std::atomic<size_t> Sleepers_ = 0;
+        std::mutex ParkLock_;
+        std::condition_variable ParkCondVar_;
+
+        // Used only if queue size is limited
+        size_t MaxQueueSize_ = 0;
+        alignas(64) std::atomic<size_t> Queued_ = 0;
+        std::atomic<size_t> SpaceWaiters_ = 0;
+        std::mutex SpaceLock_;
+        std::condition_variable SpaceCondVar_;
+
+        static thread_local TWorker* CurrentWorker_;
+    };
+
+    thread_local TWorkStealingThreadPool::TImpl::TWorker* TWorkStealingThreadPool::TImpl::CurrentWorker_ = nullptr;
+
+    TWorkStealingThreadPool::TWorkStealingThreadPool(const TParams& params, const TWorkStealingThreadPoolParams& workStealingParams)
+        : Impl_(MakeHolder<TImpl>(this, params, workStealingParams))
+    {
+    }
+
+    TWorkStealingThreadPool::~TWorkStealingThreadPool() = default;
+
+    bool TWorkStealingThreadPool::Add(IObjectInQueue* obj) {
+        return Impl_->Add(obj);
+    }
+
+    void TWorkStealingThreadPool::Start(size_t threadCount, size_t queueSizeLimit) {
+        Impl_->Start(threadCount, queueSizeLimit);
+    }
+
+    void TWorkStealingThreadPool::Stop() noexcept {
+        Impl_->Stop();
+    }
+
+    size_t TWorkStealingThreadPool::Size() const noexcept {
+        return Impl_->Size();
+    }
+}
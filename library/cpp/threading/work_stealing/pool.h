@@ -0,0 +1,48 @@
+#pragma once
+
+#include <util/generic/ptr.h>
+#include <util/thread/pool.h>
+
+namespace NThreading {
+    struct TWorkStealingThreadPoolParams {
+        // Idle worker polls the queues this many times before it parks
+        size_t SpinIterations_ = 256;
+        // Pin i-th worker to i-th cpu (modulo number of cpus), linux only
+        bool PinThreads_ = false;
+
+        using TSelf = TWorkStealingThreadPoolParams;
+
+        TSelf& SetSpinIterations(size_t val) {
+            SpinIterations_ = val;
+            return *this;
+        }
+
+        TSelf& SetPinThreads(bool val) {
+            PinThreads_ = val;
+            return *this;
+        }
+    };
+
+    // Thread pool where every worker has its own Chase-Lev deque.
+    // Tasks added from a worker go to its deque without locks, tasks added from other threads
+    // are spread round robin over per-worker inboxes. Idle workers steal from the others,
+    // spin for a while and then park, so there is no single queue mutex shared by all threads.
+    // Tasks are not run in FIFO order.
+    class TWorkStealingThreadPool: public IThreadPool {
+    public:
+        TWorkStealingThreadPool(const TParams& params = {}, const TWorkStealingThreadPoolParams& workStealingParams = {});
+        ~TWorkStealingThreadPool() override;
+
+        // If the pool is started without threads, tasks are run in the calling thread
+        bool Add(IObjectInQueue* obj) override Y_WARN_UNUSED_RESULT;
+        // Queue size limit is checked approximately
+        void Start(size_t threadCount, size_t queueSizeLimit = 0) override;
+        // Runs all tasks which are already queued
+        void Stop() noexcept override;
+        size_t Size() const noexcept override;
+
+    private:
+        class TImpl;
+        THolder<TImpl> Impl_;
+    };
+}
@@ -0,0 +1,118 @@
+#include "pool.h"
+
+#include <library/cpp/testing/unittest/registar.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace NThreading {
+    namespace {
+        // Spawns two children until depth is exhausted
+        class TTreeTask: public IObjectInQueue {
+        public:
+            TTreeTask(IThreadPool& pool, std::atomic<size_t>& done, size_t depth)
+                : Pool_(pool)
+                , Done_(done)
+                , Depth_(depth)
+            {
+            }
+
+            void Process(void*) override {
+                if (Depth_) {
+                    for (size_t i = 0; i < 2; ++i) {
+                        Y_ABORT_UNLESS(Pool_.AddAndOwn(MakeHolder<TTreeTask>(Pool_, Done_, Depth_ - 1)));
+                    }
+                }
+                Done_.fetch_add(1);
+            }
+
+        private:
+            IThreadPool& Pool_;
+            std::atomic<size_t>& Done_;
+            const size_t Depth_;
+        };
+    }
+
+    Y_UNIT_TEST_SUITE(TWorkStealingThreadPoolTest) {
+        Y_UNIT_TEST(RunsTasksOfAllProducers) {
+            constexpr size_t producers = 4;
+            constexpr size_t tasksPerProducer = 10000;
+
+            // Producers wait while the queue is full
+            TWorkStealingThreadPool pool(TThreadPool::TParams().SetBlocking(true));
+            pool.Start(4, 100);
+
+            std::atomic<size_t> done = 0;
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < producers; ++i) {
+                threads.emplace_back([&] {
+                    for (size_t j = 0; j < tasksPerProducer; ++j) {
+                        UNIT_ASSERT(pool.AddFunc([&] {
+                            done.fetch_add(1);
+                        }));
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+
+            // Stop runs all queued tasks
+            pool.Stop();
+            UNIT_ASSERT_VALUES_EQUAL(done.load(), producers * tasksPerProducer);
+            UNIT_ASSERT(!pool.AddFunc([] {}));
+        }
+
+        Y_UNIT_TEST(TasksAddedFromWorkers) {
+            constexpr size_t depth = 12;
+
+            TWorkStealingThreadPool pool(TThreadPool::TParams(), TWorkStealingThreadPoolParams().SetSpinIterations(0));
+            pool.Start(3);
+
+            std::atomic<size_t> done = 0;
+            UNIT_ASSERT(pool.AddAndOwn(MakeHolder<TTreeTask>(pool, done, depth)));
+            while (done.load() != (size_t(2) << depth) - 1) {
+                std::this_thread::yield();
+            }
+            pool.Stop();
+        }
+
+        Y_UNIT_TEST(AddConcurrentWithStop) {
+            constexpr size_t producers = 4;
+            constexpr size_t rounds = 20;
+
+            for (size_t round = 0; round < rounds; ++round) {
+                TWorkStealingThreadPool pool(TThreadPool::TParams(), TWorkStealingThreadPoolParams().SetSpinIterations(0));
+                pool.Start(2);
+
+                std::atomic<size_t> added = 0;
+                std::atomic<size_t> done = 0;
+                std::vector<std::thread> threads;
+                for (size_t i = 0; i < producers; ++i) {
+                    // Producers add tasks until the pool rejects them
+                    threads.emplace_back([&] {
+                        while (pool.AddFunc([&] {
+                            done.fetch_add(1);
+                        })) {
+                            added.fetch_add(1);
+                        }
+                    });
+                }
+                while (added.load() < 1000) {
+                    std::this_thread::yield();
+                }
+
+                pool.Stop();
+                const size_t doneByStop = done.load();
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+
+                // Every accepted task is run by Stop, none of them is lost or run later
+                UNIT_ASSERT_VALUES_EQUAL(doneByStop, added.load());
+                UNIT_ASSERT_VALUES_EQUAL(done.load(), added.load());
+            }
+        }
+    }
+}
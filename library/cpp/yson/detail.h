@@ -1,6 +1,7 @@
 #pragma once
 
 #include "public.h"
+#include "scan.h"
 #include "zigzag.h"
 
 #include <util/generic/buffer.h>
@@ -74,13 +75,12 @@ namespace NYson {
 
             void OnRangeConsumed(const char* begin, const char* end) {
                 Offset += end - begin;
-                for (auto current = begin; current != end; ++current) {
-                    ++Column;
-                    if (*current == '\n') { //TODO: memchr
-                        ++Line;
-                        Column = 1;
-                    }
+                const char* lineBegin = begin;
+                while (auto newLine = static_cast<const char*>(memchr(lineBegin, '\n', end - lineBegin))) {
+                    ++Line;
+                    lineBegin = newLine + 1;
                 }
+                Column = (lineBegin == begin ? Column : 1) + (end - lineBegin);
             }
         };
 
@@ -396,28 +396,21 @@ namespace NYson {
 
             template <bool AllowFinish>
             ENumericResult ReadNumeric(std::string_view* value) {
-                Buffer_.clear();
+                *value = ReadRun<AllowFinish>(FindNumericEnd);
+
+                const char next = TBaseStream::template GetChar<AllowFinish>();
+                if (isalpha(next)) {
+                    ythrow TYsonException() << "Unexpected '" << next << "' in numeric literal";
+                }
+
                 ENumericResult result = ENumericResult::Int64;
-                while (true) {
-                    char ch = TBaseStream::template GetChar<AllowFinish>();
-                    if (isdigit(ch) || ch == '+' || ch == '-') { // Seems like it can't be '+' or '-'
-                        Buffer_.push_back(ch);
-                    } else if (ch == '.' || ch == 'e' || ch == 'E') {
-                        Buffer_.push_back(ch);
+                for (const char ch : *value) {
+                    if (ch == '.' || ch == 'e' || ch == 'E') {
                         result = ENumericResult::Double;
                     } else if (ch == 'u') {
-                        Buffer_.push_back(ch);
                         result = ENumericResult::Uint64;
-                    } else if (isalpha(ch)) {
-                        ythrow TYsonException() << "Unexpected '" << ch << "' in numeric literal";
-                    } else {
-                        break;
                     }
-                    CheckMemoryLimit();
-                    TBaseStream::Advance(1);
                 }
-
-                *value = std::string_view(Buffer_.data(), Buffer_.size());
                 return result;
             }
 
@@ -468,53 +461,81 @@ namespace NYson {
 
             void ReadQuotedString(std::string_view* value) {
                 Buffer_.clear();
+                bool escaped = false;
                 while (true) {
                     if (TBaseStream::IsEmpty()) {
                         TBaseStream::Refresh();
                     }
-                    char ch = *TBaseStream::Begin();
-                    TBaseStream::Advance(1);
-                    if (ch != '"') {
-                        Buffer_.push_back(ch);
-                    } else {
-                        // We must count the number of '\' at the end of StringValue
-                        // to check if it's not \"
-                        int slashCount = 0;
-                        int length = Buffer_.size();
-                        while (slashCount < length && Buffer_[length - 1 - slashCount] == '\\') {
-                            ++slashCount;
-                        }
-                        if (slashCount % 2 == 0) {
-                            break;
-                        } else {
-                            Buffer_.push_back(ch);
+                    const char* begin = TBaseStream::Begin();
+                    const char* end = TBaseStream::End();
+                    const char* pos = FindQuoteOrBackslash(begin, end);
+                    if (pos == end) {
+                        Buffer_.insert(Buffer_.end(), begin, end);
+                        CheckMemoryLimit();
+                        TBaseStream::Advance(end - begin);
+                    } else if (*pos == '\\') {
+                        // The escaped character is copied with the backslash, it may be a quote
+                        escaped = true;
+                        Buffer_.insert(Buffer_.end(), begin, pos + 1);
+                        TBaseStream::Advance(pos + 1 - begin);
+                        if (TBaseStream::IsEmpty()) {
+                            TBaseStream::Refresh();
                         }
+                        Buffer_.push_back(*TBaseStream::Begin());
+                        CheckMemoryLimit();
+                        TBaseStream::Advance(1);
+                    } else if (Buffer_.empty()) {
+                        // String without escapes inside of the block is not copied
+                        *value = std::string_view(begin, pos - begin);
+                        TBaseStream::Advance(pos + 1 - begin);
+                        return;
+                    } else {
+                        Buffer_.insert(Buffer_.end(), begin, pos);
+                        CheckMemoryLimit();
+                        TBaseStream::Advance(pos + 1 - begin);
+                        break;
                     }
-                    CheckMemoryLimit();
                 }
 
-                auto unquotedValue = UnescapeC(Buffer_.data(), Buffer_.size());
-                Buffer_.clear();
-                Buffer_.insert(Buffer_.end(), unquotedValue.data(), unquotedValue.data() + unquotedValue.size());
-                CheckMemoryLimit();
+                if (escaped) {
+                    auto unquotedValue = UnescapeC(Buffer_.data(), Buffer_.size());
+                    Buffer_.clear();
+                    Buffer_.insert(Buffer_.end(), unquotedValue.data(), unquotedValue.data() + unquotedValue.size());
+                    CheckMemoryLimit();
+                }
                 *value = std::string_view(Buffer_.data(), Buffer_.size());
             }
 
-            template <bool AllowFinish>
-            void ReadUnquotedString(std::string_view* value) {
+            //! Reads characters until find returns the end of their class. The result points to the input
+            //! if the run ends inside of the current block and to Buffer_ otherwise.
+            template <bool AllowFinish, class TFind>
+            std::string_view ReadRun(TFind find) {
                 Buffer_.clear();
                 while (true) {
-                    char ch = TBaseStream::template GetChar<AllowFinish>();
-                    if (isalpha(ch) || isdigit(ch) ||
-                        ch == '_' || ch == '-' || ch == '%' || ch == '.') {
-                        Buffer_.push_back(ch);
-                    } else {
-                        break;
+                    TBaseStream::template Refresh<AllowFinish>();
+                    const char* begin = TBaseStream::Begin();
+                    const char* end = TBaseStream::End();
+                    const char* pos = find(begin, end);
+                    if (Buffer_.empty() && (pos != end || TBaseStream::IsFinished())) {
+                        TBaseStream::Advance(pos - begin);
+                        if (pos == end) {
+                            // Throws on premature end of the stream, doesn't read more since it is finished
+                            TBaseStream::template Refresh<AllowFinish>();
+                        }
+                        return std::string_view(begin, pos - begin);
                     }
+                    Buffer_.insert(Buffer_.end(), begin, pos);
                     CheckMemoryLimit();
-                    TBaseStream::Advance(1);
+                    TBaseStream::Advance(pos - begin);
+                    if (pos != end || TBaseStream::IsFinished()) {
+                        return std::string_view(Buffer_.data(), Buffer_.size());
+                    }
                 }
-                *value = std::string_view(Buffer_.data(), Buffer_.size());
+            }
+
+            template <bool AllowFinish>
+            void ReadUnquotedString(std::string_view* value) {
+                *value = ReadRun<AllowFinish>(FindUnquotedStringEnd);
             }
 
             void ReadUnquotedString(std::string_view* value) {
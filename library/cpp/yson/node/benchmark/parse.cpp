@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include <library/cpp/yson/node/node_io.h>
+#include <library/cpp/yson/parser.h>
+#include <library/cpp/yson/writer.h>
+
+#include <util/stream/null.h>
+
+using namespace NYT;
+
+namespace {
+    // Rows like the ones of YT <-> YDB transfer: numbers, short and long strings, some of them quoted
+    TNode MakeRows(size_t count) {
+        TNode rows = TNode::CreateList();
+        for (size_t i = 0; i < count; ++i) {
+            rows.Add(TNode()
+                ("id", static_cast<ui64>(i))
+                ("delta", -static_cast<i64>(i))
+                ("score", i * 0.5)
+                ("flag", i % 2 == 0)
+                ("name", "user_" + ToString(i))
+                ("text", "some longer text value with spaces, \"quotes\" and numbers " + ToString(i)));
+        }
+        return rows;
+    }
+
+    class TNullConsumer: public ::NYson::TYsonConsumerBase {
+    public:
+        void OnStringScalar(std::string_view value) override {
+            benchmark::DoNotOptimize(value);
+        }
+        void OnInt64Scalar(i64 value) override {
+            benchmark::DoNotOptimize(value);
+        }
+        void OnUint64Scalar(ui64 value) override {
+            benchmark::DoNotOptimize(value);
+        }
+        void OnDoubleScalar(double value) override {
+            benchmark::DoNotOptimize(value);
+        }
+        void OnBooleanScalar(bool value) override {
+            benchmark::DoNotOptimize(value);
+        }
+        void OnEntity() override {
+        }
+        void OnBeginList() override {
+        }
+        void OnListItem() override {
+        }
+        void OnEndList() override {
+        }
+        void OnBeginMap() override {
+        }
+        void OnKeyedItem(std::string_view key) override {
+            benchmark::DoNotOptimize(key);
+        }
+        void OnEndMap() override {
+        }
+        void OnBeginAttributes() override {
+        }
+        void OnEndAttributes() override {
+        }
+    };
+}
+
+static void BM_Parse(benchmark::State& state, ::NYson::EYsonFormat format) {
+    const std::string yson = NodeToYsonString(MakeRows(state.range(0)), format);
+    TNullConsumer consumer;
+    for (auto _ : state) {
+        ::NYson::ParseYsonStringBuffer(yson, &consumer);
+    }
+    state.SetBytesProcessed(state.iterations() * yson.size());
+}
+
+static void BM_ParseToNode(benchmark::State& state, ::NYson::EYsonFormat format) {
+    const std::string yson = NodeToYsonString(MakeRows(state.range(0)), format);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(NodeFromYsonString(yson));
+    }
+    state.SetBytesProcessed(state.iterations() * yson.size());
+}
+
+static void BM_Write(benchmark::State& state, ::NYson::EYsonFormat format) {
+    const std::string yson = NodeToYsonString(MakeRows(state.range(0)), ::NYson::EYsonFormat::Binary);
+    for (auto _ : state) {
+        TNullOutput out;
+        ::NYson::TYsonWriter writer(&out, format);
+        ::NYson::ParseYsonStringBuffer(yson, &writer);
+    }
+    state.SetBytesProcessed(state.iterations() * yson.size());
+}
+
+BENCHMARK_CAPTURE(BM_Parse, text, ::NYson::EYsonFormat::Text)->Arg(1000);
+BENCHMARK_CAPTURE(BM_Parse, binary, ::NYson::EYsonFormat::Binary)->Arg(1000);
+BENCHMARK_CAPTURE(BM_ParseToNode, text, ::NYson::EYsonFormat::Text)->Arg(1000);
+BENCHMARK_CAPTURE(BM_ParseToNode, binary, ::NYson::EYsonFormat::Binary)->Arg(1000);
+BENCHMARK_CAPTURE(BM_Write, text, ::NYson::EYsonFormat::Text)->Arg(1000);
+BENCHMARK_CAPTURE(BM_Write, binary, ::NYson::EYsonFormat::Binary)->Arg(1000);
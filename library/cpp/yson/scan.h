@@ -0,0 +1,156 @@
+#pragma once
+
+#include <util/system/compiler.h>
+#include <util/system/platform.h>
+#include <util/system/types.h>
+
+#include <cstring>
+
+#if defined(_sse2_)
+#include <emmintrin.h>
+#endif
+
+namespace NYson {
+    namespace NDetail {
+        ////////////////////////////////////////////////////////////////////////////////
+
+        //! Helpers which find the end of a run of characters of one class.
+        //! Each returns the first character of [begin, end) outside of the class, or end.
+        //! With SSE2 the input is checked by 16 bytes, the tail is checked by the scalar predicate.
+
+        inline bool IsUnquotedStringChar(char ch) {
+            return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') ||
+                   ch == '_' || ch == '-' || ch == '%' || ch == '.';
+        }
+
+        inline bool IsNumericChar(char ch) {
+            return (ch >= '0' && ch <= '9') || ch == '+' || ch == '-' || ch == '.' || ch == 'e' || ch == 'E' || ch == 'u';
+        }
+
+        inline bool IsQuoteOrBackslash(char ch) {
+            return ch == '"' || ch == '\\';
+        }
+
+        //! Printable characters except quote and backslash are written to text YSON as is.
+        inline bool IsCharToEscape(char ch) {
+            return ch < 32 || ch > 126 || ch == '"' || ch == '\\';
+        }
+
+#if defined(_sse2_)
+        //! Mask of bytes in [lo, hi], bytes above 127 are negative and never match.
+        Y_FORCE_INLINE __m128i InRange(__m128i chars, char lo, char hi) {
+            return _mm_and_si128(
+                _mm_cmpgt_epi8(chars, _mm_set1_epi8(lo - 1)),
+                _mm_cmplt_epi8(chars, _mm_set1_epi8(hi + 1)));
+        }
+
+        Y_FORCE_INLINE __m128i Equals(__m128i chars, char ch) {
+            return _mm_cmpeq_epi8(chars, _mm_set1_epi8(ch));
+        }
+
+        //! TMatch returns the mask of bytes which end the run.
+        template <class TMatch, class TPredicate>
+        Y_FORCE_INLINE const char* FindFirst(const char* begin, const char* end, TMatch match, TPredicate predicate) {
+            while (end - begin >= 16) {
+                const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+                const int mask = _mm_movemask_epi8(match(chars));
+                if (mask) {
+                    return begin + __builtin_ctz(mask);
+                }
+                begin += 16;
+            }
+            while (begin != end && !predicate(*begin)) {
+                ++begin;
+            }
+            return begin;
+        }
+#else
+        template <class TMatch, class TPredicate>
+        Y_FORCE_INLINE const char* FindFirst(const char* begin, const char* end, TMatch, TPredicate predicate) {
+            while (begin != end && !predicate(*begin)) {
+                ++begin;
+            }
+            return begin;
+        }
+#endif
+
+        inline const char* FindUnquotedStringEnd(const char* begin, const char* end) {
+            return FindFirst(
+                begin,
+                end,
+                [](auto chars) {
+#if defined(_sse2_)
+                    const __m128i letters = InRange(_mm_or_si128(chars, _mm_set1_epi8(0x20)), 'a', 'z');
+                    const __m128i digits = InRange(chars, '0', '9');
+                    const __m128i others = _mm_or_si128(
+                        _mm_or_si128(Equals(chars, '_'), Equals(chars, '-')),
+                        _mm_or_si128(Equals(chars, '%'), Equals(chars, '.')));
+                    return _mm_xor_si128(_mm_or_si128(_mm_or_si128(letters, digits), others), _mm_set1_epi8(-1));
+#else
+                    return chars;
+#endif
+                },
+                [](char ch) {
+                    return !IsUnquotedStringChar(ch);
+                });
+        }
+
+        inline const char* FindNumericEnd(const char* begin, const char* end) {
+            return FindFirst(
+                begin,
+                end,
+                [](auto chars) {
+#if defined(_sse2_)
+                    const __m128i digits = InRange(chars, '0', '9');
+                    const __m128i others = _mm_or_si128(
+                        _mm_or_si128(
+                            _mm_or_si128(Equals(chars, '+'), Equals(chars, '-')),
+                            _mm_or_si128(Equals(chars, '.'), Equals(chars, 'u'))),
+                        _mm_or_si128(Equals(chars, 'e'), Equals(chars, 'E')));
+                    return _mm_xor_si128(_mm_or_si128(digits, others), _mm_set1_epi8(-1));
+#else
+                    return chars;
+#endif
+                },
+                [](char ch) {
+                    return !IsNumericChar(ch);
+                });
+        }
+
+        inline const char* FindQuoteOrBackslash(const char* begin, const char* end) {
+            return FindFirst(
+                begin,
+                end,
+                [](auto chars) {
+#if defined(_sse2_)
+                    return _mm_or_si128(Equals(chars, '"'), Equals(chars, '\\'));
+#else
+                    return chars;
+#endif
+                },
+                IsQuoteOrBackslash);
+        }
+
+        inline const char* FindCharToEscape(const char* begin, const char* end) {
+            return FindFirst(
+                begin,
+                end,
+                [](auto chars) {
+#if defined(_sse2_)
+                    const __m128i printable = InRange(chars, 32, 126);
+                    return _mm_or_si128(
+                        _mm_xor_si128(printable, _mm_set1_epi8(-1)),
+                        _mm_or_si128(Equals(chars, '"'), Equals(chars, '\\')));
+#else
+                    return chars;
+#endif
+                },
+                [](char ch) {
+                    return IsCharToEscape(ch);
+                });
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////
+
+    }
+}
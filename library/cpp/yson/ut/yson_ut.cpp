@@ -4,6 +4,7 @@
 #include <library/cpp/testing/gtest/gtest.h>
 
 #include <util/stream/mem.h>
+#include <util/stream/str.h>
 
 using namespace NYson;
 
@@ -19,3 +20,55 @@ TEST(TTestYson, YT_17658)
         EXPECT_THROW(ParseYsonStringBuffer(data, &writer), std::exception);
     }
 }
+
+namespace {
+
+// Returns at most Step bytes per read, so tokens are split between blocks of the lexer
+class TChunkedInput
+    : public IInputStream
+{
+public:
+    TChunkedInput(std::string_view data, size_t step)
+        : Data_(data)
+        , Step_(step)
+    { }
+
+private:
+    size_t DoRead(void* buf, size_t len) override
+    {
+        len = std::min({len, Step_, Data_.size()});
+        memcpy(buf, Data_.data(), len);
+        Data_.remove_prefix(len);
+        return len;
+    }
+
+    std::string_view Data_;
+    const size_t Step_;
+};
+
+std::string Reformat(std::string_view yson, size_t step)
+{
+    TStringStream out;
+    TYsonWriter writer(&out, EYsonFormat::Text);
+    TChunkedInput input(yson, step);
+    TYsonParser parser(&writer, &input);
+    parser.Parse();
+    return out.Str();
+}
+
+} // namespace
+
+TEST(TTestYson, Scanning)
+{
+    const std::string data = R"({"long key without escapes" = "a \"quoted\" \\ string\n\x01"; key_2 = [-12; 34u; 5.5e1; %true; unquoted_string.x-y%];)"
+        R"( "" = ""; _ = "0123456789abcdefghijklmnopqrstuvwxyz0123456789"})";
+    const std::string expected = R"({"long key without escapes"="a \"quoted\" \\ string\n\1";"key_2"=[-12;34u;55.;%true;"unquoted_string.x-y%"];)"
+        R"(""="";"_"="0123456789abcdefghijklmnopqrstuvwxyz0123456789"})";
+
+    for (size_t step : {1, 2, 3, 7, 16, 1000}) {
+        EXPECT_EQ(Reformat(data, step), expected) << "step " << step;
+    }
+
+    EXPECT_THROW(Reformat("12a", 1000), std::exception);
+    EXPECT_THROW(Reformat("\"unterminated", 1), std::exception);
+}
@@ -91,22 +91,18 @@ namespace NYson {
         void EscapeC(const char* str, size_t len, IOutputStream& output) {
             char buffer[ESCAPE_C_BUFFER_SIZE];
 
-            size_t i, j;
-            for (i = 0, j = 0; i < len; ++i) {
-                size_t rlen = EscapeC(str[i], (i + 1 < len ? str[i + 1] : 0), buffer);
-
-                if (rlen > 1) {
-                    output.Write(str + j, i - j);
-                    j = i + 1;
-                    output.Write(buffer, rlen);
-                }
+            const char* end = str + len;
+            const char* written = str;
+            // Runs of characters which go as-is are skipped by SIMD scan and written at once
+            for (const char* ch = NDetail::FindCharToEscape(str, end); ch != end; ch = NDetail::FindCharToEscape(ch + 1, end)) {
+                size_t rlen = EscapeC(*ch, (ch + 1 < end ? ch[1] : 0), buffer);
+
+                output.Write(written, ch - written);
+                written = ch + 1;
+                output.Write(buffer, rlen);
             }
 
-            if (j > 0) {
-                output.Write(str + j, len - j);
-            } else {
-                output.Write(str, len);
-            }
+            output.Write(written, end - written);
         }
 
         std::string FloatToStringWithNanInf(double value) {
@@ -224,7 +220,8 @@ namespace NYson {
             Stream->Write(NDetail::Int64Marker);
             WriteVarInt64(Stream, value);
         } else {
-            Stream->Write(::ToString(value));
+            char buf[32];
+            Stream->Write(buf, ::ToString(value, buf, sizeof(buf)));
         }
         EndNode();
     }
@@ -234,8 +231,10 @@ namespace NYson {
             Stream->Write(NDetail::Uint64Marker);
             WriteVarUInt64(Stream, value);
         } else {
-            Stream->Write(::ToString(value));
-            Stream->Write("u");
+            char buf[32];
+            const size_t len = ::ToString(value, buf, sizeof(buf));
+            buf[len] = 'u';
+            Stream->Write(buf, len + 1);
         }
         EndNode();
     }
@@ -101,55 +101,108 @@ void EnableGRpcTracing() {
 //         &TGRpcKeepAliveSocketMutator::Mutate2
 //     };
 
-TChannelPool::TChannelPool(const TTcpKeepAliveSettings& tcpKeepAliveSettings, const TDuration& expireTime)
+TChannelPool::TChannelPool(const TTcpKeepAliveSettings& tcpKeepAliveSettings, const TDuration& expireTime,
+        const TChannelPoolSettings& settings)
     : TcpKeepAliveSettings_(tcpKeepAliveSettings)
     , ExpireTime_(expireTime)
     , UpdateReUseTime_(ExpireTime_ * 0.3 < TDuration::Seconds(20) ? ExpireTime_ * 0.3 : TDuration::Seconds(20))
-{}
+    , Settings_(settings)
+{
+    Settings_.UnaryChannelsPerEndpoint = std::max<ui32>(Settings_.UnaryChannelsPerEndpoint, 1);
+}
+
+TChannelPool::TSubChannels& TChannelPool::GetSubChannels(TEndpointChannels& channels, EChannelType channelType) const {
+    if (channelType == EChannelType::Streaming && Settings_.StreamingChannelsPerEndpoint) {
+        return channels.Streaming;
+    }
+    return channels.Unary;
+}
+
+ui32 TChannelPool::GetSubChannelsLimit(EChannelType channelType) const {
+    if (channelType == EChannelType::Streaming && Settings_.StreamingChannelsPerEndpoint) {
+        return Settings_.StreamingChannelsPerEndpoint;
+    }
+    return Settings_.UnaryChannelsPerEndpoint;
+}
+
+TStubsHolder* TChannelPool::FindLeastLoaded(const TSubChannels& subChannels) {
+    TStubsHolder* result = nullptr;
+    i64 minLoad = 0;
+    for (const auto& holder : subChannels) {
+        if (holder->IsChannelBroken()) {
+            continue;
+        }
+        const i64 load = holder->GetLoad();
+        if (!result || load < minLoad) {
+            result = holder.get();
+            minLoad = load;
+            if (minLoad == 0) {
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+std::shared_ptr<grpc::ChannelInterface> TChannelPool::CreateSubChannel(const TGRpcClientConfig& config) const {
+    if (Settings_.UnaryChannelsPerEndpoint == 1 && Settings_.StreamingChannelsPerEndpoint == 0) {
+        return CreateChannelInterface(config, nullptr);
+    }
+    // grpc shares subchannels (and so tcp connections) between channels with equal arguments,
+    // local subchannel pool makes each channel to open its own connection
+    auto subChannelConfig = config;
+    subChannelConfig.IntChannelParams[GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL] = 1;
+    return CreateChannelInterface(subChannelConfig, nullptr);
+}
 
 void TChannelPool::GetStubsHolderLocked(
     const std::string& channelId,
     const TGRpcClientConfig& config,
-    std::function<void(TStubsHolder&)> cb)
+    std::function<void(TStubsHolder&)> cb,
+    EChannelType channelType)
 {
+    const ui32 limit = GetSubChannelsLimit(channelType);
     {
         std::shared_lock readGuard(RWMutex_);
         const auto it = Pool_.find(channelId);
-        if (it != Pool_.end()) {
-            if (!it->second.IsChannelBroken() && !(Now() > it->second.GetLastUseTime() + UpdateReUseTime_)) {
-                return cb(it->second);
+        if (it != Pool_.end() && !(Now() > it->second.LastUsed + UpdateReUseTime_)) {
+            const auto& subChannels = GetSubChannels(it->second, channelType);
+            auto holder = FindLeastLoaded(subChannels);
+            if (holder && (holder->GetLoad() == 0 || subChannels.size() >= limit)) {
+                return cb(*holder);
             }
         }
     }
     {
         std::unique_lock writeGuard(RWMutex_);
-        {
-            auto it = Pool_.find(channelId);
-            if (it != Pool_.end()) {
-                if (!it->second.IsChannelBroken()) {
-                    EraseFromQueueByTime(it->second.GetLastUseTime(), channelId);
-                    auto now = Now();
-                    LastUsedQueue_.emplace(now, channelId);
-                    it->second.SetLastUseTime(now);
-                    return cb(it->second);
-                } else {
-                    // This channel can't be used. Remove from pool to create new one
-                    EraseFromQueueByTime(it->second.GetLastUseTime(), channelId);
-                    Pool_.erase(it);
-                }
-            }
+        auto [it, inserted] = Pool_.try_emplace(channelId);
+        if (!inserted) {
+            EraseFromQueueByTime(it->second.LastUsed, channelId);
+        }
+        const auto now = Now();
+        it->second.LastUsed = now;
+        LastUsedQueue_.emplace(now, channelId);
+
+        auto& subChannels = GetSubChannels(it->second, channelType);
+        // Broken channels can't be used. Remove them from pool to create new ones
+        std::erase_if(subChannels, [](const auto& holder) {
+            return holder->IsChannelBroken();
+        });
+
+        auto holder = FindLeastLoaded(subChannels);
+        if (!holder || (holder->GetLoad() > 0 && subChannels.size() < limit)) {
+            // TGRpcKeepAliveSocketMutator* mutator = nullptr;
+            // // will be destroyed inside grpc
+            // if (TcpKeepAliveSettings_.Enabled) {
+            //     mutator = new TGRpcKeepAliveSocketMutator(
+            //         TcpKeepAliveSettings_.Idle,
+            //         TcpKeepAliveSettings_.Count,
+            //         TcpKeepAliveSettings_.Interval
+            //     );
+            // }
+            holder = subChannels.emplace_back(std::make_unique<TStubsHolder>(CreateSubChannel(config))).get();
         }
-        // TGRpcKeepAliveSocketMutator* mutator = nullptr;
-        // // will be destroyed inside grpc
-        // if (TcpKeepAliveSettings_.Enabled) {
-        //     mutator = new TGRpcKeepAliveSocketMutator(
-        //         TcpKeepAliveSettings_.Idle,
-        //         TcpKeepAliveSettings_.Count,
-        //         TcpKeepAliveSettings_.Interval
-        //     );
-        // }
-        cb(Pool_.emplace(channelId, CreateChannelInterface(config, nullptr)).first->second);
-        LastUsedQueue_.emplace(Pool_.at(channelId).GetLastUseTime(), channelId);
+        cb(*holder);
     }
 }
 
@@ -157,7 +210,7 @@ void TChannelPool::DeleteChannel(const std::string& channelId) {
     std::unique_lock writeLock(RWMutex_);
     auto poolIt = Pool_.find(channelId);
     if (poolIt != Pool_.end()) {
-        EraseFromQueueByTime(poolIt->second.GetLastUseTime(), channelId);
+        EraseFromQueueByTime(poolIt->second.LastUsed, channelId);
         Pool_.erase(poolIt);
     }
 }
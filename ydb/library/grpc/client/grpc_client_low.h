@@ -1,6 +1,7 @@
 #pragma once
 
 #include "grpc_common.h"
+#include "request_arena.h"
 
 #include <library/cpp/deprecated/atomic/atomic.h>
 #include <util/string/builder.h>
@@ -11,8 +12,10 @@
 #include <grpc++/support/async_stream.h>
 #include <grpc++/support/async_unary_call.h>
 
+#include <atomic>
 #include <deque>
 #include <condition_variable>
+#include <memory>
 #include <typeindex>
 #include <typeinfo>
 #include <variant>
@@ -195,6 +198,10 @@ using TResponseCallback = std::function<void (TGrpcStatus&&, TResponse&&)>;
 template<typename TResponse>
 using TAdvancedResponseCallback = std::function<void (const grpc::ClientContext&, TGrpcStatus&&, TResponse&&)>;
 
+// Response is parsed into the arena of the request, the callback takes ownership of it
+template<typename TResponse>
+using TArenaResponseCallback = TAdvancedResponseCallback<TArenaMessage<TResponse>>;
+
 // Call associated metadata
 struct TCallMeta {
     std::shared_ptr<grpc::CallCredentials> CallCredentials;
@@ -202,6 +209,51 @@ struct TCallMeta {
     std::variant<TDuration, TInstant> Timeout; // timeout as duration from now or time point in future
 };
 
+// Counts requests and streams running on a channel.
+// Guard is owned by request processor, so the channel is considered loaded
+// until the unary request is finished or the stream is destroyed
+class TChannelLoadGuard {
+public:
+    using TCounter = std::atomic<i64>;
+
+    TChannelLoadGuard() = default;
+
+    explicit TChannelLoadGuard(std::shared_ptr<TCounter> counter)
+        : Counter_(std::move(counter))
+    {
+        if (Counter_) {
+            Counter_->fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    TChannelLoadGuard(const TChannelLoadGuard&) = delete;
+    TChannelLoadGuard& operator=(const TChannelLoadGuard&) = delete;
+
+    TChannelLoadGuard(TChannelLoadGuard&& other) noexcept = default;
+
+    TChannelLoadGuard& operator=(TChannelLoadGuard&& other) noexcept {
+        if (this != &other) {
+            Release();
+            Counter_ = std::move(other.Counter_);
+        }
+        return *this;
+    }
+
+    ~TChannelLoadGuard() {
+        Release();
+    }
+
+private:
+    void Release() {
+        if (Counter_) {
+            Counter_->fetch_sub(1, std::memory_order_relaxed);
+            Counter_.reset();
+        }
+    }
+
+    std::shared_ptr<TCounter> Counter_;
+};
+
 class TGRpcRequestProcessorCommon {
 protected:
     void ApplyMeta(const TCallMeta& meta) {
@@ -237,6 +289,7 @@ protected:
     grpc::Status Status;
     grpc::ClientContext Context;
     std::shared_ptr<IQueueClientContext> LocalContext;
+    TChannelLoadGuard ChannelLoad;
 };
 
 template<typename TStub, typename TRequest, typename TResponse>
@@ -319,20 +372,26 @@ private:
     bool Replied_ = false;
 };
 
-template<typename TStub, typename TRequest, typename TResponse>
+// Reply is stored either as TResponse or as TArenaMessage<TResponse>
+template<typename TStub, typename TRequest, typename TResponse, typename TReply = TResponse>
 class TAdvancedRequestProcessor
     : public TThrRefBase
     , public IQueueClientEvent
     , public TGRpcRequestProcessorCommon {
     using TAsyncReaderPtr = std::unique_ptr<grpc::ClientAsyncResponseReader<TResponse>>;
     template<typename> friend class TServiceConnection;
+    static constexpr bool InArena = !std::is_same_v<TReply, TResponse>;
 public:
     using TPtr = TIntrusivePtr<TAdvancedRequestProcessor>;
     using TAsyncRequest = TAsyncReaderPtr (TStub::*)(grpc::ClientContext*, const TRequest&, grpc::CompletionQueue*);
 
-    explicit TAdvancedRequestProcessor(TAdvancedResponseCallback<TResponse>&& callback)
+    explicit TAdvancedRequestProcessor(TAdvancedResponseCallback<TReply>&& callback)
         : Callback_(std::move(callback))
-    { }
+    {
+        if constexpr (InArena) {
+            Reply_ = TReply(MakeIntrusive<TRequestArena>());
+        }
+    }
 
     ~TAdvancedRequestProcessor() {
         if (!Replied_ && Callback_) {
@@ -380,7 +439,11 @@ private:
             std::unique_lock<std::mutex> guard(Mutex_);
             LocalContext = context;
             Reader_ = (stub.*asyncRequest)(&Context, request, context->CompletionQueue());
-            Reader_->Finish(&Reply_, &Status, FinishedEvent());
+            if constexpr (InArena) {
+                Reader_->Finish(Reply_.Get(), &Status, FinishedEvent());
+            } else {
+                Reader_->Finish(&Reply_, &Status, FinishedEvent());
+            }
         }
         context->SubscribeStop([self = TPtr(this)] {
             self->Stop();
@@ -391,14 +454,18 @@ private:
         Context.TryCancel();
     }
 
-    TAdvancedResponseCallback<TResponse> Callback_;
-    TResponse Reply_;
+    TAdvancedResponseCallback<TReply> Callback_;
+    TReply Reply_;
     std::mutex Mutex_;
     TAsyncReaderPtr Reader_;
 
     bool Replied_ = false;
 };
 
+// Reply parsed into the arena of the request, which is owned by the reply and outlives the processor
+template<typename TStub, typename TRequest, typename TResponse>
+using TArenaRequestProcessor = TAdvancedRequestProcessor<TStub, TRequest, TResponse, TArenaMessage<TResponse>>;
+
 class IStreamRequestCtrl : public TThrRefBase {
 public:
     using TPtr = TIntrusivePtr<IStreamRequestCtrl>;
@@ -475,6 +542,7 @@ class TStubsHolder : public TNonCopyable {
 public:
     TStubsHolder(std::shared_ptr<grpc::ChannelInterface> channel)
         : ChannelInterface_(channel)
+        , Load_(std::make_shared<TChannelLoadGuard::TCounter>(0))
     {}
 
     // Returns true if channel can't be used to perform request now
@@ -506,35 +574,69 @@ public:
         }
     }
 
-    const TInstant& GetLastUseTime() const {
-        return LastUsed_;
+    // Number of requests and streams currently running on the channel
+    i64 GetLoad() const {
+        return Load_->load(std::memory_order_relaxed);
     }
 
-    void SetLastUseTime(const TInstant& time) {
-        LastUsed_ = time;
+    const std::shared_ptr<TChannelLoadGuard::TCounter>& GetLoadCounter() const {
+        return Load_;
     }
 private:
-    TInstant LastUsed_ = Now();
     std::shared_mutex RWMutex_;
     std::unordered_map<TypeInfoRef, std::shared_ptr<void>, THasher, TEqualTo> Stubs_;
     std::shared_ptr<grpc::ChannelInterface> ChannelInterface_;
+    std::shared_ptr<TChannelLoadGuard::TCounter> Load_;
+};
+
+enum class EChannelType {
+    Unary,
+    Streaming
+};
+
+struct TChannelPoolSettings {
+    // Max number of channels (HTTP/2 connections) per endpoint for unary requests
+    ui32 UnaryChannelsPerEndpoint = 1;
+    // Max number of channels per endpoint for long-lived streams,
+    // 0 means that streams share channels with unary requests
+    ui32 StreamingChannelsPerEndpoint = 0;
 };
 
+// Pool of channels keyed by endpoint.
+// Each endpoint may have several channels, new channel is created only if all existing
+// channels are busy and the limit is not reached, otherwise the least loaded one is used.
+// Streams may be placed to separate channels to not delay unary requests.
 class TChannelPool {
 public:
-    TChannelPool(const TTcpKeepAliveSettings& tcpKeepAliveSettings, const TDuration& expireTime = TDuration::Minutes(6));
+    TChannelPool(const TTcpKeepAliveSettings& tcpKeepAliveSettings, const TDuration& expireTime = TDuration::Minutes(6),
+        const TChannelPoolSettings& settings = {});
     //Allows to CreateStub from TStubsHolder under lock
     //The callback will be called just during GetStubsHolderLocked call
-    void GetStubsHolderLocked(const std::string& channelId, const TGRpcClientConfig& config, std::function<void(TStubsHolder&)> cb);
+    void GetStubsHolderLocked(const std::string& channelId, const TGRpcClientConfig& config, std::function<void(TStubsHolder&)> cb,
+        EChannelType channelType = EChannelType::Unary);
     void DeleteChannel(const std::string& channelId);
     void DeleteExpiredStubsHolders();
 private:
+    using TSubChannels = std::vector<std::unique_ptr<TStubsHolder>>;
+
+    struct TEndpointChannels {
+        TSubChannels Unary;
+        TSubChannels Streaming;
+        TInstant LastUsed = Now();
+    };
+
+    TSubChannels& GetSubChannels(TEndpointChannels& channels, EChannelType channelType) const;
+    ui32 GetSubChannelsLimit(EChannelType channelType) const;
+    static TStubsHolder* FindLeastLoaded(const TSubChannels& subChannels);
+    std::shared_ptr<grpc::ChannelInterface> CreateSubChannel(const TGRpcClientConfig& config) const;
+
     std::shared_mutex RWMutex_;
-    std::unordered_map<std::string, TStubsHolder> Pool_;
+    std::unordered_map<std::string, TEndpointChannels> Pool_;
     std::multimap<TInstant, std::string> LastUsedQueue_;
     TTcpKeepAliveSettings TcpKeepAliveSettings_;
     TDuration ExpireTime_;
     TDuration UpdateReUseTime_;
+    TChannelPoolSettings Settings_;
     void EraseFromQueueByTime(const TInstant& lastUseTime, const std::string& channelId);
 };
 
@@ -1280,6 +1382,7 @@ public:
     {
         auto processor = MakeIntrusive<TSimpleRequestProcessor<TStub, TRequest, TResponse>>(std::move(callback));
         processor->ApplyMeta(metas);
+        processor->ChannelLoad = TChannelLoadGuard(Load_);
         processor->Start(*Stub_, asyncRequest, request, provider ? provider : Provider_);
     }
 
@@ -1295,6 +1398,23 @@ public:
     {
         auto processor = MakeIntrusive<TAdvancedRequestProcessor<TStub, TRequest, TResponse>>(std::move(callback));
         processor->ApplyMeta(metas);
+        processor->ChannelLoad = TChannelLoadGuard(Load_);
+        processor->Start(*Stub_, asyncRequest, request, provider ? provider : Provider_);
+    }
+
+    /*
+     * Start simple request, response is parsed into the arena of the request
+     */
+    template<typename TRequest, typename TResponse>
+    void DoArenaRequest(const TRequest& request,
+                        TArenaResponseCallback<TResponse> callback,
+                        typename TArenaRequestProcessor<TStub, TRequest, TResponse>::TAsyncRequest asyncRequest,
+                        const TCallMeta& metas = { },
+                        IQueueClientContextProvider* provider = nullptr)
+    {
+        auto processor = MakeIntrusive<TArenaRequestProcessor<TStub, TRequest, TResponse>>(std::move(callback));
+        processor->ApplyMeta(metas);
+        processor->ChannelLoad = TChannelLoadGuard(Load_);
         processor->Start(*Stub_, asyncRequest, request, provider ? provider : Provider_);
     }
 
@@ -1309,6 +1429,7 @@ public:
     {
         auto processor = MakeIntrusive<TStreamRequestReadWriteProcessor<TStub, TRequest, TResponse>>(std::move(callback));
         processor->ApplyMeta(metas);
+        processor->ChannelLoad = TChannelLoadGuard(Load_);
         processor->Start(*Stub_, std::move(asyncRequest), provider ? provider : Provider_);
     }
 
@@ -1324,6 +1445,7 @@ public:
     {
         auto processor = MakeIntrusive<TStreamRequestReadProcessor<TStub, TRequest, TResponse>>(std::move(callback));
         processor->ApplyMeta(metas);
+        processor->ChannelLoad = TChannelLoadGuard(Load_);
         processor->Start(*Stub_, request, std::move(asyncRequest), provider ? provider : Provider_);
     }
 
@@ -1340,12 +1462,14 @@ private:
                        IQueueClientContextProvider* provider)
         : Stub_(holder.GetOrCreateStub<TStub>())
         , Provider_(provider)
+        , Load_(holder.GetLoadCounter())
     {
         Y_ABORT_UNLESS(Provider_, "Connection does not have a queue provider");
     }
 
     std::shared_ptr<TStub> Stub_;
     IQueueClientContextProvider* Provider_;
+    std::shared_ptr<TChannelLoadGuard::TCounter> Load_;
 };
 
 class TGRpcClientLow
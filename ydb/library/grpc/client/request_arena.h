@@ -0,0 +1,88 @@
+#pragma once
+
+#include <util/generic/ptr.h>
+
+#include <google/protobuf/arena.h>
+
+#include <cstddef>
+
+namespace NYdbGrpc {
+
+// Memory owned by a single unary request.
+// Messages created in the arena and everything parsed into them (nested messages, strings,
+// repeated fields) are freed in one shot together with the arena.
+// The first segment is a part of the object, so a small response is parsed without mallocs,
+// larger ones take more segments from the heap, each next one twice as large as the previous.
+class TRequestArena : public TThrRefBase {
+public:
+    static constexpr size_t InitialSegmentSize = 4096;
+    static constexpr size_t MaxSegmentSize = 64 << 10;
+
+    TRequestArena()
+        : Arena_(MakeOptions(InitialSegment_))
+    { }
+
+    template<class TMessage>
+    TMessage* Create() {
+        return google::protobuf::Arena::CreateMessage<TMessage>(&Arena_);
+    }
+
+    google::protobuf::Arena* Get() {
+        return &Arena_;
+    }
+
+    // Bytes taken from the segments, including the inline one
+    size_t SpaceUsed() const {
+        return Arena_.SpaceUsed();
+    }
+
+private:
+    static google::protobuf::ArenaOptions MakeOptions(char* initialSegment) {
+        google::protobuf::ArenaOptions options;
+        options.initial_block = initialSegment;
+        options.initial_block_size = InitialSegmentSize;
+        options.start_block_size = InitialSegmentSize;
+        options.max_block_size = MaxSegmentSize;
+        return options;
+    }
+
+    // Declared before the arena, the arena never frees it
+    alignas(std::max_align_t) char InitialSegment_[InitialSegmentSize];
+    google::protobuf::Arena Arena_;
+};
+
+using TRequestArenaPtr = TIntrusivePtr<TRequestArena>;
+
+// Message living in a request arena, keeps the arena alive
+template<class TMessage>
+class TArenaMessage {
+public:
+    TArenaMessage() = default;
+
+    explicit TArenaMessage(TRequestArenaPtr arena)
+        : Arena_(std::move(arena))
+        , Message_(Arena_->Create<TMessage>())
+    { }
+
+    TMessage* Get() const {
+        return Message_;
+    }
+
+    TMessage* operator->() const {
+        return Message_;
+    }
+
+    TMessage& operator*() const {
+        return *Message_;
+    }
+
+    const TRequestArenaPtr& Arena() const {
+        return Arena_;
+    }
+
+private:
+    TRequestArenaPtr Arena_;
+    TMessage* Message_ = nullptr;
+};
+
+} // namespace NYdbGrpc
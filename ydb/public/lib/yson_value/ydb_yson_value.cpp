@@ -5,11 +5,28 @@
 #include <client/ydb_value/value.h>
 #include <client/ydb_result/result.h>
 
+#include <library/cpp/yson/tokenizer.h>
+
+#include <ydb/public/api/protos/ydb_value.pb.h>
+
 #include <util/string/builder.h>
 
+#include <utility>
+
 namespace NYdb {
 
-static void PrimitiveValueToYson(EPrimitiveType type, TValueParser& parser, NYson::TYsonWriter& writer)
+namespace {
+
+// Calls through the final class are not virtual, the writer is inlined into formatting of values
+class TFinalYsonWriter final : public NYson::TYsonWriter {
+public:
+    using TYsonWriter::TYsonWriter;
+};
+
+} // namespace
+
+template <typename TWriter>
+static void PrimitiveValueToYson(EPrimitiveType type, TValueParser& parser, TWriter& writer)
 {
     switch (type) {
         case EPrimitiveType::Bool:
@@ -92,7 +109,8 @@ static void PrimitiveValueToYson(EPrimitiveType type, TValueParser& parser, NYso
     }
 }
 
-static void FormatValueYsonInternal(TValueParser& parser, NYson::TYsonWriter& writer)
+template <typename TWriter>
+static void FormatValueYsonInternal(TValueParser& parser, TWriter& writer)
 {
     switch (parser.GetKind()) {
         case TTypeParser::ETypeKind::Primitive:
@@ -227,14 +245,16 @@ void FormatValueYson(const TValue& value, NYson::TYsonWriter& writer)
 std::string FormatValueYson(const TValue& value, NYson::EYsonFormat ysonFormat)
 {
     TStringStream out;
-    NYson::TYsonWriter writer(&out, ysonFormat, ::NYson::EYsonType::Node, true);
+    TFinalYsonWriter writer(&out, ysonFormat, ::NYson::EYsonType::Node, true);
 
-    FormatValueYson(value, writer);
+    TValueParser parser(value);
+    FormatValueYsonInternal(parser, writer);
 
     return out.Str();
 }
 
-void FormatResultSetYson(const TResultSet& result, NYson::TYsonWriter& writer)
+template <typename TWriter>
+static void FormatResultSetYsonInternal(const TResultSet& result, TWriter& writer)
 {
     auto columns = result.GetColumnsMeta();
 
@@ -254,14 +274,342 @@ void FormatResultSetYson(const TResultSet& result, NYson::TYsonWriter& writer)
     writer.OnEndList();
 }
 
+void FormatResultSetYson(const TResultSet& result, NYson::TYsonWriter& writer)
+{
+    FormatResultSetYsonInternal(result, writer);
+}
+
 std::string FormatResultSetYson(const TResultSet& result, NYson::EYsonFormat ysonFormat)
 {
     TStringStream out;
-    NYson::TYsonWriter writer(&out, ysonFormat, ::NYson::EYsonType::Node, true);
+    TFinalYsonWriter writer(&out, ysonFormat, ::NYson::EYsonType::Node, true);
 
-    FormatResultSetYson(result, writer);
+    FormatResultSetYsonInternal(result, writer);
 
     return out.Str();
 }
 
+namespace {
+
+// Reads YSON written by FormatValueYson straight into the value protobuf, guided by the type.
+// Strings are taken from the input without copies until they are put into the protobuf.
+class TYsonValueReader {
+public:
+    explicit TYsonValueReader(std::string_view yson)
+        : Tokenizer_(yson)
+    {
+        Next();
+    }
+
+    void Read(const Ydb::Type& type, Ydb::Value& value, ui32 optionalDepth = 0) {
+        switch (type.type_case()) {
+            case Ydb::Type::kTypeId:
+                ReadPrimitive(type.type_id(), value);
+                break;
+
+            case Ydb::Type::kDecimalType:
+                ReadString([&](std::string_view str) {
+                    TDecimalValue decimal(std::string(str), type.decimal_type().precision(), type.decimal_type().scale());
+                    value.set_low_128(decimal.Low_);
+                    value.set_high_128(decimal.Hi_);
+                });
+                break;
+
+            case Ydb::Type::kOptionalType:
+                if (Type() == NYson::ETokenType::Hash) {
+                    Next();
+                    // Null of a nested optional is wrapped once per enclosing optional, like TValueBuilder does
+                    Ydb::Value* null = &value;
+                    for (ui32 i = 0; i < optionalDepth; ++i) {
+                        null = null->mutable_nested_value();
+                    }
+                    null->set_null_flag_value(::google::protobuf::NULL_VALUE);
+                } else {
+                    size_t count = 0;
+                    ReadList([&] {
+                        CheckIndex(count++, 1, "Optional");
+                        Read(type.optional_type().item(), value, optionalDepth + 1);
+                    });
+                    CheckCount(count, 1, "Optional");
+                }
+                break;
+
+            case Ydb::Type::kListType:
+                ReadList([&] {
+                    Read(type.list_type().item(), *value.add_items());
+                });
+                break;
+
+            case Ydb::Type::kTupleType: {
+                const auto& elements = type.tuple_type().elements();
+                size_t count = 0;
+                ReadList([&] {
+                    CheckIndex(count, elements.size(), "Tuple");
+                    Read(elements[count++], *value.add_items());
+                });
+                CheckCount(count, elements.size(), "Tuple");
+                break;
+            }
+
+            case Ydb::Type::kStructType: {
+                const auto& members = type.struct_type().members();
+                size_t count = 0;
+                ReadList([&] {
+                    CheckIndex(count, members.size(), "Struct");
+                    Read(members[count++].type(), *value.add_items());
+                });
+                CheckCount(count, members.size(), "Struct");
+                break;
+            }
+
+            case Ydb::Type::kDictType:
+                ReadList([&] {
+                    auto* pair = value.add_pairs();
+                    size_t count = 0;
+                    ReadList([&] {
+                        CheckIndex(count++, 2, "Dict item");
+                        if (count == 1) {
+                            Read(type.dict_type().key(), *pair->mutable_key());
+                        } else {
+                            Read(type.dict_type().payload(), *pair->mutable_payload());
+                        }
+                    });
+                    CheckCount(count, 2, "Dict item");
+                });
+                break;
+
+            case Ydb::Type::kEmptyListType:
+            case Ydb::Type::kEmptyDictType:
+                ReadList([&] {
+                    ThrowFatalError("Empty list or dict has items");
+                });
+                break;
+
+            case Ydb::Type::kTaggedType:
+                Read(type.tagged_type().type(), value, optionalDepth);
+                break;
+
+            case Ydb::Type::kVoidType:
+                ReadString([](std::string_view) {});
+                break;
+
+            case Ydb::Type::kNullType:
+                Expect(NYson::ETokenType::Hash);
+                value.set_null_flag_value(::google::protobuf::NULL_VALUE);
+                break;
+
+            default:
+                ThrowFatalError(TStringBuilder() << "Unsupported type: " << TType(type));
+        }
+    }
+
+    void Finish() {
+        Expect(NYson::ETokenType::EndOfStream);
+    }
+
+private:
+    void ReadPrimitive(Ydb::Type::PrimitiveTypeId typeId, Ydb::Value& value) {
+        switch (typeId) {
+            case Ydb::Type::BOOL:
+                Check(NYson::ETokenType::Boolean);
+                value.set_bool_value(Token().GetBooleanValue());
+                Next();
+                break;
+            case Ydb::Type::INT8:
+                value.set_int32_value(ReadInteger<i8>());
+                break;
+            case Ydb::Type::UINT8:
+                value.set_uint32_value(ReadInteger<ui8>());
+                break;
+            case Ydb::Type::INT16:
+                value.set_int32_value(ReadInteger<i16>());
+                break;
+            case Ydb::Type::UINT16:
+                value.set_uint32_value(ReadInteger<ui16>());
+                break;
+            case Ydb::Type::INT32:
+                value.set_int32_value(ReadInteger<i32>());
+                break;
+            case Ydb::Type::UINT32:
+            case Ydb::Type::DATE:
+            case Ydb::Type::DATETIME:
+                value.set_uint32_value(ReadInteger<ui32>());
+                break;
+            case Ydb::Type::INT64:
+            case Ydb::Type::INTERVAL:
+                value.set_int64_value(ReadInteger<i64>());
+                break;
+            case Ydb::Type::UINT64:
+            case Ydb::Type::TIMESTAMP:
+                value.set_uint64_value(ReadInteger<ui64>());
+                break;
+            case Ydb::Type::FLOAT:
+                value.set_float_value(ReadDouble());
+                break;
+            case Ydb::Type::DOUBLE:
+                value.set_double_value(ReadDouble());
+                break;
+            case Ydb::Type::STRING:
+            case Ydb::Type::YSON:
+                ReadString([&](std::string_view str) {
+                    value.set_bytes_value(str.data(), str.size());
+                });
+                break;
+            case Ydb::Type::TZ_DATE:
+            case Ydb::Type::TZ_DATETIME:
+            case Ydb::Type::TZ_TIMESTAMP:
+            case Ydb::Type::UTF8:
+            case Ydb::Type::JSON:
+            case Ydb::Type::JSON_DOCUMENT:
+            case Ydb::Type::DYNUMBER:
+                ReadString([&](std::string_view str) {
+                    value.set_text_value(str.data(), str.size());
+                });
+                break;
+            case Ydb::Type::UUID:
+                ReadString([&](std::string_view str) {
+                    TUuidValue uuid{std::string(str)};
+                    value.set_low_128(uuid.Buf_.Halfs[0]);
+                    value.set_high_128(uuid.Buf_.Halfs[1]);
+                });
+                break;
+            default:
+                ThrowFatalError(TStringBuilder() << "Unsupported primitive type: " << static_cast<EPrimitiveType>(typeId));
+        }
+    }
+
+    template <typename T>
+    T ReadInteger() {
+        bool fits = false;
+        T result = 0;
+        if (Type() == NYson::ETokenType::Int64) {
+            fits = std::in_range<T>(Token().GetInt64Value());
+            result = static_cast<T>(Token().GetInt64Value());
+        } else if (Type() == NYson::ETokenType::Uint64) {
+            fits = std::in_range<T>(Token().GetUint64Value());
+            result = static_cast<T>(Token().GetUint64Value());
+        } else {
+            Check(NYson::ETokenType::Int64);
+        }
+
+        if (!fits) {
+            ThrowFatalError(TStringBuilder() << "Value " << NYson::ToString(Token()) << " doesn't fit in "
+                << sizeof(T) * 8 << " bit " << (std::is_signed_v<T> ? "signed" : "unsigned") << " integer");
+        }
+        Next();
+        return result;
+    }
+
+    double ReadDouble() {
+        double result = 0;
+        switch (Type()) {
+            case NYson::ETokenType::Double:
+                result = Token().GetDoubleValue();
+                break;
+            case NYson::ETokenType::Int64:
+                result = Token().GetInt64Value();
+                break;
+            case NYson::ETokenType::Uint64:
+                result = Token().GetUint64Value();
+                break;
+            default:
+                Check(NYson::ETokenType::Double);
+        }
+        Next();
+        return result;
+    }
+
+    // The string points to the input or to the buffer of the lexer, it is valid until the next token
+    template <typename TConsume>
+    void ReadString(TConsume&& consume) {
+        Check(NYson::ETokenType::String);
+        consume(Token().GetStringValue());
+        Next();
+    }
+
+    // Items are separated by semicolons, the one after the last item is optional
+    template <typename TReadItem>
+    void ReadList(TReadItem&& readItem) {
+        Expect(NYson::ETokenType::LeftBracket);
+        while (Type() != NYson::ETokenType::RightBracket) {
+            readItem();
+            if (Type() == NYson::ETokenType::Semicolon) {
+                Next();
+            } else {
+                Check(NYson::ETokenType::RightBracket);
+            }
+        }
+        Next();
+    }
+
+    static void CheckIndex(size_t index, size_t count, std::string_view what) {
+        if (index >= count) {
+            ThrowFatalError(TStringBuilder() << what << " has more than " << count << " items");
+        }
+    }
+
+    static void CheckCount(size_t count, size_t expected, std::string_view what) {
+        if (count != expected) {
+            ThrowFatalError(TStringBuilder() << what << " has " << count << " items instead of " << expected);
+        }
+    }
+
+    const NYson::TToken& Token() const {
+        return Tokenizer_.CurrentToken();
+    }
+
+    NYson::ETokenType Type() const {
+        return Tokenizer_.GetCurrentType();
+    }
+
+    void Next() {
+        Tokenizer_.ParseNext();
+    }
+
+    void Check(NYson::ETokenType expected) const {
+        if (Type() != expected) {
+            ThrowFatalError(TStringBuilder() << "Unexpected YSON token " << NYson::ToString(Token())
+                << ", expected " << TokenTypeName(expected));
+        }
+    }
+
+    static std::string TokenTypeName(NYson::ETokenType type) {
+        switch (type) {
+            case NYson::ETokenType::EndOfStream:
+                return "end of stream";
+            case NYson::ETokenType::String:
+                return "string";
+            case NYson::ETokenType::Int64:
+                return "int64";
+            case NYson::ETokenType::Uint64:
+                return "uint64";
+            case NYson::ETokenType::Double:
+                return "double";
+            case NYson::ETokenType::Boolean:
+                return "boolean";
+            default:
+                return NYson::TokenTypeToString(type);
+        }
+    }
+
+    void Expect(NYson::ETokenType expected) {
+        Check(expected);
+        Next();
+    }
+
+private:
+    NYson::TTokenizer Tokenizer_;
+};
+
+} // namespace
+
+TValue YsonToYdbValue(std::string_view yson, const TType& type)
+{
+    Ydb::Value value;
+    TYsonValueReader reader(yson);
+    reader.Read(type.GetProto(), value);
+    reader.Finish();
+    return TValue(type, std::move(value));
+}
+
 } // namespace NYdb
@@ -18,4 +18,7 @@ void FormatResultSetYson(const TResultSet& result, NYson::TYsonWriter& writer);
 
 std::string FormatResultSetYson(const TResultSet& result, NYson::EYsonFormat ysonFormat = NYson::EYsonFormat::Text);
 
+// Parses text or binary YSON in the format of FormatValueYson, without intermediate NYT::TNode
+TValue YsonToYdbValue(std::string_view yson, const TType& type);
+
 } // namespace NYdb
@@ -0,0 +1,77 @@
+#include "ydb_yson_value.h"
+
+#include <library/cpp/testing/unittest/registar.h>
+#include <client/ydb_types/exceptions/exceptions.h>
+#include <client/ydb_proto/accessor.h>
+
+namespace NYdb {
+
+namespace {
+
+void CheckRoundTrip(const TValue& value, const std::string& expectedYson) {
+    UNIT_ASSERT_NO_DIFF(FormatValueYson(value), expectedYson);
+
+    for (auto format : {NYson::EYsonFormat::Text, NYson::EYsonFormat::Binary, NYson::EYsonFormat::Pretty}) {
+        TValue resultValue = YsonToYdbValue(FormatValueYson(value, format), value.GetType());
+        UNIT_ASSERT_NO_DIFF(
+            TProtoAccessor::GetProto(value).DebugString(),
+            TProtoAccessor::GetProto(resultValue).DebugString()
+        );
+    }
+}
+
+} // namespace
+
+Y_UNIT_TEST_SUITE(YsonValueTest) {
+    Y_UNIT_TEST(PrimitiveValues) {
+        CheckRoundTrip(TValueBuilder().Bool(true).Build(), "%true");
+        CheckRoundTrip(TValueBuilder().Int8(-128).Build(), "-128");
+        CheckRoundTrip(TValueBuilder().Uint64(Max<ui64>()).Build(), "18446744073709551615u");
+        CheckRoundTrip(TValueBuilder().Double(1.5).Build(), "1.5");
+        CheckRoundTrip(TValueBuilder().String("a\"b\\c\n").Build(), R"("a\"b\\c\n")");
+        CheckRoundTrip(TValueBuilder().Utf8("utf8").Build(), R"("utf8")");
+        CheckRoundTrip(TValueBuilder().Decimal(TDecimalValue("-12.345", 22, 9)).Build(), R"("-12.345")");
+        CheckRoundTrip(TValueBuilder().Uuid(TUuidValue("5b99a330-04ef-4f1a-9b64-ba6d5f44eafe")).Build(),
+            R"("5b99a330-04ef-4f1a-9b64-ba6d5f44eafe")");
+    }
+
+    Y_UNIT_TEST(ContainerValues) {
+        auto int32Type = TTypeBuilder().Primitive(EPrimitiveType::Int32).Build();
+
+        CheckRoundTrip(TValueBuilder().OptionalInt32(std::nullopt).Build(), "#");
+        CheckRoundTrip(TValueBuilder()
+            .BeginOptional()
+                .EmptyOptional(int32Type)
+            .EndOptional()
+            .Build(), "[#]");
+        CheckRoundTrip(TValueBuilder()
+            .BeginList()
+                .AddListItem().OptionalInt32(1)
+                .AddListItem().OptionalInt32(std::nullopt)
+            .EndList()
+            .Build(), "[[1];#]");
+        CheckRoundTrip(TValueBuilder()
+            .BeginStruct()
+                .AddMember("Id").Uint32(1)
+                .AddMember("Name").Utf8("name")
+            .EndStruct()
+            .Build(), R"([1u;"name"])");
+        CheckRoundTrip(TValueBuilder()
+            .BeginDict()
+                .AddDictItem().DictKey().Utf8("key").DictPayload().BeginTuple().AddElement().Int32(1).EndTuple()
+            .EndDict()
+            .Build(), R"([["key";[1]]])");
+        CheckRoundTrip(TValueBuilder().EmptyList(int32Type).Build(), "[]");
+    }
+
+    Y_UNIT_TEST(ParseErrors) {
+        auto uint8Type = TTypeBuilder().Primitive(EPrimitiveType::Uint8).Build();
+
+        UNIT_ASSERT_EXCEPTION(YsonToYdbValue("300", uint8Type), TContractViolation);
+        UNIT_ASSERT_EXCEPTION(YsonToYdbValue("\"1\"", uint8Type), TContractViolation);
+        UNIT_ASSERT_EXCEPTION(YsonToYdbValue("1 2", uint8Type), TContractViolation);
+        UNIT_ASSERT_EXCEPTION(YsonToYdbValue("[1;2]", TValueBuilder().OptionalUint8(1).Build().GetType()), TContractViolation);
+    }
+}
+
+} // namespace NYdb